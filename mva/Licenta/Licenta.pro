@@ -1,6 +1,7 @@
 QT       += core gui sql
 QT       += widgets
-QT       += winextras
+win32:QT += winextras
+QT       += network
 
 include(others/project-configuration/project-defines.pri)
 
@@ -9,6 +10,7 @@ TEMPLATE = app
 
 INCLUDEPATH += $$PWD/proto-buffers/includes
 
+win32 {
 QMAKE_CFLAGS_RELEASE += -Zi
 
 QMAKE_LFLAGS_RELEASE += /DEBUG
@@ -26,6 +28,7 @@ LIBS += -lWbemuuid
 LIBS += -liphlpapi
 LIBS += -lws2_32
 LIBS += -lPdh
+LIBS += -lWinmm
 LIBS += -lNetapi32
 LIBS += -lShell32
 LIBS += -lPsapi
@@ -38,6 +41,11 @@ LIBS += -l$$PWD/modules/motherboard/video-card/api/nvidia-api/x86/nvapi
 
 DEFINES += NOMINMAX
 DEFINES += STK_WINDOWS
+}
+
+# Per module cost of the tool on the hidden diagnostics page and in the
+# exporter, remove to compile the instrumentation out
+DEFINES += STK_SELF_PROFILE
 
 Release:DESTDIR = $$PWD/../build
 Release:OBJECTS_DIR = $$PWD/../build/.obj
@@ -54,6 +62,7 @@ Debug:UI_DIR = $$PWD/../build/.ui
 
 SOURCES += main/main.cpp \
         utils/sources/utils.cpp \
+        utils/sources/self_profile.cpp \
         gui/abstract_controller.cpp \
         gui/view_adapter.cpp \
         controller/controller.cpp \
@@ -72,28 +81,46 @@ SOURCES += main/main.cpp \
         modules/operating-system/system-drivers/sources/system-drivers.cpp \
         modules/network/active-connections/active_connections.cpp \
         modules/computer/sensors/sources/stk_driver_wrapper.cpp \
-        modules/computer/sensors/sources/it87.cpp \
+        modules/computer/sensors/sources/cpu_topology.cpp \
         modules/network/network-devices/sources/network_devices.cpp \
         modules/motherboard/cpu/sources/intel_cpuid.cpp \
         modules/computer/sensors/sources/sensor_module.cpp \
+        modules/computer/sensors/sources/sensor_samples.cpp \
+        modules/computer/sensors/sources/sensor_delta.cpp \
+        modules/computer/sensors/sources/sensor_history.cpp \
+        modules/computer/sensors/sources/sensor_log.cpp \
+        modules/computer/sensors/sources/sensor_alarms.cpp \
+        modules/computer/sensors/sources/sensor_burst.cpp \
+        modules/computer/sensors/sources/sampling_policy.cpp \
+        modules/computer/sensors/sources/sensor_exporter.cpp \
         modules/computer/sensors/sources/hardware_usage.cpp \
+        modules/computer/sensors/sources/numa_memory.cpp \
+        modules/computer/sensors/sources/rapl_power.cpp \
+        modules/computer/sensors/sources/core_frequency.cpp \
+        modules/computer/sensors/sources/cpu_times.cpp \
+        modules/computer/sensors/sources/disk_performance.cpp \
+        modules/computer/sensors/sources/thermal_throttle.cpp \
         modules/computer/sensors/sources/intel_temperature.cpp \
         modules/computer/sensors/sources/factory_board_sensor.cpp \
+        modules/computer/sensors/sources/superio_descriptors.cpp \
+        modules/computer/sensors/sources/superio_sensor.cpp \
+        modules/computer/sensors/sources/superio_cache.cpp \
+        modules/computer/sensors/sources/hwmon_sensor.cpp \
         modules/computer/sensors/sources/factory_cpu_sensor.cpp \
-        modules/computer/sensors/sources/w836xx.cpp \
         modules/operating-system/processes/sources/processes.cpp \
         modules/software/startup-applications/sources/startup_application.cpp \
-        modules/computer/sensors/sources/f718xx.cpp \
         modules/computer/sensors/sources/amd0f_temperature.cpp \
         modules/computer/sensors/sources/amd10_temperature.cpp \
         modules/computer/device_manager/device_manager.cpp \
         modules/motherboard/video-card/nvidia_card.cpp \
         modules/motherboard/memory/memory_data.cpp \
+        modules/motherboard/memory/memory_benchmark.cpp \
         modules/operating-system/system-users/system_users_information.cpp \
         modules/software/applications-manager/sources/process_wrapper.cpp \
         modules/computer/dmi/sources/type3_enclosure_information.cpp \
         modules/computer/dmi/sources/type7_cache_information.cpp \
         modules/motherboard/memory/spd.cpp \
+        modules/motherboard/memory/spd_timings.cpp \
         modules/operating-system/summary/sources/operating_system.cpp \
         gui/sources/main_window.cpp \
         gui/sources/battery_status_widget.cpp \
@@ -114,6 +141,7 @@ SOURCES += main/main.cpp \
         gui/sources/spd_widget.cpp \
         gui/sources/video_card_widget.cpp \
         gui/sources/operating_system_widget.cpp \
+        gui/sources/diagnostics_widget.cpp \
         modules/motherboard/cpu/sources/cpuid_manager.cpp \
         modules/motherboard/cpu/sources/amd_cpuid.cpp \
         gui/sources/waiting_widget.cpp \
@@ -122,6 +150,7 @@ SOURCES += main/main.cpp \
     modules/motherboard/video-card/coverdrive6.cpp
 
 HEADERS  += gui/abstract_controller.h \
+        utils/headers/self_profile.h \
         gui/view_adapter.h \
         controller/controller.h \
         gui/headers/main_window.h \
@@ -150,29 +179,46 @@ HEADERS  += gui/abstract_controller.h \
         modules/network/active-connections/network_structures.h \
         modules/computer/sensors/driver/driver_defines.h \
         modules/computer/sensors/headers/stk_driver_wrapper.h \
+        modules/computer/sensors/headers/cpu_topology.h \
         modules/computer/sensors/interfaces/isensor.h \
-        modules/computer/sensors/headers/it87.h \
         modules/computer/sensors/headers/sensor_defines.h \
         modules/network/network-devices/headers/network_devices.h \
         modules/motherboard/cpu/headers/cpuid_defines.h \
         modules/motherboard/cpu/headers/intel_cpuid.h \
         modules/computer/sensors/headers/sensor_module.h \
+        modules/computer/sensors/headers/sensor_samples.h \
+        modules/computer/sensors/headers/sensor_delta.h \
+        modules/computer/sensors/headers/sensor_history.h \
+        modules/computer/sensors/headers/sensor_log.h \
+        modules/computer/sensors/headers/sensor_alarms.h \
+        modules/computer/sensors/headers/sensor_burst.h \
+        modules/computer/sensors/headers/sampling_policy.h \
+        modules/computer/sensors/headers/sensor_exporter.h \
         modules/computer/sensors/headers/hardware_usage.h \
+        modules/computer/sensors/headers/numa_memory.h \
+        modules/computer/sensors/headers/rapl_power.h \
+        modules/computer/sensors/headers/core_frequency.h \
+        modules/computer/sensors/headers/cpu_times.h \
+        modules/computer/sensors/headers/disk_performance.h \
+        modules/computer/sensors/headers/thermal_throttle.h \
         modules/computer/sensors/headers/intel_temperature.h \
         modules/computer/sensors/headers/factory_board_sensor.h \
+        modules/computer/sensors/headers/superio_descriptors.h \
+        modules/computer/sensors/headers/superio_sensor.h \
+        modules/computer/sensors/headers/superio_cache.h \
+        modules/computer/sensors/headers/hwmon_sensor.h \
         modules/computer/sensors/headers/factory_cpu_sensor.h \
-        modules/computer/sensors/headers/w836xx.h \
         modules/api.h \
         modules/operating-system/processes/headers/processes.h \
         modules/operating-system/processes/headers/processes_structs.h \
         modules/software/startup-applications/headers/startup_application.h \
-        modules/computer/sensors/headers/f718xx.h \
         modules/computer/sensors/headers/amd0f_temperature.h \
         modules/computer/sensors/headers/amd10_temperature.h \
         modules/computer/device_manager/device_manager.h \
         modules/motherboard/video-card/video_structures.h \
         modules/motherboard/video-card/nvidia_card.h \
         modules/motherboard/memory/memory_data.h \
+        modules/motherboard/memory/memory_benchmark.h \
         modules/operating-system/system-users/system_users_information.h \
         modules/operating-system/system-users/system_users_information_structs.h \
         modules/software/applications-manager/headers/process_wrapper.h \
@@ -180,6 +226,7 @@ HEADERS  += gui/abstract_controller.h \
         modules/computer/dmi/headers/type7_cache_information.h \
         modules/motherboard/memory/spd.h \
         modules/motherboard/memory/spd_defines.h \
+        modules/motherboard/memory/spd_timings.h \
         modules/operating-system/summary/headers/operating_system.h \
         gui/headers/battery_status_widget.h \
         gui/headers/application_manager_widget.h \
@@ -199,6 +246,7 @@ HEADERS  += gui/abstract_controller.h \
         gui/headers/spd_widget.h \
         gui/headers/video_card_widget.h \
         gui/headers/operating_system_widget.h \
+        gui/headers/diagnostics_widget.h \
         modules/motherboard/cpu/headers/cpuid_manager.h \
         modules/motherboard/cpu/headers/amd_cpuid.h \
         gui/headers/waiting_widget.h \
@@ -227,6 +275,7 @@ FORMS    += \
         gui/forms/spd_widget.ui \
         gui/forms/video_card_widget.ui \
         gui/forms/operating_system_widget.ui \
+        gui/forms/diagnostics_widget.ui \
         gui/forms/waiting_widget.ui
 
 OTHER_FILES += \
@@ -272,3 +321,64 @@ resourceFile.path = $$PWD/../build
 resourceFile.files += $$PWD/resources.rcc
 
 INSTALLS += resourceFile
+
+# The pages, the controller and the Ring0 driver are built on the Windows
+# APIs. On Linux only the sensor backends, the memory benchmark and the
+# memory inventory build, as a static library with the hwmon, /proc and
+# sysfs sources in place of the driver.
+unix {
+TEMPLATE = lib
+CONFIG += staticlib
+QT -= widgets sql network
+
+QMAKE_POST_LINK =
+INSTALLS =
+
+SOURCES = utils/sources/utils.cpp \
+        utils/sources/self_profile.cpp \
+        modules/computer/sensors/sources/sensor_samples.cpp \
+        modules/computer/sensors/sources/sensor_delta.cpp \
+        modules/computer/sensors/sources/sensor_history.cpp \
+        modules/computer/sensors/sources/sensor_log.cpp \
+        modules/computer/sensors/sources/sensor_alarms.cpp \
+        modules/computer/sensors/sources/sensor_burst.cpp \
+        modules/computer/sensors/sources/sampling_policy.cpp \
+        modules/computer/sensors/sources/sensor_exporter.cpp \
+        modules/computer/sensors/sources/numa_memory.cpp \
+        modules/computer/sensors/sources/rapl_power.cpp \
+        modules/computer/sensors/sources/core_frequency.cpp \
+        modules/computer/sensors/sources/cpu_times.cpp \
+        modules/computer/sensors/sources/disk_performance.cpp \
+        modules/computer/sensors/sources/factory_board_sensor.cpp \
+        modules/computer/sensors/sources/hwmon_sensor.cpp \
+        modules/computer/sensors/sources/factory_cpu_sensor.cpp \
+        modules/motherboard/memory/memory_benchmark.cpp \
+        modules/motherboard/memory/memory_data.cpp
+
+HEADERS = utils/headers/utils.h \
+        utils/headers/self_profile.h \
+        modules/computer/sensors/interfaces/isensor.h \
+        modules/computer/sensors/headers/sensor_defines.h \
+        modules/computer/sensors/headers/sensor_samples.h \
+        modules/computer/sensors/headers/sensor_delta.h \
+        modules/computer/sensors/headers/sensor_history.h \
+        modules/computer/sensors/headers/sensor_log.h \
+        modules/computer/sensors/headers/sensor_alarms.h \
+        modules/computer/sensors/headers/sensor_burst.h \
+        modules/computer/sensors/headers/sampling_policy.h \
+        modules/computer/sensors/headers/sensor_exporter.h \
+        modules/computer/sensors/headers/numa_memory.h \
+        modules/computer/sensors/headers/rapl_power.h \
+        modules/computer/sensors/headers/core_frequency.h \
+        modules/computer/sensors/headers/cpu_times.h \
+        modules/computer/sensors/headers/disk_performance.h \
+        modules/computer/sensors/headers/factory_board_sensor.h \
+        modules/computer/sensors/headers/hwmon_sensor.h \
+        modules/computer/sensors/headers/factory_cpu_sensor.h \
+        modules/motherboard/memory/memory_benchmark.h \
+        modules/motherboard/memory/memory_data.h
+
+FORMS =
+RESOURCES =
+LIBS += -lpthread
+}
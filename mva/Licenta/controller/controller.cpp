@@ -1,5 +1,12 @@
 #include "controller.h"
 
+#include <limits>
+
+#include <QDir>
+#include <QStandardPaths>
+
+#include "../utils/headers/self_profile.h"
+
 #pragma warning(disable:4996)
 
 int Controller::OnLoadDriverFile()
@@ -164,6 +171,12 @@ int Controller::AssignStandardModelsToUi()
     pModel = m_pSPDManager->GetDimmsInformationModel();
     if( pModel )
         emit OnSetDimmSPDInformation(pModel);
+    pModel = m_pRAMManager->GetRAMInformations();
+    if( pModel )
+        emit OnSetMemoryModulesInformation(pModel);
+    pModel = m_pMemoryBenchmark->GetResultsModel();
+    if( pModel )
+        emit OnSetMemoryBenchmarkInformation(pModel);
 
     // Nvidia models
     pModel = m_pNVidiaManager->GetPhysicalGPUModel();
@@ -226,23 +239,36 @@ int Controller::AssignStandardModelsToUi()
     // Startup applications models
     emit OnSetStartupApplicationsInformations(m_pStartupAppsManager->GetDataModel());
 
+    // Diagnostics models
+    emit OnSetDiagnosticsInformation(m_pDiagnosticsModel);
+
     return Success;
 }
 
 Controller::Controller(): m_pBatteryStatus(NULL), m_pApplicationManager(NULL),
     m_pDMIManager(NULL), m_pSmartManager(NULL), m_pSystemDriversManager(NULL),
     m_pActiveConnectionsManager(NULL), m_pNetworkDevicesManager(NULL), m_pCPUIDManager(NULL),
-    m_pSensorsManager(NULL), m_pSensor(NULL), m_pSensorsTimer(NULL), m_pCpuSensor(NULL), m_pNVidiaManager(NULL),
+    m_pSensorsManager(NULL), m_pSensor(NULL), m_pCpuSensor(NULL), m_pNVidiaManager(NULL),
     m_pProcessesManager(NULL), m_pStartupAppsManager(NULL), m_pComputerSummaryModel(NULL), m_pDeviceManager(NULL),
-    m_pUserInformationManager(NULL), m_pUninstallerProcess(NULL), m_pSPDManager(NULL), m_pOperatingSystemManager(NULL),
-    m_pATAHdds(NULL), m_pATAProp(NULL), m_nIsNvidia(-1)
+    m_pUserInformationManager(NULL), m_pUninstallerProcess(NULL), m_pSPDManager(NULL), m_pRAMManager(NULL), m_pMemoryBenchmark(NULL), m_pOperatingSystemManager(NULL),
+    m_pATAHdds(NULL), m_pATAProp(NULL), m_pDiagnosticsModel(NULL), m_nIsNvidia(-1), m_pSensorSamples(NULL), m_pSensorHistory(NULL),
+    m_pSensorLog(NULL), m_pSensorAlarms(NULL), m_pSensorExporter(NULL), m_pSamplingTimer(NULL),
+    m_pSensorBurst(NULL), m_pBurstFrequency(NULL), m_pSamplingPolicy(NULL),
+    m_nBoardId(SENSOR_INVALID_ID),
+    m_nCpuTempsId(SENSOR_INVALID_ID), m_nCpuLoadId(SENSOR_INVALID_ID), m_nCpuTimesId(SENSOR_INVALID_ID),
+    m_nCpuPowerId(SENSOR_INVALID_ID),
+    m_nCpuClockId(SENSOR_INVALID_ID), m_nCpuThrottleId(SENSOR_INVALID_ID), m_nMemoryId(SENSOR_INVALID_ID),
+    m_nNumaId(SENSOR_INVALID_ID), m_nDiskId(SENSOR_INVALID_ID), m_nOverheadId(SENSOR_INVALID_ID),
+    m_bSensorsTreeSent(false), m_bSensorsPageStale(true), m_nVCardIndex(0)
 {
-    m_pSensorsTimer = new QTimer(this);
-    connect(m_pSensorsTimer, SIGNAL(timeout()), this, SLOT(OnComputerSensorsOptClickedSlot()), Qt::QueuedConnection);
-    m_pGPUTimer = new QTimer(this);
-    connect(m_pGPUTimer, SIGNAL(timeout()), this, SLOT(OnRefreshVCardInformations()), Qt::QueuedConnection);
+    // Sensors, the sensors page and the video card page share this wakeup
+    m_pSamplingPolicy = new CSamplingPolicy;
+    m_pSamplingTimer = new QTimer(this);
+    m_pSamplingTimer->setSingleShot(true);
+    connect(m_pSamplingTimer, SIGNAL(timeout()), this, SLOT(OnSampleSensorsSlot()), Qt::QueuedConnection);
 
     connect(this, SIGNAL(OnCancelSensorsTimerSignal()), this, SLOT(OnCancelSensorsTimerSlot()), Qt::QueuedConnection);
+    connect(this, SIGNAL(OnMemoryBenchmarkFinishedSignal(int)), this, SLOT(OnMemoryBenchmarkFinishedSlot(int)), Qt::QueuedConnection);
 
     qDebug() << "Driver Loading status: " << OnLoadDriverFile();
 
@@ -257,6 +283,10 @@ Controller::Controller(): m_pBatteryStatus(NULL), m_pApplicationManager(NULL),
     m_pCPUIDManager = new CCPUIDManager();
     // Create SPD manager obj
     m_pSPDManager = new CSPDInformation();
+    // Create memory inventory obj, reads the SMBIOS and SPD data above
+    m_pRAMManager = new CRAMInformation(m_pDMIManager, m_pSPDManager);
+    // Create memory benchmark obj, rated against the SPD speed
+    m_pMemoryBenchmark = new CMemoryBenchmark(m_pSPDManager);
 
     // Create nvidia manager obj
     m_pNVidiaManager = new CNvidiaManager();
@@ -275,10 +305,12 @@ Controller::Controller(): m_pBatteryStatus(NULL), m_pApplicationManager(NULL),
     // Create ATA objects
     m_pATAHdds = new QStandardItemModel();
     m_pATAProp = new QStandardItemModel();
+    // Create diagnostics model
+    m_pDiagnosticsModel = new QStandardItemModel();
     // Populate hdd list
-    QStringList qHddList = GetPhysicalDrivesList();
+    m_qPhysicalDrives = GetPhysicalDrivesList();
     m_pATAHdds->setHorizontalHeaderLabels(QStringList() << "Devices:");
-    foreach(QString qsDrive, qHddList)
+    foreach(QString qsDrive, m_qPhysicalDrives)
     {
         ATADeviceProperties *pProperty = GetATADeviceProperties(qsDrive.toStdWString().c_str());
         if( NULL == pProperty )
@@ -314,10 +346,23 @@ Controller::~Controller()
     SAFE_DELETE(m_pActiveConnectionsManager);
     SAFE_DELETE(m_pNetworkDevicesManager);
 //    SAFE_DELETE(m_pCPUIDManager); // HEAP CORRUPTION
+    // The benchmark and the burst sampler must be idle before either goes
+    if( m_BenchmarkThread.joinable() )
+        m_BenchmarkThread.join();
+    SAFE_DELETE(m_pSensorBurst);
+    SAFE_DELETE(m_pBurstFrequency);
+    SAFE_DELETE(m_pSensorExporter);
+    SAFE_DELETE(m_pSensorAlarms);
+    SAFE_DELETE(m_pSensorLog);
+    SAFE_DELETE(m_pSensorHistory);
+    SAFE_DELETE(m_pSensorSamples);
+    SAFE_DELETE(m_pSamplingPolicy);
     SAFE_DELETE(m_pSensorsManager)
     SAFE_DELETE(m_pProcessesManager);
     SAFE_DELETE(m_pStartupAppsManager);
     SAFE_DELETE(m_pUserInformationManager);
+    SAFE_DELETE(m_pMemoryBenchmark);
+    SAFE_DELETE(m_pRAMManager);
     SAFE_DELETE(m_pSPDManager);
     SAFE_DELETE(m_pNVidiaManager);
     SAFE_DELETE(m_pRadeonManager);
@@ -325,6 +370,7 @@ Controller::~Controller()
 
     SAFE_DELETE(m_pATAHdds);
     SAFE_DELETE(m_pATAProp);
+    SAFE_DELETE(m_pDiagnosticsModel);
 
     m_HDDModelToPhysicalDrive.clear();
 
@@ -474,8 +520,12 @@ void Controller::StartController()
 
     // Create Sensor Object
     m_pSensorsManager = new CSensorModule;
-    // get board sensor
-    m_pSensor = m_pSensorsManager->GetBoardSensor();
+    // get board sensor, the Super-I/O detection is cached per baseboard in
+    // the user's local data, the install directory is usually read only
+    QString qsCacheDirectory = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    if (!QDir().mkpath(qsCacheDirectory))
+        qsCacheDirectory.clear();
+    m_pSensor = m_pSensorsManager->GetBoardSensor(qsCacheDirectory, m_pDMIManager->GetBaseboardIdentity());
     if (m_pSensor)
         if (Success != m_pSensor->Initialize())
         {
@@ -499,6 +549,654 @@ void Controller::StartController()
         else
             m_pCPUIDManager->GetCPUIDDataModel()->item(9, 1)->setText("N/A");
     }
+
+    int nStatus = InitializeSensorSamples();
+    CHECK_OPERATION_STATUS(nStatus);
+}
+
+static void OnSensorAlarm(const SensorAlarmEvent *pEvent, const QString &qsMessage, void *pContext)
+{
+    Controller *pController = (Controller*)pContext;
+
+    emit pController->OnSensorAlarmSignal(pEvent->nSensorId, pEvent->bRaised, qsMessage);
+}
+
+static void OnSensorAlarmBurst(int nSensorId, unsigned long long ullDuration, void *pContext)
+{
+    Q_UNUSED(nSensorId);
+
+    ((CSensorBurst*)pContext)->Trigger(ullDuration);
+}
+
+// Burst sources, called on the burst sampler thread with the hardware
+// mutex held
+static int ReadBurstBoard(void *pContext, double *pValues)
+{
+    return ((ISensor*)pContext)->Update(pValues);
+}
+
+static int ReadBurstCpuTemperature(void *pContext, double *pValues)
+{
+    ICPUSensor *pCpuSensor = (ICPUSensor*)pContext;
+
+    int nStatus = pCpuSensor->Update();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    memcpy(pValues, pCpuSensor->GetTemps(), pCpuSensor->GetNumberOfCores() * sizeof(double));
+
+    return Success;
+}
+
+// Effective clocks, then C0 residency, the order they are registered in
+static int ReadBurstCpuClock(void *pContext, double *pValues)
+{
+    CCoreFrequency *pCoreFrequency = (CCoreFrequency*)pContext;
+
+    int nStatus = pCoreFrequency->Update();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    const CoreFrequency *pCores = pCoreFrequency->GetCores();
+    int nCores = pCoreFrequency->GetCoreCount();
+    for(int i = 0; i < nCores; i++)
+    {
+        pValues[i] = pCores[i].dEffective;
+        pValues[nCores + i] = pCores[i].dResidency;
+    }
+
+    return Success;
+}
+
+int Controller::InitializeSensorSamples()
+{
+    char szName[SENSOR_NAME_SIZE];
+
+    m_pSensorSamples = new CSensorSamples;
+    CHECK_ALLOCATION_STATUS(m_pSensorSamples);
+
+    // IDs of a block are consecutive, only the first one is kept
+    if( m_pSensor )
+    {
+        m_qzBoardName = m_pSensor->GetChipName();
+
+        // every channel the chip reports, in Update() order
+        const SensorChannel *pChannels = m_pSensor->GetChannels();
+        for(int i = 0; i < m_pSensor->GetChannelCount(); i++)
+        {
+            int nId = m_pSensorSamples->Register(SensorGroupBoard, pChannels[i].Kind, pChannels[i].Unit, pChannels[i].szLabel);
+            if( 0 == i )
+                m_nBoardId = nId;
+        }
+        m_qBoardValues.fill(0, m_pSensor->GetChannelCount());
+    }
+
+    m_qzCpuName = m_pSensorsManager->GetCpuName();
+    if( m_pCpuSensor )
+    {
+        for(int i = 0; i < m_pCpuSensor->GetNumberOfCores(); i++)
+        {
+            sprintf(szName, "Core #%d", i + 1);
+            int nId = m_pSensorSamples->Register(SensorGroupCpu, SensorKindTemperature, SensorUnitCelsius, szName);
+            if( 0 == i )
+                m_nCpuTempsId = nId;
+        }
+    }
+    m_nCpuLoadId = m_pSensorSamples->Register(SensorGroupCpu, SensorKindLoad, SensorUnitPercent, "Total: ");
+
+    // Time per state of every logical CPU, the CPU is the instance
+    CCpuTimes *pCpuTimes = m_pSensorsManager->GetCpuTimes();
+    if( pCpuTimes && pCpuTimes->GetCpuCount() )
+    {
+        for(int i = 0; i < pCpuTimes->GetCpuCount(); i++)
+        {
+            for(int j = 0; j < CpuTimeStateCount; j++)
+            {
+                int nId = m_pSensorSamples->Register(SensorGroupCpu, SensorKindLoad, SensorUnitPercent,
+                                                     CPU_TIME_STATE_STRING((CpuTimeState)j), i);
+                if( SENSOR_INVALID_ID == m_nCpuTimesId )
+                    m_nCpuTimesId = nId;
+            }
+        }
+    }
+
+    // RAPL domains present on this part, then per core energy (AMD only)
+    CRaplPower *pRaplPower = m_pSensorsManager->GetRaplPower();
+    if( pRaplPower )
+    {
+        for(int i = 0; i < RaplDomainCount; i++)
+        {
+            if( !pRaplPower->HasDomain((RaplDomain)i) )
+                continue;
+
+            int nId = m_pSensorSamples->Register(SensorGroupCpu, SensorKindPower, SensorUnitWatt, RAPL_DOMAIN_STRING((RaplDomain)i));
+            if( SENSOR_INVALID_ID == m_nCpuPowerId )
+                m_nCpuPowerId = nId;
+        }
+
+        for(int i = 0; i < pRaplPower->GetCoreCount(); i++)
+        {
+            sprintf(szName, "Core #%d: ", i + 1);
+            int nId = m_pSensorSamples->Register(SensorGroupCpu, SensorKindPower, SensorUnitWatt, szName);
+            if( SENSOR_INVALID_ID == m_nCpuPowerId )
+                m_nCpuPowerId = nId;
+        }
+    }
+
+    // Effective clock of every core, then C0 residency in the same order
+    CCoreFrequency *pCoreFrequency = m_pSensorsManager->GetCoreFrequency();
+    if( pCoreFrequency && pCoreFrequency->GetCoreCount() )
+    {
+        for(int i = 0; i < pCoreFrequency->GetCoreCount(); i++)
+        {
+            sprintf(szName, "Core #%d: ", i + 1);
+            int nId = m_pSensorSamples->Register(SensorGroupCpu, SensorKindClock, SensorUnitMHz, szName);
+            if( 0 == i )
+                m_nCpuClockId = nId;
+        }
+
+        for(int i = 0; i < pCoreFrequency->GetCoreCount(); i++)
+        {
+            sprintf(szName, "Core #%d: ", i + 1);
+            m_pSensorSamples->Register(SensorGroupCpu, SensorKindResidency, SensorUnitPercent, szName);
+        }
+    }
+
+    // Cumulative throttling transitions, package by reason then per core.
+    // History and the on-disk log keep the tick at which each count moved.
+    CThermalThrottle *pThrottle = m_pCpuSensor ? m_pCpuSensor->GetThermalThrottle() : NULL;
+    if( pThrottle )
+    {
+        for(int i = 0; i < ThrottleReasonCount; i++)
+        {
+            sprintf(szName, "Package %s", THROTTLE_REASON_STRING((ThrottleReason)i));
+            int nId = m_pSensorSamples->Register(SensorGroupCpu, SensorKindThrottle, SensorUnitNone, szName);
+            if( 0 == i )
+                m_nCpuThrottleId = nId;
+        }
+
+        for(int i = 0; i < pThrottle->GetCoreCount(); i++)
+        {
+            sprintf(szName, "Core #%d: ", i + 1);
+            m_pSensorSamples->Register(SensorGroupCpu, SensorKindThrottle, SensorUnitNone, szName);
+        }
+    }
+
+    // What the tool itself costs, reported next to what it measures
+    m_nOverheadId = m_pSensorSamples->Register(SensorGroupCpu, SensorKindOverhead, SensorUnitPercent, "CPU time: ");
+    m_pSensorSamples->Register(SensorGroupCpu, SensorKindOverhead, SensorUnitWatt, "Package power: ");
+    m_pSensorSamples->Register(SensorGroupCpu, SensorKindOverhead, SensorUnitNone, "Wakeups/min: ");
+    m_pSensorSamples->Register(SensorGroupCpu, SensorKindOverhead, SensorUnitMilliseconds, "Interval: ");
+
+    m_nMemoryId = m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Total (Physical): ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Available (Physical): ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Pagefile (Total): ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Pagefile (Available): ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindLoad, SensorUnitPercent, "Physical: ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Committed: ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Commit limit: ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Cache: ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Standby: ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitBytes, "Modified: ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitPagesPerSecond, "Pages in: ");
+    m_pSensorSamples->Register(SensorGroupMemory, SensorKindMemory, SensorUnitPagesPerSecond, "Pages out: ");
+
+    // NUMA nodes, only meaningful on multi socket hosts
+    CNumaMemory *pNumaMemory = m_pSensorsManager->GetNumaMemory();
+    if( pNumaMemory && 1 < pNumaMemory->GetNodeCount() )
+    {
+        const NumaNodeMemory *pNodes = pNumaMemory->GetNodes();
+        for(int i = 0; i < pNumaMemory->GetNodeCount(); i++)
+        {
+            int nId = m_pSensorSamples->Register(SensorGroupMemory, SensorKindNuma, SensorUnitBytes, "Total: ", pNodes[i].nNode);
+            if( 0 == i )
+                m_nNumaId = nId;
+            m_pSensorSamples->Register(SensorGroupMemory, SensorKindNuma, SensorUnitBytes, "Free: ", pNodes[i].nNode);
+
+            if( !pNumaMemory->HasCounters() )
+                continue;
+
+            m_pSensorSamples->Register(SensorGroupMemory, SensorKindNuma, SensorUnitPages, "Hit: ", pNodes[i].nNode);
+            m_pSensorSamples->Register(SensorGroupMemory, SensorKindNuma, SensorUnitPages, "Miss: ", pNodes[i].nNode);
+            m_pSensorSamples->Register(SensorGroupMemory, SensorKindNuma, SensorUnitPages, "Local: ", pNodes[i].nNode);
+            m_pSensorSamples->Register(SensorGroupMemory, SensorKindNuma, SensorUnitPages, "Remote: ", pNodes[i].nNode);
+        }
+    }
+
+    // Physical drives in the order ATA and SMART list them, the disk
+    // number is the instance
+    CDiskPerformance *pDiskPerformance = m_pSensorsManager->GetDiskPerformance();
+    if( pDiskPerformance && Success == pDiskPerformance->Initialize(m_qPhysicalDrives) )
+    {
+        const DiskLoad *pDisks = pDiskPerformance->GetDisks();
+        for(int i = 0; i < pDiskPerformance->GetDiskCount(); i++)
+        {
+            int nId = m_pSensorSamples->Register(SensorGroupStorage, SensorKindDisk, SensorUnitBytesPerSecond, "Read: ", pDisks[i].nDisk);
+            if( 0 == i )
+                m_nDiskId = nId;
+            m_pSensorSamples->Register(SensorGroupStorage, SensorKindDisk, SensorUnitBytesPerSecond, "Write: ", pDisks[i].nDisk);
+            m_pSensorSamples->Register(SensorGroupStorage, SensorKindDisk, SensorUnitIops, "Read IOPS: ", pDisks[i].nDisk);
+            m_pSensorSamples->Register(SensorGroupStorage, SensorKindDisk, SensorUnitIops, "Write IOPS: ", pDisks[i].nDisk);
+            m_pSensorSamples->Register(SensorGroupStorage, SensorKindDisk, SensorUnitNone, "Queue depth: ", pDisks[i].nDisk);
+            m_pSensorSamples->Register(SensorGroupStorage, SensorKindDisk, SensorUnitMilliseconds, "Latency: ", pDisks[i].nDisk);
+        }
+    }
+
+    // UpdateSensorSamples() uses all three, each one is created before the
+    // first early return and stays a no-op until initialized
+    m_pSensorHistory = new CSensorHistory;
+    CHECK_ALLOCATION_STATUS(m_pSensorHistory);
+    m_pSensorLog = new CSensorLog;
+    CHECK_ALLOCATION_STATUS(m_pSensorLog);
+    m_pSensorAlarms = new CSensorAlarms;
+    CHECK_ALLOCATION_STATUS(m_pSensorAlarms);
+
+    int nStatus = m_pSensorHistory->Initialize(m_pSensorSamples->GetCount());
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    // The on-disk log is optional, the in-memory history works without it
+    nStatus = m_pSensorLog->Open(QCoreApplication::applicationDirPath() + "/history", m_pSensorSamples);
+    CHECK_OPERATION_STATUS(nStatus);
+
+    nStatus = m_pSensorAlarms->Load(QCoreApplication::applicationDirPath() + "/" SENSOR_ALARMS_RULES_FILE,
+                                    m_pSensorSamples);
+    CHECK_OPERATION_STATUS(nStatus);
+
+    if( m_pSensorAlarms->GetRuleCount() )
+    {
+        nStatus = m_pSensorAlarms->OpenLog(QCoreApplication::applicationDirPath() + "/" SENSOR_ALARMS_LOG_FILE);
+        CHECK_OPERATION_STATUS(nStatus);
+
+        nStatus = m_pSensorAlarms->Listen(SENSOR_ALARMS_SOCKET_NAME);
+        CHECK_OPERATION_STATUS(nStatus);
+
+        m_pSensorAlarms->SetCallback(OnSensorAlarm, this);
+    }
+
+    // High frequency capture for alarm rules with a burst option, enabled
+    // by its config file only. It samples all along to have the history
+    // before a trigger, so without such a rule it is not started at all.
+    int nBurstRate = 0;
+    unsigned int uBurstSources = 0;
+    if( m_pSensorAlarms->GetBurstRuleCount() &&
+        Success == CSensorBurst::ReadConfig(QCoreApplication::applicationDirPath() + "/" SENSOR_BURST_CONFIG_FILE,
+                                            &nBurstRate, &uBurstSources) )
+    {
+        nStatus = InitializeSensorBurst(nBurstRate, uBurstSources);
+        CHECK_OPERATION_STATUS(nStatus);
+    }
+
+    // The exporter is enabled by its config file only
+    QString qsAddress;
+    unsigned short usPort = 0;
+    bool bProfile = false;
+    if( Success == CSensorExporter::ReadConfig(QCoreApplication::applicationDirPath() + "/" SENSOR_EXPORTER_CONFIG_FILE,
+                                               &qsAddress, &usPort, &bProfile) )
+    {
+        // The tool's own cost per module, scraped with the sensors
+        if( bProfile )
+            CSelfProfile::Enable(true);
+
+        m_pSensorExporter = new CSensorExporter;
+        CHECK_ALLOCATION_STATUS(m_pSensorExporter);
+
+        nStatus = m_pSensorExporter->Bind(m_pSensorSamples);
+        CHECK_OPERATION_STATUS_EX(nStatus);
+
+        // A taken port only disables the exporter
+        nStatus = m_pSensorExporter->Start(qsAddress, usPort);
+        CHECK_OPERATION_STATUS(nStatus);
+        if( Success != nStatus )
+        {
+            SAFE_DELETE(m_pSensorExporter);
+            return Success;
+        }
+
+        // Scrapes have to see fresh values while the sensors page is closed
+        m_pSamplingPolicy->SetActive(SamplingSourceSensors, true);
+        ScheduleSampling();
+    }
+
+    return Success;
+}
+
+int Controller::InitializeSensorBurst(int nRate, unsigned int uSources)
+{
+    m_pSensorBurst = new CSensorBurst;
+    CHECK_ALLOCATION_STATUS(m_pSensorBurst);
+
+    if( (uSources & (1 << SensorBurstBoard)) && SENSOR_INVALID_ID != m_nBoardId )
+        m_pSensorBurst->AddSource(m_nBoardId, m_qBoardValues.size(), ReadBurstBoard, m_pSensor);
+
+    if( (uSources & (1 << SensorBurstCpuTemperature)) && SENSOR_INVALID_ID != m_nCpuTempsId )
+        m_pSensorBurst->AddSource(m_nCpuTempsId, m_pCpuSensor->GetNumberOfCores(), ReadBurstCpuTemperature, m_pCpuSensor);
+
+    // Counters of its own, the tick keeps measuring over its 750 ms
+    if( (uSources & (1 << SensorBurstCpuClock)) && SENSOR_INVALID_ID != m_nCpuClockId )
+    {
+        m_pBurstFrequency = new CCoreFrequency;
+        CHECK_ALLOCATION_STATUS(m_pBurstFrequency);
+
+        if( Success == m_pBurstFrequency->Initialize() )
+            m_pSensorBurst->AddSource(m_nCpuClockId, 2 * m_pBurstFrequency->GetCoreCount(), ReadBurstCpuClock, m_pBurstFrequency);
+    }
+
+    int nStatus = m_pSensorBurst->Start(m_pSensorSamples, nRate,
+                                        QCoreApplication::applicationDirPath() + "/" SENSOR_BURST_LOG_FILE);
+    if( Success != nStatus )
+    {
+        SAFE_DELETE(m_pSensorBurst);
+        SAFE_DELETE(m_pBurstFrequency);
+        return nStatus;
+    }
+
+    m_pSensorAlarms->SetBurstCallback(OnSensorAlarmBurst, m_pSensorBurst);
+
+    return Success;
+}
+
+int Controller::UpdateSensorSamples()
+{
+    // The previous tick and whatever ran since, pages included, is closed
+    STK_PROFILE_END_TICK();
+    STK_PROFILE_SCOPE(ProfileModuleSensorTick);
+
+    unsigned long long ullTimestamp = SensorTimestamp();
+    double *pResults = 0;
+
+    m_pSensorSamples->BeginUpdate();
+
+    // The burst sampler reads the board and CPU sensors from its own thread
+    std::mutex *pHardwareMutex = m_pSensorBurst ? &m_pSensorBurst->GetHardwareMutex() : NULL;
+    if( pHardwareMutex )
+        pHardwareMutex->lock();
+
+    if( SENSOR_INVALID_ID != m_nBoardId && Success == m_pSensor->Update(m_qBoardValues.data()) )
+    {
+        for(int i = 0; i < m_qBoardValues.size(); i++)
+            m_pSensorSamples->Set(m_nBoardId + i, m_qBoardValues[i], ullTimestamp);
+    }
+
+    if( m_pCpuSensor )
+    {
+        // A failed read keeps the previous samples rather than stale registers
+        if( Success == m_pCpuSensor->Update() )
+        {
+            pResults = m_pCpuSensor->GetTemps();
+            for(int i = 0; i < m_pCpuSensor->GetNumberOfCores(); i++)
+                m_pSensorSamples->Set(m_nCpuTempsId + i, pResults[i], ullTimestamp);
+        }
+
+        // Updated by the CPU sensor above
+        CThermalThrottle *pThrottle = m_pCpuSensor->GetThermalThrottle();
+        if( SENSOR_INVALID_ID != m_nCpuThrottleId && pThrottle )
+        {
+            const ThrottleCounter *pPackage = pThrottle->GetPackage();
+            for(int i = 0; i < ThrottleReasonCount; i++)
+                m_pSensorSamples->Set(m_nCpuThrottleId + i, pPackage->pEvents[i], ullTimestamp);
+
+            for(int i = 0; i < pThrottle->GetCoreCount(); i++)
+                m_pSensorSamples->Set(m_nCpuThrottleId + ThrottleReasonCount + i, pThrottle->GetCoreEvents(i), ullTimestamp);
+        }
+    }
+
+    if( pHardwareMutex )
+        pHardwareMutex->unlock();
+
+    // One snapshot gives the total and every CPU
+    CCpuTimes *pCpuTimes = m_pSensorsManager->GetCpuTimes();
+    if( pCpuTimes && Success == pCpuTimes->Update() )
+    {
+        m_pSensorSamples->Set(m_nCpuLoadId, pCpuTimes->GetLoad(), ullTimestamp);
+
+        if( SENSOR_INVALID_ID != m_nCpuTimesId )
+        {
+            const CpuTimes *pCpus = pCpuTimes->GetCpus();
+            int nId = m_nCpuTimesId;
+            for(int i = 0; i < pCpuTimes->GetCpuCount(); i++)
+            {
+                for(int j = 0; j < CpuTimeStateCount; j++)
+                    m_pSensorSamples->Set(nId++, pCpus[i].pPercent[j], ullTimestamp);
+            }
+        }
+    }
+
+    CRaplPower *pRaplPower = m_pSensorsManager->GetRaplPower();
+    if( SENSOR_INVALID_ID != m_nCpuPowerId && Success == pRaplPower->Update() )
+    {
+        int nId = m_nCpuPowerId;
+        for(int i = 0; i < RaplDomainCount; i++)
+        {
+            if( pRaplPower->HasDomain((RaplDomain)i) )
+                m_pSensorSamples->Set(nId++, pRaplPower->GetPower((RaplDomain)i), ullTimestamp);
+        }
+
+        for(int i = 0; i < pRaplPower->GetCoreCount(); i++)
+            m_pSensorSamples->Set(nId++, pRaplPower->GetCorePower(i), ullTimestamp);
+    }
+
+    CCoreFrequency *pCoreFrequency = m_pSensorsManager->GetCoreFrequency();
+    if( SENSOR_INVALID_ID != m_nCpuClockId && Success == pCoreFrequency->Update() )
+    {
+        const CoreFrequency *pCores = pCoreFrequency->GetCores();
+        int nCores = pCoreFrequency->GetCoreCount();
+        for(int i = 0; i < nCores; i++)
+        {
+            m_pSensorSamples->Set(m_nCpuClockId + i, pCores[i].dEffective, ullTimestamp);
+            m_pSensorSamples->Set(m_nCpuClockId + nCores + i, pCores[i].dResidency, ullTimestamp);
+        }
+    }
+
+    // Sampled into the same struct every tick
+    if( Success == m_pSensorsManager->GetMemoryStat(&m_MemoryStatus) )
+    {
+        m_pSensorSamples->Set(m_nMemoryId, (double)m_MemoryStatus.ullTotalPhys, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 1, (double)m_MemoryStatus.ullAvailPhys, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 2, (double)m_MemoryStatus.ullTotalPageFile, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 3, (double)m_MemoryStatus.ullAvailPageFile, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 4, (double)m_MemoryStatus.ulMemoryLoad, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 5, m_MemoryStatus.dCommitted, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 6, m_MemoryStatus.dCommitLimit, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 7, m_MemoryStatus.dCache, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 8, m_MemoryStatus.dStandby, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 9, m_MemoryStatus.dModified, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 10, m_MemoryStatus.dPagesIn, ullTimestamp);
+        m_pSensorSamples->Set(m_nMemoryId + 11, m_MemoryStatus.dPagesOut, ullTimestamp);
+    }
+
+    CNumaMemory *pNumaMemory = m_pSensorsManager->GetNumaMemory();
+    if( SENSOR_INVALID_ID != m_nNumaId && Success == pNumaMemory->Update() )
+    {
+        const NumaNodeMemory *pNodes = pNumaMemory->GetNodes();
+        int nId = m_nNumaId;
+        for(int i = 0; i < pNumaMemory->GetNodeCount(); i++)
+        {
+            m_pSensorSamples->Set(nId++, (double)pNodes[i].ullTotal, ullTimestamp);
+            m_pSensorSamples->Set(nId++, (double)pNodes[i].ullFree, ullTimestamp);
+
+            if( !pNumaMemory->HasCounters() )
+                continue;
+
+            m_pSensorSamples->Set(nId++, (double)pNodes[i].ullHit, ullTimestamp);
+            m_pSensorSamples->Set(nId++, (double)pNodes[i].ullMiss, ullTimestamp);
+            m_pSensorSamples->Set(nId++, (double)pNodes[i].ullLocal, ullTimestamp);
+            m_pSensorSamples->Set(nId++, (double)pNodes[i].ullRemote, ullTimestamp);
+        }
+    }
+
+    CDiskPerformance *pDiskPerformance = m_pSensorsManager->GetDiskPerformance();
+    if( SENSOR_INVALID_ID != m_nDiskId && Success == pDiskPerformance->Update() )
+    {
+        const DiskLoad *pDisks = pDiskPerformance->GetDisks();
+        int nId = m_nDiskId;
+        for(int i = 0; i < pDiskPerformance->GetDiskCount(); i++)
+        {
+            m_pSensorSamples->Set(nId++, pDisks[i].dReadRate, ullTimestamp);
+            m_pSensorSamples->Set(nId++, pDisks[i].dWriteRate, ullTimestamp);
+            m_pSensorSamples->Set(nId++, pDisks[i].dReadIops, ullTimestamp);
+            m_pSensorSamples->Set(nId++, pDisks[i].dWriteIops, ullTimestamp);
+            m_pSensorSamples->Set(nId++, pDisks[i].dQueueDepth, ullTimestamp);
+            m_pSensorSamples->Set(nId++, pDisks[i].dLatency, ullTimestamp);
+        }
+    }
+
+    // Process CPU time over the period, the package share is its part of
+    // the busy time of all CPUs
+    const SamplingOverhead *pOverhead = m_pSamplingPolicy->GetOverhead();
+    double dOverheadPower = std::numeric_limits<double>::quiet_NaN();
+    if( pCpuTimes && pCpuTimes->GetCpuCount() && SENSOR_INVALID_ID != m_nCpuPowerId &&
+        pRaplPower->HasDomain(RaplDomainPackage) )
+    {
+        double dBusy = pCpuTimes->GetLoad() * pCpuTimes->GetCpuCount();
+        if( 0 < dBusy )
+            dOverheadPower = pRaplPower->GetPower(RaplDomainPackage) * qMin(1.0, pOverhead->dCpuPercent / dBusy);
+    }
+
+    m_pSensorSamples->Set(m_nOverheadId, pOverhead->dCpuPercent, ullTimestamp);
+    m_pSensorSamples->Set(m_nOverheadId + 1, dOverheadPower, ullTimestamp);
+    m_pSensorSamples->Set(m_nOverheadId + 2, pOverhead->dWakeupsPerMinute, ullTimestamp);
+    m_pSensorSamples->Set(m_nOverheadId + 3, pOverhead->dInterval, ullTimestamp);
+
+    m_pSamplingPolicy->Observe(m_pSensorSamples);
+
+    m_pSensorAlarms->Evaluate();
+
+    if( m_pSensorExporter )
+    {
+        ExportSelfProfile();
+        m_pSensorExporter->Render();
+    }
+
+    m_pSensorLog->Append(m_pSensorSamples);
+
+    return m_pSensorHistory->Record(m_pSensorSamples);
+}
+
+void Controller::ExportGPUValues(int nIndex)
+{
+    static const char *pszMetrics[] = { "stk_gpu_temperature_celsius", "stk_gpu_fan_speed_rpm",
+                                        "stk_gpu_fan_speed_percent", "stk_gpu_usage_percent" };
+    QList<GpuReading> qReadings;
+
+    if( !m_pSensorExporter )
+        return;
+
+    if( m_nIsNvidia == 1 )
+        qReadings = m_pNVidiaManager->GetReadings();
+    if( m_nIsNvidia == 0 )
+        qReadings = m_pRadeonManager->GetReadings();
+
+    for(int i = 0; i < qReadings.size(); i++)
+    {
+        const GpuReading *pReading = &qReadings.at(i);
+
+        QString qsField = SensorShortName(pReading->qsField.toLatin1().constData());
+        if( qsField.isEmpty() )
+            qsField = QString("#%1").arg(i + 1);
+
+        m_pSensorExporter->SetGauge(pszMetrics[pReading->Kind], QString("gpu=\"%1\",field=\"%2\"").arg(nIndex)
+                                    .arg(SensorExporterLabel(qsField)), pReading->dValue);
+    }
+}
+
+void Controller::ExportSMARTValues(const QString &qzModel)
+{
+    if( !m_pSensorExporter )
+        return;
+
+    QList<SmartData*> qEntries = m_pSmartManager->GetSmartData();
+    for(int i = 0; i < qEntries.size(); i++)
+    {
+        const SmartData *pData = qEntries.at(i);
+        const SmartDetails *pDetails = pData ? m_pSmartManager->GetSMARTDetailsFromDB(pData->m_ucAttribIndex) : NULL;
+
+        // The same attributes as the SMART page
+        if( !pDetails )
+            continue;
+
+        QString qsLabels = QString("drive=\"%1\",id=\"%2\",attribute=\"%3\"")
+                .arg(SensorExporterLabel(qzModel.trimmed()))
+                .arg(pDetails->m_ucAttribId)
+                .arg(SensorExporterLabel(pDetails->m_csAttribName.trimmed()));
+
+        m_pSensorExporter->SetGauge("stk_smart_raw", qsLabels, pData->m_dwAttribValue);
+        m_pSensorExporter->SetGauge("stk_smart_value", qsLabels, pData->m_ucValue);
+        m_pSensorExporter->SetGauge("stk_smart_worst", qsLabels, pData->m_ucWorst);
+        m_pSensorExporter->SetGauge("stk_smart_threshold", qsLabels, pData->m_dwThreshold);
+    }
+}
+
+void Controller::ExportSelfProfile()
+{
+    ProfileCounters pTick[ProfileModuleCount];
+    ProfileCounters pTotals[ProfileModuleCount];
+
+    if( !CSelfProfile::IsEnabled() )
+        return;
+
+    CSelfProfile::GetLastTick(pTick);
+    CSelfProfile::GetTotals(pTotals);
+
+    // The last tick as gauges, the totals as counters so rate() works on them
+    for(int i = 0; i < ProfileModuleCount; i++)
+    {
+        ProfileModule Module = (ProfileModule)i;
+        QString qsLabels = QString("module=\"%1\"").arg(PROFILE_MODULE_STRING(Module));
+        QString qsTickLabels = qsLabels + ",period=\"tick\"";
+
+        m_pSensorExporter->SetGauge("stk_profile_calls", qsTickLabels, (double)pTick[i].ullCalls);
+        m_pSensorExporter->SetGauge("stk_profile_wall_seconds", qsTickLabels, pTick[i].ullWallTime / 1000000.0);
+        m_pSensorExporter->SetGauge("stk_profile_cpu_seconds", qsTickLabels, pTick[i].ullCpuTime / 1000000.0);
+        m_pSensorExporter->SetGauge("stk_profile_syscalls", qsTickLabels, (double)pTick[i].ullSyscalls);
+        m_pSensorExporter->SetGauge("stk_profile_allocations", qsTickLabels, (double)pTick[i].ullAllocations);
+
+        m_pSensorExporter->SetCounter("stk_profile_calls_total", qsLabels, (double)pTotals[i].ullCalls);
+        m_pSensorExporter->SetCounter("stk_profile_wall_seconds_total", qsLabels, pTotals[i].ullWallTime / 1000000.0);
+        m_pSensorExporter->SetCounter("stk_profile_cpu_seconds_total", qsLabels, pTotals[i].ullCpuTime / 1000000.0);
+        m_pSensorExporter->SetCounter("stk_profile_syscalls_total", qsLabels, (double)pTotals[i].ullSyscalls);
+        m_pSensorExporter->SetCounter("stk_profile_allocations_total", qsLabels, (double)pTotals[i].ullAllocations);
+    }
+}
+
+static void AppendProfileRows(QStandardItemModel *pModel, const QString &qsTitle, const ProfileCounters *pCounters)
+{
+    QStandardItem *pRoot = new QStandardItem(qsTitle);
+    QList<QStandardItem*> qList;
+
+    for(int i = 0; i < ProfileModuleCount; i++)
+    {
+        ProfileModule Module = (ProfileModule)i;
+
+        qList << new QStandardItem(QString(PROFILE_MODULE_STRING(Module)));
+        qList << new QStandardItem(QString::number(pCounters[i].ullCalls));
+        qList << new QStandardItem(QString().sprintf("%.3f ms", pCounters[i].ullWallTime / 1000.0));
+        qList << new QStandardItem(QString().sprintf("%.3f ms", pCounters[i].ullCpuTime / 1000.0));
+        qList << new QStandardItem(QString::number(pCounters[i].ullSyscalls));
+        qList << new QStandardItem(QString::number(pCounters[i].ullAllocations));
+
+        pRoot->appendRow(qList);
+        qList.clear();
+    }
+
+    pModel->appendRow(pRoot);
+}
+
+void Controller::RefreshDiagnostics()
+{
+    ProfileCounters pLastTick[ProfileModuleCount];
+    ProfileCounters pTotals[ProfileModuleCount];
+
+    CSelfProfile::GetLastTick(pLastTick);
+    unsigned long long ullTicks = CSelfProfile::GetTotals(pTotals);
+
+    m_pDiagnosticsModel->clear();
+    m_pDiagnosticsModel->setHorizontalHeaderLabels(QStringList() << "Module" << "Calls" << "Wall time" << "CPU time"
+                                                   << "Kernel calls" << "Allocations");
+
+#ifndef STK_SELF_PROFILE
+    m_pDiagnosticsModel->appendRow(new QStandardItem("Built without STK_SELF_PROFILE, nothing is recorded"));
+#endif
+
+    AppendProfileRows(m_pDiagnosticsModel, "Last tick", pLastTick);
+    AppendProfileRows(m_pDiagnosticsModel, QString("Since enabled, %1 ticks").arg(ullTicks), pTotals);
 }
 
 
@@ -546,6 +1244,9 @@ void Controller::OnDispatchMenuOptionTagSlot(int nOptionTag)
     case SOFTWARE_STARTUP_APPLICATIONS_ID:
         OnSoftwareStartupApplicationsOptClickedSlot(); break;
 
+    case DIAGNOSTICS_ID:
+        OnDiagnosticsOptClickedSlot(); break;
+
     default:
         qDebug() << "Invalid Menu Option Clicked";
     }
@@ -583,6 +1284,24 @@ void Controller::OnComputerPowerManagementOptClickedSlot()
 
 void Controller::OnComputerSensorsOptClickedSlot()
 {
+    if (!m_pSensorSamples)
+        return;
+
+    // The page missed the ticks while it was closed
+    m_bSensorsPageStale = true;
+    m_pSamplingPolicy->SetActive(SamplingSourceSensors, true);
+    m_pSamplingPolicy->SetActive(SamplingSourceSensorsPage, true);
+
+    UpdateSensorSamples();
+    SendSensorsPage();
+
+    ScheduleSampling();
+}
+
+void Controller::SendSensorsPage()
+{
+    STK_PROFILE_SCOPE(ProfileModuleSensorsPage);
+
     SensorsData pSensorData;
 
     DataType *pDataType = 0;
@@ -590,139 +1309,90 @@ void Controller::OnComputerSensorsOptClickedSlot()
     MotherboardData *pMBData = 0;
     CpuData *pCpuData = 0;
     RAMData *pRAMData = 0;
+    DiskData *pDiskData = 0;
 
-    double *pResults = 0;
-    VoltageReading *pVoltages = 0;
-    QString qzTemp1 = "", qzTemp2 = "";
-    MemoryStatus* pMemoryStatus = 0;
-
-    if (!m_pSensorsTimer->isActive())
-        m_pSensorsTimer->start(750);
-
-    if (!m_pSensor)
-        goto CPU;
-
-    pMBData = pSensorData.mutable_mbdata();
-    pMBData->set_name(m_pSensor->GetChipName().toLatin1().data());
+    // One schema per tree root, concatenated in the order the page walks them
+    std::string pSchemas[SensorGroupStorage + 1];
 
-    m_pSensor->Update();
-    pResults = m_pSensor->GetTemps();
+    int nGroup = -1, nKind = -1, nInstance = -1;
 
-    pDataType = pMBData->add_data();
-    pDataType->set_dataname("Temperatures: ");
-
-    for(int i = 0; i < 3; i++)
+    // The page holds the tree already, only the changed values go out
+    if (m_bSensorsTreeSent)
     {
-        if (!pResults[i])
-            continue;
-        qzTemp1.sprintf("Temperature #%d", i + 1);
-        qzTemp2.sprintf("%.1fC", pResults[i]);
-
-        pItemPair = pDataType->add_datavalue();
-        pItemPair->set_name(qzTemp1.toLatin1().data());
-        pItemPair->set_value(qzTemp2.toLatin1().data());
-    }
-
-    // voltages
-    pDataType = pMBData->add_data();
-    pDataType->set_dataname("Voltages: ");
-
-    pVoltages = m_pSensor->GetVoltages();
-
-    for(int i = 0; i < 4; i++)
-    {
-        pItemPair = pDataType->add_datavalue();
-        pItemPair->set_name(pVoltages[i].qzName.toLatin1().data());
-        pItemPair->set_value(pVoltages[i].qzValue.toLatin1().data());
+        SensorPackDelta(m_pSensorSamples, m_bSensorsPageStale, &m_sSensorsDelta);
+        m_bSensorsPageStale = false;
+        if (!m_sSensorsDelta.empty())
+            emit OnUpdateSensorsValues(m_sSensorsDelta);
+        return;
     }
 
-    // fan speed
-    pDataType = pMBData->add_data();
-    pDataType->set_dataname("Fan speed: ");
-
-    pResults = m_pSensor->GetFanSpeeds();
-
-    for(int i = 0; i < 5; i++)
+    if (m_pSensor)
     {
-        if (!pResults[i])
-            continue;
-        qzTemp1.sprintf("Fan #%d", i + 1);
-        qzTemp2.sprintf("%.1fRPM", pResults[i]);
-
-        pItemPair = pDataType->add_datavalue();
-        pItemPair->set_name(qzTemp1.toLatin1().data());
-        pItemPair->set_value(qzTemp2.toLatin1().data());
+        pMBData = pSensorData.mutable_mbdata();
+        pMBData->set_name(m_qzBoardName.toLatin1().data());
     }
 
-CPU:
-    if (NULL == m_pCpuSensor)
-        goto RAM;
-
     pCpuData = pSensorData.mutable_cpudata();
-    pCpuData->set_name(m_pSensorsManager->GetCpuName().toLatin1().data());
-
-    pDataType = pCpuData->add_data();
-    pDataType->set_dataname("Temperatures: ");
-
-    m_pCpuSensor->Update();
-    pResults = m_pCpuSensor->GetTemps();
+    pCpuData->set_name(m_qzCpuName.toLatin1().data());
 
-    qzTemp1 = "", qzTemp2 = "";
-    for(int i = 0; i < m_pCpuSensor->GetNumberOfCores(); i++)
-    {
-        if (!pResults[i])
-            continue;
-        qzTemp1.sprintf("Core #%d", i + 1);
-        qzTemp2.sprintf("%.1fC", pResults[i]);
-
-        pItemPair = pDataType->add_datavalue();
-        pItemPair->set_name(qzTemp1.toLatin1().data());
-        pItemPair->set_value(qzTemp2.toLatin1().data());
-    }
-
-    pDataType = pCpuData->add_data();
-    pDataType->set_dataname("Usage: ");
-
-    pItemPair = pDataType->add_datavalue();
-    pItemPair->set_name("Load: ");
-    pItemPair->set_value(QString().sprintf("%.2f%", m_pSensorsManager->GetCpuLoad()).toLatin1().data());
-
-RAM:
     pRAMData = pSensorData.mutable_ramdata();
     pRAMData->set_name("Memory");
 
-    pMemoryStatus = m_pSensorsManager->GetMemoryStat();
-
-    // DATA
-    pDataType = pRAMData->add_data();
-    pDataType->set_dataname("Data: ");
+    if (SENSOR_INVALID_ID != m_nDiskId)
+    {
+        pDiskData = pSensorData.mutable_diskdata();
+        pDiskData->set_name("Storage");
+    }
 
-    pItemPair = pDataType->add_datavalue();
-    pItemPair->set_name("Total (Physical): ");
-    pItemPair->set_value(pMemoryStatus->qzTotalPhys.toLatin1().data());
+    // Values are only formatted here, for display
+    const SensorDescriptor *pDescriptors = m_pSensorSamples->GetDescriptors();
+    const double *pValues = m_pSensorSamples->GetValues();
 
-    pItemPair = pDataType->add_datavalue();
-    pItemPair->set_name("Available (Physical): ");
-    pItemPair->set_value(pMemoryStatus->qzAvailPhys.toLatin1().data());
+    for(int i = 0; i < m_pSensorSamples->GetCount(); i++)
+    {
+        const SensorDescriptor *pDescriptor = &pDescriptors[i];
 
-    pItemPair = pDataType->add_datavalue();
-    pItemPair->set_name("Pagefile (Total): ");
-    pItemPair->set_value(pMemoryStatus->qzTotalPageFile.toLatin1().data());
+        if (pDescriptor->Group != nGroup || pDescriptor->Kind != nKind || pDescriptor->nInstance != nInstance)
+        {
+            switch (pDescriptor->Group)
+            {
+            case SensorGroupBoard:
+                pDataType = pMBData->add_data(); break;
+            case SensorGroupCpu:
+                pDataType = pCpuData->add_data(); break;
+            case SensorGroupStorage:
+                pDataType = pDiskData->add_data(); break;
+            default:
+                pDataType = pRAMData->add_data(); break;
+            }
 
-    pItemPair = pDataType->add_datavalue();
-    pItemPair->set_name("Pagefile (Available): ");
-    pItemPair->set_value(pMemoryStatus->qzAvailPageFile.toLatin1().data());
+            if (SensorKindNuma == pDescriptor->Kind)
+                pDataType->set_dataname(QString().sprintf("NUMA node #%d: ", pDescriptor->nInstance).toLatin1().data());
+            else if (SensorKindDisk == pDescriptor->Kind)
+                pDataType->set_dataname(QString().sprintf("Disk #%d: ", pDescriptor->nInstance).toLatin1().data());
+            else if (SensorKindLoad == pDescriptor->Kind && 0 <= pDescriptor->nInstance)
+                pDataType->set_dataname(QString().sprintf("CPU #%d: ", pDescriptor->nInstance + 1).toLatin1().data());
+            else
+                pDataType->set_dataname(SENSOR_KIND_STRING(pDescriptor->Kind));
+
+            nGroup = pDescriptor->Group;
+            nKind = pDescriptor->Kind;
+            nInstance = pDescriptor->nInstance;
+        }
 
-    // LOAD
-    pDataType = pRAMData->add_data();
-    pDataType->set_dataname("Load: ");
+        pItemPair = pDataType->add_datavalue();
+        pItemPair->set_name(pDescriptor->szName);
+        pItemPair->set_value(SensorFormatValue(pValues[i], pDescriptor->Unit).toLatin1().data());
 
-    pItemPair = pDataType->add_datavalue();
-    pItemPair->set_name("Value");
-    pItemPair->set_value(pMemoryStatus->qzMemoryLoad.toLatin1().data());
+        SensorAppendSchema(&pSchemas[pDescriptor->Group], i, pDescriptor->Unit);
+    }
 
+    m_bSensorsTreeSent = true;
+    m_bSensorsPageStale = false;
 
-    emit OnSetSensorsInformations(pSensorData.SerializeAsString());
+    emit OnSetSensorsInformations(pSensorData.SerializeAsString(),
+                                  pSchemas[SensorGroupBoard] + pSchemas[SensorGroupCpu] +
+                                  pSchemas[SensorGroupMemory] + pSchemas[SensorGroupStorage]);
 }
 
 
@@ -863,6 +1533,22 @@ void Controller::OnCPUOptClickedSlot()
 
 }
 
+void Controller::OnDiagnosticsOptClickedSlot()
+{
+    // Stays enabled until exit, the ticks keep running while the page is
+    // open so that Refresh shows fresh ones
+    CSelfProfile::Enable(true);
+
+    m_pSamplingPolicy->SetActive(SamplingSourceSensors, true);
+    m_pSamplingPolicy->SetActive(SamplingSourceSensorsPage, false);
+    m_pSamplingPolicy->SetActive(SamplingSourceGpu, false);
+    ScheduleSampling();
+
+    RefreshDiagnostics();
+
+    emit OnDiagnosticsInformationDataChanged();
+}
+
 void Controller::OnSmbiosOptClickedSlot()
 {
     qDebug() << __FUNCTION__;
@@ -895,6 +1581,40 @@ void Controller::OnRequestSPDDimmDetailsSlot(int nDimm)
     emit OnSPDDimmInformationDataChanged();
 }
 
+void Controller::OnRunMemoryBenchmarkSlot()
+{
+    // A run is in progress, its results are on the way
+    if( m_BenchmarkThread.joinable() )
+        return;
+
+    // The regular tick keeps sampling, only the high rate captures would
+    // both load the benchmark and record it instead of the machine
+    if( m_pSensorBurst )
+        m_pSensorBurst->Suspend(true);
+
+    m_BenchmarkThread = std::thread(&Controller::RunMemoryBenchmark, this);
+}
+
+void Controller::RunMemoryBenchmark()
+{
+    // Worker thread, the results are published back on the controller thread
+    emit OnMemoryBenchmarkFinishedSignal(m_pMemoryBenchmark->Run());
+}
+
+void Controller::OnMemoryBenchmarkFinishedSlot(int nStatus)
+{
+    m_BenchmarkThread.join();
+
+    if( m_pSensorBurst )
+        m_pSensorBurst->Suspend(false);
+
+    CHECK_OPERATION_STATUS(nStatus);
+    if( Success == nStatus )
+        m_pMemoryBenchmark->Publish();
+
+    emit OnMemoryBenchmarkDataChanged();
+}
+
 void Controller::OnRequestVCardInformationSlot(int nIndex)
 {
     if( m_nIsNvidia == 1 )
@@ -902,9 +1622,11 @@ void Controller::OnRequestVCardInformationSlot(int nIndex)
     if( m_nIsNvidia == 0 )
         m_pRadeonManager->OnRefreshData(nIndex);
 
-    m_pGPUTimer->setProperty("VCardIndex", nIndex);
-    if (!m_pGPUTimer->isActive())
-        m_pGPUTimer->start(750);
+    ExportGPUValues(nIndex);
+
+    m_nVCardIndex = nIndex;
+    m_pSamplingPolicy->SetActive(SamplingSourceGpu, true);
+    ScheduleSampling();
 
     emit OnVideoCardInformationDataChanged();
 }
@@ -972,6 +1694,8 @@ void Controller::OnRequestSMARTProperties(QString qzModel)
 {
     m_pSmartManager->OnRefreshData(qzModel);
 
+    ExportSMARTValues(qzModel);
+
     emit OnSMARTItemPropertiesDataChanged();
 }
 
@@ -1020,17 +1744,74 @@ void Controller::OnAddStartupApplicationSlot(QString qsAppName, QString qsPath)
 
 void Controller::OnCancelSensorsTimerSlot()
 {
-    m_pSensorsTimer->stop();
-    m_pGPUTimer->stop();
+    // Only the exporter keeps the sensors sampled in the background
+    m_pSamplingPolicy->SetActive(SamplingSourceSensors, NULL != m_pSensorExporter);
+    m_pSamplingPolicy->SetActive(SamplingSourceSensorsPage, false);
+    m_pSamplingPolicy->SetActive(SamplingSourceGpu, false);
+
+    ScheduleSampling();
+}
+
+void Controller::ScheduleSampling()
+{
+    int nDelay = m_pSamplingPolicy->Schedule();
+
+    if( 0 > nDelay )
+        m_pSamplingTimer->stop();
+    else
+        m_pSamplingTimer->start(nDelay);
+}
+
+void Controller::OnSampleSensorsSlot()
+{
+    m_pSamplingPolicy->SetOnBattery(m_pBatteryStatus->IsOnBattery());
+
+    // Every source due at this wakeup runs now, back to back
+    unsigned int uDue = m_pSamplingPolicy->BeginWakeup();
+
+    if( (uDue & (1 << SamplingSourceSensors)) && m_pSensorSamples )
+        UpdateSensorSamples();
+
+    if( (uDue & (1 << SamplingSourceSensorsPage)) && m_pSensorSamples )
+        SendSensorsPage();
+
+    if( uDue & (1 << SamplingSourceGpu) )
+        OnRefreshVCardInformations();
+
+    ScheduleSampling();
+}
+
+void Controller::OnWindowVisibilityChangedSlot(bool bVisible)
+{
+    if( bVisible == m_pSamplingPolicy->IsVisible() )
+        return;
+
+    m_pSamplingPolicy->SetVisible(bVisible);
+
+    // The open page is brought up to date right away, not on the next wakeup
+    if( bVisible && m_pSensorSamples && m_pSamplingPolicy->IsActive(SamplingSourceSensorsPage) )
+    {
+        m_bSensorsPageStale = true;
+        UpdateSensorSamples();
+        SendSensorsPage();
+    }
+
+    if( bVisible && m_pSamplingPolicy->IsActive(SamplingSourceGpu) )
+        OnRefreshVCardInformations();
+
+    ScheduleSampling();
 }
 
 void Controller::OnRefreshVCardInformations()
 {
+    STK_PROFILE_SCOPE(ProfileModuleGpu);
+
     if( m_nIsNvidia == 1 )
-        m_pNVidiaManager->OnRefreshData(m_pGPUTimer->property("VCardIndex").toInt());
+        m_pNVidiaManager->OnRefreshData(m_nVCardIndex);
     if( m_nIsNvidia == 0 )
-        m_pRadeonManager->OnRefreshData(m_pGPUTimer->property("VCardIndex").toInt());
+        m_pRadeonManager->OnRefreshData(m_nVCardIndex);
 
+    ExportGPUValues(m_nVCardIndex);
 
     emit OnVideoCardInformationDataChanged();
 }
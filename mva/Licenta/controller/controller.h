@@ -4,6 +4,8 @@
 #include <comdef.h>
 #include <lmcons.h>
 
+#include <thread>
+
 #include "../gui/abstract_controller.h"
 #include "../modules/api.h"
 
@@ -31,6 +33,9 @@ private: // internal objects
     CStartupManager             *m_pStartupAppsManager;
     CSystemUsersInformation     *m_pUserInformationManager;
     CSPDInformation             *m_pSPDManager;
+    CRAMInformation             *m_pRAMManager;
+    CMemoryBenchmark            *m_pMemoryBenchmark;
+    std::thread                 m_BenchmarkThread;
     CNvidiaManager              *m_pNVidiaManager;
     CAmdCard                    *m_pRadeonManager;
     COperatingSystemInformation *m_pOperatingSystemManager;
@@ -38,10 +43,37 @@ private: // internal objects
     CSensorModule               *m_pSensorsManager;
     ISensor                     *m_pSensor;
     ICPUSensor                  *m_pCpuSensor;
-    QTimer                      *m_pSensorsTimer;
-    QTimer                      *m_pGPUTimer;
+    CSensorSamples              *m_pSensorSamples;
+    CSensorHistory              *m_pSensorHistory;
+    CSensorLog                  *m_pSensorLog;
+    CSensorAlarms               *m_pSensorAlarms;
+    CSensorExporter             *m_pSensorExporter;
+    CSensorBurst                *m_pSensorBurst;
+    CCoreFrequency              *m_pBurstFrequency;
+    CSamplingPolicy             *m_pSamplingPolicy;
+    QTimer                      *m_pSamplingTimer;
+    QString                     m_qzBoardName;
+    QString                     m_qzCpuName;
+    int                         m_nBoardId;
+    QVector<double>             m_qBoardValues;
+    int                         m_nCpuTempsId;
+    int                         m_nCpuLoadId;
+    int                         m_nCpuTimesId;
+    int                         m_nCpuPowerId;
+    int                         m_nCpuClockId;
+    int                         m_nCpuThrottleId;
+    int                         m_nMemoryId;
+    MemoryStatus                m_MemoryStatus;
+    int                         m_nNumaId;
+    int                         m_nDiskId;
+    int                         m_nOverheadId;
+    bool                        m_bSensorsTreeSent;
+    bool                        m_bSensorsPageStale;
+    std::string                 m_sSensorsDelta;
+    int                         m_nVCardIndex;
 
     QMap<QString, QString>      m_HDDModelToPhysicalDrive;
+    QStringList                 m_qPhysicalDrives;
 
     QStandardItemModel          *m_pComputerSummaryModel;
 
@@ -50,12 +82,24 @@ private: // internal objects
     // Internal Models
     QStandardItemModel          *m_pATAHdds;
     QStandardItemModel          *m_pATAProp;
+    QStandardItemModel          *m_pDiagnosticsModel;
 
     int OnLoadDriverFile();
     int OnUnloadDriverFile();
 
     int AssignStandardModelsToUi();
 
+    int InitializeSensorSamples();
+    int InitializeSensorBurst(int nRate, unsigned int uSources);
+    int UpdateSensorSamples();
+    void SendSensorsPage();
+    void ScheduleSampling();
+    void ExportGPUValues(int nIndex);
+    void ExportSMARTValues(const QString &qzModel);
+    void ExportSelfProfile();
+    void RefreshDiagnostics();
+    void RunMemoryBenchmark();
+
 public:
     Controller();
     virtual ~Controller();
@@ -92,6 +136,8 @@ public slots:
     virtual void OnSoftwareApplicationManagerOptClickedSlot();
     virtual void OnCPUOptClickedSlot();
 
+    virtual void OnDiagnosticsOptClickedSlot();
+
     // Device manager slots()
     virtual void OnRequestDeviceDetailsSlot(QString);
 
@@ -100,6 +146,7 @@ public slots:
 
     // SPD slots()
     virtual void OnRequestSPDDimmDetailsSlot(int);
+    virtual void OnRunMemoryBenchmarkSlot();
 
     // Video card slots()
     virtual void OnRequestVCardInformationSlot(int);
@@ -124,11 +171,17 @@ public slots:
     virtual void OnChangeStartupApplicationStateSlot(QString);
     virtual void OnAddStartupApplicationSlot(QString, QString);
 
+    // Main window slots()
+    virtual void OnWindowVisibilityChangedSlot(bool);
+
 signals:
     void OnCancelSensorsTimerSignal();
+    void OnMemoryBenchmarkFinishedSignal(int);
 
 private slots:
     void OnCancelSensorsTimerSlot();
+    void OnMemoryBenchmarkFinishedSlot(int);
+    void OnSampleSensorsSlot();
     void OnRefreshVCardInformations();
     void OnUninstallApplicationErrorReportSlot(QString);
 };
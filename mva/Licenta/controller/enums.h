@@ -34,7 +34,10 @@ typedef enum _MENU_OPTIONS_IDS_
     NETWORK_CONNECTIONS_ID,
 
     SOFTWARE_APPLICATION_MANAGER_ID,
-    SOFTWARE_STARTUP_APPLICATIONS_ID
+    SOFTWARE_STARTUP_APPLICATIONS_ID,
+
+    // Not in the menu tree, Ctrl+Shift+D opens it
+    DIAGNOSTICS_ID
 }MenuOptionId;
 
 #define MENU_OPTION_ID_TAG              Qt::UserRole + 1
@@ -47,6 +47,9 @@ signals:
     void OnAvailableDIMMSInformationDataChanged();
     void OnSetDimmSPDInformation(QStandardItemModel*);
     void OnSPDDimmInformationDataChanged();
+    void OnSetMemoryModulesInformation(QStandardItemModel*);
+    void OnSetMemoryBenchmarkInformation(QStandardItemModel*);
+    void OnMemoryBenchmarkDataChanged();
 
     /*** Video card Manager Signals ***/
     void OnSetAvailableVCardsInformation(QStandardItemModel*);
@@ -100,10 +103,16 @@ signals:
 
     void OnSetApplicationManagerInformation(QStandardItemModel *);
 
+    /*** Diagnostics Signals ***/
+    void OnSetDiagnosticsInformation(QStandardItemModel *);
+    void OnDiagnosticsInformationDataChanged();
 
 
 
-    void OnSetSensorsInformations(std::string);
+
+    void OnSetSensorsInformations(std::string, std::string);
+    void OnUpdateSensorsValues(std::string);
+    void OnSensorAlarmSignal(int nSensorId, bool bRaised, QString qsMessage);
 
 
 
@@ -131,6 +140,7 @@ public slots:
     virtual void OnOperatingSystemUserInformationsOptClickedSlot() = 0;
     virtual void OnMotherBoardSPDOptClickedSlot() = 0;
     virtual void OnMotherboardVCardOptClickedSlot() = 0;
+    virtual void OnDiagnosticsOptClickedSlot() = 0;
 
     // Device manager slots
     virtual void OnRequestDeviceDetailsSlot(QString) = 0;
@@ -140,6 +150,7 @@ public slots:
 
     // SPD slots
     virtual void OnRequestSPDDimmDetailsSlot(int) = 0;
+    virtual void OnRunMemoryBenchmarkSlot() = 0;
 
     // Video card slots
     virtual void OnRequestVCardInformationSlot(int) = 0;
@@ -163,6 +174,9 @@ public slots:
     virtual void OnRemoveStartupApplicationSlot(QString) = 0;
     virtual void OnChangeStartupApplicationStateSlot(QString) = 0;
     virtual void OnAddStartupApplicationSlot(QString, QString) = 0;
+
+    // Main window slots()
+    virtual void OnWindowVisibilityChangedSlot(bool) = 0;
 };
 
 #endif // ABSTRACT_CONTROLLER_H
@@ -0,0 +1,32 @@
+#ifndef DIAGNOSTICS_WIDGET_H
+#define DIAGNOSTICS_WIDGET_H
+
+#include <QWidget>
+#include "../abstract_controller.h"
+
+namespace Ui {
+class CDiagnosticsWidget;
+}
+
+// Hidden page with the self profile of the tool, per module
+class CDiagnosticsWidget : public QWidget
+{
+    Q_OBJECT
+
+private:
+    Ui::CDiagnosticsWidget *ui;
+    AbstractController *m_pController;
+
+public:
+    explicit CDiagnosticsWidget(QWidget *parent = 0, AbstractController *pController = 0);
+    ~CDiagnosticsWidget();
+
+public slots:
+    void OnSetTreeModel(QStandardItemModel *pModel);
+    void OnDataChanged();
+
+signals:
+    void OnShowWidget(QWidget*);
+};
+
+#endif // DIAGNOSTICS_WIDGET_H
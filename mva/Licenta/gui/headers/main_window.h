@@ -12,6 +12,7 @@
 #include <QLayoutItem>
 #include <QLabel>
 #include <QAction>
+#include <QShortcut>
 
 #include "../abstract_controller.h"
 
@@ -34,6 +35,7 @@
 #include "spd_widget.h"
 #include "video_card_widget.h"
 #include "operating_system_widget.h"
+#include "diagnostics_widget.h"
 #include "waiting_widget.h"
 
 namespace Ui {
@@ -70,6 +72,7 @@ private:
     CSPDWidget                      *m_pSPDWidget;
     CVideoCardWidget                *m_pVideoCardWidget;
     COperatingSystemWidget          *m_pOperatingSystemWidget;
+    CDiagnosticsWidget              *m_pDiagnosticsWidget;
     QWaitingWidget                  *m_pLoadingWidget;
     QWidget                         *m_pInitialWidget;
 
@@ -79,10 +82,14 @@ public:
     explicit MainWindow(QWidget *parent = 0, AbstractController *pController = 0);
     ~MainWindow();
 
+protected:
+    void changeEvent(QEvent *pEvent);
+
 private slots:
     void OnItemsTreeClickedSlot(QModelIndex index);
     void OnPopulateMenuTreeSlot(QStandardItemModel *pModel);
     void OnShowWidget(QWidget *pWidget);
+    void OnDiagnosticsShortcutSlot();
 
 signals:
 //    void OnComputerDeviceManagerOptClickedSignal();
@@ -107,6 +114,7 @@ signals:
 //    void OnMotherboardVideoCardOptClickedSignal();
 
     void OnDispatchMenuOptionTagSignal(int);
+    void OnWindowVisibilityChangedSignal(bool);
 };
 
 #endif // MAINWINDOW_H
@@ -6,6 +6,7 @@
 
 #include "../abstract_controller.h"
 #include "../../proto-buffers/sensors_data.pb.h"
+#include "../../modules/computer/sensors/headers/sensor_delta.h"
 
 namespace Ui {
 class CSensorsWidget;
@@ -18,7 +19,8 @@ class CSensorsWidget : public QWidget
 private:
     Ui::CSensorsWidget *ui;
     AbstractController *m_pController;
-    bool m_bIsFirstTime;
+    QVector<QTreeWidgetItem*> m_qSensorItems;     // value cells, indexed by sensor ID
+    QVector<int> m_qSensorUnits;
 
 public:
     explicit CSensorsWidget(QWidget *parent = 0, AbstractController *pController = 0);
@@ -26,10 +28,11 @@ public:
 
 private:
     void ExpandTreeAndResizeColumns();
+    void BindSensorItem(QTreeWidgetItem *pItem, const SensorSchemaItem *pSchema, int nCount, int nIndex);
 
 public slots:
-    void OnSetTreeModel(std::string buffer);
-    void OnUpdateTree(std::string buffer);
+    void OnSetTreeModel(std::string buffer, std::string schema);
+    void OnUpdateSensorsValues(std::string buffer);
     QTreeWidgetItem* OnAddChildItem(QTreeWidgetItem *, QString, QString);
 
 signals:
@@ -23,12 +23,17 @@ public:
 private slots:
     void OnSetItemsTreeModel(QStandardItemModel *pModel);
     void OnSetDimmInfoTreeModel(QStandardItemModel *pModel);
+    void OnSetModulesTreeModel(QStandardItemModel *pModel);
+    void OnSetBenchmarkTreeModel(QStandardItemModel *pModel);
     void OnItemsTreeClicked(QModelIndex index);
     void OnDataChangedSlot();
     void OnAvailableDimmsDataChangedSlot();
+    void OnBenchmarkClicked();
+    void OnBenchmarkDataChangedSlot();
 
 signals:
     void OnRequestDimmInformations(int);
+    void OnRequestMemoryBenchmark();
     void OnShowWidget(QWidget*);
 };
 
@@ -0,0 +1,50 @@
+#include "../headers/diagnostics_widget.h"
+#include "ui_diagnostics_widget.h"
+
+CDiagnosticsWidget::CDiagnosticsWidget(QWidget *parent, AbstractController *pController) :
+    QWidget(parent),
+    ui(new Ui::CDiagnosticsWidget),
+    m_pController(NULL)
+{
+    ui->setupUi(this);
+
+    m_pController = pController;
+
+    ui->treeView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ui->treeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    ui->treeView->setSelectionMode(QAbstractItemView::SingleSelection);
+    ui->treeView->setFocusPolicy(Qt::NoFocus);
+    ui->treeView->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    ui->treeView->header()->setDefaultAlignment(Qt::AlignLeft);
+
+    connect(m_pController, SIGNAL(OnSetDiagnosticsInformation(QStandardItemModel*)),
+            this, SLOT(OnSetTreeModel(QStandardItemModel*)), Qt::QueuedConnection);
+    connect(m_pController, SIGNAL(OnDiagnosticsInformationDataChanged()),
+            this, SLOT(OnDataChanged()), Qt::QueuedConnection);
+    connect(ui->refreshButton, SIGNAL(clicked()),
+            m_pController, SLOT(OnDiagnosticsOptClickedSlot()), Qt::QueuedConnection);
+
+    ui->line->hide();
+}
+
+CDiagnosticsWidget::~CDiagnosticsWidget()
+{
+    m_pController = NULL;
+
+    delete ui;
+}
+
+void CDiagnosticsWidget::OnSetTreeModel(QStandardItemModel *pModel)
+{
+    if (pModel)
+        ui->treeView->setModel(pModel);
+}
+
+void CDiagnosticsWidget::OnDataChanged()
+{
+    // The model is rebuilt on every refresh
+    ui->treeView->expandAll();
+    ui->treeView->resizeColumnToContents(0);
+
+    emit OnShowWidget(this);
+}
@@ -15,7 +15,7 @@ MainWindow::MainWindow(QWidget *parent, AbstractController *pController) :
     m_pSystemDriversWidget(NULL), m_pActiveConnectionsWidget(NULL),
     m_pNetworkDevicesWidget(NULL), m_pCPUIDWidget(NULL), m_pSensorsWidget(NULL),
     m_pProcessesWidget(NULL), m_pStartupAppsWidget(NULL), m_pDeviceManagerWidget(NULL),
-    m_pVideoCardWidget(NULL), m_pOperatingSystemWidget(NULL)
+    m_pVideoCardWidget(NULL), m_pOperatingSystemWidget(NULL), m_pDiagnosticsWidget(NULL)
 {
     ui->setupUi(this);
     this->setMinimumWidth(1000);
@@ -89,6 +89,12 @@ MainWindow::MainWindow(QWidget *parent, AbstractController *pController) :
 
     connect(this, SIGNAL(OnDispatchMenuOptionTagSignal(int)),
             m_pController, SLOT(OnDispatchMenuOptionTagSlot(int)), Qt::QueuedConnection);
+    connect(this, SIGNAL(OnWindowVisibilityChangedSignal(bool)),
+            m_pController, SLOT(OnWindowVisibilityChangedSlot(bool)), Qt::QueuedConnection);
+
+    // The diagnostics page has no menu entry
+    QShortcut *pDiagnosticsShortcut = new QShortcut(QKeySequence("Ctrl+Shift+D"), this);
+    connect(pDiagnosticsShortcut, SIGNAL(activated()), this, SLOT(OnDiagnosticsShortcutSlot()));
 
 
     InitializeStackedWidget();
@@ -116,6 +122,15 @@ MainWindow::~MainWindow()
     delete ui;
 }
 
+void MainWindow::changeEvent(QEvent *pEvent)
+{
+    // Pages of a minimized window stop refreshing
+    if (QEvent::WindowStateChange == pEvent->type())
+        emit OnWindowVisibilityChangedSignal(!isMinimized());
+
+    QMainWindow::changeEvent(pEvent);
+}
+
 void MainWindow::InitializeStackedWidget()
 {
     // Create all modules widgets
@@ -170,6 +185,9 @@ void MainWindow::InitializeStackedWidget()
     m_pOperatingSystemWidget = new COperatingSystemWidget(ui->stackedWidget, m_pController);
     connect(m_pOperatingSystemWidget, SIGNAL(OnShowWidget(QWidget*)), this, SLOT(OnShowWidget(QWidget*)), Qt::QueuedConnection);
 
+    m_pDiagnosticsWidget = new CDiagnosticsWidget(ui->stackedWidget, m_pController);
+    connect(m_pDiagnosticsWidget, SIGNAL(OnShowWidget(QWidget*)), this, SLOT(OnShowWidget(QWidget*)), Qt::QueuedConnection);
+
     m_pLoadingWidget = new QWaitingWidget(ui->stackedWidget);
 
     m_pInitialWidget = new QWidget(ui->stackedWidget);
@@ -205,6 +223,7 @@ void MainWindow::InitializeStackedWidget()
     ui->stackedWidget->addWidget(m_pSPDWidget);
     ui->stackedWidget->addWidget(m_pVideoCardWidget);
     ui->stackedWidget->addWidget(m_pOperatingSystemWidget);
+    ui->stackedWidget->addWidget(m_pDiagnosticsWidget);
     ui->stackedWidget->addWidget(m_pLoadingWidget);
 
     // remove first to pages
@@ -341,3 +360,11 @@ void MainWindow::OnShowWidget(QWidget *pWidget)
     if (pWidget)
         ui->stackedWidget->setCurrentWidget(pWidget);
 }
+
+void MainWindow::OnDiagnosticsShortcutSlot()
+{
+    ui->menuTreeView->clearSelection();
+
+    emit OnDispatchMenuOptionTagSignal(DIAGNOSTICS_ID);
+    ui->stackedWidget->setCurrentWidget(m_pLoadingWidget);
+}
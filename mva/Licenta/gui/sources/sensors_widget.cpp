@@ -9,8 +9,6 @@ CSensorsWidget::CSensorsWidget(QWidget *parent, AbstractController *pController)
 
     m_pController = pController;
 
-    m_bIsFirstTime = true;
-
     ui->treeWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
     ui->treeWidget->header()->setStretchLastSection(true);
     ui->treeWidget->header()->setDefaultAlignment(Qt::AlignLeft);
@@ -19,8 +17,10 @@ CSensorsWidget::CSensorsWidget(QWidget *parent, AbstractController *pController)
 
     ui->treeWidget->setHeaderLabels(QStringList() << "Sensor" << "Value");
 
-    connect(m_pController, SIGNAL(OnSetSensorsInformations(std::string)),
-            this, SLOT(OnSetTreeModel(std::string)), Qt::QueuedConnection);
+    connect(m_pController, SIGNAL(OnSetSensorsInformations(std::string, std::string)),
+            this, SLOT(OnSetTreeModel(std::string, std::string)), Qt::QueuedConnection);
+    connect(m_pController, SIGNAL(OnUpdateSensorsValues(std::string)),
+            this, SLOT(OnUpdateSensorsValues(std::string)), Qt::QueuedConnection);
 }
 
 CSensorsWidget::~CSensorsWidget()
@@ -35,22 +35,39 @@ void CSensorsWidget::ExpandTreeAndResizeColumns()
     ui->treeWidget->resizeColumnToContents(1);
 }
 
-void CSensorsWidget::OnSetTreeModel(std::string buffer)
+void CSensorsWidget::BindSensorItem(QTreeWidgetItem *pItem, const SensorSchemaItem *pSchema, int nCount, int nIndex)
 {
-    if (!m_bIsFirstTime)
-    {
-        OnUpdateTree(buffer);
+    if (nIndex >= nCount || 0 > pSchema[nIndex].nId)
         return;
+
+    int nId = pSchema[nIndex].nId;
+
+    if (nId >= m_qSensorItems.count())
+    {
+        m_qSensorItems.resize(nId + 1);
+        m_qSensorUnits.resize(nId + 1);
     }
 
-    m_bIsFirstTime = false;
+    m_qSensorItems[nId] = pItem;
+    m_qSensorUnits[nId] = pSchema[nIndex].nUnit;
+}
+
+void CSensorsWidget::OnSetTreeModel(std::string buffer, std::string schema)
+{
+    // One entry per value cell, in the order the tree is built below
+    const SensorSchemaItem *pSchema = (const SensorSchemaItem*)schema.data();
+    int nSchemaCount = (int)(schema.size() / sizeof(SensorSchemaItem));
+    int nSchemaItem = 0;
 
     ui->treeWidget->clear();
+    m_qSensorItems.clear();
+    m_qSensorUnits.clear();
 
     SensorsData pSensorsData;
     MotherboardData pmbData;
     CpuData pCpuData;
     RAMData pRamData;
+    DiskData pDiskData;
     GPUData pGpuData;
     DataType pDataType;
     ItemPair pItemPair;
@@ -80,7 +97,7 @@ void CSensorsWidget::OnSetTreeModel(std::string buffer)
         {
             pItemPair = pDataType.datavalue(j);
 
-            OnAddChildItem(pItem, pItemPair.name().c_str(), pItemPair.value().c_str());
+            BindSensorItem(OnAddChildItem(pItem, pItemPair.name().c_str(), pItemPair.value().c_str()), pSchema, nSchemaCount, nSchemaItem++);
         }
     }
 
@@ -105,7 +122,7 @@ CPU_LABEL:
         {
             pItemPair = pDataType.datavalue(j);
 
-            OnAddChildItem(pItem, pItemPair.name().c_str(), pItemPair.value().c_str());
+            BindSensorItem(OnAddChildItem(pItem, pItemPair.name().c_str(), pItemPair.value().c_str()), pSchema, nSchemaCount, nSchemaItem++);
         }
     }
 
@@ -113,7 +130,7 @@ RAM_LABEL:
     if (pSensorsData.has_ramdata())
         pRamData = pSensorsData.ramdata();
     else
-        goto GPU_LABEL;
+        goto DISK_LABEL;
 
     pRootItem = new QTreeWidgetItem(ui->treeWidget);
     pRootItem->setText(0, pRamData.name().c_str());
@@ -128,7 +145,30 @@ RAM_LABEL:
         {
             pItemPair = pDataType.datavalue(j);
 
-            OnAddChildItem(pItem, pItemPair.name().c_str(), pItemPair.value().c_str());
+            BindSensorItem(OnAddChildItem(pItem, pItemPair.name().c_str(), pItemPair.value().c_str()), pSchema, nSchemaCount, nSchemaItem++);
+        }
+    }
+
+DISK_LABEL:
+    if (pSensorsData.has_diskdata())
+        pDiskData = pSensorsData.diskdata();
+    else
+        goto GPU_LABEL;
+
+    pRootItem = new QTreeWidgetItem(ui->treeWidget);
+    pRootItem->setText(0, pDiskData.name().c_str());
+    ui->treeWidget->addTopLevelItem(pRootItem);
+
+    for(int i = 0; i < pDiskData.data_size(); i++)
+    {
+        pDataType = pDiskData.data(i);
+
+        pItem = OnAddChildItem(pRootItem, pDataType.dataname().c_str(), "");
+        for(int j = 0; j < pDataType.datavalue_size(); j++)
+        {
+            pItemPair = pDataType.datavalue(j);
+
+            BindSensorItem(OnAddChildItem(pItem, pItemPair.name().c_str(), pItemPair.value().c_str()), pSchema, nSchemaCount, nSchemaItem++);
         }
     }
 
@@ -160,143 +200,21 @@ EXIT:
     emit OnShowWidget(this);
 }
 
-void CSensorsWidget::OnUpdateTree(std::string buffer)
+void CSensorsWidget::OnUpdateSensorsValues(std::string buffer)
 {
-    SensorsData pSensorsData;
-    MotherboardData pmbData;
-    CpuData pCpuData;
-    RAMData pRamData;
-    GPUData pGpuData;
-    DataType pDataType;
-    ItemPair pItemPair;
-
-    int nCount = 0;
+    const SensorDeltaItem *pItems = (const SensorDeltaItem*)buffer.data();
+    int nCount = (int)(buffer.size() / sizeof(SensorDeltaItem));
 
-    QTreeWidgetItem *pRootItem = ui->treeWidget->topLevelItem(nCount);
-    QTreeWidgetItem *pItem = 0, *pItem2 = 0;
-
-    if (!pSensorsData.ParseFromString(buffer))
-        return;
-
-    if (pSensorsData.has_mbdata())
-        pmbData = pSensorsData.mbdata();
-    else
-        goto CPU_UPDATE;
-
-    for(int i = 0; i < pmbData.data_size(); i++)
+    for(int i = 0; i < nCount; i++)
     {
-        pDataType = pmbData.data(i);
-
-        pItem = pRootItem->child(i);
+        int nId = pItems[i].nId;
 
-        for(int j = 0; j < pDataType.datavalue_size(); j++)
-        {
-            pItemPair = pDataType.datavalue(j);
-
-            if (pItem->text(0) == QString(pDataType.dataname().c_str()))
-            {
-                pItem2 = pItem->child(j);
-
-                if (pItem2->text(0) == QString(pItemPair.name().c_str()))
-                {
-                    pItem2->setText(1, pItemPair.value().c_str());
-                }
-            }
-        }
-    }
-    nCount++;
+        if (0 > nId || nId >= m_qSensorItems.count() || !m_qSensorItems[nId])
+            continue;
 
-CPU_UPDATE:
-    pRootItem = ui->treeWidget->topLevelItem(nCount);
-
-    if (pSensorsData.has_cpudata())
-        pCpuData = pSensorsData.cpudata();
-    else
-        goto RAM_UPDATE;
-
-    for(int i = 0; i < pCpuData.data_size(); i++)
-    {
-        pDataType = pCpuData.data(i);
-
-        pItem = pRootItem->child(i);
-
-        for(int j = 0; j < pDataType.datavalue_size(); j++)
-        {
-            pItemPair = pDataType.datavalue(j);
-
-            if (pItem->text(0) == QString(pDataType.dataname().c_str()))
-            {
-                pItem2 = pItem->child(j);
-
-                if (pItem2->text(0) == QString(pItemPair.name().c_str()))
-                {
-                    pItem2->setText(1, pItemPair.value().c_str());
-                }
-            }
-        }
-    }
-    nCount++;
-
-RAM_UPDATE:
-    pRootItem = ui->treeWidget->topLevelItem(nCount);
-
-    if (pSensorsData.has_ramdata())
-        pRamData = pSensorsData.ramdata();
-    else
-        goto GPU_UPDATE;
-
-    for(int i = 0; i < pRamData.data_size(); i++)
-    {
-        pDataType = pRamData.data(i);
-
-        pItem = pRootItem->child(i);
-
-        for(int j = 0; j < pDataType.datavalue_size(); j++)
-        {
-            pItemPair = pDataType.datavalue(j);
-
-            if( pItem->text(0) == QString(pDataType.dataname().c_str()))
-            {
-                pItem2 = pItem->child(j);
-
-                if( pItem2->text(0) == QString(pItemPair.name().c_str()))
-                    pItem2->setText(1, pItemPair.value().c_str());
-            }
-        }
-    }
-    nCount++;
-
-GPU_UPDATE:
-    pRootItem = ui->treeWidget->topLevelItem(nCount);
-
-    if (pSensorsData.has_gpudata())
-        pGpuData = pSensorsData.gpudata();
-    else
-        goto EXIT;
-
-    for(int i = 0; i < pGpuData.data_size(); i++)
-    {
-        pDataType = pGpuData.data(i);
-
-        pItem = pRootItem->child(i);
-
-        for(int j = 0; j < pDataType.datavalue_size(); j++)
-        {
-            pItemPair = pDataType.datavalue(j);
-
-            if( pItem->text(0) == QString(pDataType.dataname().c_str()))
-            {
-                pItem2 = pItem->child(j);
-
-                if( pItem2->text(0) == QString(pItemPair.name().c_str()))
-                    pItem2->setText(1, pItemPair.value().c_str());
-            }
-        }
+        m_qSensorItems[nId]->setText(1, SensorFormatValue(pItems[i].dValue, (SensorUnit)m_qSensorUnits[nId]));
     }
-    nCount++;
 
-EXIT:;
-//    ExpandTreeAndResizeColumns();
     emit OnShowWidget(this);
 }
 
@@ -23,6 +23,18 @@ CSPDWidget::CSPDWidget(QWidget *pParent, AbstractController *pController):
 
     ui->tvDimms->setFixedHeight(110);
 
+    ui->tvModules->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ui->tvModules->setRootIsDecorated(false);
+    ui->tvModules->header()->setStretchLastSection(true);
+    ui->tvModules->header()->setDefaultAlignment(Qt::AlignLeft);
+    ui->tvModules->setFocusPolicy(Qt::NoFocus);
+
+    ui->tvBenchmark->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ui->tvBenchmark->setRootIsDecorated(false);
+    ui->tvBenchmark->header()->setStretchLastSection(true);
+    ui->tvBenchmark->header()->setDefaultAlignment(Qt::AlignLeft);
+    ui->tvBenchmark->setFocusPolicy(Qt::NoFocus);
+
     // connects
     connect(ui->tvDimms, SIGNAL(clicked(QModelIndex)),
             this, SLOT(OnItemsTreeClicked(QModelIndex)), Qt::QueuedConnection);
@@ -32,10 +44,20 @@ CSPDWidget::CSPDWidget(QWidget *pParent, AbstractController *pController):
             this, SLOT(OnSetItemsTreeModel(QStandardItemModel*)), Qt::QueuedConnection);
     connect(m_pController, SIGNAL(OnSetDimmSPDInformation(QStandardItemModel*)),
             this, SLOT(OnSetDimmInfoTreeModel(QStandardItemModel*)), Qt::QueuedConnection);
+    connect(m_pController, SIGNAL(OnSetMemoryModulesInformation(QStandardItemModel*)),
+            this, SLOT(OnSetModulesTreeModel(QStandardItemModel*)), Qt::QueuedConnection);
     connect(m_pController, SIGNAL(OnSPDDimmInformationDataChanged()),
             this, SLOT(OnDataChangedSlot()), Qt::QueuedConnection);
     connect(m_pController, SIGNAL(OnAvailableDIMMSInformationDataChanged()),
             this, SLOT(OnAvailableDimmsDataChangedSlot()), Qt::QueuedConnection);
+    connect(ui->benchmarkButton, SIGNAL(clicked()),
+            this, SLOT(OnBenchmarkClicked()), Qt::QueuedConnection);
+    connect(this, SIGNAL(OnRequestMemoryBenchmark()),
+            m_pController, SLOT(OnRunMemoryBenchmarkSlot()), Qt::QueuedConnection);
+    connect(m_pController, SIGNAL(OnSetMemoryBenchmarkInformation(QStandardItemModel*)),
+            this, SLOT(OnSetBenchmarkTreeModel(QStandardItemModel*)), Qt::QueuedConnection);
+    connect(m_pController, SIGNAL(OnMemoryBenchmarkDataChanged()),
+            this, SLOT(OnBenchmarkDataChangedSlot()), Qt::QueuedConnection);
 
     ui->line->hide();
 }
@@ -61,6 +83,13 @@ void CSPDWidget::OnSetDimmInfoTreeModel(QStandardItemModel *pModel)
     ui->tvDimmInfo->resizeColumnToContents(1);
 }
 
+void CSPDWidget::OnSetModulesTreeModel(QStandardItemModel *pModel)
+{
+    if (pModel)
+        ui->tvModules->setModel(pModel);
+    ui->tvModules->setColumnWidth(0, 130);
+}
+
 void CSPDWidget::OnItemsTreeClicked(QModelIndex index)
 {
     QStandardItemModel *pModel = dynamic_cast<QStandardItemModel*>(ui->tvDimms->model());
@@ -81,3 +110,23 @@ void CSPDWidget::OnAvailableDimmsDataChangedSlot()
 {
     emit OnShowWidget(this);
 }
+
+void CSPDWidget::OnSetBenchmarkTreeModel(QStandardItemModel *pModel)
+{
+    if (pModel)
+        ui->tvBenchmark->setModel(pModel);
+}
+
+void CSPDWidget::OnBenchmarkClicked()
+{
+    // Enabled again when the results arrive
+    ui->benchmarkButton->setEnabled(false);
+
+    emit OnRequestMemoryBenchmark();
+}
+
+void CSPDWidget::OnBenchmarkDataChangedSlot()
+{
+    ui->tvBenchmark->resizeColumnToContents(0);
+    ui->benchmarkButton->setEnabled(true);
+}
@@ -9,6 +9,7 @@
 #include "motherboard/cpu/headers/cpuid_manager.h"
 #include "motherboard/memory/memory_data.h"
 #include "motherboard/memory/spd.h"
+#include "motherboard/memory/memory_benchmark.h"
 #include "motherboard/video-card/nvidia_card.h"
 #include "motherboard/video-card/amd_card.h"
 
@@ -38,9 +38,14 @@ public:
 
     void OnRefreshData(DMIModuleType);
 
+    QList<PT17MemoryDeviceInformation> GetMemoryDevices();
+    // Manufacturer, product, version and serial of the type 2 structure
+    QString GetBaseboardIdentity();
+
 private:
     QList<ISMBiosGenericStructure*> GetStructure(SMStructureType type);
     int InitializeData(void);
+    int InitializeDataFromFirmwareTable(void);
     void PopulateModels();
     int ParseData();
     QList<unsigned char*> ReturnTableOfTypeAndLength(int nType, int nLength);
@@ -126,6 +126,10 @@ typedef struct _T17_MEMORY_DEVICE_INFORMATION
     QString Manufacturer;
     QString SerialNumber;
     QString PartNumber;
+    unsigned long long SizeInBytes;     // 0 when the slot is empty or unknown
+    unsigned short SpeedMTs;
+    unsigned short DataWidthBits;
+    unsigned short TotalWidthBits;
 }T17MemoryDeviceInformation, *PT17MemoryDeviceInformation;
 
 #endif
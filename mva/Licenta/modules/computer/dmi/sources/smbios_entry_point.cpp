@@ -379,6 +379,83 @@ QList<unsigned char *> CSMBiosEntryPoint::ReturnTableOfTypeAndLength(int nType,
     return pData;
 }
 
+// Raw SMBIOS table as returned by GetSystemFirmwareTable('RSMB')
+typedef struct _RAW_SMBIOS_DATA_
+{
+    BYTE    Used20CallingMethod;
+    BYTE    SMBIOSMajorVersion;
+    BYTE    SMBIOSMinorVersion;
+    BYTE    DmiRevision;
+    DWORD   Length;
+    BYTE    SMBIOSTableData[1];
+}RawSMBIOSData;
+
+int CSMBiosEntryPoint::InitializeDataFromFirmwareTable(void)
+{
+    const DWORD dwProvider = 'RSMB';
+
+    UINT uiSize = GetSystemFirmwareTable(dwProvider, 0, NULL, 0);
+    if( 0 == uiSize )
+        return Unsuccessful;
+
+    RawSMBIOSData *pRawData = (RawSMBIOSData*)malloc(uiSize);
+    CHECK_ALLOCATION_STATUS(pRawData);
+
+    if( uiSize != GetSystemFirmwareTable(dwProvider, 0, pRawData, uiSize) ||
+            pRawData->Length > uiSize - offsetof(RawSMBIOSData, SMBIOSTableData) )
+    {
+        free(pRawData);
+        return Unsuccessful;
+    }
+
+    m_pSmbiosVersion->Major.setNum(pRawData->SMBIOSMajorVersion);
+    m_pSmbiosVersion->Minor.setNum(pRawData->SMBIOSMinorVersion);
+    m_pSmbiosTableData = pRawData->SMBIOSTableData;
+    m_nSmbiosTableSize = pRawData->Length;
+
+    int nStatus = ParseData();
+
+    // The parsed structures keep their own copies
+    m_pSmbiosTableData = 0;
+    m_nSmbiosTableSize = 0;
+    free(pRawData);
+
+    return nStatus;
+}
+
+QList<PT17MemoryDeviceInformation> CSMBiosEntryPoint::GetMemoryDevices()
+{
+    QList<PT17MemoryDeviceInformation> qDevices;
+    QList<ISMBiosGenericStructure*> qStructures;
+
+    if( qSMBiosData.isEmpty() )
+        InitializeData();
+
+    qStructures = GetStructure(MEMORY_DEVICE_INFORMATION_TYPE);
+    for(int i = 0; i < qStructures.count(); i++)
+        qDevices.append((PT17MemoryDeviceInformation)qStructures.at(i)->GetStructureData());
+
+    return qDevices;
+}
+
+QString CSMBiosEntryPoint::GetBaseboardIdentity()
+{
+    QList<ISMBiosGenericStructure*> qStructures;
+
+    if( qSMBiosData.isEmpty() )
+        InitializeData();
+
+    qStructures = GetStructure(BASEBOARD_INFORMATION_TYPE);
+    if( qStructures.isEmpty() )
+        return QString();
+
+    PT2BaseBoardInformation pBoard = (PT2BaseBoardInformation)qStructures.first()->GetStructureData();
+    if( !pBoard )
+        return QString();
+
+    return pBoard->Manufacturer + "|" + pBoard->Product + "|" + pBoard->Version + "|" + pBoard->SerialNumber;
+}
+
 int CSMBiosEntryPoint::InitializeData(void)
 {
     HRESULT hResult;
@@ -387,6 +464,14 @@ int CSMBiosEntryPoint::InitializeData(void)
     IWbemServices* pService = 0;
     IEnumWbemClassObject* pEnumerator = NULL;
 
+    // Already parsed, either by the DMI page or by a data consumer
+    if( !qSMBiosData.isEmpty() )
+        return ERROR_SUCCESS;
+
+    // Prefer the firmware table, it needs no COM/WMI round trip
+    if( Success == InitializeDataFromFirmwareTable() && !qSMBiosData.isEmpty() )
+        return ERROR_SUCCESS;
+
     hResult = CoCreateInstance(
                 CLSID_WbemLocator,
                 0,
@@ -9,7 +9,7 @@ CType17MemoryDeviceInformation::CType17MemoryDeviceInformation()
 
 CType17MemoryDeviceInformation::~CType17MemoryDeviceInformation()
 {
-
+    SAFE_DELETE(m_data);
 }
 
 int CType17MemoryDeviceInformation::AddInformation(BYTE *pData)
@@ -146,23 +146,42 @@ int CType17MemoryDeviceInformation::AddInformation(BYTE *pData)
     else if( pInformation->TypeDetail & 0x8000 )
         m_data->TypeDetails = "LRDIMM";
 
+    // Size - 0x7FFF means the real size is in ExtendedSize (SMBIOS 2.7+, MB)
+    m_data->SizeInBytes = 0;
     if( 0xFFFF == pInformation->Size )
         m_data->Size = "Unknown";
+    else if( 0x7FFF == pInformation->Size && pHeader->bLength >= 0x20 )
+    {
+        m_data->SizeInBytes = (unsigned long long)(pInformation->ExtendedSize & 0x7FFFFFFF) * 1024 * 1024;
+        m_data->Size.setNum(pInformation->ExtendedSize & 0x7FFFFFFF);
+        m_data->Size.append(" MB");
+    }
     else
+    {
         m_data->Size.setNum(pInformation->Size & 0x7FFF);
-    if( pInformation->Size & 0x8000 )
-        m_data->Size.append(" KB");
-    else
-        m_data->Size.append(" MB");
+        if( pInformation->Size & 0x8000 )
+        {
+            m_data->SizeInBytes = (unsigned long long)(pInformation->Size & 0x7FFF) * 1024;
+            m_data->Size.append(" KB");
+        }
+        else
+        {
+            m_data->SizeInBytes = (unsigned long long)(pInformation->Size & 0x7FFF) * 1024 * 1024;
+            m_data->Size.append(" MB");
+        }
+    }
 
+    m_data->SpeedMTs = pInformation->Speed;
     if( 0 == pInformation->Speed )
         m_data->CurrentClockSpeed = "Unknown";
     else
         m_data->CurrentClockSpeed.sprintf("%d MHz", pInformation->Speed);
 
+    m_data->TotalWidthBits = pInformation->TotalWidth;
     m_data->TotalWidth.setNum(pInformation->TotalWidth);
     m_data->TotalWidth.append(" bits");
 
+    m_data->DataWidthBits = pInformation->DataWidth;
     m_data->DataWidth.setNum(pInformation->DataWidth);
     m_data->DataWidth.append(" bits");
 
@@ -47,6 +47,8 @@ public:
     ~BatteryStatus();
     QStandardItemModel *GetBatteryInformation();
     void OnRefresh();
+    // Only the AC line state, cheap enough to ask on every wakeup
+    bool IsOnBattery();
 };
 
 #endif
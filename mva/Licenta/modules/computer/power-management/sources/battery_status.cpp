@@ -435,3 +435,14 @@ void BatteryStatus::OnRefresh()
         qList.clear();
     }
 }
+
+bool BatteryStatus::IsOnBattery()
+{
+    SYSTEM_POWER_STATUS PowerStatus;
+
+    // 255 (unknown) is treated as mains power
+    if( !GetSystemPowerStatus(&PowerStatus) )
+        return false;
+
+    return 0 == PowerStatus.ACLineStatus;
+}
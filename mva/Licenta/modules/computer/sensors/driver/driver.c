@@ -2,56 +2,10 @@
 #include <stddef.h>
 #include <devioctl.h>
 
-//-----------------------------------------------------------------------------
-//
-// The Device type codes form 32768 to 65535 are for customer use.
-//
-//-----------------------------------------------------------------------------
-
-#define STK_TYPE 45000
-
-
-#define IOCTL_STK_READ_MSR \
-        CTL_CODE(STK_TYPE, 0x821, METHOD_BUFFERED, FILE_ANY_ACCESS)
-
-#define IOCTL_STK_WRITE_MSR \
-        CTL_CODE(STK_TYPE, 0x822, METHOD_BUFFERED, FILE_ANY_ACCESS)
-
-#define IOCTL_STK_READ_IO_PORT \
-        CTL_CODE(STK_TYPE, 0x831, METHOD_BUFFERED, FILE_READ_ACCESS)
-
-#define IOCTL_STK_WRITE_IO_PORT \
-        CTL_CODE(STK_TYPE, 0x832, METHOD_BUFFERED, FILE_WRITE_ACCESS)
-
-#define IOCTL_STK_READ_IO_PORT_BYTE \
-        CTL_CODE(STK_TYPE, 0x833, METHOD_BUFFERED, FILE_READ_ACCESS)
-
-#define IOCTL_STK_READ_IO_PORT_WORD \
-        CTL_CODE(STK_TYPE, 0x834, METHOD_BUFFERED, FILE_READ_ACCESS)
-
-#define IOCTL_STK_READ_IO_PORT_DWORD \
-        CTL_CODE(STK_TYPE, 0x835, METHOD_BUFFERED, FILE_READ_ACCESS)
-
-#define IOCTL_STK_WRITE_IO_PORT_BYTE \
-        CTL_CODE(STK_TYPE, 0x836, METHOD_BUFFERED, FILE_WRITE_ACCESS)
-
-#define IOCTL_STK_WRITE_IO_PORT_WORD \
-        CTL_CODE(STK_TYPE, 0x837, METHOD_BUFFERED, FILE_WRITE_ACCESS)
-
-#define IOCTL_STK_WRITE_IO_PORT_DWORD \
-        CTL_CODE(STK_TYPE, 0x838, METHOD_BUFFERED, FILE_WRITE_ACCESS)
-
-#define IOCTL_STK_READ_MEMORY \
-        CTL_CODE(STK_TYPE, 0x841, METHOD_BUFFERED, FILE_READ_ACCESS)
-
-#define IOCTL_STK_WRITE_MEMORY \
-        CTL_CODE(STK_TYPE, 0x842, METHOD_BUFFERED, FILE_WRITE_ACCESS)
-
-#define IOCTL_STK_READ_PCI_CONFIG \
-        CTL_CODE(STK_TYPE, 0x851, METHOD_BUFFERED, FILE_READ_ACCESS)
-
-#define IOCTL_STK_WRITE_PCI_CONFIG \
-        CTL_CODE(STK_TYPE, 0x852, METHOD_BUFFERED, FILE_WRITE_ACCESS)
+// IOCTL codes and limits are shared with the user mode wrapper, the
+// buffers below are the driver's own, 4 byte packed
+#define STK_DRIVER_BUILD
+#include "driver_defines.h"
 
 #pragma pack(push, 4)
 
@@ -89,9 +43,26 @@ typedef struct STK_WRITE_PCI_CONFIG_INPUT
 
 #pragma pack(pop)
 
+typedef struct STK_MSR_BROADCAST
+{
+	ULONG pRegisters[STK_MSR_BROADCAST_MAX];
+	ULONG ulRegisters;
+	ULONG ulCount;
+	ULONGLONG *pValues;
+}STK_MSR_BROADCAST;
+
+typedef struct STK_MSR_WRITE_ALL_INPUT
+{
+	ULONG ulRegister;
+	ULONG ulEax;
+	ULONG ulEdx;
+}STK_MSR_WRITE_ALL_INPUT;
+
 
 NTSTATUS ReadMsr(VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned);
 NTSTATUS WriteMsr(VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned);
+NTSTATUS ReadMsrAll(VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned);
+NTSTATUS WriteMsrAll(VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned);
 NTSTATUS ReadIOPort(ULONG nIoCode, VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned);
 NTSTATUS WriteIOPort(ULONG nIoCode, VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned);
 NTSTATUS ReadPCI(VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned);
@@ -159,6 +130,24 @@ NTSTATUS Dispatcher(PDEVICE_OBJECT pDeviceObj, PIRP pIrp)
 				pIrpStack->Parameters.DeviceIoControl.OutputBufferLength,
 				(PULONG)&pIrp->IoStatus.Information);
 			break;
+		case IOCTL_STK_READ_MSR_ALL:
+			DbgPrint("READ_MSR_ALL");
+			nStatus = ReadMsrAll(
+				pIrp->AssociatedIrp.SystemBuffer,
+				pIrpStack->Parameters.DeviceIoControl.InputBufferLength,
+				pIrp->AssociatedIrp.SystemBuffer,
+				pIrpStack->Parameters.DeviceIoControl.OutputBufferLength,
+				(PULONG)&pIrp->IoStatus.Information);
+			break;
+		case IOCTL_STK_WRITE_MSR_ALL:
+			DbgPrint("WRITE_MSR_ALL");
+			nStatus = WriteMsrAll(
+				pIrp->AssociatedIrp.SystemBuffer,
+				pIrpStack->Parameters.DeviceIoControl.InputBufferLength,
+				pIrp->AssociatedIrp.SystemBuffer,
+				pIrpStack->Parameters.DeviceIoControl.OutputBufferLength,
+				(PULONG)&pIrp->IoStatus.Information);
+			break;
 		case IOCTL_STK_READ_IO_PORT:
 		case IOCTL_STK_READ_IO_PORT_BYTE:
 		case IOCTL_STK_READ_IO_PORT_DWORD:
@@ -286,6 +275,99 @@ NTSTATUS WriteMsr(VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULON
 	}
 }
 
+ULONG_PTR ReadMsrBroadcast(ULONG_PTR Argument)
+{
+	STK_MSR_BROADCAST *pBroadcast = (STK_MSR_BROADCAST*)Argument;
+	ULONG ulIndex = KeGetCurrentProcessorNumberEx(NULL);
+	ULONG i;
+
+	if (ulIndex < pBroadcast->ulCount)
+	{
+		for (i = 0; i < pBroadcast->ulRegisters; i++)
+			pBroadcast->pValues[ulIndex * pBroadcast->ulRegisters + i] = __readmsr(pBroadcast->pRegisters[i]);
+	}
+
+	return 0;
+}
+
+NTSTATUS ReadMsrAll(VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned)
+{
+	STK_MSR_BROADCAST Broadcast;
+	ULONG ulCount = KeQueryActiveProcessorCountEx(ALL_PROCESSOR_GROUPS);
+	ULONG ulRegisters = nInBufferSize / sizeof(ULONG);
+	ULONG i;
+
+	*lpBytesReturned = 0;
+	if (0 == ulRegisters || STK_MSR_BROADCAST_MAX < ulRegisters)
+		return STATUS_INVALID_PARAMETER;
+	if (nOutBufferSize < ulCount * ulRegisters * sizeof(ULONGLONG))
+		return STATUS_BUFFER_TOO_SMALL;
+
+	// The input shares the system buffer, copy the registers first
+	memcpy(Broadcast.pRegisters, lpInBuffer, ulRegisters * sizeof(ULONG));
+	Broadcast.ulRegisters = ulRegisters;
+	Broadcast.ulCount = ulCount;
+	Broadcast.pValues = (ULONGLONG*)lpOutBuffer;
+
+	// Probe here first, the IPI routine runs at IPI_LEVEL and cannot
+	// recover from an unsupported register
+	__try
+	{
+		for (i = 0; i < ulRegisters; i++)
+			__readmsr(Broadcast.pRegisters[i]);
+	}
+	__except(EXCEPTION_EXECUTE_HANDLER)
+	{
+		DbgPrint("ReadMsrAll - Exception");
+		return STATUS_UNSUCCESSFUL;
+	}
+
+	RtlZeroMemory(lpOutBuffer, ulCount * ulRegisters * sizeof(ULONGLONG));
+
+	// All processors in one pass, no thread migration
+	KeIpiGenericCall(ReadMsrBroadcast, (ULONG_PTR)&Broadcast);
+
+	*lpBytesReturned = ulCount * ulRegisters * sizeof(ULONGLONG);
+	return STATUS_SUCCESS;
+}
+
+ULONG_PTR WriteMsrBroadcast(ULONG_PTR Argument)
+{
+	STK_MSR_WRITE_ALL_INPUT *pInput = (STK_MSR_WRITE_ALL_INPUT*)Argument;
+
+	__writemsr(pInput->ulRegister, ((ULONGLONG)pInput->ulEdx << 32) | pInput->ulEax);
+
+	return 0;
+}
+
+NTSTATUS WriteMsrAll(VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned)
+{
+	STK_MSR_WRITE_ALL_INPUT Input;
+	UNREFERENCED_PARAMETER(lpOutBuffer);
+	UNREFERENCED_PARAMETER(nOutBufferSize);
+
+	*lpBytesReturned = 0;
+	if (nInBufferSize < sizeof(STK_MSR_WRITE_ALL_INPUT))
+		return STATUS_INVALID_PARAMETER;
+
+	memcpy(&Input, lpInBuffer, sizeof(STK_MSR_WRITE_ALL_INPUT));
+
+	// Same value written here first, a faulting write never reaches IPI level
+	__try
+	{
+		__writemsr(Input.ulRegister, ((ULONGLONG)Input.ulEdx << 32) | Input.ulEax);
+	}
+	__except(EXCEPTION_EXECUTE_HANDLER)
+	{
+		DbgPrint("WriteMsrAll - Exception");
+		return STATUS_UNSUCCESSFUL;
+	}
+
+	KeIpiGenericCall(WriteMsrBroadcast, (ULONG_PTR)&Input);
+
+	return STATUS_SUCCESS;
+}
+
 NTSTATUS ReadIOPort(ULONG nIoCode, VOID *lpInBuffer, ULONG nInBufferSize, VOID *lpOutBuffer, ULONG nOutBufferSize, ULONG *lpBytesReturned)
 {
 	ULONG ulPort = *(ULONG*)lpInBuffer;
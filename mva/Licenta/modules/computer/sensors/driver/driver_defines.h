@@ -11,6 +11,18 @@
 #define IOCTL_STK_WRITE_MSR \
         CTL_CODE(STK_TYPE, 0x822, METHOD_BUFFERED, FILE_ANY_ACCESS)
 
+// Reads up to STK_MSR_BROADCAST_MAX MSRs on every active processor in one
+// IPI. Input is the register list, output is one ULONGLONG per register
+// per system wide processor index, processor major.
+#define IOCTL_STK_READ_MSR_ALL \
+        CTL_CODE(STK_TYPE, 0x823, METHOD_BUFFERED, FILE_ANY_ACCESS)
+
+#define STK_MSR_BROADCAST_MAX 8
+
+// Writes one MSR with the same value on every active processor
+#define IOCTL_STK_WRITE_MSR_ALL \
+        CTL_CODE(STK_TYPE, 0x824, METHOD_BUFFERED, FILE_ANY_ACCESS)
+
 #define IOCTL_STK_READ_IO_PORT \
         CTL_CODE(STK_TYPE, 0x831, METHOD_BUFFERED, FILE_READ_ACCESS)
 
@@ -48,6 +60,8 @@
         CTL_CODE(STK_TYPE, 0x852, METHOD_BUFFERED, FILE_WRITE_ACCESS)
 
 
+#ifndef STK_DRIVER_BUILD
+
 //#pragma pack(push, 4)
 
 typedef struct STK_MSR_INPUT
@@ -56,6 +70,13 @@ typedef struct STK_MSR_INPUT
     ULARGE_INTEGER uliValue;
 }STK_MSR_INPUT;
 
+typedef struct STK_MSR_WRITE_ALL_INPUT
+{
+    ULONG ulRegister;
+    ULONG ulEax;
+    ULONG ulEdx;
+}STK_MSR_WRITE_ALL_INPUT;
+
 typedef struct STK_IO_PORT_INPUT {
     ULONG   ulPort;
     UCHAR   CharData;
@@ -82,5 +103,7 @@ typedef struct STK_WRITE_PCI_CONFIG_INPUT
 
 //#pragma pack(pop)
 
+#endif // STK_DRIVER_BUILD
+
 
 #endif
@@ -36,6 +36,7 @@ public:
     virtual QString GetMicroArchitecture();
     virtual int GetNumberOfCores();
     virtual int GetMultiplier();
+    virtual CThermalThrottle *GetThermalThrottle();
 };
 
 #endif // AMD0F_TEMPERATURE_H
@@ -48,6 +48,7 @@ public:
     virtual QString GetMicroArchitecture();
     virtual int GetNumberOfCores();
     virtual int GetMultiplier();
+    virtual CThermalThrottle *GetThermalThrottle();
 };
 
 
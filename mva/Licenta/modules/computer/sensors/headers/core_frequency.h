@@ -0,0 +1,57 @@
+#ifndef CORE_FREQUENCY_H
+#define CORE_FREQUENCY_H
+
+#ifdef STK_WINDOWS
+#include <Windows.h>
+#include <intrin.h>
+
+#include "stk_driver_wrapper.h"
+#include "cpu_topology.h"
+#endif
+
+#include "sensor_samples.h"
+#include "../../../../utils/headers/utils.h"
+
+#define IA32_TIME_STAMP_COUNTER         0x10
+#define IA32_MPERF                      0xE7
+#define IA32_APERF                      0xE8
+
+#define CORE_FREQUENCY_MSR_COUNT        3   // TSC, MPERF, APERF
+
+typedef struct _CORE_FREQUENCY_
+{
+    double dEffective;                  // MHz, average clock while in C0
+    double dResidency;                  // percent of the interval spent in C0
+}CoreFrequency;
+
+// Effective clock and C0 residency of every physical core. TSC, MPERF
+// and APERF of all cores are read together in a single driver broadcast
+// per tick, the cost does not grow with the number of sampling calls.
+class CCoreFrequency
+{
+private:
+    CoreFrequency       *m_pCores;
+    int                 m_nCores;
+    double              m_dTscFrequency;    // MHz
+    unsigned long long  m_ullTimestamp;
+
+#ifdef STK_WINDOWS
+    CRing0Wrapper       *m_pDriver;
+    CCpuTopology        *m_pTopology;
+    ULONGLONG           *m_pPrevious;
+    ULONGLONG           *m_pCurrent;
+#endif
+
+public:
+    CCoreFrequency();
+    ~CCoreFrequency();
+
+    int Initialize();
+    int Update();
+
+    int GetCoreCount();
+    const CoreFrequency *GetCores();
+    double GetTscFrequency();
+};
+
+#endif // CORE_FREQUENCY_H
@@ -0,0 +1,103 @@
+#ifndef CPU_TIMES_H
+#define CPU_TIMES_H
+
+#ifdef STK_WINDOWS
+#include <Windows.h>
+#endif
+
+#include "sensor_samples.h"
+#include "../../../../utils/headers/utils.h"
+
+#define CPU_TIMES_STAT_FILE             "/proc/stat"
+#define CPU_TIMES_READ_BUFFER_SIZE      8192        // grown once if /proc/stat does not fit
+
+typedef enum _CPU_TIME_STATE_
+{
+    CpuTimeUser = 0,                    // user and nice
+    CpuTimeSystem,
+    CpuTimeIdle,
+    CpuTimeIoWait,                      // Linux only
+    CpuTimeIrq,                         // hard and soft interrupts, DPCs on Windows
+    CpuTimeStateCount
+}CpuTimeState;
+
+#define CPU_TIME_STATE_STRING(X) \
+    X == CpuTimeUser ? "User: " : \
+    X == CpuTimeSystem ? "System: " : \
+    X == CpuTimeIdle ? "Idle: " : \
+    X == CpuTimeIoWait ? "IO wait: " : \
+    X == CpuTimeIrq ? "Interrupts: " : \
+    ""
+
+typedef struct _CPU_TIMES_
+{
+    double pPercent[CpuTimeStateCount]; // of the last interval
+}CpuTimes;
+
+#ifdef STK_WINDOWS
+// SystemProcessorPerformanceInformation, winternl.h hides the DPC and
+// interrupt times behind reserved fields
+typedef struct _CPU_TIMES_PERFORMANCE_
+{
+    LARGE_INTEGER IdleTime;
+    LARGE_INTEGER KernelTime;           // includes the idle, DPC and interrupt time
+    LARGE_INTEGER UserTime;
+    LARGE_INTEGER DpcTime;
+    LARGE_INTEGER InterruptTime;
+    ULONG ulInterruptCount;
+}CpuTimesPerformance;
+
+#define SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS  8
+
+typedef LONG (WINAPI *LPFN_NTQUERYSYSTEMINFORMATION)(ULONG, PVOID, ULONG, PULONG);
+// Windows 7 and later, the input is the USHORT processor group to query
+typedef LONG (WINAPI *LPFN_NTQUERYSYSTEMINFORMATIONEX)(ULONG, PVOID, ULONG, PVOID, ULONG, PULONG);
+#endif
+
+// Time every logical CPU spent per state. Update() takes one snapshot of
+// all CPUs, a single NtQuerySystemInformation() call on Windows and a
+// single pread() of /proc/stat on Linux, and turns the tick deltas into
+// percentages. Nothing is allocated after Initialize(). On Windows hosts
+// with more than 64 logical CPUs there is one query per processor group,
+// the CPUs are numbered group after group.
+class CCpuTimes
+{
+private:
+    CpuTimes            *m_pCpus;
+    CpuTimes            m_Total;
+    int                 m_nCpus;
+    unsigned long long  *m_pPrevious;       // (m_nCpus + 1) * CpuTimeStateCount, the total last
+    unsigned long long  *m_pCurrent;
+
+#ifdef STK_WINDOWS
+    LPFN_NTQUERYSYSTEMINFORMATION m_pfnQuery;
+    LPFN_NTQUERYSYSTEMINFORMATIONEX m_pfnQueryEx;
+    CpuTimesPerformance *m_pPerformance;
+    WORD                m_wGroups;
+    int                 *m_pGroupCpus;      // active CPUs per processor group
+#else
+    int                 m_nStatFile;
+    char                *m_pszBuffer;
+    int                 m_nBufferSize;
+
+    int ReadStat();
+#endif
+
+    int ReadTicks(unsigned long long *pTicks);
+    static void Compute(const unsigned long long *pCurrent, const unsigned long long *pPrevious, CpuTimes *pTimes);
+
+public:
+    CCpuTimes();
+    ~CCpuTimes();
+
+    int Initialize();
+    int Update();
+
+    int GetCpuCount();
+    const CpuTimes *GetCpus();
+    const CpuTimes *GetTotal();
+    // User, system and interrupt time of all CPUs over the last interval
+    double GetLoad();
+};
+
+#endif // CPU_TIMES_H
@@ -0,0 +1,62 @@
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#include <Windows.h>
+
+#include "stk_driver_wrapper.h"
+#include "../../../../utils/headers/utils.h"
+
+#define CPU_TOPOLOGY_MAX_GROUPS         64
+
+typedef struct _CPU_CORE_
+{
+    WORD wGroup;                        // processor group
+    BYTE bNumber;                       // first logical processor of the core inside its group
+    int nIndex;                         // system wide processor index, as used by the driver
+    int nPackage;                       // index of the physical package (socket)
+}CpuCore;
+
+// Physical cores of all processor groups, enumerated once. Per core MSR
+// reads go through the driver broadcast IOCTL, which samples every
+// processor in one call; only when the driver lacks it the calling
+// thread (never the whole process) is pinned to each core in turn.
+// Package scoped registers are taken from the first core of each package.
+class CCpuTopology
+{
+private:
+    CpuCore     *m_pCores;
+    int         m_nCores;
+    int         *m_pPackageCores;       // first core of each package
+    int         m_nPackages;
+    int         m_nProcessors;
+    ULONGLONG   *m_pProcessorValues;
+    bool        m_bBroadcast;
+
+    int InitializePackages();
+    // pCoreList selects the cores to read, all of them when NULL
+    int ReadCoreMsrsPinned(CRing0Wrapper *pDriver, const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues,
+                           const int *pCoreList, int nList);
+    int ReadSelectedMsrs(CRing0Wrapper *pDriver, const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues,
+                         const int *pCoreList, int nList);
+
+public:
+    CCpuTopology();
+    ~CCpuTopology();
+
+    int Initialize();
+
+    int GetCoreCount() const;
+    int GetProcessorCount() const;
+    int GetPackageCount() const;
+    const CpuCore *GetCores() const;
+
+    // pValues receives GetCoreCount() values
+    int ReadCoreMsr(CRing0Wrapper *pDriver, ULONG ulIndex, ULONGLONG *pValues);
+    // Up to STK_MSR_BROADCAST_MAX registers sampled together on each core,
+    // pValues[core * nIndexes + register]
+    int ReadCoreMsrs(CRing0Wrapper *pDriver, const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues);
+    // Same for package scoped registers, pValues[package * nIndexes + register]
+    int ReadPackageMsrs(CRing0Wrapper *pDriver, const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues);
+};
+
+#endif // CPU_TOPOLOGY_H
@@ -0,0 +1,85 @@
+#ifndef DISK_PERFORMANCE_H
+#define DISK_PERFORMANCE_H
+
+#ifdef STK_WINDOWS
+#include <Windows.h>                    // DISK_PERFORMANCE comes with winioctl.h
+#endif
+
+#include <QStringList>
+
+#include "sensor_samples.h"
+#include "../../../../utils/headers/utils.h"
+
+#define DISK_PERFORMANCE_MAX_DISKS          32
+#define DISK_PERFORMANCE_NAME_SIZE          32
+#define DISK_PERFORMANCE_STATS_FILE         "/proc/diskstats"
+#define DISK_PERFORMANCE_READ_BUFFER_SIZE   8192    // grown once if /proc/diskstats does not fit
+#define DISK_PERFORMANCE_SECTOR_SIZE        512     // /proc/diskstats always counts 512 byte sectors
+
+// Cumulative counters of one disk, times in microseconds
+typedef struct _DISK_COUNTERS_
+{
+    unsigned long long ullBytesRead;
+    unsigned long long ullBytesWritten;
+    unsigned long long ullReads;
+    unsigned long long ullWrites;
+    unsigned long long ullServiceTime;  // spent on completed reads and writes
+    unsigned long long ullQueueTime;    // Linux, requests in flight integrated over time
+    unsigned long ulQueueDepth;         // Windows, requests in flight right now
+}DiskCounters;
+
+typedef struct _DISK_LOAD_
+{
+    int nDisk;                          // N of \\.\PhysicalDriveN, the position on Linux
+    char szName[DISK_PERFORMANCE_NAME_SIZE];
+    double dReadRate;                   // bytes per second
+    double dWriteRate;
+    double dReadIops;
+    double dWriteIops;
+    double dQueueDepth;                 // average over the interval on Linux
+    double dLatency;                    // ms per completed request
+    DiskCounters Previous;
+    DiskCounters Current;
+#ifdef STK_WINDOWS
+    HANDLE hDisk;
+#endif
+}DiskLoad;
+
+// Throughput, IOPS, queue depth and latency of every physical disk.
+// Initialize() takes the drives of GetPhysicalDrivesList(), the same
+// identities the ATA and SMART pages use. Update() reads the counters of
+// all disks once, IOCTL_DISK_PERFORMANCE per open handle on Windows and
+// one pread() of /proc/diskstats on Linux, and computes the deltas in
+// place; nothing is allocated after Initialize().
+class CDiskPerformance
+{
+private:
+    DiskLoad            m_pDisks[DISK_PERFORMANCE_MAX_DISKS];
+    int                 m_nDisks;
+    unsigned long long  m_ullTimestamp;
+
+#ifndef STK_WINDOWS
+    int                 m_nStatsFile;
+    char                *m_pszBuffer;
+    int                 m_nBufferSize;
+
+    int ReadStats();
+#endif
+
+    int ReadCounters();
+    static void Compute(DiskLoad *pDisk, double dSeconds);
+
+public:
+    CDiskPerformance();
+    ~CDiskPerformance();
+
+    // qDrives holds \\.\PhysicalDriveN paths, on Linux block device names;
+    // an empty list on Linux takes every whole disk in /proc/diskstats
+    int Initialize(const QStringList &qDrives);
+    int Update();
+
+    int GetDiskCount();
+    const DiskLoad *GetDisks();
+};
+
+#endif // DISK_PERFORMANCE_H
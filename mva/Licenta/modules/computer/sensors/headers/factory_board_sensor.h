@@ -1,24 +1,18 @@
 #ifndef FACTORY_BOARD_SENSOR_H
 #define FACTORY_BOARD_SENSOR_H
 
-#include "it87.h"
-#include "w836xx.h"
-#include "f718xx.h"
+#include <mutex>
 
-#define BASE_ADDRESS_REGISTER 0x60
+#ifdef STK_WINDOWS
+#include "superio_sensor.h"
+#include "superio_cache.h"
+#else
+#include "hwmon_sensor.h"
 
-#define IT87_REGISTER_PORT 0x2E
-#define IT87_VALUE_PORT 0x2F
-#define IT87_CHIP_VERSION_REGISTER 0x22
-#define IT87_ENVIRONMENT_CONTROLLER 0x04
+class CRing0Wrapper;
+#endif
 
-#define W836_REGISTER_PORT 0x2E //4E
-#define W836_VALUE_PORT 0x2F //4F
-
-#define F718_REGISTER_PORT 0x4E
-#define F718_VALUE_PORT 0x4F
-#define F718_VENDOR_ID_REGISTER 0x23
-#define F718_VENDOR_ID_VALUE 0x1934
+#define SUPERIO_CACHE_FILE "superio.cache"
 
 class FactoryBoardSensor
 {
@@ -26,18 +20,36 @@ private:
     CRing0Wrapper *m_pDriver;
     ISensor *m_pBoardSensor;
 
+    // Held for one index/data transaction at a time, so the probes of the
+    // two configuration ports can interleave on the shared driver handle
+    std::mutex m_DriverMutex;
+
+#ifdef STK_WINDOWS
+    void WritePort(BYTE bPort, BYTE bValue);
     USHORT ReadWordFromPort(BYTE bRegisterPort, BYTE bValuePort, BYTE bRegister);
     BYTE ReadByteFromPort(BYTE bRegisterPort, BYTE bValuePort, BYTE bRegister);
+    void WriteByteToPort(BYTE bRegisterPort, BYTE bValuePort, BYTE bRegister, BYTE bValue);
+
+    void EnterConfiguration(const SuperIOFamilyDescriptor *pFamily);
+    void ExitConfiguration(const SuperIOFamilyDescriptor *pFamily);
+    void ReadChipId(const SuperIOFamilyDescriptor *pFamily, USHORT *pusChipId, BYTE *pbRevision);
+
+    bool DetectSuperIOSensor(const SuperIOFamilyDescriptor *pFamily, SuperIODetection *pDetection);
+    void DetectOnPort(BYTE bRegisterPort, SuperIODetection *pDetections, char *pbFound);
+    int Detect(SuperIODetection *pDetection);
 
-    bool DetectIT87XXSensor();
-    bool DetectW836XXSensor();
-    bool DetectF718XXSensor();
+    bool ValidateDetection(const SuperIODetection *pDetection);
+    ISensor *CreateSensor(const SuperIODetection *pDetection);
+#endif
 
 public:
     FactoryBoardSensor();
     ~FactoryBoardSensor();
 
-    ISensor *GetBoardSensor();
+    // Uses the detection cache in qsCacheDirectory when the baseboard
+    // identity is known, otherwise always probes. Without the Windows
+    // driver the sensors exported by the kernel hwmon drivers are used.
+    ISensor *GetBoardSensor(const QString &qsCacheDirectory, const QString &qsBoardIdentity);
     int DestroySensor();
 };
 
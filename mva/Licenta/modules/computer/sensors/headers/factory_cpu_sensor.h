@@ -1,14 +1,21 @@
 #ifndef FACTORY_CPU_SENSOR_H
 #define FACTORY_CPU_SENSOR_H
 
+#include <string>
+
+#ifdef STK_WINDOWS
 // WinAPI includes
 #include <Windows.h>
 #include <intrin.h>
-#include <string>
 
 #include "intel_temperature.h"
 #include "amd0f_temperature.h"
 #include "amd10_temperature.h"
+#else
+#include "hwmon_sensor.h"
+
+class CRing0Wrapper;
+#endif
 
 class FactoryCpuSensor
 {
@@ -5,25 +5,40 @@
 #include <Pdh.h>
 
 #include "sensor_defines.h"
+#include "../../../../utils/headers/utils.h"
 
 #include <QDebug>
 
+// Memory manager counters without a Win32 API, all in one PDH query
+typedef enum _MEMORY_COUNTER_
+{
+    MemoryCounterCommitted = 0,
+    MemoryCounterCommitLimit,
+    MemoryCounterCache,
+    MemoryCounterStandbyReserve,
+    MemoryCounterStandbyNormal,
+    MemoryCounterStandbyCore,
+    MemoryCounterModified,
+    MemoryCounterPagesInput,
+    MemoryCounterPagesOutput,
+    MemoryCounterCount
+}MemoryCounter;
+
 class CHardwareUsage
 {
 private:
-    PDH_HQUERY m_CpuQuery;
-    PDH_HQUERY m_DiskQuery;
-    PDH_HCOUNTER m_CpuCounter;
-    PDH_HCOUNTER m_DiskCounter;
+    PDH_HQUERY m_MemoryQuery;
+    PDH_HCOUNTER m_pMemoryCounters[MemoryCounterCount];
+
+    double GetMemoryCounter(MemoryCounter Counter);
 
 public:
     CHardwareUsage();
     ~CHardwareUsage();
 
-    double GetCpuLoad();
     QString GetCpuName();
-    double GetDiskLoad();
-    MemoryStatus* GetMemoryStatus();
+    // Fills the caller's struct, nothing is allocated per call
+    int GetMemoryStatus(MemoryStatus *pMemoryStatus);
 };
 
 #endif // HARDWARE_USAGE_H
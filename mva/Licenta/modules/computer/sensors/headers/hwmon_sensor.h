@@ -0,0 +1,102 @@
+#ifndef HWMON_SENSOR_H
+#define HWMON_SENSOR_H
+
+#include <string.h>
+#include <vector>
+
+#include "sensor_defines.h"
+#include "sensor_samples.h"
+#include "../interfaces/isensor.h"
+#include "../../../../utils/headers/utils.h"
+
+#define HWMON_CLASS_DIRECTORY           "/sys/class/hwmon"
+#define HWMON_READ_BUFFER_SIZE          32
+#define HWMON_PATH_SIZE                 256
+
+// Drivers that report the processor itself, they feed CHwmonCpuSensor
+// and are left out of the board sensor
+#define HWMON_IS_CPU_DRIVER(X) \
+    (0 == strcmp(X, "coretemp") || 0 == strcmp(X, "k10temp") || \
+     0 == strcmp(X, "k8temp") || 0 == strcmp(X, "zenpower") || \
+     0 == strcmp(X, "via_cputemp"))
+
+typedef struct _HWMON_INPUT_
+{
+    int nFile;                          // <type><n>_input, kept open
+    double dScale;                      // sysfs reports milli units for temperatures and voltages
+}HwmonInput;
+
+// The inputs of every accepted /sys/class/hwmon device. The directories are
+// walked once in Open(), inputs are stored grouped by device so a driver
+// that refreshes its whole register set on the first access of a tick is
+// hit back to back, and Read() is one pread() per input.
+class CHwmonInputs
+{
+private:
+    std::vector<HwmonInput> m_qInputs;
+    std::vector<SensorChannel> m_qChannels;
+    QString m_qzDevices;
+
+    int AddDevice(const char *pszDirectory, const char *pszName, bool bPrefix, bool bTempsOnly);
+
+public:
+    CHwmonInputs();
+    ~CHwmonInputs();
+
+    // bCpu selects the processor drivers, otherwise everything else
+    int Open(bool bCpu);
+    void Close();
+
+    int GetCount();
+    const SensorChannel* GetChannels();
+    // Device names joined with ", "
+    QString GetDevices();
+
+    // NaN for an input the driver failed to read
+    int Read(double *pValues);
+};
+
+class CHwmonSensor : public ISensor
+{
+private:
+    CHwmonInputs m_Inputs;
+
+public:
+    CHwmonSensor();
+    virtual ~CHwmonSensor();
+
+    virtual int Initialize();
+    virtual int Destroy();
+    virtual int GetChannelCount();
+    virtual const SensorChannel* GetChannels();
+    virtual int Update(double *pValues);
+    virtual QString GetChipName();
+};
+
+// coretemp reports one "Core N" input per core plus the package, k10temp
+// and zenpower only Tctl/Tdie/Tccd; the per core inputs are used when the
+// driver has them, otherwise every temperature of the driver
+class CHwmonCpuSensor : public ICPUSensor
+{
+private:
+    CHwmonInputs m_Inputs;
+    std::vector<int> m_qCoreInputs;
+    std::vector<double> m_qValues;
+    double *m_pTemps;
+
+public:
+    CHwmonCpuSensor();
+    virtual ~CHwmonCpuSensor();
+
+    virtual int Initialize();
+    virtual int Destroy();
+    virtual int Update();
+    virtual double* GetTemps();
+    virtual QString GetCpuName();
+    virtual QString GetMicroArchitecture();
+    virtual int GetNumberOfCores();
+    virtual int GetMultiplier();
+    virtual CThermalThrottle* GetThermalThrottle();
+};
+
+#endif // HWMON_SENSOR_H
@@ -1,8 +1,13 @@
 #ifndef INTEL_TEMPERATURE_H
 #define INTEL_TEMPERATURE_H
 
+#include <intrin.h>
+
 #include "sensor_defines.h"
+#include "sensor_samples.h"
 #include "stk_driver_wrapper.h"
+#include "cpu_topology.h"
+#include "thermal_throttle.h"
 #include "../interfaces/isensor.h"
 #include "../../../../utils/headers/utils.h"
 
@@ -12,11 +17,17 @@
 #define IA32_THERM_STATUS_MSR       0x019C
 #define IA32_TEMPERATURE_TARGET     0x01A2
 
+#define THERM_STATUS_READING_VALID  0x80000000
+
 
 class CIntelCpuSensor : public ICPUSensor
 {
 private:
     CRing0Wrapper *m_pDriver;
+    CCpuTopology *m_pTopology;
+    ULONGLONG *m_pMsrValues;
+    CThermalThrottle *m_pThrottle;
+    bool m_bPackageThermal;
 
     double *m_pTemps;
     double *m_pTjMax;
@@ -41,6 +52,7 @@ public:
     virtual QString GetMicroArchitecture();
     virtual int GetNumberOfCores();
     virtual int GetMultiplier();
+    virtual CThermalThrottle *GetThermalThrottle();
 };
 
 #endif // INTEL_TEMPERATURE_H
@@ -0,0 +1,58 @@
+#ifndef NUMA_MEMORY_H
+#define NUMA_MEMORY_H
+
+#ifdef STK_WINDOWS
+#include <Windows.h>
+#include <Pdh.h>
+#endif
+
+#include "../../../../utils/headers/utils.h"
+
+#define NUMA_MAX_NODES                  64
+#define NUMA_READ_BUFFER_SIZE           4096
+
+typedef struct _NUMA_NODE_MEMORY_
+{
+    int nNode;
+    unsigned long long ullTotal;        // bytes
+    unsigned long long ullFree;         // bytes
+    // numastat counters, in pages
+    unsigned long long ullHit;          // allocated here as intended
+    unsigned long long ullMiss;         // allocated here although another node was preferred
+    unsigned long long ullForeign;      // intended for this node, allocated elsewhere
+    unsigned long long ullLocal;        // allocated here for a process running on this node
+    unsigned long long ullRemote;       // allocated here for a process running on another node
+}NumaNodeMemory;
+
+// Per node memory statistics. Nodes are discovered once, Update() only
+// refreshes the numbers in place and does not allocate.
+class CNumaMemory
+{
+private:
+    NumaNodeMemory  m_pNodes[NUMA_MAX_NODES];
+    int             m_nNodes;
+    bool            m_bHasCounters;
+
+#ifdef STK_WINDOWS
+    int ReadNodeTotals();
+#else
+    int             m_pMeminfoFiles[NUMA_MAX_NODES];
+    int             m_pNumastatFiles[NUMA_MAX_NODES];
+
+    int ReadNodeFile(int nFile, char *pszBuffer);
+#endif
+
+public:
+    CNumaMemory();
+    ~CNumaMemory();
+
+    int Initialize();
+    int Update();
+
+    int GetNodeCount();
+    const NumaNodeMemory *GetNodes();
+    // hit/miss/foreign/local/remote are only provided by Linux
+    bool HasCounters();
+};
+
+#endif // NUMA_MEMORY_H
@@ -0,0 +1,113 @@
+#ifndef RAPL_POWER_H
+#define RAPL_POWER_H
+
+#ifdef STK_WINDOWS
+#include <Windows.h>
+#include <intrin.h>
+
+#include "stk_driver_wrapper.h"
+#include "cpu_topology.h"
+#endif
+
+#include "sensor_samples.h"
+#include "../../../../utils/headers/utils.h"
+
+#define RAPL_MAX_COUNTERS               32
+#define RAPL_READ_BUFFER_SIZE           32
+
+// Intel
+#define MSR_RAPL_POWER_UNIT             0x606
+#define MSR_PKG_ENERGY_STATUS           0x611
+#define MSR_DRAM_ENERGY_STATUS          0x619
+#define MSR_PP0_ENERGY_STATUS           0x639
+#define MSR_PP1_ENERGY_STATUS           0x641
+
+// AMD family 17h and later
+#define MSR_AMD_RAPL_POWER_UNIT         0xC0010299
+#define MSR_AMD_CORE_ENERGY_STAT        0xC001029A
+#define MSR_AMD_PKG_ENERGY_STAT         0xC001029B
+
+// Server parts use a fixed 15.3 uJ DRAM unit regardless of MSR_RAPL_POWER_UNIT
+#define RAPL_DRAM_FIXED_UNIT            (1.0 / 65536)
+
+typedef enum _RAPL_DOMAIN_
+{
+    RaplDomainPackage = 0,
+    RaplDomainCores,                    // PP0, all cores together
+    RaplDomainUncore,                   // PP1, usually the integrated GPU
+    RaplDomainDram,
+    RaplDomainCount
+}RaplDomain;
+
+#define RAPL_DOMAIN_STRING(X) \
+    X == RaplDomainPackage ? "Package: " : \
+    X == RaplDomainCores ? "Cores: " : \
+    X == RaplDomainUncore ? "Uncore: " : \
+    X == RaplDomainDram ? "DRAM: " : \
+    ""
+
+typedef struct _RAPL_COUNTER_
+{
+    RaplDomain Domain;
+    unsigned long long ullRaw;          // last raw counter value
+    unsigned long long ullRange;        // the counter wraps to 0 at this value
+    double dUnit;                       // joules per count
+    double dEnergy;                     // joules since Initialize()
+    double dPower;                      // watts over the last interval
+#ifdef STK_WINDOWS
+    int nPackage;
+    int nSlot;                          // register index in the package reads
+#else
+    int nFile;                          // powercap energy_uj, kept open
+#endif
+}RaplCounter;
+
+// Energy counters of the CPU power domains, one per package and domain.
+// Counters are discovered once, Update() reads them (one driver broadcast
+// for every package, one more for the AMD per core counters) and turns the
+// wrap corrected delta into watts.
+class CRaplPower
+{
+private:
+    RaplCounter         m_pCounters[RAPL_MAX_COUNTERS];
+    int                 m_nCounters;
+    RaplCounter         *m_pCores;
+    int                 m_nCores;
+    unsigned long long  m_ullTimestamp;
+
+#ifdef STK_WINDOWS
+    CRing0Wrapper       *m_pDriver;
+    CCpuTopology        *m_pTopology;
+    ULONGLONG           *m_pCoreValues;
+    ULONG               m_pMsrs[RaplDomainCount];
+    int                 m_nMsrs;
+    ULONGLONG           *m_pPackageValues;
+
+    int AddMsrCounters(RaplDomain Domain, ULONG ulMsr, double dUnit);
+    int InitializeIntel(int nModel);
+    int InitializeAmd();
+#else
+    int AddFileCounter(RaplDomain Domain, const char *pszDirectory);
+    int ReadCounterFile(int nFile, unsigned long long *pullValue);
+#endif
+
+    static void Accumulate(RaplCounter *pCounter, unsigned long long ullRaw, double dSeconds);
+
+public:
+    CRaplPower();
+    ~CRaplPower();
+
+    int Initialize();
+    int Update();
+
+    bool HasDomain(RaplDomain Domain);
+    // Summed over all packages
+    double GetPower(RaplDomain Domain);
+    double GetEnergy(RaplDomain Domain);
+
+    // Per core energy, only AMD provides it
+    int GetCoreCount();
+    double GetCorePower(int nCore);
+};
+
+#endif // RAPL_POWER_H
@@ -0,0 +1,84 @@
+#ifndef SAMPLING_POLICY_H
+#define SAMPLING_POLICY_H
+
+#include <vector>
+
+#include "sensor_samples.h"
+
+#define SAMPLING_POLICY_QUANTUM             750     // ms, every interval is a power of two multiple
+#define SAMPLING_POLICY_STABLE_TICKS        8       // quiet ticks before each back off step
+#define SAMPLING_POLICY_MAX_STABLE_SHIFT    2       // x4 while the values hold still
+#define SAMPLING_POLICY_MAX_WATCHED_SHIFT   1       // x2 on an open page, someone is looking
+#define SAMPLING_POLICY_BACKGROUND_SHIFT    1       // x2 with no page open, scrapes only
+#define SAMPLING_POLICY_BATTERY_SHIFT       1       // x2 on battery
+#define SAMPLING_POLICY_RELATIVE_DEADBAND   0.05    // of the last significant value
+
+typedef enum _SAMPLING_SOURCE_
+{
+    SamplingSourceSensors = 0,          // sensor tick: history, log, alarms and exporter
+    SamplingSourceSensorsPage,          // values sent to the open sensors page
+    SamplingSourceGpu,                  // video card page refresh
+    SamplingSourceCount
+}SamplingSource;
+
+typedef struct _SAMPLING_OVERHEAD_
+{
+    double dCpuPercent;                 // CPU time of the whole process over wall time, of one CPU
+    double dWakeupsPerMinute;
+    double dInterval;                   // ms, current sensor tick interval
+}SamplingOverhead;
+
+// Decides when every periodic source runs. All intervals are power of two
+// multiples of one quantum and wakeups land on a single lattice anchored
+// at construction, so the sources due together share one timer wakeup
+// instead of waking the CPU each on its own. Intervals stretch while the
+// sensor values stay inside their deadband, on battery and with no page
+// open; pages stop refreshing while the window is minimized. The policy
+// also measures what the whole process costs between sensor ticks.
+class CSamplingPolicy
+{
+private:
+    bool                        m_pActive[SamplingSourceCount];
+    bool                        m_bVisible;
+    bool                        m_bOnBattery;
+    int                         m_nStableShift;
+    int                         m_nStableTicks;
+    std::vector<double>         m_qReferences;      // per sensor, value at the last significant move
+
+    unsigned long long          m_ullAnchor;        // SensorTimestamp() of quantum 0
+    unsigned long long          m_ullNext;          // quantum of the scheduled wakeup
+    unsigned long long          m_ullFired;         // quantum of the last wakeup that ran
+
+    unsigned long long          m_ullLastCpuTime;
+    unsigned long long          m_ullLastWallTime;
+    unsigned int                m_uWakeups;
+    SamplingOverhead            m_Overhead;
+
+    bool IsRunning(SamplingSource Source) const;
+    int GetShift(SamplingSource Source) const;
+
+public:
+    CSamplingPolicy();
+    ~CSamplingPolicy();
+
+    void SetActive(SamplingSource Source, bool bActive);
+    bool IsActive(SamplingSource Source) const;
+    void SetVisible(bool bVisible);
+    bool IsVisible() const;
+    void SetOnBattery(bool bOnBattery);
+
+    // Deadband check of the values that changed in the tick, O(changed)
+    void Observe(const CSensorSamples *pSamples);
+
+    // Call from the wakeup, returns a mask of the SamplingSource bits due
+    unsigned int BeginWakeup();
+    // ms to the next lattice point a running source is due at, -1 for none
+    int Schedule();
+    // ms
+    int GetInterval(SamplingSource Source) const;
+
+    // Averages over the period since the previous call
+    const SamplingOverhead *GetOverhead();
+};
+
+#endif // SAMPLING_POLICY_H
@@ -0,0 +1,138 @@
+#ifndef SENSOR_ALARMS_H
+#define SENSOR_ALARMS_H
+
+#include <vector>
+
+#include <QFile>
+#include <QList>
+#include <QString>
+
+#include "sensor_samples.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+#define SENSOR_ALARMS_RULES_FILE        "alarms.rules"
+#define SENSOR_ALARMS_LOG_FILE          "alarms.log"
+#define SENSOR_ALARMS_SOCKET_NAME       "stk-sensor-alarms"
+
+typedef enum _SENSOR_ALARM_CONDITION_
+{
+    SensorAlarmAbove = 0,               // value > threshold
+    SensorAlarmBelow,                   // value < threshold
+    SensorAlarmRateAbove,               // units per second > threshold
+    SensorAlarmRateBelow                // units per second < threshold
+}SensorAlarmCondition;
+
+typedef enum _SENSOR_ALARM_STATE_
+{
+    SensorAlarmIdle = 0,
+    SensorAlarmPending,                 // condition holds, waiting for the duration
+    SensorAlarmActive
+}SensorAlarmState;
+
+#define SENSOR_ALARM_CONDITION_STRING(X) \
+    X == SensorAlarmAbove ? "above" : \
+    X == SensorAlarmBelow ? "below" : \
+    X == SensorAlarmRateAbove ? "rate-above" : \
+    X == SensorAlarmRateBelow ? "rate-below" : \
+    ""
+
+typedef struct _SENSOR_ALARM_RULE_
+{
+    SensorAlarmCondition Condition;
+    double dThreshold;
+    double dHysteresis;                 // distance back past the threshold before the alarm clears
+    unsigned long long ullDuration;     // us the condition has to hold, 0 raises at once
+    unsigned long long ullBurst;        // us of high frequency capture, 0 for none
+    int nLine;                          // in the rules file, reported with the events
+}SensorAlarmRule;
+
+// One rule bound to one sensor. Instances are sorted by sensor ID so the
+// instances of a sensor are contiguous.
+typedef struct _SENSOR_ALARM_INSTANCE_
+{
+    int nRule;
+    int nSensorId;
+    SensorAlarmState State;
+    unsigned long long ullSince;        // start of the pending period
+    unsigned int uEpoch;                // last batch that evaluated the instance
+}SensorAlarmInstance;
+
+typedef struct _SENSOR_ALARM_EVENT_
+{
+    int nRule;
+    int nSensorId;
+    bool bRaised;                       // false when the alarm cleared
+    double dValue;                      // the sample, or the rate for rate rules
+    unsigned long long ullTimestamp;
+}SensorAlarmEvent;
+
+typedef void (*SensorAlarmCallback)(const SensorAlarmEvent *pEvent, const QString &qsMessage, void *pContext);
+typedef void (*SensorAlarmBurstCallback)(int nSensorId, unsigned long long ullDuration, void *pContext);
+
+// Threshold, rate and sustained-condition alarms with hysteresis. Load()
+// binds every rule to the sensors it names once, Evaluate() then only
+// visits the instances of the sensors that changed in the batch plus the
+// ones already pending or active. Events go to the log file, the callback
+// and every client of the local socket. A rule with a burst option calls
+// the burst callback as soon as its condition first holds, before a
+// "for" duration has passed, so the capture covers the alarm itself.
+//
+// Rules file, one rule per line, lines starting with # are comments:
+//   <group|*> <kind|*> <"name"|*> <above|below|rate-above|rate-below> <threshold>
+//       [for <seconds>] [hysteresis <delta>] [burst <seconds>]
+// Names match the sensor name without the trailing ": ", case insensitive,
+// a trailing * matches a prefix. For example:
+//   cpu temperature * above 90 for 5 hysteresis 5
+//   board voltage "+12V" below 11.4 hysteresis 0.1
+//   cpu temperature "Core #1" rate-above 20 burst 1
+class CSensorAlarms
+{
+private:
+    const CSensorSamples            *m_pSamples;
+
+    std::vector<SensorAlarmRule>    m_qRules;
+    std::vector<SensorAlarmInstance> m_qInstances;
+    std::vector<int>                m_qSensorFirst;     // sensor ID -> first instance, count + 1 entries
+    std::vector<int>                m_qArmed;           // pending and active instances
+    std::vector<int>                m_qNextArmed;
+    std::vector<double>             m_qLastValues;      // per sensor, value before the last change
+    unsigned long long              m_ullLastEvaluate;
+    unsigned int                    m_uEpoch;
+
+    QFile                           m_LogFile;
+    QLocalServer                    *m_pServer;
+    QList<QLocalSocket*>            m_qClients;
+    SensorAlarmCallback             m_pfnCallback;
+    void                            *m_pContext;
+    SensorAlarmBurstCallback        m_pfnBurstCallback;
+    void                            *m_pBurstContext;
+
+    int ParseRule(const QString &qsLine, int nLine, QString *pqsGroup, QString *pqsKind, QString *pqsName);
+    void BindRule(int nRule, const QString &qsGroup, const QString &qsKind, const QString &qsName,
+                  std::vector<SensorAlarmInstance> &qInstances);
+    void EvaluateInstance(int nInstance, unsigned long long ullNow, double dSeconds);
+    void Emit(const SensorAlarmInstance *pInstance, bool bRaised, double dValue, unsigned long long ullTimestamp);
+
+public:
+    CSensorAlarms();
+    ~CSensorAlarms();
+
+    // A missing rules file is not an error, the engine just stays idle
+    int Load(const QString &qsRulesFile, const CSensorSamples *pSamples);
+    int OpenLog(const QString &qsLogFile);
+    int Listen(const QString &qsSocketName);
+    void SetCallback(SensorAlarmCallback pfnCallback, void *pContext);
+    void SetBurstCallback(SensorAlarmBurstCallback pfnCallback, void *pContext);
+
+    // Call after the batch has been written into the samples
+    int Evaluate();
+
+    int GetRuleCount() const;
+    // Rules with a burst option
+    int GetBurstRuleCount() const;
+    int GetActiveCount() const;
+};
+
+#endif // SENSOR_ALARMS_H
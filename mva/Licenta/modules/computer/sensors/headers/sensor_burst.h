@@ -0,0 +1,119 @@
+#ifndef SENSOR_BURST_H
+#define SENSOR_BURST_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QFile>
+#include <QString>
+
+#include "sensor_samples.h"
+#include "sensor_history.h"
+
+#define SENSOR_BURST_CONFIG_FILE        "burst.conf"
+#define SENSOR_BURST_LOG_FILE           "burst.log"
+#define SENSOR_BURST_RING_SIZE          1024        // 10 s at 100 Hz per sensor
+#define SENSOR_BURST_MAX_SOURCES        8
+#define SENSOR_BURST_MIN_RATE           10          // Hz
+#define SENSOR_BURST_MAX_RATE           100
+#define SENSOR_BURST_DEFAULT_RATE       50
+#define SENSOR_BURST_PRE_TRIGGER        1000000ULL  // us of history written before the trigger
+#define SENSOR_BURST_MAX_DURATION       5000000ULL  // us, with the history what the rings hold at the highest rate
+
+typedef enum _SENSOR_BURST_SOURCE_TYPE_
+{
+    SensorBurstBoard = 0,               // every channel of the board chip, VCORE included
+    SensorBurstCpuTemperature,          // core temperatures
+    SensorBurstCpuClock,                // APERF/MPERF effective clocks and C0 residency
+    SensorBurstSourceCount
+}SensorBurstSourceType;
+
+#define SENSOR_BURST_SOURCE_STRING(X) \
+    X == SensorBurstBoard ? "board" : \
+    X == SensorBurstCpuTemperature ? "temperature" : \
+    X == SensorBurstCpuClock ? "clock" : \
+    ""
+
+// Fills the values of the consecutive sensors a source was added with
+typedef int (*SensorBurstRead)(void *pContext, double *pValues);
+
+typedef struct _SENSOR_BURST_SOURCE_
+{
+    int nFirstId;
+    int nCount;
+    int nFirstRing;                     // rings are laid out source after source
+    SensorBurstRead pfnRead;
+    void *pContext;
+}SensorBurstSource;
+
+// High frequency capture of a few sensors around a transient. Once started
+// the sampler thread reads its sources at 10-100 Hz into rings of its own,
+// so a transient that trips an alarm rule has already been recorded when
+// the rule calls Trigger(). The capture written to the burst log then runs
+// from SENSOR_BURST_PRE_TRIGGER before the trigger to the end of the
+// requested time. Start it only while a rule with a burst option is
+// loaded. The regular tick, the sensors page and CSensorSamples are not
+// touched; the chips the sources read are shared with the tick through
+// GetHardwareMutex().
+//
+// Config file, one setting per line, lines starting with # are comments:
+//   rate <10-100>
+//   source <board|temperature|clock>
+class CSensorBurst
+{
+private:
+    const CSensorSamples            *m_pSamples;
+    SensorBurstSource               m_pSources[SENSOR_BURST_MAX_SOURCES];
+    int                             m_nSources;
+    CSensorRing<SensorRawSample, SENSOR_BURST_RING_SIZE> *m_pRings;
+    int                             m_nRings;
+    int                             m_nRate;
+
+    // Sampler thread only
+    std::vector<double>             m_qValues;
+    std::vector<SensorRawSample>    m_qCapture;
+    QFile                           m_LogFile;
+
+    std::thread                     m_Sampler;
+    std::mutex                      m_HardwareMutex;
+    std::mutex                      m_Mutex;
+    std::condition_variable         m_Condition;
+    unsigned long long              m_ullTriggered;     // first trigger of the running capture
+    unsigned long long              m_ullCaptureEnd;    // 0 while idle
+    bool                            m_bSuspended;
+    bool                            m_bStop;
+
+    void SamplerThread();
+    void Sample();
+    void WriteCapture(unsigned long long ullTriggered, unsigned long long ullTo);
+    int FindRing(int nId) const;
+
+public:
+    CSensorBurst();
+    ~CSensorBurst();
+
+    // puSources gets a mask of SensorBurstSourceType bits
+    static int ReadConfig(const QString &qsFile, int *pnRate, unsigned int *puSources);
+
+    int AddSource(int nFirstId, int nCount, SensorBurstRead pfnRead, void *pContext);
+    int Start(const CSensorSamples *pSamples, int nRate, const QString &qsLogFile);
+    void Stop();
+
+    // Writes the history before now and ullDuration us from now, extends a
+    // running capture up to SENSOR_BURST_MAX_DURATION after its first trigger
+    void Trigger(unsigned long long ullDuration);
+    // Stops sampling, ends a running capture and ignores triggers until
+    // resumed, for work the sampler would disturb and be disturbed by
+    void Suspend(bool bSuspend);
+
+    // Held around every read of the chips a source reads
+    std::mutex &GetHardwareMutex();
+
+    int GetRate() const;
+    // Newest samples of a burst sensor, oldest first, 0 for other sensors
+    int ReadRaw(int nId, SensorRawSample *pOut, int nMax) const;
+};
+
+#endif // SENSOR_BURST_H
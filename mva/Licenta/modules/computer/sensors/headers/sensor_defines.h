@@ -3,6 +3,8 @@
 
 #include <QString>
 
+#include "sensor_samples.h"
+
 #define AMD_INVALID_ADDRESS 0xFFFFFFFF
 #define AMD_VENDOR_ID 0x1022
 #define AMD_BASE_DEVICE 0x18
@@ -91,22 +93,34 @@ typedef enum _AMD_MICROARCHITECTURE_
     AMD_VISHERA = 12
 }AMDMicroArchitecture;
 
+// sizes in bytes
 typedef struct _MEMORY_STATUS_
 {
-    QString qzTotalPhys;
-    QString qzAvailPhys;
-    QString qzTotalPageFile;
-    QString qzAvailPageFile;
-    QString qzTotalVirtual;
-    QString qzAvailVirtual;
-    QString qzAvailExtVirtual;
-    QString qzMemoryLoad;
+    unsigned long long ullTotalPhys;
+    unsigned long long ullAvailPhys;
+    unsigned long long ullTotalPageFile;
+    unsigned long long ullAvailPageFile;
+    unsigned long long ullTotalVirtual;
+    unsigned long long ullAvailVirtual;
+    unsigned long long ullAvailExtVirtual;
+    unsigned long ulMemoryLoad;         // percent
+    // memory manager counters, NaN when the system does not provide one
+    double dCommitted;                  // commit charge
+    double dCommitLimit;
+    double dCache;                      // system cache working set
+    double dStandby;                    // standby lists, all priorities
+    double dModified;                   // modified page list
+    double dPagesIn;                    // pages per second read for hard faults
+    double dPagesOut;                   // pages per second written to the page files
 }MemoryStatus;
 
-typedef struct _VOLTAGE_READING_STRUCT_
+// One reading of a board sensor. The list is built by Initialize() and
+// gives the order of the values Update() writes.
+typedef struct _SENSOR_CHANNEL_
 {
-    QString qzName;
-    QString qzValue;
-}VoltageReading;
+    SensorKind Kind;
+    SensorUnit Unit;
+    char szLabel[SENSOR_NAME_SIZE];
+}SensorChannel;
 
 #endif // SENSOR_DEFINES_H
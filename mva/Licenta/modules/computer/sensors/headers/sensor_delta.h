@@ -0,0 +1,34 @@
+#ifndef SENSOR_DELTA_H
+#define SENSOR_DELTA_H
+
+#include <string>
+
+#include "sensor_samples.h"
+
+// Wire format of the sensors page. The tree goes out once, as a
+// SensorsData message followed by the schema: one SensorSchemaItem per
+// ItemPair, in message order, which binds every value cell to its sensor
+// ID and unit. From then on every tick only carries a packed array of
+// SensorDeltaItem records for the values that changed, so the page
+// updates in O(changed) without parsing or matching labels.
+#pragma pack(push, 1)
+typedef struct _SENSOR_SCHEMA_ITEM_
+{
+    int nId;
+    int nUnit;                          // SensorUnit
+}SensorSchemaItem;
+
+typedef struct _SENSOR_DELTA_ITEM_
+{
+    int nId;
+    double dValue;
+}SensorDeltaItem;
+#pragma pack(pop)
+
+void SensorAppendSchema(std::string *psSchema, int nId, SensorUnit Unit);
+
+// Packs the values changed since BeginUpdate(), or all of them for a page
+// that missed ticks. The buffer is reused, it only grows.
+void SensorPackDelta(const CSensorSamples *pSamples, bool bAll, std::string *psDelta);
+
+#endif // SENSOR_DELTA_H
@@ -0,0 +1,121 @@
+#ifndef SENSOR_EXPORTER_H
+#define SENSOR_EXPORTER_H
+
+#include <stdint.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QString>
+
+#include "sensor_samples.h"
+
+#define SENSOR_EXPORTER_CONFIG_FILE     "exporter.conf"
+#define SENSOR_EXPORTER_DEFAULT_PORT    9465
+#define SENSOR_EXPORTER_REQUEST_SIZE    2048
+#define SENSOR_EXPORTER_TIMEOUT         2000        // ms a client may take from connect to the last byte sent
+#define SENSOR_EXPORTER_MAX_CLIENTS     512         // connections in flight, the rest wait in the backlog
+#define SENSOR_EXPORTER_POLL_INTERVAL   100         // ms, how late Stop() and the timeouts may be noticed
+#define SENSOR_EXPORTER_CONTENT_TYPE    "text/plain; version=0.0.4; charset=utf-8"
+
+// SOCKET is a UINT_PTR, winsock2.h has to stay out of this header because
+// Windows.h is already included by the other sensor headers
+#ifdef STK_WINDOWS
+typedef uintptr_t SensorExporterSocket;
+#else
+typedef int SensorExporterSocket;
+#endif
+#define SENSOR_EXPORTER_INVALID_SOCKET  ((SensorExporterSocket)-1)
+
+// HELP/TYPE header followed by the series of one metric
+typedef struct _SENSOR_EXPORTER_FAMILY_
+{
+    std::string sHeader;
+    std::vector<int> qItems;
+}SensorExporterFamily;
+
+// A connection in flight, reading the request while sResponse is empty
+typedef struct _SENSOR_EXPORTER_CLIENT_
+{
+    SensorExporterSocket hSocket;
+    std::string sRequest;
+    std::string sResponse;
+    size_t nSent;
+    std::chrono::steady_clock::time_point Deadline;
+}SensorExporterClient;
+
+typedef struct _SENSOR_EXPORTER_GAUGE_
+{
+    std::string sPrefix;                // metric{labels} plus the separating space
+    double dValue;
+}SensorExporterGauge;
+
+// Prometheus text exposition of the sampled sensors. Bind() renders the
+// metric names and labels of every sensor once; Render() runs after each
+// tick, appends only the values into a back buffer and swaps it with the
+// published one. The server thread answers a scrape by copying the
+// published buffer, so scrapes never reach the hardware or the sampler.
+// All connections are served by that one thread with nonblocking sockets
+// and poll(), a slow client holds its own slot only.
+// Values that are not sampled per tick (GPU, SMART) are pushed with
+// SetGauge() or SetCounter() whenever the controller refreshes them.
+class CSensorExporter
+{
+private:
+    const CSensorSamples                *m_pSamples;
+    std::vector<std::string>            m_qSensorPrefixes;
+    std::vector<SensorExporterFamily>   m_qSensorFamilies;
+
+    std::vector<SensorExporterGauge>    m_qGauges;
+    std::vector<SensorExporterFamily>   m_qGaugeFamilies;
+    std::map<std::string, int>          m_qGaugeIndex;      // series -> m_qGauges
+    std::map<std::string, int>          m_qGaugeFamilyIndex;
+
+    std::string                         m_sBack;
+    std::string                         m_sFront;
+    std::mutex                          m_Mutex;
+
+    SensorExporterSocket                m_hListen;
+    unsigned short                      m_usPort;
+    std::vector<SensorExporterClient>   m_qClients;
+    std::thread                         m_Server;
+    volatile bool                       m_bStop;
+    bool                                m_bNetwork;         // WSAStartup() done
+
+    static void AppendValue(std::string &sOut, double dValue);
+    void SetSeries(const char *pszMetric, const char *pszType, const QString &qsLabels, double dValue);
+    void ServerThread();
+    void Accept();
+    bool Serve(SensorExporterClient *pClient);
+    void Respond(SensorExporterClient *pClient);
+
+public:
+    CSensorExporter();
+    ~CSensorExporter();
+
+    int Bind(const CSensorSamples *pSamples);
+    int Render();
+
+    // qsLabels is the inside of the braces, e.g. drive="0",attribute="Power_On_Hours"
+    void SetGauge(const char *pszMetric, const QString &qsLabels, double dValue);
+    // Same for a value that only grows, pszMetric ends with _total
+    void SetCounter(const char *pszMetric, const QString &qsLabels, double dValue);
+
+    // usPort 0 picks a free port, GetPort() tells which one
+    int Start(const QString &qsAddress, unsigned short usPort);
+    void Stop();
+    unsigned short GetPort() const;
+
+    // "<address> [port] [profile]" from the first line of the file that is
+    // not a comment, profile also exports the self profile of the tool
+    static int ReadConfig(const QString &qsFile, QString *pqsAddress, unsigned short *pusPort, bool *pbProfile);
+};
+
+// Escapes \, " and new lines of a label value
+QString SensorExporterLabel(const QString &qsValue);
+
+#endif // SENSOR_EXPORTER_H
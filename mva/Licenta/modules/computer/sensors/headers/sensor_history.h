@@ -0,0 +1,143 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <atomic>
+
+#include "sensor_samples.h"
+
+// Ring sizes per sensor, ~13 KB in total, 2.5 MB for 200 sensors. The 24 h
+// view is read from the hour ring, minute detail further back than the
+// minute ring is in the on-disk sensor log.
+#define SENSOR_HISTORY_RAW_SIZE             64      // last tick samples
+#define SENSOR_HISTORY_SECOND_SIZE          60      // 1 minute of 1 s buckets
+#define SENSOR_HISTORY_MINUTE_SIZE          360     // 6 hours of 1 min buckets
+#define SENSOR_HISTORY_HOUR_SIZE            168     // 7 days of 1 h buckets
+
+typedef enum _SENSOR_RESOLUTION_
+{
+    SensorResolutionSecond = 0,
+    SensorResolutionMinute,
+    SensorResolutionHour,
+    SensorResolutionCount
+}SensorResolution;
+
+#define SENSOR_RESOLUTION_PERIOD(X) \
+    (X == SensorResolutionSecond ? 1000000ULL : \
+     X == SensorResolutionMinute ? 60000000ULL : \
+     3600000000ULL)
+
+typedef struct _SENSOR_RAW_SAMPLE_
+{
+    unsigned long long ullTimestamp;    // SensorTimestamp() microseconds
+    double dValue;
+}SensorRawSample;
+
+// NaN samples (sensor unreadable) are left out, a bucket without any
+// other sample is not pushed
+typedef struct _SENSOR_ROLLUP_
+{
+    unsigned int uBucket;               // timestamp / resolution period
+    float fMin;
+    float fMax;
+    float fMean;
+    float fLast;
+}SensorRollup;
+
+// Single producer, multiple consumer ring. The producer never waits, a
+// reader copies what it wants and drops the entries that were overwritten
+// while it was copying.
+template <typename T, int N>
+class CSensorRing
+{
+private:
+    T                               m_pSlots[N];
+    std::atomic<unsigned long long> m_ullHead;      // items pushed so far
+
+public:
+    CSensorRing() : m_ullHead(0) {}
+
+    void Push(const T &Item)
+    {
+        unsigned long long ullHead = m_ullHead.load(std::memory_order_relaxed);
+        m_pSlots[ullHead % N] = Item;
+        m_ullHead.store(ullHead + 1, std::memory_order_release);
+    }
+
+    // Newest nMax entries, oldest first. Returns the number copied.
+    int Read(T *pOut, int nMax) const
+    {
+        unsigned long long ullHead = m_ullHead.load(std::memory_order_acquire);
+        unsigned long long ullCount = ullHead < (unsigned long long)N ? ullHead : N;
+        if( ullCount > (unsigned long long)nMax )
+            ullCount = nMax;
+
+        unsigned long long ullFirst = ullHead - ullCount;
+        for( unsigned long long i = 0; i < ullCount; i++ )
+            pOut[i] = m_pSlots[(ullFirst + i) % N];
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // The producer may be rewriting the slot after the newest one
+        unsigned long long ullNow = m_ullHead.load(std::memory_order_relaxed);
+        unsigned long long ullValid = ullNow + 1 > (unsigned long long)N ? ullNow + 1 - N : 0;
+        if( ullValid <= ullFirst )
+            return (int)ullCount;
+
+        unsigned long long ullDropped = ullValid - ullFirst;
+        if( ullDropped >= ullCount )
+            return 0;
+
+        for( unsigned long long i = 0; i + ullDropped < ullCount; i++ )
+            pOut[i] = pOut[i + ullDropped];
+
+        return (int)(ullCount - ullDropped);
+    }
+};
+
+typedef struct _SENSOR_ACCUMULATOR_
+{
+    unsigned int uBucket;
+    int nCount;
+    double dMin;
+    double dMax;
+    double dSum;
+    double dLast;
+}SensorAccumulator;
+
+class CSensorSeries
+{
+public:
+    CSensorRing<SensorRawSample, SENSOR_HISTORY_RAW_SIZE>   Raw;
+    CSensorRing<SensorRollup, SENSOR_HISTORY_SECOND_SIZE>   Seconds;
+    CSensorRing<SensorRollup, SENSOR_HISTORY_MINUTE_SIZE>   Minutes;
+    CSensorRing<SensorRollup, SENSOR_HISTORY_HOUR_SIZE>     Hours;
+
+    // Open buckets, producer only
+    SensorAccumulator                                       pAccumulators[SensorResolutionCount];
+};
+
+// Bounded history of every registered sensor. Memory is allocated once by
+// Initialize(), Record() is called by the sampler after each tick and can
+// run concurrently with any number of readers.
+class CSensorHistory
+{
+private:
+    CSensorSeries   *m_pSeries;
+    int             m_nSeries;
+
+    void Accumulate(CSensorSeries *pSeries, SensorResolution Resolution, unsigned long long ullTimestamp, double dValue);
+
+public:
+    CSensorHistory();
+    ~CSensorHistory();
+
+    int Initialize(int nSensors);
+    int Record(const CSensorSamples *pSamples);
+
+    int GetSensorCount() const;
+    int ReadRaw(int nId, SensorRawSample *pOut, int nMax) const;
+    // Closed buckets only, the one being filled is not visible
+    int ReadRollups(int nId, SensorResolution Resolution, SensorRollup *pOut, int nMax) const;
+};
+
+#endif // SENSOR_HISTORY_H
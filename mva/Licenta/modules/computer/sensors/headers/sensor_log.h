@@ -0,0 +1,135 @@
+#ifndef SENSOR_LOG_H
+#define SENSOR_LOG_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef STK_WINDOWS
+#include <Windows.h>
+#endif
+
+#include <QString>
+#include <QVector>
+
+#include "sensor_samples.h"
+
+#define SENSOR_LOG_BLOCK_SIZE           16384       // one series per block, ~3 h at 1 Hz
+#define SENSOR_LOG_MAGIC                0x484B5453  // "STKH"
+#define SENSOR_LOG_VERSION              1
+#define SENSOR_LOG_FLUSH_INTERVAL       30000       // ms, open blocks reach the disk at least this often
+#define SENSOR_LOG_MAX_SAMPLE_BITS      128         // worst case timestamp + value encoding
+
+#define SENSOR_LOG_DATA_FILE            "sensors.dat"
+#define SENSOR_LOG_INDEX_FILE           "sensors.idx"
+#define SENSOR_LOG_CATALOG_FILE         "sensors.cat"
+
+#ifdef STK_WINDOWS
+typedef HANDLE SensorLogFile;
+#define SENSOR_LOG_INVALID_FILE         INVALID_HANDLE_VALUE
+#else
+typedef int SensorLogFile;
+#define SENSOR_LOG_INVALID_FILE         -1
+#endif
+
+// Block layout: header followed by the bit stream. The first timestamp
+// and value are stored raw, then timestamps as delta-of-delta and values
+// XORed with their predecessor.
+typedef struct _SENSOR_LOG_BLOCK_HEADER_
+{
+    unsigned int uMagic;
+    unsigned short usVersion;
+    unsigned short usReserved;
+    int nSensorId;
+    unsigned int uCount;
+    unsigned int uBitCount;
+    unsigned int uPadding;
+    unsigned long long ullFirstTimestamp;   // ms since the Unix epoch
+    unsigned long long ullLastTimestamp;
+}SensorLogBlockHeader;
+
+// Entry N of the index describes block N of the data file
+typedef struct _SENSOR_LOG_INDEX_ENTRY_
+{
+    int nSensorId;
+    unsigned int uCount;
+    unsigned long long ullFirstTimestamp;
+    unsigned long long ullLastTimestamp;
+}SensorLogIndexEntry;
+
+typedef struct _SENSOR_LOG_SAMPLE_
+{
+    unsigned long long ullTimestamp;        // ms since the Unix epoch
+    double dValue;
+}SensorLogSample;
+
+typedef struct _SENSOR_LOG_ENCODER_
+{
+    unsigned int uBlock;
+    unsigned char *pbBlock;
+    unsigned int uBitCount;
+    unsigned int uCount;
+    unsigned long long ullFirstTimestamp;
+    unsigned long long ullLastTimestamp;
+    long long llLastDelta;
+    unsigned long long ullLastValue;
+    int nLeading;
+    int nTrailing;
+    bool bDirty;
+}SensorLogEncoder;
+
+typedef struct _SENSOR_LOG_JOB_
+{
+    unsigned int uBlock;
+    SensorLogIndexEntry Entry;
+    std::vector<unsigned char> qData;
+}SensorLogJob;
+
+// Append only, compressed sensor history on disk. Append() only encodes
+// into in-memory blocks; full blocks and periodic snapshots of open ones
+// are handed to a writer thread, so the sampler never touches the disk.
+class CSensorLog
+{
+private:
+    QString                         m_qsDirectory;
+    SensorLogFile                   m_hDataFile;
+    SensorLogFile                   m_hIndexFile;
+
+    std::vector<SensorLogEncoder>   m_qEncoders;
+    std::vector<unsigned char>      m_qBlocks;
+    unsigned int                    m_uNextBlock;
+    long long                       m_llClockOffset;       // wall clock - SensorTimestamp(), us
+    unsigned long long              m_ullLastFlush;
+
+    std::thread                     m_Writer;
+    std::mutex                      m_Mutex;
+    std::condition_variable         m_Condition;
+    std::deque<SensorLogJob>        m_qJobs;
+    bool                            m_bStop;
+
+    int CheckCatalog(const CSensorSamples *pSamples);
+    void StartBlock(SensorLogEncoder *pEncoder);
+    void Encode(SensorLogEncoder *pEncoder, unsigned long long ullTimestamp, double dValue);
+    void QueueBlock(int nSensorId, SensorLogEncoder *pEncoder);
+    void WriterThread();
+
+public:
+    CSensorLog();
+    ~CSensorLog();
+
+    int Open(const QString &qsDirectory, const CSensorSamples *pSamples);
+    int Append(const CSensorSamples *pSamples);
+    int Close();
+
+    // Reads the index, then maps and decodes only the matching blocks.
+    // Safe to call from any thread while the log is being written.
+    static int Query(const QString &qsDirectory, int nSensorId, unsigned long long ullFrom,
+                     unsigned long long ullTo, QVector<SensorLogSample> &qSamples);
+};
+
+int SensorLogDecodeBlock(const unsigned char *pbBlock, unsigned long long ullFrom,
+                         unsigned long long ullTo, QVector<SensorLogSample> &qSamples);
+
+#endif // SENSOR_LOG_H
@@ -4,6 +4,19 @@
 #include "factory_board_sensor.h"
 #include "factory_cpu_sensor.h"
 #include "hardware_usage.h"
+#include "numa_memory.h"
+#include "rapl_power.h"
+#include "core_frequency.h"
+#include "cpu_times.h"
+#include "disk_performance.h"
+#include "sensor_samples.h"
+#include "sensor_delta.h"
+#include "sensor_history.h"
+#include "sensor_log.h"
+#include "sensor_alarms.h"
+#include "sensor_burst.h"
+#include "sampling_policy.h"
+#include "sensor_exporter.h"
 
 class CSensorModule
 {
@@ -11,21 +24,29 @@ private:
     FactoryBoardSensor *m_pBoardFactory;
     FactoryCpuSensor *m_pCpuFactory;
     CHardwareUsage *m_pHardwareUsage;
+    CNumaMemory *m_pNumaMemory;
+    CRaplPower *m_pRaplPower;
+    CCoreFrequency *m_pCoreFrequency;
+    CCpuTimes *m_pCpuTimes;
+    CDiskPerformance *m_pDiskPerformance;
 
 public:
     CSensorModule();
     ~CSensorModule();
 
-    ISensor *GetBoardSensor();
+    ISensor *GetBoardSensor(const QString &qsCacheDirectory, const QString &qsBoardIdentity);
     ICPUSensor *GetCpuSensor();
 
     int DestroyBoardSensor();
     int DestroyCpuSensor();
 
-    double GetCpuLoad();
     QString GetCpuName();
-    double GetDiskLoad();
-    MemoryStatus* GetMemoryStat();
+    int GetMemoryStat(MemoryStatus *pMemoryStatus);
+    CNumaMemory *GetNumaMemory();
+    CRaplPower *GetRaplPower();
+    CCoreFrequency *GetCoreFrequency();
+    CCpuTimes *GetCpuTimes();
+    CDiskPerformance *GetDiskPerformance();
 };
 
 #endif // SENSOR_MODULE_H
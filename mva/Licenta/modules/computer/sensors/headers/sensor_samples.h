@@ -0,0 +1,130 @@
+#ifndef SENSOR_SAMPLES_H
+#define SENSOR_SAMPLES_H
+
+#include <QString>
+#include <QVector>
+
+#define SENSOR_NAME_SIZE                32
+#define SENSOR_INVALID_ID               -1
+
+typedef enum _SENSOR_GROUP_
+{
+    SensorGroupBoard = 0,
+    SensorGroupCpu,
+    SensorGroupMemory,
+    SensorGroupStorage
+}SensorGroup;
+
+typedef enum _SENSOR_KIND_
+{
+    SensorKindTemperature = 0,
+    SensorKindVoltage,
+    SensorKindFan,
+    SensorKindLoad,
+    SensorKindMemory,
+    SensorKindNuma,
+    SensorKindPower,
+    SensorKindClock,
+    SensorKindResidency,
+    SensorKindThrottle,
+    SensorKindDisk,
+    SensorKindOverhead                  // cost of the tool itself
+}SensorKind;
+
+typedef enum _SENSOR_UNIT_
+{
+    SensorUnitNone = 0,
+    SensorUnitCelsius,
+    SensorUnitVolt,
+    SensorUnitRPM,
+    SensorUnitPercent,
+    SensorUnitBytes,
+    SensorUnitPages,
+    SensorUnitWatt,
+    SensorUnitMHz,
+    SensorUnitBytesPerSecond,
+    SensorUnitIops,
+    SensorUnitMilliseconds,
+    SensorUnitPagesPerSecond
+}SensorUnit;
+
+#define SENSOR_KIND_STRING(X) \
+    X == SensorKindTemperature ? "Temperatures: " : \
+    X == SensorKindVoltage ? "Voltages: " : \
+    X == SensorKindFan ? "Fan speed: " : \
+    X == SensorKindLoad ? "Load: " : \
+    X == SensorKindMemory ? "Data: " : \
+    X == SensorKindNuma ? "NUMA node" : \
+    X == SensorKindPower ? "Power: " : \
+    X == SensorKindClock ? "Clocks: " : \
+    X == SensorKindResidency ? "C0 residency: " : \
+    X == SensorKindThrottle ? "Throttling events: " : \
+    X == SensorKindDisk ? "Disk" : \
+    X == SensorKindOverhead ? "Monitoring overhead: " : \
+    ""
+
+typedef struct _SENSOR_DESCRIPTOR_
+{
+    SensorGroup Group;
+    SensorKind Kind;
+    SensorUnit Unit;
+    int nInstance;                      // e.g. NUMA node, -1 when not applicable
+    char szName[SENSOR_NAME_SIZE];
+}SensorDescriptor;
+
+// Typed readings of every sensor, one slot per sensor ID. Descriptors are
+// registered once, values and timestamps live in parallel flat arrays that
+// are overwritten in place on every tick. The IDs whose value moved since
+// BeginUpdate() are collected, so consumers can skip the unchanged ones.
+class CSensorSamples
+{
+private:
+    QVector<SensorDescriptor>       m_qDescriptors;
+    QVector<double>                 m_qValues;
+    QVector<unsigned long long>     m_qTimestamps;
+    QVector<char>                   m_qChangedFlags;
+    QVector<int>                    m_qChanged;
+
+public:
+    CSensorSamples();
+    ~CSensorSamples();
+
+    int Register(SensorGroup Group, SensorKind Kind, SensorUnit Unit, const char *pszName, int nInstance = -1);
+    void Clear();
+
+    inline void Set(int nId, double dValue, unsigned long long ullTimestamp)
+    {
+        double dLast = m_qValues[nId];
+
+        // NaN never compares equal, NaN followed by NaN is not a change
+        if( dLast != dValue && (dLast == dLast || dValue == dValue) && !m_qChangedFlags[nId] )
+        {
+            m_qChangedFlags[nId] = 1;
+            m_qChanged.append(nId);
+        }
+
+        m_qValues[nId] = dValue;
+        m_qTimestamps[nId] = ullTimestamp;
+    }
+
+    // Starts a new tick, forgets the changes of the previous one
+    void BeginUpdate();
+
+    int GetCount() const;
+    const SensorDescriptor *GetDescriptors() const;
+    const double *GetValues() const;
+    const unsigned long long *GetTimestamps() const;
+    int GetChangedCount() const;
+    const int *GetChanged() const;
+};
+
+// Monotonic clock, microseconds
+unsigned long long SensorTimestamp();
+
+// Name without the display separator, e.g. "Core #1" for "Core #1: "
+QString SensorShortName(const char *pszName);
+
+// Display time formatting, e.g. "45.0C", "1.225V", "1200.0RPM"
+QString SensorFormatValue(double dValue, SensorUnit Unit);
+
+#endif // SENSOR_SAMPLES_H
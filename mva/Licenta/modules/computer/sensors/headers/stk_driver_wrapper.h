@@ -20,6 +20,12 @@ public:
 
     int ReadMsr(ULONG ulIndex, ULONG *ulEAX, ULONG *ulEDX);
     int WriteMsr(ULONG ulIndex, ULONG ulEAX, ULONG ulEDX);
+    // One value per system wide processor index, read by the driver on
+    // every processor in a single call
+    int ReadMsrAllProcessors(ULONG ulIndex, ULONGLONG *pValues, int nCount);
+    // Several registers in the same pass, pValues[processor * nIndexes + register]
+    int ReadMsrAllProcessors(const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues, int nCount);
+    int WriteMsrAllProcessors(ULONG ulIndex, ULONG ulEAX, ULONG ulEDX);
 
     int ReadIoPortByte(ULONG ulPort, BYTE *bValue);
     int WriteIoPortByte(ULONG ulPort, BYTE bValue);
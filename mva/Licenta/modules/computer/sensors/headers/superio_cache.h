@@ -0,0 +1,55 @@
+#ifndef SUPERIO_CACHE_H
+#define SUPERIO_CACHE_H
+
+#include <QString>
+#include <QVector>
+
+#include "superio_descriptors.h"
+
+#define SUPERIO_CACHE_MAGIC             0x4F495353  // "SSIO"
+#define SUPERIO_CACHE_VERSION           1           // bump when the descriptor tables change
+
+// Result of a cold probe. eChip is Unknown_Chip when no supported chip
+// answered on any configuration port.
+typedef struct _SUPERIO_DETECTION_
+{
+    unsigned int uFamily;
+    unsigned int uChip;
+    unsigned short usChipId;
+    unsigned short usAddress;
+    unsigned char bRevision;
+    unsigned char bReserved[3];
+}SuperIODetection;
+
+// One record per baseboard, the checksum covers every other field
+typedef struct _SUPERIO_CACHE_RECORD_
+{
+    unsigned int uMagic;
+    unsigned int uVersion;
+    unsigned int uBoard;                // FNV-1a of the SMBIOS baseboard identity
+    unsigned int uChecksum;
+    SuperIODetection Detection;
+}SuperIOCacheRecord;
+
+// Detection results of the boards this installation has run on, so a warm
+// start only has to confirm the chip instead of probing every vendor. Only
+// found chips are kept, a board without one is probed on every start.
+class CSuperIODetectionCache
+{
+private:
+    QString m_qsFile;
+    QVector<SuperIOCacheRecord> m_qRecords;
+
+    static unsigned int Hash(const void *pData, int nSize, unsigned int uHash);
+    static unsigned int Checksum(const SuperIOCacheRecord *pRecord);
+
+public:
+    int Load(const QString &qsFile);
+    int Save();
+
+    bool Find(const QString &qsBoardIdentity, SuperIODetection *pDetection);
+    void Store(const QString &qsBoardIdentity, const SuperIODetection *pDetection);
+    void Remove(const QString &qsBoardIdentity);
+};
+
+#endif // SUPERIO_CACHE_H
@@ -0,0 +1,153 @@
+#ifndef SUPERIO_DESCRIPTORS_H
+#define SUPERIO_DESCRIPTORS_H
+
+#include <Windows.h>
+
+#include "sensor_defines.h"
+
+#define SUPERIO_MAX_VOLTAGES                    10
+#define SUPERIO_MAX_TEMPS                       3
+#define SUPERIO_MAX_FANS                        5
+#define SUPERIO_MAX_DIVISOR_BITS                3
+
+#define SUPERIO_ADDRESS_REGISTER_OFFSET         0x05
+#define SUPERIO_DATA_REGISTER_OFFSET            0x06
+#define SUPERIO_WINBOND_BANK_SELECT_REGISTER    0x4E
+
+#define SUPERIO_BASE_ADDRESS_REGISTER           0x60
+#define SUPERIO_CHIP_ID_REGISTER                0x20
+#define SUPERIO_CHIP_REVISION_REGISTER          0x21
+#define SUPERIO_LOGICAL_DEVICE_REGISTER         0x07
+
+// Hardware monitor registers are addressed as bank << 8 | register,
+// chips without banks only use bank 0
+#define SUPERIO_REGISTER(bank, reg)             ((USHORT)(((bank) << 8) | (reg)))
+#define SUPERIO_REGISTER_BANK(X)                ((BYTE)((X) >> 8))
+#define SUPERIO_REGISTER_OFFSET(X)              ((BYTE)((X) & 0xFF))
+#define SUPERIO_NO_REGISTER                     0xFFFF
+
+typedef enum _SUPERIO_FAMILY_
+{
+    SuperIOIte = 0,
+    SuperIOWinbond = 1,
+    SuperIOFintek = 2
+}SuperIOFamily;
+
+typedef enum _SUPERIO_BANK_SCHEME_
+{
+    SuperIONoBank = 0,
+    SuperIOWinbondBank = 1              // bank number written to register 0x4E
+}SuperIOBankScheme;
+
+typedef enum _SUPERIO_TEMP_FORMAT_
+{
+    SuperIOTempByte = 0,                // unsigned degrees
+    SuperIOTempSignedByte = 1,          // signed degrees
+    SuperIOTempHalfDegree = 2,          // signed degrees, bit 7 of register + 1 adds 0.5
+    SuperIOTempFintek11Bit = 3          // F71858 fixed point, register + 1 holds the fraction
+}SuperIOTempFormat;
+
+// Holds when (register & mask) == value. A zero mask means "no condition".
+typedef struct _SUPERIO_CONDITION_
+{
+    USHORT usRegister;
+    BYTE bMask;
+    BYTE bValue;
+}SuperIOCondition;
+
+typedef struct _SUPERIO_BIT_
+{
+    USHORT usRegister;
+    BYTE bBit;
+}SuperIOBit;
+
+// value = raw * scale + offset, or the alternate pair when Alternate holds.
+// Present and Alternate are evaluated once when the sensor is initialized.
+typedef struct _SUPERIO_VOLTAGE_CHANNEL_
+{
+    const char *szName;
+    USHORT usRegister;                  // SUPERIO_NO_REGISTER for an unconnected input
+    double dScale;
+    double dOffset;
+    SuperIOCondition Present;
+    SuperIOCondition Alternate;
+    double dAltScale;
+    double dAltOffset;
+}SuperIOVoltageChannel;
+
+typedef struct _SUPERIO_TEMP_CHANNEL_
+{
+    USHORT usRegister;
+    SuperIOTempFormat eFormat;
+    double dMin;                        // readings outside [dMin, dMax] are reported as NaN
+    double dMax;
+    SuperIOCondition Present;
+}SuperIOTempChannel;
+
+// rpm = fan clock / (count * (base divisor << divisor bits))
+typedef struct _SUPERIO_FAN_CHANNEL_
+{
+    USHORT usCountLow;
+    USHORT usCountHigh;                 // SUPERIO_NO_REGISTER for 8-bit counters
+    BYTE bBaseDivisor;
+    BYTE bDivisorBits;
+    SuperIOBit DivisorBits[SUPERIO_MAX_DIVISOR_BITS];   // least significant first
+}SuperIOFanChannel;
+
+typedef struct _SUPERIO_CHIP_DESCRIPTOR_
+{
+    Chip eChip;
+    const char *szName;
+    SuperIOBankScheme eBankScheme;
+    SuperIOCondition Identify[2];       // checked against the hardware monitor before use
+
+    const SuperIOVoltageChannel *pVoltages;
+    int nVoltages;
+
+    const SuperIOTempChannel *pTemps;
+    int nTemps;
+    USHORT usTempMode;                  // table mode register of SuperIOTempFintek11Bit
+
+    const SuperIOFanChannel *pFans;
+    int nFans;
+    double dFanClock;
+    USHORT usFanMinCount;               // counts outside the range read as 0 rpm
+    USHORT usFanMaxCount;
+    bool bAdjustFanDivisor;             // move the divisor to keep the count in 96..192
+}SuperIOChipDescriptor;
+
+// Maps the configuration space ID of a chip to its descriptor
+typedef struct _SUPERIO_CHIP_ID_
+{
+    SuperIOFamily eFamily;
+    USHORT usId;                        // ID byte, or ID word for families with bWordId
+    BYTE bRevisionMask;
+    BYTE bRevision;
+    BYTE bLogicalDevice;                // hardware monitor logical device
+    BYTE bGpioDevice;                   // 0 when the GPIO base is not verified
+    BYTE bGpioRegister;
+    Chip eChip;
+}SuperIOChipId;
+
+// How to enter, identify and leave the configuration space of a vendor
+typedef struct _SUPERIO_FAMILY_DESCRIPTOR_
+{
+    SuperIOFamily eFamily;
+    BYTE bRegisterPort;
+    BYTE bValuePort;
+    BYTE pbEnterKey[4];
+    int nEnterKey;
+    BYTE bExitRegister;
+    BYTE bExitValue;
+    bool bExitWithValue;                // false: bExitRegister is the whole exit key
+    bool bWordId;                       // chip ID spans registers 0x20 and 0x21
+    USHORT usVendorRegister;            // 0 when the vendor is not checked
+    USHORT usVendorId;
+    bool bMaskAddressOffset;            // base address may already include the +5 offset
+}SuperIOFamilyDescriptor;
+
+const SuperIOFamilyDescriptor *SuperIOGetFamilies(int *pnCount);
+const SuperIOChipId *SuperIOFindChipId(SuperIOFamily eFamily, USHORT usId, BYTE bRevision);
+const SuperIOChipDescriptor *SuperIOFindChip(Chip eChip);
+
+#endif // SUPERIO_DESCRIPTORS_H
@@ -0,0 +1,85 @@
+#ifndef SUPERIO_SENSOR_H
+#define SUPERIO_SENSOR_H
+
+#include <vector>
+
+#include "sensor_defines.h"
+#include "superio_descriptors.h"
+#include "stk_driver_wrapper.h"
+#include "../interfaces/isensor.h"
+#include "../../../../utils/headers/utils.h"
+
+// Channel as compiled into the read plan, indexes point into m_qValues.
+// -1 marks a channel that is not sampled.
+typedef struct _SUPERIO_VOLTAGE_SLOT_
+{
+    int nIndex;
+    double dScale;
+    double dOffset;
+}SuperIOVoltageSlot;
+
+typedef struct _SUPERIO_TEMP_SLOT_
+{
+    int nIndex;
+    int nFraction;
+}SuperIOTempSlot;
+
+typedef struct _SUPERIO_FAN_SLOT_
+{
+    int nLow;
+    int nHigh;
+    int pnDivisor[SUPERIO_MAX_DIVISOR_BITS];
+}SuperIOFanSlot;
+
+// One sampler for every chip in superio_descriptors.cpp. Initialize()
+// resolves the static configuration of the board once and compiles the
+// remaining registers into a sorted, de-duplicated read plan, so Update()
+// only touches each register (and each bank) once per tick.
+class CSuperIOSensor : public ISensor
+{
+private:
+    const SuperIOChipDescriptor *m_pChip;
+    USHORT m_usAddress;
+    CRing0Wrapper *m_pDriver;
+
+    std::vector<SensorChannel> m_qChannels;
+
+    SuperIOVoltageSlot m_pVoltageSlots[SUPERIO_MAX_VOLTAGES];
+    SuperIOTempSlot m_pTempSlots[SUPERIO_MAX_TEMPS];
+    SuperIOFanSlot m_pFanSlots[SUPERIO_MAX_FANS];
+    int m_nTempMode;
+
+    std::vector<USHORT> m_qPlan;
+    std::vector<BYTE> m_qValues;
+    int m_nBank;
+
+    int SelectBank(BYTE bBank);
+    int ReadRegister(USHORT usRegister, BYTE *pbValue);
+    int WriteRegister(USHORT usRegister, BYTE bValue);
+    int CheckCondition(const SuperIOCondition *pCondition, bool *pbHolds);
+
+    void AddToPlan(USHORT usRegister);
+    int PlanIndex(int nRegister);
+    int BuildPlan();
+    void AddChannel(SensorKind Kind, SensorUnit Unit, const char *pszLabel);
+
+    bool DecodeTemp(int nChannel, double *pdValue);
+    int AdjustFanDivisors();
+
+public:
+    CSuperIOSensor(const SuperIOChipDescriptor *pChip, USHORT usAddress);
+    virtual ~CSuperIOSensor();
+
+    // Single read of the first identification register, used to confirm a
+    // cached detection without entering the configuration space
+    int Validate();
+
+    virtual int Initialize();
+    virtual int Destroy();
+    virtual int GetChannelCount();
+    virtual const SensorChannel* GetChannels();
+    virtual int Update(double *pValues);
+    virtual QString GetChipName();
+};
+
+#endif // SUPERIO_SENSOR_H
@@ -0,0 +1,97 @@
+#ifndef THERMAL_THROTTLE_H
+#define THERMAL_THROTTLE_H
+
+#include "../../../../utils/headers/utils.h"
+
+#define IA32_PACKAGE_THERM_STATUS       0x01B1
+
+// Status bits of IA32_THERM_STATUS and IA32_PACKAGE_THERM_STATUS, each one
+// has its sticky log bit right above it. Log bits are cleared by writing 0,
+// writing 1 leaves them alone, a reserved bit must be written as 0.
+#define THERM_STATUS_THERMAL            0x0001
+#define THERM_STATUS_PROCHOT            0x0004
+#define THERM_STATUS_CRITICAL           0x0010
+#define THERM_STATUS_POWER_LIMIT        0x0400
+#define THERM_STATUS_LOG_MASK           0x002A      // thermal, PROCHOT and critical logs
+#define THERM_STATUS_POWER_LIMIT_LOG    0x0800      // only with CPUID.06H:EAX[4] (PLN)
+
+// Logs of other users of the registers, written back as 1: the threshold
+// #1 and #2 logs, and on the cores the current and cross domain limit logs
+// that come with CPUID.06H:EAX[7]
+#define THERM_STATUS_THRESHOLD_LOGS     0x0280
+#define THERM_STATUS_LIMIT_LOGS         0xA000
+
+#define CPUID_06_EAX_PLN                0x0010
+#define CPUID_06_EAX_HWP                0x0080
+
+typedef enum _THROTTLE_REASON_
+{
+    ThrottleReasonThermal = 0,
+    ThrottleReasonProchot,
+    ThrottleReasonCritical,
+    ThrottleReasonPowerLimit,
+    ThrottleReasonCount
+}ThrottleReason;
+
+#define THROTTLE_REASON_MASK(X) \
+    (X == ThrottleReasonThermal ? THERM_STATUS_THERMAL : \
+     X == ThrottleReasonProchot ? THERM_STATUS_PROCHOT : \
+     X == ThrottleReasonCritical ? THERM_STATUS_CRITICAL : \
+     THERM_STATUS_POWER_LIMIT)
+
+#define THROTTLE_REASON_STRING(X) \
+    X == ThrottleReasonThermal ? "Thermal: " : \
+    X == ThrottleReasonProchot ? "PROCHOT: " : \
+    X == ThrottleReasonCritical ? "Critical: " : \
+    X == ThrottleReasonPowerLimit ? "Power limit: " : \
+    ""
+
+typedef struct _THROTTLE_COUNTER_
+{
+    unsigned int pEvents[ThrottleReasonCount];  // transitions into the state since start
+    bool pActive[ThrottleReasonCount];
+    unsigned long long ullLastEvent;            // SensorTimestamp() of the latest transition
+}ThrottleCounter;
+
+// Turns raw thermal status MSR values into per core and package event
+// counts. A transition is a rising status bit, or a log bit set while the
+// status is clear (the event started and ended between two samples).
+// The caller clears the returned log bits so the next short event is seen.
+class CThermalThrottle
+{
+private:
+    ThrottleCounter     *m_pCores;
+    int                 m_nCores;
+    ThrottleCounter     m_Package;
+    bool                m_bBaseline;
+    unsigned long       m_ulLogMask;            // log bits of the tracked reasons
+    unsigned long       m_ulCoreKeep;           // log bits of others, per register
+    unsigned long       m_ulPackageKeep;
+
+    void Track(ThrottleCounter *pCounter, unsigned long long ullStatus, unsigned long long ullTimestamp);
+
+public:
+    CThermalThrottle();
+    ~CThermalThrottle();
+
+    // ulCpuidThermal is CPUID.06H:EAX, it tells which log bits exist
+    int Initialize(int nCores, unsigned long ulCpuidThermal);
+
+    // pValues[core * nStride] is IA32_THERM_STATUS, pValues[core * nStride + 1]
+    // IA32_PACKAGE_THERM_STATUS when nStride is 2. The log bits seen on any
+    // core are returned in pulCoreLogs / pulPackageLogs.
+    int Record(const unsigned long long *pValues, int nStride, unsigned long long ullTimestamp,
+               unsigned long *pulCoreLogs, unsigned long *pulPackageLogs);
+
+    // Values to write to IA32_THERM_STATUS and IA32_PACKAGE_THERM_STATUS
+    // that clear the given tracked logs and no other bit
+    unsigned long GetCoreClear(unsigned long ulLogs);
+    unsigned long GetPackageClear(unsigned long ulLogs);
+
+    int GetCoreCount();
+    const ThrottleCounter *GetCores();
+    const ThrottleCounter *GetPackage();
+    unsigned int GetCoreEvents(int nCore);
+};
+
+#endif // THERMAL_THROTTLE_H
@@ -7,13 +7,16 @@ public:
     virtual ~ISensor() {}
     virtual int Initialize() = 0;
     virtual int Destroy() = 0;
-    virtual int Update() = 0;
-    virtual double* GetTemps() = 0;
-    virtual double* GetFanSpeeds() = 0;
-    virtual VoltageReading* GetVoltages() = 0;
+    virtual int GetChannelCount() = 0;
+    virtual const SensorChannel* GetChannels() = 0;
+    // pValues holds GetChannelCount() entries, NaN for a reading the chip
+    // returned out of range
+    virtual int Update(double *pValues) = 0;
     virtual QString GetChipName() = 0;
 };
 
+class CThermalThrottle;
+
 class ICPUSensor
 {
 public:
@@ -26,6 +29,8 @@ public:
     virtual QString GetMicroArchitecture() = 0;
     virtual int GetNumberOfCores() = 0;
     virtual int GetMultiplier() = 0;
+    // NULL when the CPU does not report throttling
+    virtual CThermalThrottle* GetThermalThrottle() = 0;
 };
 
 #endif
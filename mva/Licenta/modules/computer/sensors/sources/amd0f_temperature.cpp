@@ -1,5 +1,7 @@
 #include "../headers/amd0f_temperature.h"
 
+#include "../../../../utils/headers/self_profile.h"
+
 CAmd0FCpuSensor::CAmd0FCpuSensor(int nFamily, int nModel, int nStepping, int nCoreCount):
     m_pDriver(NULL)
 {
@@ -76,6 +78,8 @@ int CAmd0FCpuSensor::Destroy()
 
 int CAmd0FCpuSensor::Update()
 {    
+    STK_PROFILE_SCOPE(ProfileModuleCpuTemperature);
+
     int nStatus = Uninitialized;
     UINT unAddress = AMD_INVALID_ADDRESS;
     ULONG unTempValue = 0;
@@ -132,3 +136,8 @@ int CAmd0FCpuSensor::GetMultiplier()
 {
     return 0;
 }
+
+CThermalThrottle *CAmd0FCpuSensor::GetThermalThrottle()
+{
+    return NULL;
+}
@@ -1,5 +1,7 @@
 #include "../headers/amd10_temperature.h"
 
+#include "../../../../utils/headers/self_profile.h"
+
 UINT CAmd10CpuSensor::GetControllAddress(int nFunction, USHORT usDeviceID)
 {
     UINT unAddress = 0;
@@ -96,55 +98,45 @@ int CAmd10CpuSensor::Destroy()
 
 int CAmd10CpuSensor::Update()
 {
-    BOOL bResult = FALSE;
-    DWORD_PTR dwProcAffinityMask = 0;
-    DWORD_PTR dwSysAffinityMask = 0;
-    DWORD_PTR dwCurrentMask = 1;
+    STK_PROFILE_SCOPE(ProfileModuleCpuTemperature);
 
     ULONG ulValue = 0;
     int nStatus = Uninitialized;
+    double dTemp = 0;
 
-    bResult = GetProcessAffinityMask(GetCurrentProcess(), &dwProcAffinityMask, &dwSysAffinityMask);
-    if( FALSE == bResult )
+    if( m_uiControlAddress == AMD_INVALID_ADDRESS )
         return Unsuccessful;
 
-    for(int i = 0; i < m_nCoreCount; i++)
-    {
-        dwCurrentMask = (DWORD_PTR)1 << i;
-
-        SetProcessAffinityMask(GetCurrentProcess(), dwCurrentMask);
-
-        if( m_uiControlAddress == AMD_INVALID_ADDRESS )
-            return Unsuccessful;
+    // The reported temperature lives in the northbridge PCI function, it
+    // reads the same from any core, so one read serves all of them
+    nStatus = m_pDriver->ReadPCIConfiguration(m_uiControlAddress,
+                                              REPORTED_TEMPERATURE_CONTROL_REGISTER,
+                                              &ulValue);
+    CHECK_OPERATION_STATUS_EX(nStatus);
 
-        nStatus = m_pDriver->ReadPCIConfiguration(m_uiControlAddress,
-                                                  REPORTED_TEMPERATURE_CONTROL_REGISTER,
-                                                  &ulValue);
-        CHECK_OPERATION_STATUS_EX(nStatus);
-
-        if( m_nFamily == 0x15 && (ulValue & 0x30000) == 0x30000 )
-        {
-            if( (m_nModel & 0xF0) == 0x00 )
-            {
-                m_pTemps[i] = ((ulValue >> 21) & 0x7FC) / 8.0f - 49; // 49 is temperature offset
-                                                                        // specific for AMD
-            }
-            else
-            {
-                m_pTemps[i] = ((ulValue >> 21) & 0x7FF) / 8.0f - 49;
-            }
-        }
-        else if( m_nFamily = 0x16 && ((ulValue & 0x30000) == 0x30000 || (ulValue & 0x80000) == 0x80000) )
+    if( m_nFamily == 0x15 && (ulValue & 0x30000) == 0x30000 )
+    {
+        if( (m_nModel & 0xF0) == 0x00 )
         {
-            m_pTemps[i] = ((ulValue >> 21) & 0x7FF) / 8.0f - 49;
+            dTemp = ((ulValue >> 21) & 0x7FC) / 8.0f - 49; // 49 is temperature offset
+                                                          // specific for AMD
         }
         else
         {
-            m_pTemps[i] = ((ulValue >> 21) & 0x7FF) / 8.0f;
+            dTemp = ((ulValue >> 21) & 0x7FF) / 8.0f - 49;
         }
     }
+    else if( m_nFamily == 0x16 && ((ulValue & 0x30000) == 0x30000 || (ulValue & 0x80000) == 0x80000) )
+    {
+        dTemp = ((ulValue >> 21) & 0x7FF) / 8.0f - 49;
+    }
+    else
+    {
+        dTemp = ((ulValue >> 21) & 0x7FF) / 8.0f;
+    }
 
-    SetProcessAffinityMask(GetCurrentProcess(), dwProcAffinityMask);
+    for(int i = 0; i < m_nCoreCount; i++)
+        m_pTemps[i] = dTemp;
 
     return Success;
 }
@@ -173,3 +165,8 @@ int CAmd10CpuSensor::GetMultiplier()
 {
     return 0;
 }
+
+CThermalThrottle *CAmd10CpuSensor::GetThermalThrottle()
+{
+    return NULL;
+}
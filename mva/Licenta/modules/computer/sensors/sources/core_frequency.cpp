@@ -0,0 +1,158 @@
+#include "../headers/core_frequency.h"
+
+#include "../../../../utils/headers/self_profile.h"
+
+#ifdef STK_WINDOWS
+static const ULONG g_pFrequencyMsrs[CORE_FREQUENCY_MSR_COUNT] = { IA32_TIME_STAMP_COUNTER, IA32_MPERF, IA32_APERF };
+#endif
+
+CCoreFrequency::CCoreFrequency():
+    m_pCores( NULL ),
+    m_nCores( 0 ),
+    m_dTscFrequency( 0 ),
+    m_ullTimestamp( 0 )
+#ifdef STK_WINDOWS
+    , m_pDriver( NULL ),
+    m_pTopology( NULL ),
+    m_pPrevious( NULL ),
+    m_pCurrent( NULL )
+#endif
+{
+
+}
+
+CCoreFrequency::~CCoreFrequency()
+{
+    delete[] m_pCores;
+    m_pCores = NULL;
+
+#ifdef STK_WINDOWS
+    delete[] m_pPrevious;
+    m_pPrevious = NULL;
+    delete[] m_pCurrent;
+    m_pCurrent = NULL;
+    SAFE_DELETE(m_pTopology);
+
+    if( m_pDriver )
+    {
+        int nStatus = m_pDriver->Destroy();
+        CHECK_OPERATION_STATUS(nStatus);
+        SAFE_DELETE(m_pDriver);
+    }
+#endif
+}
+
+int CCoreFrequency::GetCoreCount()
+{
+    return m_nCores;
+}
+
+const CoreFrequency *CCoreFrequency::GetCores()
+{
+    return m_pCores;
+}
+
+double CCoreFrequency::GetTscFrequency()
+{
+    return m_dTscFrequency;
+}
+
+#ifdef STK_WINDOWS
+int CCoreFrequency::Initialize()
+{
+    int CPUIDINF[4];
+    int nStatus = Uninitialized;
+
+    // CPUID.06H:ECX[0], hardware coordination feedback (APERF/MPERF)
+    __cpuid(CPUIDINF, 0);
+    if( 6 > CPUIDINF[0] )
+        return Unsuccessful;
+    __cpuid(CPUIDINF, 6);
+    if( !(CPUIDINF[2] & 1) )
+        return Unsuccessful;
+
+    m_pDriver = new CRing0Wrapper;
+    CHECK_ALLOCATION_STATUS(m_pDriver);
+
+    nStatus = m_pDriver->Initialize();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    m_pTopology = new CCpuTopology;
+    CHECK_ALLOCATION_STATUS(m_pTopology);
+
+    nStatus = m_pTopology->Initialize();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    int nCores = m_pTopology->GetCoreCount();
+    m_pPrevious = new ULONGLONG[nCores * CORE_FREQUENCY_MSR_COUNT];
+    CHECK_ALLOCATION_STATUS(m_pPrevious);
+    m_pCurrent = new ULONGLONG[nCores * CORE_FREQUENCY_MSR_COUNT];
+    CHECK_ALLOCATION_STATUS(m_pCurrent);
+    m_pCores = new CoreFrequency[nCores];
+    CHECK_ALLOCATION_STATUS(m_pCores);
+    memset(m_pCores, 0, nCores * sizeof(CoreFrequency));
+
+    // Baseline for the first interval
+    nStatus = m_pTopology->ReadCoreMsrs(m_pDriver, g_pFrequencyMsrs, CORE_FREQUENCY_MSR_COUNT, m_pPrevious);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    m_ullTimestamp = SensorTimestamp();
+    m_nCores = nCores;
+
+    return Success;
+}
+
+int CCoreFrequency::Update()
+{
+    STK_PROFILE_SCOPE(ProfileModuleCoreFrequency);
+
+    if( 0 == m_nCores )
+        return Uninitialized;
+
+    int nStatus = m_pTopology->ReadCoreMsrs(m_pDriver, g_pFrequencyMsrs, CORE_FREQUENCY_MSR_COUNT, m_pCurrent);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    unsigned long long ullNow = SensorTimestamp();
+    unsigned long long ullElapsed = ullNow - m_ullTimestamp;
+    m_ullTimestamp = ullNow;
+    if( 0 == ullElapsed )
+        return Unsuccessful;
+
+    // The TSC runs at the nominal clock, ticks per microsecond is MHz
+    m_dTscFrequency = (double)(m_pCurrent[0] - m_pPrevious[0]) / ullElapsed;
+
+    for( int i = 0; i < m_nCores; i++ )
+    {
+        const ULONGLONG *pCurrent = &m_pCurrent[i * CORE_FREQUENCY_MSR_COUNT];
+        const ULONGLONG *pPrevious = &m_pPrevious[i * CORE_FREQUENCY_MSR_COUNT];
+
+        // Unsigned differences survive one wrap of the 64 bit counters
+        ULONGLONG ullTsc = pCurrent[0] - pPrevious[0];
+        ULONGLONG ullMperf = pCurrent[1] - pPrevious[1];
+        ULONGLONG ullAperf = pCurrent[2] - pPrevious[2];
+
+        // MPERF counts at the TSC rate while in C0, APERF at the actual clock
+        m_pCores[i].dEffective = ullMperf ? m_dTscFrequency * ullAperf / ullMperf : 0;
+        m_pCores[i].dResidency = ullTsc ? 100.0 * ullMperf / ullTsc : 0;
+        if( 100 < m_pCores[i].dResidency )
+            m_pCores[i].dResidency = 100;
+    }
+
+    ULONGLONG *pSwap = m_pPrevious;
+    m_pPrevious = m_pCurrent;
+    m_pCurrent = pSwap;
+
+    return Success;
+}
+#else
+int CCoreFrequency::Initialize()
+{
+    // Needs the ring0 driver
+    return Unsuccessful;
+}
+
+int CCoreFrequency::Update()
+{
+    return Uninitialized;
+}
+#endif
@@ -0,0 +1,342 @@
+#include "../headers/cpu_times.h"
+
+#ifndef STK_WINDOWS
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+#include "../../../../utils/headers/self_profile.h"
+
+CCpuTimes::CCpuTimes():
+    m_pCpus( NULL ),
+    m_nCpus( 0 ),
+    m_pPrevious( NULL ),
+    m_pCurrent( NULL )
+#ifdef STK_WINDOWS
+    , m_pfnQuery( NULL ),
+    m_pfnQueryEx( NULL ),
+    m_pPerformance( NULL ),
+    m_wGroups( 0 ),
+    m_pGroupCpus( NULL )
+#else
+    , m_nStatFile( -1 ),
+    m_pszBuffer( NULL ),
+    m_nBufferSize( 0 )
+#endif
+{
+    memset(&m_Total, 0, sizeof(m_Total));
+}
+
+CCpuTimes::~CCpuTimes()
+{
+    delete[] m_pCpus;
+    m_pCpus = NULL;
+    delete[] m_pPrevious;
+    m_pPrevious = NULL;
+    delete[] m_pCurrent;
+    m_pCurrent = NULL;
+
+#ifdef STK_WINDOWS
+    delete[] m_pPerformance;
+    m_pPerformance = NULL;
+    delete[] m_pGroupCpus;
+    m_pGroupCpus = NULL;
+#else
+    if( 0 <= m_nStatFile )
+        close(m_nStatFile);
+    delete[] m_pszBuffer;
+    m_pszBuffer = NULL;
+#endif
+}
+
+int CCpuTimes::GetCpuCount()
+{
+    return m_nCpus;
+}
+
+const CpuTimes *CCpuTimes::GetCpus()
+{
+    return m_pCpus;
+}
+
+const CpuTimes *CCpuTimes::GetTotal()
+{
+    return &m_Total;
+}
+
+double CCpuTimes::GetLoad()
+{
+    return m_Total.pPercent[CpuTimeUser] + m_Total.pPercent[CpuTimeSystem] + m_Total.pPercent[CpuTimeIrq];
+}
+
+void CCpuTimes::Compute(const unsigned long long *pCurrent, const unsigned long long *pPrevious, CpuTimes *pTimes)
+{
+    unsigned long long pDeltas[CpuTimeStateCount];
+    unsigned long long ullTotal = 0;
+
+    for(int i = 0; i < CpuTimeStateCount; i++)
+    {
+        // an offline CPU keeps its last ticks, a counter that went back is a reset
+        pDeltas[i] = pCurrent[i] >= pPrevious[i] ? pCurrent[i] - pPrevious[i] : 0;
+        ullTotal += pDeltas[i];
+    }
+
+    for(int i = 0; i < CpuTimeStateCount; i++)
+        pTimes->pPercent[i] = ullTotal ? 100.0 * pDeltas[i] / ullTotal : 0;
+}
+
+int CCpuTimes::Update()
+{
+    STK_PROFILE_SCOPE(ProfileModuleCpuTimes);
+
+    if( 0 == m_nCpus )
+        return Uninitialized;
+
+    int nStatus = ReadTicks(m_pCurrent);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    for(int i = 0; i < m_nCpus; i++)
+        Compute(&m_pCurrent[i * CpuTimeStateCount], &m_pPrevious[i * CpuTimeStateCount], &m_pCpus[i]);
+    Compute(&m_pCurrent[m_nCpus * CpuTimeStateCount], &m_pPrevious[m_nCpus * CpuTimeStateCount], &m_Total);
+
+    unsigned long long *pSwap = m_pPrevious;
+    m_pPrevious = m_pCurrent;
+    m_pCurrent = pSwap;
+
+    return Success;
+}
+
+#ifdef STK_WINDOWS
+int CCpuTimes::Initialize()
+{
+    SYSTEM_INFO SystemInfo;
+    int nCpus = 0;
+
+    // Exported by every NT version, there is just no import library for it
+    m_pfnQuery = (LPFN_NTQUERYSYSTEMINFORMATION) GetProcAddress(GetModuleHandle(TEXT("ntdll")), "NtQuerySystemInformation");
+    CHECK_ALLOCATION_STATUS(m_pfnQuery);
+    m_pfnQueryEx = (LPFN_NTQUERYSYSTEMINFORMATIONEX) GetProcAddress(GetModuleHandle(TEXT("ntdll")), "NtQuerySystemInformationEx");
+
+    // Before Windows 7 there is a single group of at most 64 processors
+    GetSystemInfo(&SystemInfo);
+    m_wGroups = m_pfnQueryEx ? GetActiveProcessorGroupCount() : 1;
+    if( 0 == m_wGroups )
+        return Unsuccessful;
+
+    m_pGroupCpus = new int[m_wGroups];
+    CHECK_ALLOCATION_STATUS(m_pGroupCpus);
+
+    // GetActiveProcessorCount(ALL_PROCESSOR_GROUPS) group by group, the
+    // buffer then matches what the queries below fill
+    for(WORD i = 0; i < m_wGroups; i++)
+    {
+        m_pGroupCpus[i] = m_pfnQueryEx ? (int)GetActiveProcessorCount(i) : (int)SystemInfo.dwNumberOfProcessors;
+        nCpus += m_pGroupCpus[i];
+    }
+    if( 0 >= nCpus )
+        return Unsuccessful;
+
+    m_pPerformance = new CpuTimesPerformance[nCpus];
+    CHECK_ALLOCATION_STATUS(m_pPerformance);
+    m_pCpus = new CpuTimes[nCpus];
+    CHECK_ALLOCATION_STATUS(m_pCpus);
+    memset(m_pCpus, 0, nCpus * sizeof(CpuTimes));
+    m_pPrevious = new unsigned long long[(nCpus + 1) * CpuTimeStateCount];
+    CHECK_ALLOCATION_STATUS(m_pPrevious);
+    m_pCurrent = new unsigned long long[(nCpus + 1) * CpuTimeStateCount];
+    CHECK_ALLOCATION_STATUS(m_pCurrent);
+
+    m_nCpus = nCpus;
+
+    // Baseline for the first interval
+    int nStatus = ReadTicks(m_pPrevious);
+    if( Success != nStatus )
+        m_nCpus = 0;
+
+    return nStatus;
+}
+
+int CCpuTimes::ReadTicks(unsigned long long *pTicks)
+{
+    ULONG ulLength = 0;
+    int nCpus = 0;
+
+    unsigned long long *pTotal = &pTicks[m_nCpus * CpuTimeStateCount];
+    memset(pTicks, 0, (m_nCpus + 1) * CpuTimeStateCount * sizeof(unsigned long long));
+
+    // Without the Ex query only the calling thread's group is reported
+    for(WORD wGroup = 0; wGroup < m_wGroups; wGroup++)
+    {
+        CpuTimesPerformance *pGroup = &m_pPerformance[nCpus];
+        ULONG ulSize = m_pGroupCpus[wGroup] * sizeof(CpuTimesPerformance);
+        LONG lStatus = 0;
+
+        STK_PROFILE_SYSCALL();
+        if( m_pfnQueryEx )
+            lStatus = m_pfnQueryEx(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS, &wGroup, sizeof(wGroup),
+                                   pGroup, ulSize, &ulLength);
+        else
+            lStatus = m_pfnQuery(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION_CLASS, pGroup, ulSize, &ulLength);
+        if( 0 > lStatus )
+            return Unsuccessful;
+
+        // a group that reports fewer CPUs keeps zeros in the rest of its slots
+        if( ulLength < ulSize )
+            memset((char*)pGroup + ulLength, 0, ulSize - ulLength);
+        nCpus += m_pGroupCpus[wGroup];
+    }
+
+    for(int i = 0; i < nCpus && i < m_nCpus; i++)
+    {
+        const CpuTimesPerformance *pPerformance = &m_pPerformance[i];
+        unsigned long long *pCpu = &pTicks[i * CpuTimeStateCount];
+
+        unsigned long long ullKernel = pPerformance->KernelTime.QuadPart;
+        unsigned long long ullIdle = pPerformance->IdleTime.QuadPart;
+        unsigned long long ullIrq = pPerformance->DpcTime.QuadPart + pPerformance->InterruptTime.QuadPart;
+
+        pCpu[CpuTimeUser] = pPerformance->UserTime.QuadPart;
+        pCpu[CpuTimeIdle] = ullIdle;
+        pCpu[CpuTimeIrq] = ullIrq;
+        pCpu[CpuTimeSystem] = ullKernel > ullIdle + ullIrq ? ullKernel - ullIdle - ullIrq : 0;
+
+        for(int j = 0; j < CpuTimeStateCount; j++)
+            pTotal[j] += pCpu[j];
+    }
+
+    return Success;
+}
+#else
+int CCpuTimes::ReadStat()
+{
+    for( ;; )
+    {
+        STK_PROFILE_SYSCALL();
+        ssize_t nRead = pread(m_nStatFile, m_pszBuffer, m_nBufferSize - 1, 0);
+        if( 0 >= nRead )
+            return Unsuccessful;
+
+        if( nRead < m_nBufferSize - 1 )
+        {
+            m_pszBuffer[nRead] = 0;
+            return Success;
+        }
+
+        // Only on the first reads of a large host, the size then stays
+        delete[] m_pszBuffer;
+        m_nBufferSize *= 2;
+        m_pszBuffer = new char[m_nBufferSize];
+        CHECK_ALLOCATION_STATUS(m_pszBuffer);
+    }
+}
+
+int CCpuTimes::Initialize()
+{
+    m_nStatFile = open(CPU_TIMES_STAT_FILE, O_RDONLY);
+    if( 0 > m_nStatFile )
+        return Unsuccessful;
+
+    m_nBufferSize = CPU_TIMES_READ_BUFFER_SIZE;
+    m_pszBuffer = new char[m_nBufferSize];
+    CHECK_ALLOCATION_STATUS(m_pszBuffer);
+
+    int nStatus = ReadStat();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    // Highest "cpuN" line, offline CPUs leave gaps
+    int nCpus = 0;
+    for(const char *pszLine = m_pszBuffer; 0 == strncmp(pszLine, "cpu", 3); )
+    {
+        if( isdigit((unsigned char)pszLine[3]) )
+        {
+            int nCpu = atoi(pszLine + 3);
+            if( nCpu >= nCpus )
+                nCpus = nCpu + 1;
+        }
+
+        pszLine = strchr(pszLine, '\n');
+        if( !pszLine )
+            break;
+        pszLine++;
+    }
+    if( 0 == nCpus )
+        return Unsuccessful;
+
+    m_pCpus = new CpuTimes[nCpus];
+    CHECK_ALLOCATION_STATUS(m_pCpus);
+    memset(m_pCpus, 0, nCpus * sizeof(CpuTimes));
+    m_pPrevious = new unsigned long long[(nCpus + 1) * CpuTimeStateCount];
+    CHECK_ALLOCATION_STATUS(m_pPrevious);
+    memset(m_pPrevious, 0, (nCpus + 1) * CpuTimeStateCount * sizeof(unsigned long long));
+    m_pCurrent = new unsigned long long[(nCpus + 1) * CpuTimeStateCount];
+    CHECK_ALLOCATION_STATUS(m_pCurrent);
+    memset(m_pCurrent, 0, (nCpus + 1) * CpuTimeStateCount * sizeof(unsigned long long));
+
+    m_nCpus = nCpus;
+
+    // Baseline for the first interval
+    nStatus = ReadTicks(m_pPrevious);
+    if( Success != nStatus )
+        m_nCpus = 0;
+
+    return nStatus;
+}
+
+int CCpuTimes::ReadTicks(unsigned long long *pTicks)
+{
+    unsigned long long pFields[8];
+    char *pszEnd = NULL;
+
+    int nStatus = ReadStat();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    // "cpu  user nice system idle iowait irq softirq steal ..." for the
+    // total, then one "cpuN" line per online CPU; the lines come first
+    for(const char *pszLine = m_pszBuffer; 0 == strncmp(pszLine, "cpu", 3); )
+    {
+        const char *pszField = pszLine + 3;
+        bool bTotal = !isdigit((unsigned char)*pszField);
+        int nCpu = m_nCpus;
+
+        if( !bTotal )
+        {
+            nCpu = (int)strtol(pszField, &pszEnd, 10);
+            pszField = pszEnd;
+        }
+
+        // older kernels stop after irq or softirq
+        memset(pFields, 0, sizeof(pFields));
+        for(int i = 0; i < 8; i++)
+        {
+            pFields[i] = strtoull(pszField, &pszEnd, 10);
+            if( pszEnd == pszField )
+                break;
+            pszField = pszEnd;
+        }
+
+        // the total has the slot after the CPUs, a CPU brought online
+        // after Initialize() is left out
+        if( bTotal || nCpu < m_nCpus )
+        {
+            unsigned long long *pCpu = &pTicks[nCpu * CpuTimeStateCount];
+
+            // guest time is already part of user, steal is not this system's
+            pCpu[CpuTimeUser] = pFields[0] + pFields[1];
+            pCpu[CpuTimeSystem] = pFields[2];
+            pCpu[CpuTimeIdle] = pFields[3];
+            pCpu[CpuTimeIoWait] = pFields[4];
+            pCpu[CpuTimeIrq] = pFields[5] + pFields[6];
+        }
+
+        pszLine = strchr(pszField, '\n');
+        if( !pszLine )
+            break;
+        pszLine++;
+    }
+
+    return Success;
+}
+#endif
@@ -0,0 +1,270 @@
+#include "../headers/cpu_topology.h"
+
+CCpuTopology::CCpuTopology():
+    m_pCores( NULL ),
+    m_nCores( 0 ),
+    m_pPackageCores( NULL ),
+    m_nPackages( 0 ),
+    m_nProcessors( 0 ),
+    m_pProcessorValues( NULL ),
+    m_bBroadcast( true )
+{
+
+}
+
+CCpuTopology::~CCpuTopology()
+{
+    delete[] m_pCores;
+    m_pCores = NULL;
+    delete[] m_pPackageCores;
+    m_pPackageCores = NULL;
+    delete[] m_pProcessorValues;
+    m_pProcessorValues = NULL;
+}
+
+int CCpuTopology::Initialize()
+{
+    int nStatus = Uninitialized;
+    DWORD dwLength = 0;
+    BYTE *pBuffer = NULL;
+    int pGroupBase[CPU_TOPOLOGY_MAX_GROUPS] = { 0 };
+
+    delete[] m_pCores;
+    m_pCores = NULL;
+    delete[] m_pPackageCores;
+    m_pPackageCores = NULL;
+    delete[] m_pProcessorValues;
+    m_pProcessorValues = NULL;
+    m_nCores = 0;
+    m_nPackages = 0;
+
+    // System wide index of the first processor of each group
+    WORD wGroups = GetActiveProcessorGroupCount();
+    for( WORD i = 1; i < wGroups && i < CPU_TOPOLOGY_MAX_GROUPS; i++ )
+        pGroupBase[i] = pGroupBase[i - 1] + GetActiveProcessorCount(i - 1);
+
+    m_nProcessors = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    if( 0 >= m_nProcessors )
+        return Unsuccessful;
+
+    m_pProcessorValues = new ULONGLONG[m_nProcessors * STK_MSR_BROADCAST_MAX];
+    CHECK_ALLOCATION_STATUS(m_pProcessorValues);
+
+    GetLogicalProcessorInformationEx(RelationProcessorCore, NULL, &dwLength);
+    if( ERROR_INSUFFICIENT_BUFFER != GetLastError() )
+        return Unsuccessful;
+
+    pBuffer = new BYTE[dwLength];
+    CHECK_ALLOCATION_STATUS(pBuffer);
+
+    if( !GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)pBuffer, &dwLength) )
+    {
+        nStatus = Unsuccessful;
+        goto CLEANUP;
+    }
+
+    // One entry per physical core, worst case one per processor
+    m_pCores = new CpuCore[m_nProcessors];
+    if( !m_pCores )
+    {
+        nStatus = NotAllocated;
+        goto CLEANUP;
+    }
+
+    for( DWORD dwOffset = 0; dwOffset < dwLength && m_nCores < m_nProcessors; )
+    {
+        PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX pInfo = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(pBuffer + dwOffset);
+        dwOffset += pInfo->Size;
+
+        // A core never spans groups
+        KAFFINITY Mask = pInfo->Processor.GroupMask[0].Mask;
+        WORD wGroup = pInfo->Processor.GroupMask[0].Group;
+        if( 0 == Mask )
+            continue;
+
+        BYTE bNumber = 0;
+        while( !(Mask & ((KAFFINITY)1 << bNumber)) )
+            bNumber++;
+
+        m_pCores[m_nCores].wGroup = wGroup;
+        m_pCores[m_nCores].bNumber = bNumber;
+        m_pCores[m_nCores].nIndex = (wGroup < CPU_TOPOLOGY_MAX_GROUPS ? pGroupBase[wGroup] : 0) + bNumber;
+        m_pCores[m_nCores].nPackage = 0;
+        m_nCores++;
+    }
+
+    nStatus = m_nCores ? InitializePackages() : Unsuccessful;
+
+CLEANUP:
+    delete[] pBuffer;
+
+    return nStatus;
+}
+
+int CCpuTopology::InitializePackages()
+{
+    DWORD dwLength = 0;
+    BYTE *pBuffer = NULL;
+
+    m_pPackageCores = new int[m_nCores];
+    CHECK_ALLOCATION_STATUS(m_pPackageCores);
+
+    // Without the package relation every core is taken as one package
+    m_pPackageCores[0] = 0;
+    m_nPackages = 1;
+
+    GetLogicalProcessorInformationEx(RelationProcessorPackage, NULL, &dwLength);
+    if( ERROR_INSUFFICIENT_BUFFER != GetLastError() )
+        return Success;
+
+    pBuffer = new BYTE[dwLength];
+    CHECK_ALLOCATION_STATUS(pBuffer);
+
+    if( GetLogicalProcessorInformationEx(RelationProcessorPackage, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)pBuffer, &dwLength) )
+    {
+        int nPackage = 0;
+
+        // A package may span several groups
+        for( DWORD dwOffset = 0; dwOffset < dwLength && nPackage < m_nCores; nPackage++ )
+        {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX pInfo = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(pBuffer + dwOffset);
+            dwOffset += pInfo->Size;
+
+            for( WORD i = 0; i < pInfo->Processor.GroupCount; i++ )
+            {
+                const GROUP_AFFINITY *pGroup = &pInfo->Processor.GroupMask[i];
+                for( int j = 0; j < m_nCores; j++ )
+                {
+                    if( m_pCores[j].wGroup == pGroup->Group && (pGroup->Mask & ((KAFFINITY)1 << m_pCores[j].bNumber)) )
+                        m_pCores[j].nPackage = nPackage;
+                }
+            }
+        }
+
+        // First core of each package
+        m_nPackages = 0;
+        for( int i = 0; i < nPackage; i++ )
+        {
+            for( int j = 0; j < m_nCores; j++ )
+            {
+                if( i == m_pCores[j].nPackage )
+                {
+                    m_pPackageCores[m_nPackages++] = j;
+                    break;
+                }
+            }
+        }
+
+        if( 0 == m_nPackages )
+        {
+            m_pPackageCores[0] = 0;
+            m_nPackages = 1;
+        }
+    }
+
+    delete[] pBuffer;
+
+    return Success;
+}
+
+int CCpuTopology::GetCoreCount() const
+{
+    return m_nCores;
+}
+
+int CCpuTopology::GetProcessorCount() const
+{
+    return m_nProcessors;
+}
+
+int CCpuTopology::GetPackageCount() const
+{
+    return m_nPackages;
+}
+
+const CpuCore *CCpuTopology::GetCores() const
+{
+    return m_pCores;
+}
+
+int CCpuTopology::ReadCoreMsrsPinned(CRing0Wrapper *pDriver, const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues,
+                                     const int *pCoreList, int nList)
+{
+    int nStatus = Success;
+    GROUP_AFFINITY Previous, Affinity;
+    ULONG ulEax = 0, ulEdx = 0;
+
+    if( !GetThreadGroupAffinity(GetCurrentThread(), &Previous) )
+        return Unsuccessful;
+
+    for( int i = 0; i < nList; i++ )
+    {
+        const CpuCore *pCore = &m_pCores[pCoreList ? pCoreList[i] : i];
+
+        memset(&Affinity, 0, sizeof(GROUP_AFFINITY));
+        Affinity.Group = pCore->wGroup;
+        Affinity.Mask = (KAFFINITY)1 << pCore->bNumber;
+        bool bPinned = FALSE != SetThreadGroupAffinity(GetCurrentThread(), &Affinity, NULL);
+
+        for( int j = 0; j < nIndexes; j++ )
+        {
+            if( !bPinned || Success != pDriver->ReadMsr(pIndexes[j], &ulEax, &ulEdx) )
+            {
+                pValues[i * nIndexes + j] = 0;
+                nStatus = Unsuccessful;
+                continue;
+            }
+
+            pValues[i * nIndexes + j] = ((ULONGLONG)ulEdx << 32) | ulEax;
+        }
+    }
+
+    SetThreadGroupAffinity(GetCurrentThread(), &Previous, NULL);
+
+    return nStatus;
+}
+
+int CCpuTopology::ReadSelectedMsrs(CRing0Wrapper *pDriver, const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues,
+                                   const int *pCoreList, int nList)
+{
+    if( !pDriver || !pIndexes || !pValues || !m_pCores || 0 >= nIndexes || STK_MSR_BROADCAST_MAX < nIndexes )
+        return InvalidParameter;
+
+    if( m_bBroadcast )
+    {
+        if( Success == pDriver->ReadMsrAllProcessors(pIndexes, nIndexes, m_pProcessorValues, m_nProcessors) )
+        {
+            for( int i = 0; i < nList; i++ )
+            {
+                const CpuCore *pCore = &m_pCores[pCoreList ? pCoreList[i] : i];
+                for( int j = 0; j < nIndexes; j++ )
+                    pValues[i * nIndexes + j] = pCore->nIndex < m_nProcessors ?
+                                m_pProcessorValues[pCore->nIndex * nIndexes + j] : 0;
+            }
+            return Success;
+        }
+    }
+
+    int nStatus = ReadCoreMsrsPinned(pDriver, pIndexes, nIndexes, pValues, pCoreList, nList);
+
+    // The registers are fine but the driver cannot broadcast, stop trying
+    if( Success == nStatus )
+        m_bBroadcast = false;
+
+    return nStatus;
+}
+
+int CCpuTopology::ReadCoreMsr(CRing0Wrapper *pDriver, ULONG ulIndex, ULONGLONG *pValues)
+{
+    return ReadCoreMsrs(pDriver, &ulIndex, 1, pValues);
+}
+
+int CCpuTopology::ReadCoreMsrs(CRing0Wrapper *pDriver, const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues)
+{
+    return ReadSelectedMsrs(pDriver, pIndexes, nIndexes, pValues, NULL, m_nCores);
+}
+
+int CCpuTopology::ReadPackageMsrs(CRing0Wrapper *pDriver, const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues)
+{
+    return ReadSelectedMsrs(pDriver, pIndexes, nIndexes, pValues, m_pPackageCores, m_nPackages);
+}
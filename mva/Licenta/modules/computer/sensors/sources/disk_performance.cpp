@@ -0,0 +1,339 @@
+#include "../headers/disk_performance.h"
+
+#include <stdio.h>
+
+#ifndef STK_WINDOWS
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+#include "../../../../utils/headers/self_profile.h"
+
+CDiskPerformance::CDiskPerformance():
+    m_nDisks( 0 ),
+    m_ullTimestamp( 0 )
+#ifndef STK_WINDOWS
+    , m_nStatsFile( -1 ),
+    m_pszBuffer( NULL ),
+    m_nBufferSize( 0 )
+#endif
+{
+    memset(m_pDisks, 0, sizeof(m_pDisks));
+}
+
+CDiskPerformance::~CDiskPerformance()
+{
+#ifdef STK_WINDOWS
+    for(int i = 0; i < m_nDisks; i++)
+        CloseHandle(m_pDisks[i].hDisk);
+#else
+    if( 0 <= m_nStatsFile )
+        close(m_nStatsFile);
+    delete[] m_pszBuffer;
+    m_pszBuffer = NULL;
+#endif
+}
+
+int CDiskPerformance::GetDiskCount()
+{
+    return m_nDisks;
+}
+
+const DiskLoad *CDiskPerformance::GetDisks()
+{
+    return m_pDisks;
+}
+
+// Counters that went back belong to a reset disk, the interval reads 0
+static unsigned long long CounterDelta(unsigned long long ullCurrent, unsigned long long ullPrevious)
+{
+    return ullCurrent >= ullPrevious ? ullCurrent - ullPrevious : 0;
+}
+
+void CDiskPerformance::Compute(DiskLoad *pDisk, double dSeconds)
+{
+    const DiskCounters *pCurrent = &pDisk->Current;
+    const DiskCounters *pPrevious = &pDisk->Previous;
+
+    unsigned long long ullReads = CounterDelta(pCurrent->ullReads, pPrevious->ullReads);
+    unsigned long long ullWrites = CounterDelta(pCurrent->ullWrites, pPrevious->ullWrites);
+    unsigned long long ullService = CounterDelta(pCurrent->ullServiceTime, pPrevious->ullServiceTime);
+
+    pDisk->dReadRate = CounterDelta(pCurrent->ullBytesRead, pPrevious->ullBytesRead) / dSeconds;
+    pDisk->dWriteRate = CounterDelta(pCurrent->ullBytesWritten, pPrevious->ullBytesWritten) / dSeconds;
+    pDisk->dReadIops = ullReads / dSeconds;
+    pDisk->dWriteIops = ullWrites / dSeconds;
+    pDisk->dLatency = (ullReads + ullWrites) ? ullService / 1000.0 / (ullReads + ullWrites) : 0;
+
+#ifdef STK_WINDOWS
+    pDisk->dQueueDepth = pCurrent->ulQueueDepth;
+#else
+    // Little's law, the in flight time accumulated per second of wall time
+    pDisk->dQueueDepth = CounterDelta(pCurrent->ullQueueTime, pPrevious->ullQueueTime) / (dSeconds * 1000000);
+#endif
+
+    pDisk->Previous = pDisk->Current;
+}
+
+int CDiskPerformance::Update()
+{
+    STK_PROFILE_SCOPE(ProfileModuleDiskPerformance);
+
+    if( 0 == m_nDisks )
+        return Uninitialized;
+
+    int nStatus = ReadCounters();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    unsigned long long ullNow = SensorTimestamp();
+    unsigned long long ullElapsed = ullNow - m_ullTimestamp;
+    m_ullTimestamp = ullNow;
+    if( 0 == ullElapsed )
+        return Unsuccessful;
+
+    for(int i = 0; i < m_nDisks; i++)
+        Compute(&m_pDisks[i], ullElapsed / 1000000.0);
+
+    return Success;
+}
+
+#ifdef STK_WINDOWS
+static bool QueryDisk(HANDLE hDisk, DiskCounters *pCounters)
+{
+    DISK_PERFORMANCE Performance;
+    DWORD dwReturned = 0;
+
+    // Fails when the disk counters are turned off (diskperf -n)
+    STK_PROFILE_SYSCALL();
+    if( !DeviceIoControl(hDisk, IOCTL_DISK_PERFORMANCE, NULL, 0, &Performance, sizeof(Performance), &dwReturned, NULL) )
+        return false;
+
+    // Times are in 100 ns units
+    pCounters->ullBytesRead = Performance.BytesRead.QuadPart;
+    pCounters->ullBytesWritten = Performance.BytesWritten.QuadPart;
+    pCounters->ullReads = Performance.ReadCount;
+    pCounters->ullWrites = Performance.WriteCount;
+    pCounters->ullServiceTime = (Performance.ReadTime.QuadPart + Performance.WriteTime.QuadPart) / 10;
+    pCounters->ullQueueTime = 0;
+    pCounters->ulQueueDepth = Performance.QueueDepth;
+
+    return true;
+}
+
+int CDiskPerformance::Initialize(const QStringList &qDrives)
+{
+    m_nDisks = 0;
+
+    foreach(QString qsDrive, qDrives)
+    {
+        if( DISK_PERFORMANCE_MAX_DISKS == m_nDisks )
+            break;
+
+        DiskLoad *pDisk = &m_pDisks[m_nDisks];
+
+        // No access rights are needed for the counters, only the handle
+        pDisk->hDisk = CreateFile(qsDrive.toStdWString().c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                  NULL, OPEN_EXISTING, 0, NULL);
+        if( INVALID_HANDLE_VALUE == pDisk->hDisk )
+            continue;
+
+        if( !QueryDisk(pDisk->hDisk, &pDisk->Previous) )
+        {
+            CloseHandle(pDisk->hDisk);
+            continue;
+        }
+
+        // "\\.\PhysicalDriveN"
+        int nIndex = qsDrive.lastIndexOf("PhysicalDrive", -1, Qt::CaseInsensitive);
+        pDisk->nDisk = 0 <= nIndex ? qsDrive.mid(nIndex + 13).toInt() : m_nDisks;
+        sprintf(pDisk->szName, "PhysicalDrive%d", pDisk->nDisk);
+
+        m_nDisks++;
+    }
+
+    m_ullTimestamp = SensorTimestamp();
+
+    return m_nDisks ? Success : Unsuccessful;
+}
+
+int CDiskPerformance::ReadCounters()
+{
+    for(int i = 0; i < m_nDisks; i++)
+    {
+        // a failed query keeps the last counters, the interval reads 0
+        if( !QueryDisk(m_pDisks[i].hDisk, &m_pDisks[i].Current) )
+            m_pDisks[i].Current = m_pDisks[i].Previous;
+    }
+
+    return Success;
+}
+#else
+// "   8       0 sda 4511 1398 271482 2316 ..." -> sda, the fields after it
+static const char *ParseDiskName(const char *pszLine, char *pszName, int nSize)
+{
+    char *pszEnd = NULL;
+
+    strtoul(pszLine, &pszEnd, 10);
+    strtoul(pszEnd, &pszEnd, 10);
+    while( ' ' == *pszEnd )
+        pszEnd++;
+
+    int nLength = 0;
+    while( pszEnd[nLength] && ' ' != pszEnd[nLength] && '\n' != pszEnd[nLength] )
+        nLength++;
+    if( 0 == nLength || nLength >= nSize )
+        return NULL;
+
+    memcpy(pszName, pszEnd, nLength);
+    pszName[nLength] = 0;
+
+    return pszEnd + nLength;
+}
+
+static bool IsWholeDisk(const char *pszName)
+{
+    char szPath[DISK_PERFORMANCE_NAME_SIZE + 16];
+
+    if( 0 == strncmp(pszName, "loop", 4) || 0 == strncmp(pszName, "ram", 3) || 0 == strncmp(pszName, "zram", 4) )
+        return false;
+
+    // partitions have no entry of their own in /sys/block
+    sprintf(szPath, "/sys/block/%s", pszName);
+
+    return 0 == access(szPath, F_OK);
+}
+
+int CDiskPerformance::ReadStats()
+{
+    for( ;; )
+    {
+        STK_PROFILE_SYSCALL();
+        ssize_t nRead = pread(m_nStatsFile, m_pszBuffer, m_nBufferSize - 1, 0);
+        if( 0 >= nRead )
+            return Unsuccessful;
+
+        if( nRead < m_nBufferSize - 1 )
+        {
+            m_pszBuffer[nRead] = 0;
+            return Success;
+        }
+
+        // Only on the first reads of a host with many partitions
+        delete[] m_pszBuffer;
+        m_nBufferSize *= 2;
+        m_pszBuffer = new char[m_nBufferSize];
+        CHECK_ALLOCATION_STATUS(m_pszBuffer);
+    }
+}
+
+int CDiskPerformance::Initialize(const QStringList &qDrives)
+{
+    char szName[DISK_PERFORMANCE_NAME_SIZE];
+
+    m_nStatsFile = open(DISK_PERFORMANCE_STATS_FILE, O_RDONLY);
+    if( 0 > m_nStatsFile )
+        return Unsuccessful;
+
+    m_nBufferSize = DISK_PERFORMANCE_READ_BUFFER_SIZE;
+    m_pszBuffer = new char[m_nBufferSize];
+    CHECK_ALLOCATION_STATUS(m_pszBuffer);
+
+    int nStatus = ReadStats();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    m_nDisks = 0;
+    for(const char *pszLine = m_pszBuffer; *pszLine && DISK_PERFORMANCE_MAX_DISKS > m_nDisks; )
+    {
+        if( ParseDiskName(pszLine, szName, sizeof(szName)) )
+        {
+            bool bSelected = false;
+
+            if( qDrives.isEmpty() )
+                bSelected = IsWholeDisk(szName);
+            foreach(QString qsDrive, qDrives)
+            {
+                // "/dev/sda" or "sda"
+                if( qsDrive.mid(qsDrive.lastIndexOf('/') + 1) == szName )
+                    bSelected = true;
+            }
+
+            if( bSelected )
+            {
+                m_pDisks[m_nDisks].nDisk = m_nDisks;
+                strcpy(m_pDisks[m_nDisks].szName, szName);
+                m_nDisks++;
+            }
+        }
+
+        pszLine = strchr(pszLine, '\n');
+        if( !pszLine )
+            break;
+        pszLine++;
+    }
+    if( 0 == m_nDisks )
+        return Unsuccessful;
+
+    // Baseline for the first interval
+    nStatus = ReadCounters();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    for(int i = 0; i < m_nDisks; i++)
+        m_pDisks[i].Previous = m_pDisks[i].Current;
+    m_ullTimestamp = SensorTimestamp();
+
+    return Success;
+}
+
+int CDiskPerformance::ReadCounters()
+{
+    unsigned long long pFields[11];
+    char szName[DISK_PERFORMANCE_NAME_SIZE];
+    char *pszEnd = NULL;
+
+    int nStatus = ReadStats();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    for(const char *pszLine = m_pszBuffer; *pszLine; )
+    {
+        const char *pszField = ParseDiskName(pszLine, szName, sizeof(szName));
+
+        DiskLoad *pDisk = NULL;
+        for(int i = 0; pszField && i < m_nDisks; i++)
+        {
+            if( 0 == strcmp(m_pDisks[i].szName, szName) )
+                pDisk = &m_pDisks[i];
+        }
+
+        if( pDisk )
+        {
+            // reads, merged, sectors, ms, writes, merged, sectors, ms,
+            // in flight, ms doing IO, weighted ms doing IO
+            memset(pFields, 0, sizeof(pFields));
+            for(int i = 0; i < 11; i++)
+            {
+                pFields[i] = strtoull(pszField, &pszEnd, 10);
+                if( pszEnd == pszField )
+                    break;
+                pszField = pszEnd;
+            }
+
+            pDisk->Current.ullReads = pFields[0];
+            pDisk->Current.ullBytesRead = pFields[2] * DISK_PERFORMANCE_SECTOR_SIZE;
+            pDisk->Current.ullWrites = pFields[4];
+            pDisk->Current.ullBytesWritten = pFields[6] * DISK_PERFORMANCE_SECTOR_SIZE;
+            pDisk->Current.ullServiceTime = (pFields[3] + pFields[7]) * 1000;
+            pDisk->Current.ulQueueDepth = (unsigned long)pFields[8];
+            pDisk->Current.ullQueueTime = pFields[10] * 1000;
+        }
+
+        pszLine = strchr(pszLine, '\n');
+        if( !pszLine )
+            break;
+        pszLine++;
+    }
+
+    return Success;
+}
+#endif
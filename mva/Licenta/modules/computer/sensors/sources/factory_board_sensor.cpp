@@ -1,15 +1,23 @@
 #include "../headers/factory_board_sensor.h"
 
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include <QDir>
+
 
 FactoryBoardSensor::FactoryBoardSensor():
     m_pDriver( NULL ),
     m_pBoardSensor( NULL )
 {
+#ifdef STK_WINDOWS
     m_pDriver = new CRing0Wrapper;
     CHECK_ALLOCATION(m_pDriver);
 
     int nStatus = m_pDriver->Initialize();
     CHECK_OPERATION_STATUS(nStatus);
+#endif
 }
 
 FactoryBoardSensor::~FactoryBoardSensor()
@@ -23,30 +31,62 @@ FactoryBoardSensor::~FactoryBoardSensor()
         SAFE_DELETE(m_pBoardSensor);
     }
 
-    nStatus = m_pDriver->Destroy();
-    CHECK_OPERATION_STATUS(nStatus);
-    SAFE_DELETE(m_pDriver);
+#ifdef STK_WINDOWS
+    if (m_pDriver)
+    {
+        nStatus = m_pDriver->Destroy();
+        CHECK_OPERATION_STATUS(nStatus);
+        SAFE_DELETE(m_pDriver);
+    }
+#endif
 }
 
-USHORT FactoryBoardSensor::ReadWordFromPort(BYTE bRegisterPort, BYTE bValuePort, BYTE bRegister)
+#ifndef STK_WINDOWS
+ISensor *FactoryBoardSensor::GetBoardSensor(const QString &qsCacheDirectory, const QString &qsBoardIdentity)
 {
-    USHORT usVal = 0;
+    UNUSED(qsCacheDirectory);
+    UNUSED(qsBoardIdentity);
 
-    m_pDriver->WriteIoPortByte(bRegisterPort, bRegister);
-    BYTE bVal1 = 0;
-    m_pDriver->ReadIoPortByte(bValuePort, &bVal1);
+    // discovery is a directory walk, there is nothing worth caching
+    if (!m_pBoardSensor)
+        m_pBoardSensor = new CHwmonSensor;
 
-    m_pDriver->WriteIoPortByte(bRegisterPort, bRegister + 1);
-    BYTE bVal2 = 0;
-    m_pDriver->ReadIoPortByte(bValuePort, &bVal2);
+    return m_pBoardSensor;
+}
+#else
+static const SuperIOFamilyDescriptor *FindFamily(unsigned int uFamily)
+{
+    int nFamilies = 0;
+    const SuperIOFamilyDescriptor *pFamilies = SuperIOGetFamilies(&nFamilies);
 
-    usVal = ((bVal1 << 8)| bVal2);
+    for( int i = 0; i < nFamilies; i++ )
+    {
+        if( (unsigned int)pFamilies[i].eFamily == uFamily )
+            return &pFamilies[i];
+    }
 
-    return usVal;
+    return NULL;
+}
+
+void FactoryBoardSensor::WritePort(BYTE bPort, BYTE bValue)
+{
+    std::lock_guard<std::mutex> Lock(m_DriverMutex);
+
+    int nStatus = m_pDriver->WriteIoPortByte(bPort, bValue);
+    CHECK_OPERATION_STATUS(nStatus);
+}
+
+USHORT FactoryBoardSensor::ReadWordFromPort(BYTE bRegisterPort, BYTE bValuePort, BYTE bRegister)
+{
+    BYTE bVal1 = ReadByteFromPort(bRegisterPort, bValuePort, bRegister);
+    BYTE bVal2 = ReadByteFromPort(bRegisterPort, bValuePort, bRegister + 1);
+
+    return (USHORT)((bVal1 << 8) | bVal2);
 }
 
 BYTE FactoryBoardSensor::ReadByteFromPort(BYTE bRegisterPort, BYTE bValuePort, BYTE bRegister)
 {
+    std::lock_guard<std::mutex> Lock(m_DriverMutex);
     BYTE bVal = 0;
 
     m_pDriver->WriteIoPortByte(bRegisterPort, bRegister);
@@ -55,404 +95,279 @@ BYTE FactoryBoardSensor::ReadByteFromPort(BYTE bRegisterPort, BYTE bValuePort, B
     return bVal;
 }
 
-bool FactoryBoardSensor::DetectIT87XXSensor()
+void FactoryBoardSensor::WriteByteToPort(BYTE bRegisterPort, BYTE bValuePort, BYTE bRegister, BYTE bValue)
 {
-    USHORT usChipID = 0;
-    BYTE bChipIDRegister = 0x20;
-    Chip eChip = Unknown_Chip;
-
-    // Prepare environment for ITE family chip query
-    m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x87);
-    m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x01);
-    m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x55);
-    m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x55);
-
-    // Get ChipID
-    usChipID = ReadWordFromPort(IT87_REGISTER_PORT, IT87_VALUE_PORT, bChipIDRegister);
-    switch (usChipID)
-    {
-    case 0x8705:
-        eChip = IT8705F; break;
-    case 0x8712:
-        eChip = IT8712F; break;
-    case 0x8716:
-        eChip = IT8716F; break;
-    case 0x8718:
-        eChip = IT8718F; break;
-    case 0x8720:
-        eChip = IT8720F; break;
-    case 0x8721:
-        eChip = IT8721F; break;
-    case 0x8726:
-        eChip = IT8726F; break;
-    case 0x8728:
-        eChip = IT8728F; break;
-    case 0x8771:
-        eChip = IT8771E; break;
-    case 0x8772:
-        eChip = IT8772E; break;
-    default:
-        eChip = Unknown_Chip;
-    }
+    std::lock_guard<std::mutex> Lock(m_DriverMutex);
+
+    int nStatus = m_pDriver->WriteIoPortByte(bRegisterPort, bRegister);
+    CHECK_OPERATION_STATUS(nStatus);
+    nStatus = m_pDriver->WriteIoPortByte(bValuePort, bValue);
+    CHECK_OPERATION_STATUS(nStatus);
+}
+
+void FactoryBoardSensor::EnterConfiguration(const SuperIOFamilyDescriptor *pFamily)
+{
+    for( int i = 0; i < pFamily->nEnterKey; i++ )
+        WritePort(pFamily->bRegisterPort, pFamily->pbEnterKey[i]);
+}
+
+void FactoryBoardSensor::ExitConfiguration(const SuperIOFamilyDescriptor *pFamily)
+{
+    if( pFamily->bExitWithValue )
+        WriteByteToPort(pFamily->bRegisterPort, pFamily->bValuePort, pFamily->bExitRegister, pFamily->bExitValue);
+    else
+        WritePort(pFamily->bRegisterPort, pFamily->bExitRegister);
+}
+
+void FactoryBoardSensor::ReadChipId(const SuperIOFamilyDescriptor *pFamily, USHORT *pusChipId, BYTE *pbRevision)
+{
+    *pbRevision = 0;
 
-    if (Unknown_Chip == eChip)
+    if( pFamily->bWordId )
     {
-        if (usChipID != 0 && usChipID != 0xFFFF)
-        {
-            // Exit ITE enviroment
-            m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x02);
-            m_pDriver->WriteIoPortByte(IT87_VALUE_PORT, 0x02);
-        }
+        *pusChipId = ReadWordFromPort(pFamily->bRegisterPort, pFamily->bValuePort, SUPERIO_CHIP_ID_REGISTER);
     }
     else
     {
-        // select environment
-        m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x07);
-        m_pDriver->WriteIoPortByte(IT87_VALUE_PORT, IT87_ENVIRONMENT_CONTROLLER);
-
-        USHORT usAddress = 0;
-        USHORT usVerify = 0;
+        *pusChipId = ReadByteFromPort(pFamily->bRegisterPort, pFamily->bValuePort, SUPERIO_CHIP_ID_REGISTER);
+        *pbRevision = ReadByteFromPort(pFamily->bRegisterPort, pFamily->bValuePort, SUPERIO_CHIP_REVISION_REGISTER);
+    }
+}
 
-        usAddress = ReadWordFromPort(IT87_REGISTER_PORT, IT87_VALUE_PORT, BASE_ADDRESS_REGISTER);
+// Enters the configuration space of one vendor, looks the chip up in the
+// descriptor tables and validates the hardware monitor base address
+bool FactoryBoardSensor::DetectSuperIOSensor(const SuperIOFamilyDescriptor *pFamily, SuperIODetection *pDetection)
+{
+    USHORT usChipID = 0;
+    BYTE bRevision = 0;
 
-#ifdef STK_WINDOWS
-        Sleep(1);
-#endif
+    EnterConfiguration(pFamily);
+    ReadChipId(pFamily, &usChipID, &bRevision);
 
-        usVerify = ReadWordFromPort(IT87_REGISTER_PORT, IT87_VALUE_PORT, BASE_ADDRESS_REGISTER);
+    const SuperIOChipId *pChipId = SuperIOFindChipId(pFamily->eFamily, usChipID, bRevision);
+    const SuperIOChipDescriptor *pChip = pChipId ? SuperIOFindChip(pChipId->eChip) : NULL;
 
-        BYTE bVersion = 0;
-        m_pDriver->ReadIoPortByte((IT87_CHIP_VERSION_REGISTER & 0x0F), &bVersion);
+    if( !pChip )
+    {
+        // something answered, leave its configuration mode
+        if( 0 != usChipID && (pFamily->bWordId ? 0xFFFF : 0xFF) != usChipID )
+            ExitConfiguration(pFamily);
 
-        USHORT usGPIOAdress = 0;
-        USHORT usGPIOVerify = 0;
+        return false;
+    }
 
-        if (IT8705F == eChip)
-        {
-            BYTE bGPIO_LND = 0x05;
-            m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x07);
-            m_pDriver->WriteIoPortByte(IT87_VALUE_PORT, bGPIO_LND);
+    USHORT usAddress = 0;
+    USHORT usVerify = 0;
+    USHORT usGPIOAddress = 0;
+    USHORT usGPIOVerify = 0;
+    USHORT usVendorID = 0;
 
-            usGPIOAdress = ReadWordFromPort(IT87_REGISTER_PORT, IT87_VALUE_PORT, BASE_ADDRESS_REGISTER);
+    WriteByteToPort(pFamily->bRegisterPort, pFamily->bValuePort, SUPERIO_LOGICAL_DEVICE_REGISTER,
+                    pChipId->bLogicalDevice);
 
+    usAddress = ReadWordFromPort(pFamily->bRegisterPort, pFamily->bValuePort, SUPERIO_BASE_ADDRESS_REGISTER);
 #ifdef STK_WINDOWS
-            Sleep(1);
+    Sleep(1);
 #endif
+    usVerify = ReadWordFromPort(pFamily->bRegisterPort, pFamily->bValuePort, SUPERIO_BASE_ADDRESS_REGISTER);
 
-            usGPIOVerify = ReadWordFromPort(IT87_REGISTER_PORT, IT87_VALUE_PORT, BASE_ADDRESS_REGISTER);
-        }
-        else
-        {
-            BYTE bGPIO_LND_2 = 0x07;
-            m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x07);
-            m_pDriver->WriteIoPortByte(IT87_VALUE_PORT, bGPIO_LND_2);
+    if( pFamily->usVendorRegister )
+        usVendorID = ReadWordFromPort(pFamily->bRegisterPort, pFamily->bValuePort, (BYTE)pFamily->usVendorRegister);
 
-            usGPIOAdress = ReadWordFromPort(IT87_REGISTER_PORT, IT87_VALUE_PORT, BASE_ADDRESS_REGISTER + 2);
+    if( pChipId->bGpioDevice )
+    {
+        WriteByteToPort(pFamily->bRegisterPort, pFamily->bValuePort, SUPERIO_LOGICAL_DEVICE_REGISTER,
+                        pChipId->bGpioDevice);
 
+        usGPIOAddress = ReadWordFromPort(pFamily->bRegisterPort, pFamily->bValuePort, pChipId->bGpioRegister);
 #ifdef STK_WINDOWS
-            Sleep(1);
+        Sleep(1);
 #endif
+        usGPIOVerify = ReadWordFromPort(pFamily->bRegisterPort, pFamily->bValuePort, pChipId->bGpioRegister);
+    }
 
-            usGPIOVerify = ReadWordFromPort(IT87_REGISTER_PORT, IT87_VALUE_PORT, BASE_ADDRESS_REGISTER + 2);
-        }
+    ExitConfiguration(pFamily);
 
-        m_pDriver->WriteIoPortByte(IT87_REGISTER_PORT, 0x02);
-        m_pDriver->WriteIoPortByte(IT87_VALUE_PORT, 0x02);
+    if( usAddress != usVerify )
+        return false;
 
+    // some F718 chips have address offset added already
+    if( pFamily->bMaskAddressOffset && (usAddress & 0x07) == SUPERIO_ADDRESS_REGISTER_OFFSET )
+        usAddress &= 0xFFF8;
 
-        if (usAddress != usVerify || usAddress < 0x100 || (usAddress & 0xF007) != 0)
-            return false;
+    if( usAddress < 0x100 || ((usAddress & 0xF007) != 0) )
+        return false;
 
-        if (usGPIOAdress != usGPIOVerify || usGPIOAdress < 0x100 || (usGPIOAdress & 0xF007) != 0)
-            return false;
+    if( pChipId->bGpioDevice &&
+        (usGPIOAddress != usGPIOVerify || usGPIOAddress < 0x100 || (usGPIOAddress & 0xF007) != 0) )
+        return false;
 
-        m_pBoardSensor = new CIT87(eChip, usAddress);
-        return true;
-    }
-    return false;
-}
+    if( pFamily->usVendorRegister && usVendorID != pFamily->usVendorId )
+        return false;
 
-bool FactoryBoardSensor::DetectW836XXSensor()
-{
-    int nStatus = Uninitialized;
-    BYTE bChipID = 0, bRevision = 0;
-    BYTE bChipIDRegister = 0x20;
-    BYTE bRevisionRegister = 0x21;
-    BYTE bLogicalDeviceNumber = 0x0B;
-    Chip eChip = Unknown_Chip;
+    pDetection->uFamily = pFamily->eFamily;
+    pDetection->uChip = pChip->eChip;
+    pDetection->usChipId = usChipID;
+    pDetection->bRevision = bRevision;
+    pDetection->usAddress = usAddress;
 
-    nStatus = m_pDriver->WriteIoPortByte(W836_REGISTER_PORT, 0x87);
-    CHECK_OPERATION_STATUS(nStatus);
-    nStatus = m_pDriver->WriteIoPortByte(W836_REGISTER_PORT, 0x87);
-    CHECK_OPERATION_STATUS(nStatus);
+    return true;
+}
 
-    bChipID = ReadByteFromPort(W836_REGISTER_PORT, W836_VALUE_PORT, bChipIDRegister);
-    bRevision = ReadByteFromPort(W836_REGISTER_PORT, W836_VALUE_PORT, bRevisionRegister);
+// Families sharing a configuration port are probed in table order, the
+// first chip found on the port ends its probe
+void FactoryBoardSensor::DetectOnPort(BYTE bRegisterPort, SuperIODetection *pDetections, char *pbFound)
+{
+    int nFamilies = 0;
+    const SuperIOFamilyDescriptor *pFamilies = SuperIOGetFamilies(&nFamilies);
 
-    switch (bChipID)
+    for( int i = 0; i < nFamilies; i++ )
     {
-    case 0x52:
-        switch (bRevision)
-        {
-        case 0x17:
-        case 0x3A:
-        case 0x41:
-            eChip = W83627HF;
-            break;
-        }
-
-        break;
-    case 0x82:
-        switch (bRevision & 0xF0)
-        {
-        case 0x80:
-            eChip = W83627THF;
-            break;
-        }
-
-        break;
-    case 0x85:
-        switch (bRevision)
-        {
-        case 0x41:
-            eChip = W83687THF;
-            break;
-        }
+        if( pFamilies[i].bRegisterPort != bRegisterPort )
+            continue;
 
-        break;
-    case 0x88:
-        switch (bRevision & 0xF0)
+        if( DetectSuperIOSensor(&pFamilies[i], &pDetections[i]) )
         {
-        case 0x50:
-        case 0x60:
-            eChip = W83627EHF;
-            break;
+            pbFound[i] = 1;
+            return;
         }
+    }
+}
 
-        break;
-    case 0xA0:
-        switch (bRevision & 0xF0)
-        {
-        case 0x20:
-            eChip = W83627DHG;
-            break;
-        }
+// Cold probe, one thread per configuration port. When several ports answer,
+// the family listed first in the descriptor table wins.
+int FactoryBoardSensor::Detect(SuperIODetection *pDetection)
+{
+    int nFamilies = 0;
+    const SuperIOFamilyDescriptor *pFamilies = SuperIOGetFamilies(&nFamilies);
 
-        break;
-    case 0xA5:
-        switch (bRevision & 0xF0)
-        {
-        case 0x10:
-            eChip = W83667HG;
-            break;
-        }
+    std::vector<SuperIODetection> qDetections(nFamilies);
+    std::vector<char> qFound(nFamilies, 0);
+    std::vector<std::thread> qProbes;
 
-        break;
-    case 0xB0:
-        switch (bRevision & 0xF0)
-        {
-        case 0x70:
-            eChip = W83627DHGP;
-            break;
-        }
+    memset(pDetection, 0, sizeof(SuperIODetection));
+    pDetection->uChip = Unknown_Chip;
 
-        break;
-    case 0xB3:
-        switch (bRevision & 0xF0)
-        {
-        case 0x50:
-            eChip = W83667HGB;
-            break;
-        }
+    for( int i = 0; i < nFamilies; i++ )
+    {
+        bool bNewPort = true;
+        for( int j = 0; j < i; j++ )
+            bNewPort = bNewPort && pFamilies[j].bRegisterPort != pFamilies[i].bRegisterPort;
 
-        break;
-    default:
-        eChip = Unknown_Chip;
-        break;
+        if( bNewPort )
+            qProbes.push_back(std::thread(&FactoryBoardSensor::DetectOnPort, this, pFamilies[i].bRegisterPort,
+                                          qDetections.data(), qFound.data()));
     }
 
-    if( Unknown_Chip == eChip )
+    for( size_t i = 0; i < qProbes.size(); i++ )
+        qProbes[i].join();
+
+    for( int i = 0; i < nFamilies; i++ )
     {
-        if( 0 != bChipID && 0xFF != bChipID )
+        if( qFound[i] )
         {
-            m_pDriver->WriteIoPortByte(W836_REGISTER_PORT, 0xAA);
+            *pDetection = qDetections[i];
+            return Success;
         }
     }
-    else
-    {
-        // select environment
-        nStatus = m_pDriver->WriteIoPortByte(W836_REGISTER_PORT, 0x07);
-        CHECK_OPERATION_STATUS(nStatus);
-        nStatus = m_pDriver->WriteIoPortByte(W836_VALUE_PORT, bLogicalDeviceNumber);
-        CHECK_OPERATION_STATUS(nStatus);
-
-        USHORT usAddress = 0;
-        USHORT usVerify = 0;
-
-        usAddress = ReadWordFromPort(W836_REGISTER_PORT, W836_VALUE_PORT, BASE_ADDRESS_REGISTER);
-#ifdef STK_WINDOWS
-        Sleep(1);
-#endif
-        usVerify = ReadWordFromPort(W836_REGISTER_PORT, W836_VALUE_PORT, BASE_ADDRESS_REGISTER);
-
-        nStatus = m_pDriver->WriteIoPortByte(W836_REGISTER_PORT, 0xAA);
-        CHECK_OPERATION_STATUS(nStatus);
 
-        if( usAddress != usVerify )
-            return false;
-
-        if( usAddress < 0x100 || ((usAddress & 0xF007) != 0) )
-            return false;
+    return Unsuccessful;
+}
 
-        m_pBoardSensor = new CW836XX(eChip, usAddress, bRevision);
-        return true;
-    }
+ISensor *FactoryBoardSensor::CreateSensor(const SuperIODetection *pDetection)
+{
+    const SuperIOChipDescriptor *pChip = SuperIOFindChip((Chip)pDetection->uChip);
+    if( !pChip )
+        return NULL;
 
-    return false;
+    return new CSuperIOSensor(pChip, pDetection->usAddress);
 }
 
-bool FactoryBoardSensor::DetectF718XXSensor()
+// Warm start: the chip is confirmed with one ID read, through the hardware
+// monitor when the chip has an identification register there, otherwise
+// through its configuration space
+bool FactoryBoardSensor::ValidateDetection(const SuperIODetection *pDetection)
 {
-    int nStatus = Uninitialized;
-    BYTE bChipID = 0, bRevision = 0;
-    BYTE bChipIDRegister = 0x20;
-    BYTE bRevisionRegister = 0x21;
-    BYTE bLogicalDeviceNumber = 0x04;
-    Chip eChip = Unknown_Chip;
-
+    const SuperIOFamilyDescriptor *pFamily = FindFamily(pDetection->uFamily);
+    const SuperIOChipDescriptor *pChip = SuperIOFindChip((Chip)pDetection->uChip);
+    const SuperIOChipId *pChipId = NULL;
 
-    nStatus = m_pDriver->WriteIoPortByte(F718_REGISTER_PORT, 0x87);
-    CHECK_OPERATION_STATUS(nStatus);
-    nStatus = m_pDriver->WriteIoPortByte(F718_REGISTER_PORT, 0x87);
-    CHECK_OPERATION_STATUS(nStatus);
+    if( pFamily )
+        pChipId = SuperIOFindChipId(pFamily->eFamily, pDetection->usChipId, pDetection->bRevision);
 
-    bChipID = ReadByteFromPort(F718_REGISTER_PORT, F718_VALUE_PORT, bChipIDRegister);
-    bRevision = ReadByteFromPort(F718_REGISTER_PORT, F718_VALUE_PORT, bRevisionRegister);
+    if( !pChip || !pChipId || pChipId->eChip != pChip->eChip )
+        return false;
 
-    switch( bChipID )
+    if( 0 != pChip->Identify[0].bMask )
     {
-    case 0x05:
-        switch( bRevision )
-        {
-        case 0x07:
-            eChip = F71858; break;
-            bLogicalDeviceNumber = 0x02;
-        case 0x41:
-            eChip = F71882; break;
-        }
-
-        break;
-    case 0x06:
-        switch( bRevision )
-        {
-        case 0x01:
-            eChip = F71862; break;
-        }
-
-        break;
-    case 0x07:
-        switch( bRevision )
-        {
-        case 0x23:
-            eChip = F71889F; break;
-        }
-
-        break;
-    case 0x08:
-        switch (bRevision )
-        {
-        case 0x14:
-            eChip = F71869; break;
-        }
-
-        break;
-    case 0x09:
-        switch( bRevision )
-        {
-        case 0x01:
-            eChip = F71808E; break;
-        case 0x09:
-            eChip = F71889ED; break;
-        }
+        CSuperIOSensor *pSensor = new CSuperIOSensor(pChip, pDetection->usAddress);
+        if( !pSensor )
+            return false;
 
-        break;
-    case 0x10:
-        switch( bRevision )
+        if( Success != pSensor->Validate() )
         {
-        case 0x05:
-            eChip = F71889AD; break;
-        case 0x07:
-            eChip = F71869A; break;
+            pSensor->Destroy();
+            SAFE_DELETE(pSensor);
+            return false;
         }
 
-        break;
-    default:
-        break;
-    }
-
-    if( Unknown_Chip == eChip )
-    {
-        if( 0 != bChipID && 0xFF != bChipID )
-        {
-            m_pDriver->WriteIoPortByte(F718_REGISTER_PORT, 0xAA);
-        }
+        m_pBoardSensor = pSensor;
+        return true;
     }
-    else
-    {
-        // select environment
-        nStatus = m_pDriver->WriteIoPortByte(F718_REGISTER_PORT, 0x07);
-        CHECK_OPERATION_STATUS(nStatus);
-        nStatus = m_pDriver->WriteIoPortByte(F718_VALUE_PORT, bLogicalDeviceNumber);
-        CHECK_OPERATION_STATUS(nStatus);
 
-        USHORT usAddress = 0;
-        USHORT usVerify = 0;
-        USHORT usFintekVendorID = 0;
+    USHORT usChipID = 0;
+    BYTE bRevision = 0;
 
-        usAddress = ReadWordFromPort(F718_REGISTER_PORT, F718_VALUE_PORT, BASE_ADDRESS_REGISTER);
-#ifdef STK_WINDOWS
-        Sleep(1);
-#endif
-        usVerify = ReadWordFromPort(F718_REGISTER_PORT, F718_VALUE_PORT, BASE_ADDRESS_REGISTER);
-        usFintekVendorID = ReadWordFromPort(F718_REGISTER_PORT, F718_VALUE_PORT, F718_VENDOR_ID_REGISTER);
+    EnterConfiguration(pFamily);
+    ReadChipId(pFamily, &usChipID, &bRevision);
+    if( 0 != usChipID && (pFamily->bWordId ? 0xFFFF : 0xFF) != usChipID )
+        ExitConfiguration(pFamily);
 
-        nStatus = m_pDriver->WriteIoPortByte(F718_REGISTER_PORT, 0xAA);
-        CHECK_OPERATION_STATUS(nStatus);
+    if( usChipID != pDetection->usChipId || bRevision != pDetection->bRevision )
+        return false;
 
-        if( usAddress != usVerify )
-            return false;
+    m_pBoardSensor = CreateSensor(pDetection);
+    return NULL != m_pBoardSensor;
+}
 
-        // some F718 chips have address offset added already
-        if( (usAddress & 0x07) == 0x05 )
-            usAddress &= 0xFFF8;
+ISensor *FactoryBoardSensor::GetBoardSensor(const QString &qsCacheDirectory, const QString &qsBoardIdentity)
+{
+    CSuperIODetectionCache Cache;
+    SuperIODetection Detection;
+    bool bUseCache = !qsCacheDirectory.isEmpty() && !qsBoardIdentity.isEmpty();
 
-        if( usAddress < 0x100 || ((usAddress & 0xF007) != 0) )
-            return false;
+    if (m_pBoardSensor)
+        return m_pBoardSensor;
 
-        if( usFintekVendorID != F718_VENDOR_ID_VALUE )
-            return false;
+    if (bUseCache)
+    {
+        Cache.Load(QDir(qsCacheDirectory).filePath(SUPERIO_CACHE_FILE));
 
-        m_pBoardSensor = new CF718(eChip, usAddress);
-        return true;
+        if (Cache.Find(qsBoardIdentity, &Detection) && ValidateDetection(&Detection))
+            return m_pBoardSensor;
     }
 
-    return false;
-}
-
+    Detect(&Detection);
 
-ISensor *FactoryBoardSensor::GetBoardSensor()
-{
-    if (DetectIT87XXSensor())
-        return m_pBoardSensor;
+    // a miss is not kept, the driver may only have failed to load this time
+    if (bUseCache)
+    {
+        if (Unknown_Chip == Detection.uChip)
+            Cache.Remove(qsBoardIdentity);
+        else
+            Cache.Store(qsBoardIdentity, &Detection);
 
-    if (DetectW836XXSensor())
-        return m_pBoardSensor;
+        int nStatus = Cache.Save();
+        CHECK_OPERATION_STATUS(nStatus);
+    }
 
-    if (DetectF718XXSensor())
-        return m_pBoardSensor;
+    if (Unknown_Chip == Detection.uChip)
+        return NULL;
 
-    return NULL;
+    m_pBoardSensor = CreateSensor(&Detection);
+    return m_pBoardSensor;
 }
+#endif
 
 int FactoryBoardSensor::DestroySensor()
 {
@@ -5,11 +5,13 @@ FactoryCpuSensor::FactoryCpuSensor():
     m_pDriver( NULL ),
     m_pCpuSensor( NULL )
 {
+#ifdef STK_WINDOWS
     m_pDriver = new CRing0Wrapper;
     CHECK_ALLOCATION(m_pDriver);
 
     int nStatus = m_pDriver->Initialize();
     CHECK_OPERATION_STATUS(nStatus);
+#endif
 
     this->DetectCpuSensor();
 }
@@ -25,11 +27,25 @@ FactoryCpuSensor::~FactoryCpuSensor()
         SAFE_DELETE(m_pCpuSensor);
     }
 
-    nStatus = m_pDriver->Destroy();
-    CHECK_OPERATION_STATUS(nStatus);
-    SAFE_DELETE(m_pDriver);
+#ifdef STK_WINDOWS
+    if (m_pDriver)
+    {
+        nStatus = m_pDriver->Destroy();
+        CHECK_OPERATION_STATUS(nStatus);
+        SAFE_DELETE(m_pDriver);
+    }
+#endif
 }
 
+#ifndef STK_WINDOWS
+bool FactoryCpuSensor::DetectCpuSensor()
+{
+    // coretemp and k10temp already know the TjMax and offsets of the part
+    m_pCpuSensor = new CHwmonCpuSensor;
+
+    return true;
+}
+#else
 bool FactoryCpuSensor::DetectCpuSensor()
 {
     bool bResult = false;
@@ -111,6 +127,7 @@ bool FactoryCpuSensor::DetectCpuSensor()
 
     return true;
 }
+#endif
 
 ICPUSensor *FactoryCpuSensor::GetCpuSensor()
 {
@@ -1,32 +1,49 @@
 #include "../headers/hardware_usage.h"
 
+#include <limits>
 
-CHardwareUsage::CHardwareUsage()
-{
-    PdhOpenQuery(NULL, NULL, &m_CpuQuery);
-    PdhOpenQuery(NULL, NULL, &m_DiskQuery);
+#include "../../../../utils/headers/self_profile.h"
 
-    PdhAddCounter(m_CpuQuery, L"\\Processor(_Total)\\% Processor Time", NULL, &m_CpuCounter);
-    PdhAddCounter(m_DiskQuery, L"\\Disk(_Total)\\% Disk Time", NULL, &m_DiskCounter);
+// Indexed by MemoryCounter, English names work on localized systems too
+static const wchar_t *g_pwszMemoryCounters[MemoryCounterCount] =
+{
+    L"\\Memory\\Committed Bytes",
+    L"\\Memory\\Commit Limit",
+    L"\\Memory\\Cache Bytes",
+    L"\\Memory\\Standby Cache Reserve Bytes",
+    L"\\Memory\\Standby Cache Normal Priority Bytes",
+    L"\\Memory\\Standby Cache Core Bytes",
+    L"\\Memory\\Modified Page List Bytes",
+    L"\\Memory\\Pages Input/sec",
+    L"\\Memory\\Pages Output/sec"
+};
+
+CHardwareUsage::CHardwareUsage(): m_MemoryQuery(NULL)
+{
+    memset(m_pMemoryCounters, 0, sizeof(m_pMemoryCounters));
 
-    PdhCollectQueryData(m_CpuQuery);
-    PdhCollectQueryData(m_DiskQuery);
-}
+    if( ERROR_SUCCESS != PdhOpenQuery(NULL, NULL, &m_MemoryQuery) )
+    {
+        m_MemoryQuery = NULL;
+        return;
+    }
 
-CHardwareUsage::~CHardwareUsage()
-{
+    // A counter the system lacks (standby lists before Vista) stays NULL
+    for(int i = 0; i < MemoryCounterCount; i++)
+    {
+        if( ERROR_SUCCESS != PdhAddEnglishCounterW(m_MemoryQuery, g_pwszMemoryCounters[i], NULL, &m_pMemoryCounters[i]) )
+            m_pMemoryCounters[i] = NULL;
+    }
 
+    // The rates need a first collection to compare with
+    PdhCollectQueryData(m_MemoryQuery);
 }
 
-double CHardwareUsage::GetCpuLoad()
+CHardwareUsage::~CHardwareUsage()
 {
-    PDH_FMT_COUNTERVALUE CounterValue;
-    memset(&CounterValue, 0, sizeof(PDH_FMT_COUNTERVALUE));
-
-    PdhCollectQueryData(m_CpuQuery);
-    PdhGetFormattedCounterValue(m_CpuCounter, PDH_FMT_DOUBLE, NULL, &CounterValue);
-
-    return CounterValue.doubleValue;
+    // Also removes the counters of the query
+    if( m_MemoryQuery )
+        PdhCloseQuery(m_MemoryQuery);
 }
 
 QString CHardwareUsage::GetCpuName()
@@ -56,41 +73,63 @@ QString CHardwareUsage::GetCpuName()
     return "";
 }
 
-double CHardwareUsage::GetDiskLoad()
+double CHardwareUsage::GetMemoryCounter(MemoryCounter Counter)
 {
     PDH_FMT_COUNTERVALUE CounterValue;
     memset(&CounterValue, 0, sizeof(PDH_FMT_COUNTERVALUE));
 
-    PdhCollectQueryData(m_DiskQuery);
-    PdhGetFormattedCounterValue(m_DiskCounter, PDH_FMT_DOUBLE, NULL, &CounterValue);
+    if( !m_pMemoryCounters[Counter] ||
+        ERROR_SUCCESS != PdhGetFormattedCounterValue(m_pMemoryCounters[Counter], PDH_FMT_DOUBLE, NULL, &CounterValue) )
+        return std::numeric_limits<double>::quiet_NaN();
 
     return CounterValue.doubleValue;
 }
 
-MemoryStatus *CHardwareUsage::GetMemoryStatus()
+int CHardwareUsage::GetMemoryStatus(MemoryStatus *pMemoryStatus)
 {
-    MemoryStatus* pMemoryStatus = new MemoryStatus;
+    STK_PROFILE_SCOPE(ProfileModuleMemory);
+
+    if( !pMemoryStatus )
+        return NullException;
 
     MEMORYSTATUSEX MemStat;
     ZeroMemory(&MemStat, sizeof(MEMORYSTATUSEX));
     MemStat.dwLength = sizeof(MEMORYSTATUSEX);
 
+    STK_PROFILE_SYSCALL();
     if (!GlobalMemoryStatusEx(&MemStat))
+        return Unsuccessful;
+
+    pMemoryStatus->ulMemoryLoad = MemStat.dwMemoryLoad;
+    pMemoryStatus->ullAvailExtVirtual = MemStat.ullAvailExtendedVirtual;
+    pMemoryStatus->ullAvailPageFile = MemStat.ullAvailPageFile;
+    pMemoryStatus->ullTotalPageFile = MemStat.ullTotalPageFile;
+    pMemoryStatus->ullAvailVirtual = MemStat.ullAvailVirtual;
+    pMemoryStatus->ullTotalVirtual = MemStat.ullTotalVirtual;
+    pMemoryStatus->ullAvailPhys = MemStat.ullAvailPhys;
+    pMemoryStatus->ullTotalPhys = MemStat.ullTotalPhys;
+
+    STK_PROFILE_SYSCALL();
+    if( m_MemoryQuery && ERROR_SUCCESS == PdhCollectQueryData(m_MemoryQuery) )
     {
-        delete pMemoryStatus;
-        return 0;
+        pMemoryStatus->dCommitted = GetMemoryCounter(MemoryCounterCommitted);
+        pMemoryStatus->dCommitLimit = GetMemoryCounter(MemoryCounterCommitLimit);
+        pMemoryStatus->dCache = GetMemoryCounter(MemoryCounterCache);
+        pMemoryStatus->dStandby = GetMemoryCounter(MemoryCounterStandbyReserve) +
+                                  GetMemoryCounter(MemoryCounterStandbyNormal) +
+                                  GetMemoryCounter(MemoryCounterStandbyCore);
+        pMemoryStatus->dModified = GetMemoryCounter(MemoryCounterModified);
+        pMemoryStatus->dPagesIn = GetMemoryCounter(MemoryCounterPagesInput);
+        pMemoryStatus->dPagesOut = GetMemoryCounter(MemoryCounterPagesOutput);
+    }
+    else
+    {
+        pMemoryStatus->dCommitted = pMemoryStatus->dCommitLimit = pMemoryStatus->dCache =
+            pMemoryStatus->dStandby = pMemoryStatus->dModified = pMemoryStatus->dPagesIn =
+            pMemoryStatus->dPagesOut = std::numeric_limits<double>::quiet_NaN();
     }
 
-    pMemoryStatus->qzMemoryLoad.sprintf("%d%", MemStat.dwMemoryLoad);
-    pMemoryStatus->qzAvailExtVirtual.sprintf("0");
-    pMemoryStatus->qzAvailPageFile.sprintf("%d MB", MemStat.ullAvailPageFile / 1048576);
-    pMemoryStatus->qzTotalPageFile.sprintf("%d MB", MemStat.ullTotalPageFile / 1048576);
-//    pMemoryStatus->qzAvailVirtual.sprintf("%d MB", MemStat.ullAvailVirtual / 1048576);
-//    pMemoryStatus->qzTotalVirtual.sprintf("%d MB", MemStat.ullTotalVirtual / 1048576);
-    pMemoryStatus->qzAvailPhys.sprintf("%d MB", MemStat.ullAvailPhys / 1048576);
-    pMemoryStatus->qzTotalPhys.sprintf("%d MB", MemStat.ullTotalPhys / 1048576);
-
-    return pMemoryStatus;
+    return Success;
 }
 
 
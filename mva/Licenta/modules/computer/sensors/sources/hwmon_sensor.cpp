@@ -0,0 +1,405 @@
+#include "../headers/hwmon_sensor.h"
+
+#ifndef STK_WINDOWS
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../../../utils/headers/self_profile.h"
+
+typedef struct _HWMON_ATTRIBUTE_
+{
+    SensorKind Kind;
+    int nIndex;
+}HwmonAttribute;
+
+static bool CompareAttributes(const HwmonAttribute &Left, const HwmonAttribute &Right)
+{
+    if( Left.Kind != Right.Kind )
+        return Left.Kind < Right.Kind;
+    return Left.nIndex < Right.nIndex;
+}
+
+// Reads a short text attribute and strips the trailing newline
+static bool ReadAttribute(const char *pszPath, char *pszValue, int nSize)
+{
+    int nFile = open(pszPath, O_RDONLY);
+    if( 0 > nFile )
+        return false;
+
+    ssize_t nRead = read(nFile, pszValue, nSize - 1);
+    close(nFile);
+    if( 0 >= nRead )
+        return false;
+
+    pszValue[nRead] = 0;
+    if( '\n' == pszValue[nRead - 1] )
+        pszValue[nRead - 1] = 0;
+
+    return true;
+}
+
+// <prefix><n>_input, n >= 1
+static bool ParseInput(const char *pszEntry, const char *pszPrefix, int *pnIndex)
+{
+    size_t nLength = strlen(pszPrefix);
+    char *pszEnd = NULL;
+
+    if( 0 != strncmp(pszEntry, pszPrefix, nLength) )
+        return false;
+
+    long lIndex = strtol(pszEntry + nLength, &pszEnd, 10);
+    if( pszEnd == pszEntry + nLength || 0 != strcmp(pszEnd, "_input") )
+        return false;
+
+    *pnIndex = (int)lIndex;
+    return true;
+}
+
+CHwmonInputs::CHwmonInputs()
+{
+}
+
+CHwmonInputs::~CHwmonInputs()
+{
+    Close();
+}
+
+int CHwmonInputs::AddDevice(const char *pszDirectory, const char *pszName, bool bPrefix, bool bTempsOnly)
+{
+    std::vector<HwmonAttribute> qAttributes;
+    char szPath[HWMON_PATH_SIZE], szLabel[SENSOR_NAME_SIZE];
+    HwmonAttribute Attribute;
+    struct dirent *pEntry = NULL;
+
+    DIR *pDirectory = opendir(pszDirectory);
+    if( !pDirectory )
+        return Unsuccessful;
+
+    while( NULL != (pEntry = readdir(pDirectory)) )
+    {
+        if( ParseInput(pEntry->d_name, "temp", &Attribute.nIndex) )
+            Attribute.Kind = SensorKindTemperature;
+        else if( bTempsOnly )
+            continue;
+        else if( ParseInput(pEntry->d_name, "in", &Attribute.nIndex) )
+            Attribute.Kind = SensorKindVoltage;
+        else if( ParseInput(pEntry->d_name, "fan", &Attribute.nIndex) )
+            Attribute.Kind = SensorKindFan;
+        else
+            continue;
+
+        qAttributes.push_back(Attribute);
+    }
+    closedir(pDirectory);
+
+    // readdir order is arbitrary, keep the channel list stable between runs
+    std::sort(qAttributes.begin(), qAttributes.end(), CompareAttributes);
+
+    for(size_t i = 0; i < qAttributes.size(); i++)
+    {
+        const char *pszType = NULL, *pszDefault = NULL;
+        HwmonInput Input;
+        SensorChannel Channel;
+
+        switch( qAttributes[i].Kind )
+        {
+        case SensorKindTemperature:
+            pszType = "temp";
+            pszDefault = "Temperature #%d";
+            Channel.Unit = SensorUnitCelsius;
+            Input.dScale = 0.001;
+            break;
+        case SensorKindVoltage:
+            pszType = "in";
+            pszDefault = "Voltage #%d";
+            Channel.Unit = SensorUnitVolt;
+            Input.dScale = 0.001;
+            break;
+        default:
+            pszType = "fan";
+            pszDefault = "Fan #%d";
+            Channel.Unit = SensorUnitRPM;
+            Input.dScale = 1;
+            break;
+        }
+
+        snprintf(szPath, sizeof(szPath), "%s/%s%d_input", pszDirectory, pszType, qAttributes[i].nIndex);
+        Input.nFile = open(szPath, O_RDONLY);
+        if( 0 > Input.nFile )
+            continue;
+
+        snprintf(szPath, sizeof(szPath), "%s/%s%d_label", pszDirectory, pszType, qAttributes[i].nIndex);
+        if( !ReadAttribute(szPath, szLabel, sizeof(szLabel)) )
+            snprintf(szLabel, sizeof(szLabel), pszDefault, qAttributes[i].nIndex);
+
+        Channel.Kind = qAttributes[i].Kind;
+        if( bPrefix )
+            snprintf(Channel.szLabel, sizeof(Channel.szLabel), "%s %s", pszName, szLabel);
+        else
+            snprintf(Channel.szLabel, sizeof(Channel.szLabel), "%s", szLabel);
+
+        m_qInputs.push_back(Input);
+        m_qChannels.push_back(Channel);
+    }
+
+    return Success;
+}
+
+int CHwmonInputs::Open(bool bCpu)
+{
+    std::vector<int> qDevices;
+    std::vector<std::string> qDirectories, qNames;
+    char szDirectory[HWMON_PATH_SIZE], szPath[HWMON_PATH_SIZE], szName[HWMON_READ_BUFFER_SIZE];
+    struct dirent *pEntry = NULL;
+    int nDevice = 0;
+
+    Close();
+
+    DIR *pDirectory = opendir(HWMON_CLASS_DIRECTORY);
+    if( !pDirectory )
+        return Unsuccessful;
+
+    while( NULL != (pEntry = readdir(pDirectory)) )
+    {
+        if( 1 == sscanf(pEntry->d_name, "hwmon%d", &nDevice) )
+            qDevices.push_back(nDevice);
+    }
+    closedir(pDirectory);
+
+    std::sort(qDevices.begin(), qDevices.end());
+
+    for(size_t i = 0; i < qDevices.size(); i++)
+    {
+        snprintf(szDirectory, sizeof(szDirectory), HWMON_CLASS_DIRECTORY "/hwmon%d", qDevices[i]);
+        snprintf(szPath, sizeof(szPath), "%s/name", szDirectory);
+
+        // Drivers older than 3.15 keep their attributes on the parent device
+        if( !ReadAttribute(szPath, szName, sizeof(szName)) )
+        {
+            snprintf(szDirectory, sizeof(szDirectory), HWMON_CLASS_DIRECTORY "/hwmon%d/device", qDevices[i]);
+            snprintf(szPath, sizeof(szPath), "%s/name", szDirectory);
+            if( !ReadAttribute(szPath, szName, sizeof(szName)) )
+                continue;
+        }
+
+        if( bCpu != HWMON_IS_CPU_DRIVER(szName) )
+            continue;
+
+        qDirectories.push_back(szDirectory);
+        qNames.push_back(szName);
+    }
+
+    for(size_t i = 0; i < qDirectories.size(); i++)
+    {
+        size_t nFirst = m_qInputs.size();
+
+        if( Success != AddDevice(qDirectories[i].c_str(), qNames[i].c_str(), !bCpu && 1 < qDirectories.size(), bCpu) )
+            continue;
+        if( nFirst == m_qInputs.size() )
+            continue;
+
+        if( !m_qzDevices.isEmpty() )
+            m_qzDevices += ", ";
+        m_qzDevices += qNames[i].c_str();
+    }
+
+    return m_qInputs.empty() ? Unsuccessful : Success;
+}
+
+void CHwmonInputs::Close()
+{
+    for(size_t i = 0; i < m_qInputs.size(); i++)
+        close(m_qInputs[i].nFile);
+
+    m_qInputs.clear();
+    m_qChannels.clear();
+    m_qzDevices.clear();
+}
+
+int CHwmonInputs::GetCount()
+{
+    return (int)m_qChannels.size();
+}
+
+const SensorChannel *CHwmonInputs::GetChannels()
+{
+    return m_qChannels.empty() ? NULL : &m_qChannels[0];
+}
+
+QString CHwmonInputs::GetDevices()
+{
+    return m_qzDevices;
+}
+
+int CHwmonInputs::Read(double *pValues)
+{
+    char szBuffer[HWMON_READ_BUFFER_SIZE];
+
+    if( !pValues )
+        return NullException;
+
+    if( m_qInputs.empty() )
+        return Uninitialized;
+
+    for(size_t i = 0; i < m_qInputs.size(); i++)
+    {
+        // unplugged fans and open thermistors fail with EIO or ENODATA
+        STK_PROFILE_SYSCALL();
+        ssize_t nRead = pread(m_qInputs[i].nFile, szBuffer, sizeof(szBuffer) - 1, 0);
+        if( 0 >= nRead )
+        {
+            pValues[i] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+
+        szBuffer[nRead] = 0;
+        pValues[i] = strtol(szBuffer, 0, 10) * m_qInputs[i].dScale;
+    }
+
+    return Success;
+}
+
+CHwmonSensor::CHwmonSensor()
+{
+}
+
+CHwmonSensor::~CHwmonSensor()
+{
+}
+
+int CHwmonSensor::Initialize()
+{
+    return m_Inputs.Open(false);
+}
+
+int CHwmonSensor::Destroy()
+{
+    m_Inputs.Close();
+
+    return Success;
+}
+
+int CHwmonSensor::GetChannelCount()
+{
+    return m_Inputs.GetCount();
+}
+
+const SensorChannel *CHwmonSensor::GetChannels()
+{
+    return m_Inputs.GetChannels();
+}
+
+int CHwmonSensor::Update(double *pValues)
+{
+    STK_PROFILE_SCOPE(ProfileModuleBoard);
+
+    return m_Inputs.Read(pValues);
+}
+
+QString CHwmonSensor::GetChipName()
+{
+    return m_Inputs.GetDevices();
+}
+
+CHwmonCpuSensor::CHwmonCpuSensor():
+    m_pTemps( NULL )
+{
+}
+
+CHwmonCpuSensor::~CHwmonCpuSensor()
+{
+    Destroy();
+}
+
+int CHwmonCpuSensor::Initialize()
+{
+    int nStatus = m_Inputs.Open(true);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    const SensorChannel *pChannels = m_Inputs.GetChannels();
+    for(int i = 0; i < m_Inputs.GetCount(); i++)
+    {
+        if( 0 == strncmp(pChannels[i].szLabel, "Core ", 5) )
+            m_qCoreInputs.push_back(i);
+    }
+
+    if( m_qCoreInputs.empty() )
+    {
+        for(int i = 0; i < m_Inputs.GetCount(); i++)
+            m_qCoreInputs.push_back(i);
+    }
+
+    m_qValues.resize(m_Inputs.GetCount());
+
+    m_pTemps = new double[m_qCoreInputs.size()];
+    CHECK_ALLOCATION_STATUS(m_pTemps);
+    memset(m_pTemps, 0, m_qCoreInputs.size() * sizeof(double));
+
+    return Success;
+}
+
+int CHwmonCpuSensor::Destroy()
+{
+    m_Inputs.Close();
+    m_qCoreInputs.clear();
+    m_qValues.clear();
+
+    delete[] m_pTemps;
+    m_pTemps = NULL;
+
+    return Success;
+}
+
+int CHwmonCpuSensor::Update()
+{
+    STK_PROFILE_SCOPE(ProfileModuleCpuTemperature);
+
+    if( m_qValues.empty() )
+        return Uninitialized;
+
+    int nStatus = m_Inputs.Read(&m_qValues[0]);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    for(size_t i = 0; i < m_qCoreInputs.size(); i++)
+        m_pTemps[i] = m_qValues[m_qCoreInputs[i]];
+
+    return Success;
+}
+
+double *CHwmonCpuSensor::GetTemps()
+{
+    return m_pTemps;
+}
+
+QString CHwmonCpuSensor::GetCpuName()
+{
+    return "";
+}
+
+QString CHwmonCpuSensor::GetMicroArchitecture()
+{
+    return m_Inputs.GetDevices();
+}
+
+int CHwmonCpuSensor::GetNumberOfCores()
+{
+    return (int)m_qCoreInputs.size();
+}
+
+int CHwmonCpuSensor::GetMultiplier()
+{
+    return 0;
+}
+
+CThermalThrottle *CHwmonCpuSensor::GetThermalThrottle()
+{
+    return NULL;
+}
+#endif
@@ -1,7 +1,16 @@
 #include "../headers/intel_temperature.h"
 
+#include <limits>
+
+#include "../../../../utils/headers/self_profile.h"
+
 CIntelCpuSensor::CIntelCpuSensor(int nFamily, int nModel, int nStepping, int nCoreCount):
+    m_pTopology( NULL ),
+    m_pMsrValues( NULL ),
+    m_pThrottle( NULL ),
+    m_bPackageThermal( false ),
     m_pTemps( NULL ),
+    m_pTjMax( NULL ),
     m_nFamily( 0 ), m_nModel( 0 ), m_nStepping( 0 ), m_nCoreCount( 0 ),
     m_nMultiplier( 0 )
 {
@@ -14,7 +23,35 @@ CIntelCpuSensor::CIntelCpuSensor(int nFamily, int nModel, int nStepping, int nCo
     int nStatus = m_pDriver->Initialize();
     CHECK_OPERATION_STATUS(nStatus);
 
+    // Physical cores of all processor groups, nCoreCount only covers the
+    // logical processors of the current group
+    m_pTopology = new CCpuTopology;
+    nStatus = m_pTopology->Initialize();
+    CHECK_OPERATION_STATUS(nStatus);
+    if (Success == nStatus)
+        m_nCoreCount = m_pTopology->GetCoreCount();
+
     m_pTemps = new double[m_nCoreCount];
+    memset(m_pTemps, 0, m_nCoreCount * sizeof(double));
+    // Room for IA32_THERM_STATUS and IA32_PACKAGE_THERM_STATUS per core
+    m_pMsrValues = new ULONGLONG[m_nCoreCount * 2];
+    memset(m_pMsrValues, 0, m_nCoreCount * 2 * sizeof(ULONGLONG));
+
+    // CPUID.06H:EAX[6], package thermal management, the other bits tell
+    // which log bits of the thermal status registers exist
+    int CPUIDINF[4];
+    unsigned long ulCpuidThermal = 0;
+    __cpuid(CPUIDINF, 0);
+    if (6 <= CPUIDINF[0])
+    {
+        __cpuid(CPUIDINF, 6);
+        ulCpuidThermal = (unsigned long)CPUIDINF[0];
+        m_bPackageThermal = 0 != (CPUIDINF[0] & 0x40);
+    }
+
+    m_pThrottle = new CThermalThrottle;
+    nStatus = m_pThrottle->Initialize(m_nCoreCount, ulCpuidThermal);
+    CHECK_OPERATION_STATUS(nStatus);
 }
 
 CIntelCpuSensor::~CIntelCpuSensor()
@@ -25,6 +62,11 @@ CIntelCpuSensor::~CIntelCpuSensor()
 
     SAFE_DELETE(m_pTjMax);
 
+    delete[] m_pMsrValues;
+    m_pMsrValues = NULL;
+    SAFE_DELETE(m_pThrottle);
+    SAFE_DELETE(m_pTopology);
+
     if (m_pDriver)
     {
         nStatus = m_pDriver->Destroy();
@@ -47,14 +89,12 @@ void CIntelCpuSensor::InitializeTjMaxTableFromMSR()
     m_pTjMax = new double[m_nCoreCount];
     CHECK_ALLOCATION(m_pTjMax);
 
-    int nStatus = Uninitialized;
-    ULONG ulEax = 0, ulEdx = 0;
+    int nStatus = m_pTopology->ReadCoreMsr(m_pDriver, IA32_TEMPERATURE_TARGET, m_pMsrValues);
 
     for(int i = 0; i < m_nCoreCount; i++)
     {
-        nStatus = m_pDriver->ReadMsr(IA32_TEMPERATURE_TARGET, &ulEax, &ulEdx);
-        if (Success == nStatus)
-            m_pTjMax[i] = (ulEax >> 16) & 0xFF;
+        if (Success == nStatus && m_pMsrValues[i])
+            m_pTjMax[i] = (m_pMsrValues[i] >> 16) & 0xFF;
         else
             m_pTjMax[i] = 100;
     }
@@ -207,25 +247,24 @@ int CIntelCpuSensor::Destroy()
 
 int CIntelCpuSensor::Update()
 {
-    int nStatus = Uninitialized;
-    BOOL bResult = FALSE;
-    DWORD_PTR dwProcAffinityMask = 0;
-    DWORD_PTR dwSysAffinityMask = 0;
-    DWORD_PTR dwCurrentMask = 1;
-    ULONG uiEax = 0, uiEdx = 0;
+    STK_PROFILE_SCOPE(ProfileModuleCpuTemperature);
+
+    const ULONG pRegisters[2] = { IA32_THERM_STATUS_MSR, IA32_PACKAGE_THERM_STATUS };
+    int nStride = m_bPackageThermal ? 2 : 1;
+    unsigned long ulCoreLogs = 0, ulPackageLogs = 0;
 
-    bResult = GetProcessAffinityMask(GetCurrentProcess(), &dwProcAffinityMask, &dwSysAffinityMask);
-    if (FALSE == bResult)
-        return Unsuccessful;
+    // Every core in one pass, no affinity changes
+    int nStatus = m_pTopology->ReadCoreMsrs(m_pDriver, pRegisters, nStride, m_pMsrValues);
+    CHECK_OPERATION_STATUS_EX(nStatus);
 
     for(int i = 0; i < m_nCoreCount; i++)
     {
-        dwCurrentMask = (DWORD_PTR)1 << i;
-
-        SetProcessAffinityMask(GetCurrentProcess(), dwCurrentMask);
-
-        nStatus = m_pDriver->ReadMsr(IA32_THERM_STATUS_MSR, &uiEax, &uiEdx);
-        CHECK_OPERATION_STATUS(nStatus);
+        ULONG uiEax = (ULONG)m_pMsrValues[i * nStride];
+        if (!(uiEax & THERM_STATUS_READING_VALID))
+        {
+            m_pTemps[i] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
 
         double dDeltaT = ((uiEax & 0x007F0000) >> 16);
         double dTjMax = m_pTjMax[i];
@@ -233,7 +272,13 @@ int CIntelCpuSensor::Update()
         m_pTemps[i] = dTjMax - dTSlope * dDeltaT;
     }
 
-    SetProcessAffinityMask(GetCurrentProcess(), dwProcAffinityMask);
+    m_pThrottle->Record(m_pMsrValues, nStride, SensorTimestamp(), &ulCoreLogs, &ulPackageLogs);
+
+    // Clear the log bits that were seen, the other logs are written as 1
+    if (ulCoreLogs)
+        m_pDriver->WriteMsrAllProcessors(IA32_THERM_STATUS_MSR, m_pThrottle->GetCoreClear(ulCoreLogs), 0);
+    if (ulPackageLogs)
+        m_pDriver->WriteMsrAllProcessors(IA32_PACKAGE_THERM_STATUS, m_pThrottle->GetPackageClear(ulPackageLogs), 0);
 
     return Success;
 }
@@ -302,3 +347,8 @@ int CIntelCpuSensor::GetMultiplier()
 {
     return m_nMultiplier;
 }
+
+CThermalThrottle *CIntelCpuSensor::GetThermalThrottle()
+{
+    return m_pThrottle;
+}
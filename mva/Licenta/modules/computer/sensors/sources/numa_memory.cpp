@@ -0,0 +1,242 @@
+#include "../headers/numa_memory.h"
+
+#ifndef STK_WINDOWS
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+#include "../../../../utils/headers/self_profile.h"
+
+CNumaMemory::CNumaMemory():
+    m_nNodes( 0 ),
+    m_bHasCounters( false )
+{
+    memset(m_pNodes, 0, sizeof(m_pNodes));
+
+#ifndef STK_WINDOWS
+    for(int i = 0; i < NUMA_MAX_NODES; i++)
+    {
+        m_pMeminfoFiles[i] = -1;
+        m_pNumastatFiles[i] = -1;
+    }
+#endif
+}
+
+CNumaMemory::~CNumaMemory()
+{
+#ifndef STK_WINDOWS
+    for(int i = 0; i < m_nNodes; i++)
+    {
+        if( 0 <= m_pMeminfoFiles[i] )
+            close(m_pMeminfoFiles[i]);
+        if( 0 <= m_pNumastatFiles[i] )
+            close(m_pNumastatFiles[i]);
+    }
+#endif
+}
+
+int CNumaMemory::GetNodeCount()
+{
+    return m_nNodes;
+}
+
+const NumaNodeMemory *CNumaMemory::GetNodes()
+{
+    return m_pNodes;
+}
+
+bool CNumaMemory::HasCounters()
+{
+    return m_bHasCounters;
+}
+
+#ifdef STK_WINDOWS
+int CNumaMemory::Initialize()
+{
+    ULONG ulHighestNode = 0;
+    ULONGLONG ullAvailable = 0;
+
+    if( !GetNumaHighestNodeNumber(&ulHighestNode) )
+        return Unsuccessful;
+
+    // Node numbers may be sparse, keep the ones the kernel answers for
+    m_nNodes = 0;
+    for(ULONG i = 0; i <= ulHighestNode && m_nNodes < NUMA_MAX_NODES; i++)
+    {
+        if( !GetNumaAvailableMemoryNodeEx((USHORT)i, &ullAvailable) )
+            continue;
+
+        m_pNodes[m_nNodes].nNode = (int)i;
+        m_pNodes[m_nNodes].ullFree = ullAvailable;
+        m_nNodes++;
+    }
+
+    if( 0 == m_nNodes )
+        return Unsuccessful;
+
+    // Windows does not expose numastat style counters
+    m_bHasCounters = false;
+
+    int nStatus = ReadNodeTotals();
+    if( Success != nStatus && 1 == m_nNodes )
+    {
+        MEMORYSTATUSEX MemStat;
+        ZeroMemory(&MemStat, sizeof(MEMORYSTATUSEX));
+        MemStat.dwLength = sizeof(MEMORYSTATUSEX);
+        if( GlobalMemoryStatusEx(&MemStat) )
+            m_pNodes[0].ullTotal = MemStat.ullTotalPhys;
+    }
+
+    return Success;
+}
+
+int CNumaMemory::ReadNodeTotals()
+{
+    PDH_HQUERY hQuery = NULL;
+    PDH_HCOUNTER hCounter = NULL;
+    PDH_FMT_COUNTERVALUE_ITEM_W *pItems = 0;
+    DWORD dwSize = 0, dwCount = 0;
+    int nStatus = Unsuccessful;
+
+    // The installed memory of a node does not change, query it once
+    if( ERROR_SUCCESS != PdhOpenQuery(NULL, NULL, &hQuery) )
+        return Unsuccessful;
+
+    if( ERROR_SUCCESS != PdhAddCounterW(hQuery, L"\\NUMA Node Memory(*)\\Total MBytes", NULL, &hCounter) ||
+        ERROR_SUCCESS != PdhCollectQueryData(hQuery) )
+        goto CLEANUP;
+
+    if( PDH_MORE_DATA != PdhGetFormattedCounterArrayW(hCounter, PDH_FMT_LARGE, &dwSize, &dwCount, NULL) )
+        goto CLEANUP;
+
+    pItems = (PDH_FMT_COUNTERVALUE_ITEM_W*)new BYTE[dwSize];
+    if( !pItems )
+    {
+        nStatus = NotAllocated;
+        goto CLEANUP;
+    }
+
+    if( ERROR_SUCCESS != PdhGetFormattedCounterArrayW(hCounter, PDH_FMT_LARGE, &dwSize, &dwCount, pItems) )
+        goto CLEANUP;
+
+    // Instances are named after the node number, plus "_Total"
+    for(DWORD i = 0; i < dwCount; i++)
+    {
+        wchar_t *pwszEnd = 0;
+        long lNode = wcstol(pItems[i].szName, &pwszEnd, 10);
+        if( pwszEnd == pItems[i].szName )
+            continue;
+
+        for(int j = 0; j < m_nNodes; j++)
+        {
+            if( m_pNodes[j].nNode == lNode )
+                m_pNodes[j].ullTotal = (unsigned long long)pItems[i].FmtValue.largeValue * 1048576;
+        }
+    }
+    nStatus = Success;
+
+CLEANUP:
+    delete[] (BYTE*)pItems;
+    PdhCloseQuery(hQuery);
+
+    return nStatus;
+}
+
+int CNumaMemory::Update()
+{
+    STK_PROFILE_SCOPE(ProfileModuleNumaMemory);
+
+    ULONGLONG ullAvailable = 0;
+
+    for(int i = 0; i < m_nNodes; i++)
+    {
+        if( GetNumaAvailableMemoryNodeEx((USHORT)m_pNodes[i].nNode, &ullAvailable) )
+            m_pNodes[i].ullFree = ullAvailable;
+    }
+
+    return m_nNodes ? Success : Uninitialized;
+}
+#else
+static unsigned long long ParseValue(const char *pszBuffer, const char *pszKey)
+{
+    const char *pszValue = strstr(pszBuffer, pszKey);
+    if( !pszValue )
+        return 0;
+
+    return strtoull(pszValue + strlen(pszKey), 0, 10);
+}
+
+int CNumaMemory::Initialize()
+{
+    char szPath[64];
+
+    // Keep the files open, every Update() is a pread() per file
+    m_nNodes = 0;
+    for(int i = 0; i < NUMA_MAX_NODES; i++)
+    {
+        snprintf(szPath, sizeof(szPath), "/sys/devices/system/node/node%d/meminfo", i);
+        int nMeminfo = open(szPath, O_RDONLY);
+        if( 0 > nMeminfo )
+            continue;
+
+        snprintf(szPath, sizeof(szPath), "/sys/devices/system/node/node%d/numastat", i);
+        m_pMeminfoFiles[m_nNodes] = nMeminfo;
+        m_pNumastatFiles[m_nNodes] = open(szPath, O_RDONLY);
+        if( 0 <= m_pNumastatFiles[m_nNodes] )
+            m_bHasCounters = true;
+
+        m_pNodes[m_nNodes].nNode = i;
+        m_nNodes++;
+    }
+
+    if( 0 == m_nNodes )
+        return Unsuccessful;
+
+    return Update();
+}
+
+int CNumaMemory::ReadNodeFile(int nFile, char *pszBuffer)
+{
+    STK_PROFILE_SYSCALL();
+    ssize_t nRead = pread(nFile, pszBuffer, NUMA_READ_BUFFER_SIZE - 1, 0);
+    if( 0 >= nRead )
+        return Unsuccessful;
+
+    pszBuffer[nRead] = 0;
+
+    return Success;
+}
+
+int CNumaMemory::Update()
+{
+    STK_PROFILE_SCOPE(ProfileModuleNumaMemory);
+
+    char szBuffer[NUMA_READ_BUFFER_SIZE];
+
+    for(int i = 0; i < m_nNodes; i++)
+    {
+        NumaNodeMemory *pNode = &m_pNodes[i];
+
+        // "Node 0 MemTotal:       16318412 kB"
+        if( Success == ReadNodeFile(m_pMeminfoFiles[i], szBuffer) )
+        {
+            pNode->ullTotal = ParseValue(szBuffer, "MemTotal:") * 1024;
+            pNode->ullFree = ParseValue(szBuffer, "MemFree:") * 1024;
+        }
+
+        if( 0 <= m_pNumastatFiles[i] && Success == ReadNodeFile(m_pNumastatFiles[i], szBuffer) )
+        {
+            pNode->ullHit = ParseValue(szBuffer, "numa_hit");
+            pNode->ullMiss = ParseValue(szBuffer, "numa_miss");
+            pNode->ullForeign = ParseValue(szBuffer, "numa_foreign");
+            pNode->ullLocal = ParseValue(szBuffer, "local_node");
+            pNode->ullRemote = ParseValue(szBuffer, "other_node");
+        }
+    }
+
+    return m_nNodes ? Success : Uninitialized;
+}
+#endif
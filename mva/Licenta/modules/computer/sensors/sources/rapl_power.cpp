@@ -0,0 +1,407 @@
+#include "../headers/rapl_power.h"
+
+#ifndef STK_WINDOWS
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+#include "../../../../utils/headers/self_profile.h"
+
+CRaplPower::CRaplPower():
+    m_nCounters( 0 ),
+    m_pCores( NULL ),
+    m_nCores( 0 ),
+    m_ullTimestamp( 0 )
+#ifdef STK_WINDOWS
+    , m_pDriver( NULL ),
+    m_pTopology( NULL ),
+    m_pCoreValues( NULL ),
+    m_nMsrs( 0 ),
+    m_pPackageValues( NULL )
+#endif
+{
+    memset(m_pCounters, 0, sizeof(m_pCounters));
+}
+
+CRaplPower::~CRaplPower()
+{
+    delete[] m_pCores;
+    m_pCores = NULL;
+
+#ifdef STK_WINDOWS
+    delete[] m_pCoreValues;
+    m_pCoreValues = NULL;
+    delete[] m_pPackageValues;
+    m_pPackageValues = NULL;
+    SAFE_DELETE(m_pTopology);
+
+    if( m_pDriver )
+    {
+        int nStatus = m_pDriver->Destroy();
+        CHECK_OPERATION_STATUS(nStatus);
+        SAFE_DELETE(m_pDriver);
+    }
+#else
+    for(int i = 0; i < m_nCounters; i++)
+    {
+        if( 0 <= m_pCounters[i].nFile )
+            close(m_pCounters[i].nFile);
+    }
+#endif
+}
+
+void CRaplPower::Accumulate(RaplCounter *pCounter, unsigned long long ullRaw, double dSeconds)
+{
+    // At most one wrap between two ticks, the fastest counters take minutes
+    unsigned long long ullDelta = ullRaw >= pCounter->ullRaw ?
+                ullRaw - pCounter->ullRaw : pCounter->ullRange - pCounter->ullRaw + ullRaw;
+
+    double dJoules = ullDelta * pCounter->dUnit;
+    pCounter->dEnergy += dJoules;
+    if( 0 < dSeconds )
+        pCounter->dPower = dJoules / dSeconds;
+    pCounter->ullRaw = ullRaw;
+}
+
+bool CRaplPower::HasDomain(RaplDomain Domain)
+{
+    for(int i = 0; i < m_nCounters; i++)
+    {
+        if( Domain == m_pCounters[i].Domain )
+            return true;
+    }
+
+    return false;
+}
+
+double CRaplPower::GetPower(RaplDomain Domain)
+{
+    double dPower = 0;
+
+    for(int i = 0; i < m_nCounters; i++)
+    {
+        if( Domain == m_pCounters[i].Domain )
+            dPower += m_pCounters[i].dPower;
+    }
+
+    return dPower;
+}
+
+double CRaplPower::GetEnergy(RaplDomain Domain)
+{
+    double dEnergy = 0;
+
+    for(int i = 0; i < m_nCounters; i++)
+    {
+        if( Domain == m_pCounters[i].Domain )
+            dEnergy += m_pCounters[i].dEnergy;
+    }
+
+    return dEnergy;
+}
+
+int CRaplPower::GetCoreCount()
+{
+    return m_nCores;
+}
+
+double CRaplPower::GetCorePower(int nCore)
+{
+    if( 0 > nCore || nCore >= m_nCores )
+        return 0;
+
+    return m_pCores[nCore].dPower;
+}
+
+#ifdef STK_WINDOWS
+int CRaplPower::AddMsrCounters(RaplDomain Domain, ULONG ulMsr, double dUnit)
+{
+    int nPackages = m_pTopology->GetPackageCount();
+
+    if( RaplDomainCount <= m_nMsrs || RAPL_MAX_COUNTERS < m_nCounters + nPackages )
+        return Unsuccessful;
+
+    // Missing domains fault in the driver
+    if( Success != m_pTopology->ReadPackageMsrs(m_pDriver, &ulMsr, 1, m_pPackageValues) )
+        return Unsuccessful;
+
+    for(int i = 0; i < nPackages; i++)
+    {
+        RaplCounter *pCounter = &m_pCounters[m_nCounters++];
+        pCounter->Domain = Domain;
+        pCounter->nPackage = i;
+        pCounter->nSlot = m_nMsrs;
+        pCounter->dUnit = dUnit;
+        pCounter->ullRange = 0x100000000ULL;
+        pCounter->ullRaw = m_pPackageValues[i] & 0xFFFFFFFF;
+    }
+
+    m_pMsrs[m_nMsrs++] = ulMsr;
+
+    return Success;
+}
+
+int CRaplPower::InitializeIntel(int nModel)
+{
+    ULONG ulEax = 0, ulEdx = 0;
+
+    int nStatus = m_pDriver->ReadMsr(MSR_RAPL_POWER_UNIT, &ulEax, &ulEdx);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    double dUnit = 1.0 / (1ULL << ((ulEax >> 8) & 0x1F));
+    double dDramUnit = dUnit;
+    switch( nModel )
+    {
+    case 0x3F: // Haswell-EP
+    case 0x4F: // Broadwell-EP
+    case 0x56: // Broadwell-DE
+    case 0x55: // Skylake-SP
+    case 0x57: // Knights Landing
+    case 0x85: // Knights Mill
+    case 0x6A: // Ice Lake-SP
+    case 0x8F: // Sapphire Rapids
+        dDramUnit = RAPL_DRAM_FIXED_UNIT;
+        break;
+    }
+
+    nStatus = AddMsrCounters(RaplDomainPackage, MSR_PKG_ENERGY_STATUS, dUnit);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    // Optional domains, depend on the part
+    AddMsrCounters(RaplDomainCores, MSR_PP0_ENERGY_STATUS, dUnit);
+    AddMsrCounters(RaplDomainUncore, MSR_PP1_ENERGY_STATUS, dUnit);
+    AddMsrCounters(RaplDomainDram, MSR_DRAM_ENERGY_STATUS, dDramUnit);
+
+    return Success;
+}
+
+int CRaplPower::InitializeAmd()
+{
+    ULONG ulEax = 0, ulEdx = 0;
+
+    int nStatus = m_pDriver->ReadMsr(MSR_AMD_RAPL_POWER_UNIT, &ulEax, &ulEdx);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    double dUnit = 1.0 / (1ULL << ((ulEax >> 8) & 0x1F));
+
+    nStatus = AddMsrCounters(RaplDomainPackage, MSR_AMD_PKG_ENERGY_STAT, dUnit);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    // Per core counters, gathered with one driver broadcast per tick
+    m_pCoreValues = new ULONGLONG[m_pTopology->GetCoreCount()];
+    CHECK_ALLOCATION_STATUS(m_pCoreValues);
+
+    if( Success != m_pTopology->ReadCoreMsr(m_pDriver, MSR_AMD_CORE_ENERGY_STAT, m_pCoreValues) )
+        return Success;
+
+    m_pCores = new RaplCounter[m_pTopology->GetCoreCount()];
+    CHECK_ALLOCATION_STATUS(m_pCores);
+
+    m_nCores = m_pTopology->GetCoreCount();
+    for(int i = 0; i < m_nCores; i++)
+    {
+        memset(&m_pCores[i], 0, sizeof(RaplCounter));
+        m_pCores[i].Domain = RaplDomainCores;
+        m_pCores[i].nPackage = m_pTopology->GetCores()[i].nPackage;
+        m_pCores[i].dUnit = dUnit;
+        m_pCores[i].ullRange = 0x100000000ULL;
+        m_pCores[i].ullRaw = m_pCoreValues[i] & 0xFFFFFFFF;
+    }
+
+    return Success;
+}
+
+int CRaplPower::Initialize()
+{
+    int CPUIDINF[4];
+    char szVendor[13];
+    int nStatus = Uninitialized;
+
+    m_pDriver = new CRing0Wrapper;
+    CHECK_ALLOCATION_STATUS(m_pDriver);
+
+    nStatus = m_pDriver->Initialize();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    __cpuid(CPUIDINF, 0);
+    memcpy(szVendor, &CPUIDINF[1], 4);
+    memcpy(szVendor + 4, &CPUIDINF[3], 4);
+    memcpy(szVendor + 8, &CPUIDINF[2], 4);
+    szVendor[12] = 0;
+
+    __cpuid(CPUIDINF, 1);
+    int nFamily = (CPUIDINF[0] >> 8) & 0xF;
+    int nModel = ((CPUIDINF[0] >> 4) & 0xF) | (((CPUIDINF[0] >> 16) & 0xF) << 4);
+    if( 0xF == nFamily )
+        nFamily += (CPUIDINF[0] >> 20) & 0xFF;
+
+    // Package scoped counters are read on one core of every package
+    m_pTopology = new CCpuTopology;
+    CHECK_ALLOCATION_STATUS(m_pTopology);
+
+    nStatus = m_pTopology->Initialize();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    m_pPackageValues = new ULONGLONG[m_pTopology->GetPackageCount() * RaplDomainCount];
+    CHECK_ALLOCATION_STATUS(m_pPackageValues);
+
+    if( 0 == strcmp(szVendor, "GenuineIntel") && 0x06 == nFamily )
+        nStatus = InitializeIntel(nModel);
+    else if( 0 == strcmp(szVendor, "AuthenticAMD") && 0x17 <= nFamily )
+        nStatus = InitializeAmd();
+    else
+        nStatus = Unsuccessful;
+
+    m_ullTimestamp = SensorTimestamp();
+
+    return nStatus;
+}
+
+int CRaplPower::Update()
+{
+    STK_PROFILE_SCOPE(ProfileModuleRaplPower);
+
+    if( 0 == m_nCounters )
+        return Uninitialized;
+
+    unsigned long long ullNow = SensorTimestamp();
+    double dSeconds = (ullNow - m_ullTimestamp) / 1000000.0;
+    m_ullTimestamp = ullNow;
+
+    // Every domain of every package in one pass
+    if( Success == m_pTopology->ReadPackageMsrs(m_pDriver, m_pMsrs, m_nMsrs, m_pPackageValues) )
+    {
+        for(int i = 0; i < m_nCounters; i++)
+        {
+            RaplCounter *pCounter = &m_pCounters[i];
+            Accumulate(pCounter, m_pPackageValues[pCounter->nPackage * m_nMsrs + pCounter->nSlot] & 0xFFFFFFFF, dSeconds);
+        }
+    }
+
+    if( m_nCores && Success == m_pTopology->ReadCoreMsr(m_pDriver, MSR_AMD_CORE_ENERGY_STAT, m_pCoreValues) )
+    {
+        for(int i = 0; i < m_nCores; i++)
+            Accumulate(&m_pCores[i], m_pCoreValues[i] & 0xFFFFFFFF, dSeconds);
+    }
+
+    return Success;
+}
+#else
+int CRaplPower::ReadCounterFile(int nFile, unsigned long long *pullValue)
+{
+    char szBuffer[RAPL_READ_BUFFER_SIZE];
+
+    STK_PROFILE_SYSCALL();
+    ssize_t nRead = pread(nFile, szBuffer, sizeof(szBuffer) - 1, 0);
+    if( 0 >= nRead )
+        return Unsuccessful;
+
+    szBuffer[nRead] = 0;
+    *pullValue = strtoull(szBuffer, 0, 10);
+
+    return Success;
+}
+
+int CRaplPower::AddFileCounter(RaplDomain Domain, const char *pszDirectory)
+{
+    char szPath[128];
+    unsigned long long ullRange = 0;
+
+    if( RAPL_MAX_COUNTERS <= m_nCounters )
+        return Unsuccessful;
+
+    snprintf(szPath, sizeof(szPath), "%s/max_energy_range_uj", pszDirectory);
+    int nFile = open(szPath, O_RDONLY);
+    if( 0 > nFile )
+        return Unsuccessful;
+    int nStatus = ReadCounterFile(nFile, &ullRange);
+    close(nFile);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    // energy_uj is usually root only
+    snprintf(szPath, sizeof(szPath), "%s/energy_uj", pszDirectory);
+    nFile = open(szPath, O_RDONLY);
+    if( 0 > nFile )
+        return Unsuccessful;
+
+    RaplCounter *pCounter = &m_pCounters[m_nCounters];
+    pCounter->Domain = Domain;
+    pCounter->nFile = nFile;
+    pCounter->dUnit = 1e-6;
+    pCounter->ullRange = ullRange + 1;
+    if( Success != ReadCounterFile(nFile, &pCounter->ullRaw) )
+    {
+        close(nFile);
+        return Unsuccessful;
+    }
+
+    m_nCounters++;
+
+    return Success;
+}
+
+int CRaplPower::Initialize()
+{
+    char szDirectory[64], szPath[96], szName[RAPL_READ_BUFFER_SIZE];
+
+    // intel-rapl:<package> and intel-rapl:<package>:<subdomain>, the AMD
+    // driver registers under the same names
+    for(int i = 0; i < RAPL_MAX_COUNTERS; i++)
+    {
+        snprintf(szDirectory, sizeof(szDirectory), "/sys/class/powercap/intel-rapl:%d", i);
+        if( Success != AddFileCounter(RaplDomainPackage, szDirectory) )
+            continue;
+
+        for(int j = 0; j < RaplDomainCount; j++)
+        {
+            snprintf(szDirectory, sizeof(szDirectory), "/sys/class/powercap/intel-rapl:%d:%d", i, j);
+            snprintf(szPath, sizeof(szPath), "%s/name", szDirectory);
+
+            int nFile = open(szPath, O_RDONLY);
+            if( 0 > nFile )
+                break;
+            ssize_t nRead = read(nFile, szName, sizeof(szName) - 1);
+            close(nFile);
+            if( 0 >= nRead )
+                continue;
+            szName[nRead] = 0;
+
+            if( 0 == strncmp(szName, "core", 4) )
+                AddFileCounter(RaplDomainCores, szDirectory);
+            else if( 0 == strncmp(szName, "uncore", 6) )
+                AddFileCounter(RaplDomainUncore, szDirectory);
+            else if( 0 == strncmp(szName, "dram", 4) )
+                AddFileCounter(RaplDomainDram, szDirectory);
+        }
+    }
+
+    m_ullTimestamp = SensorTimestamp();
+
+    return m_nCounters ? Success : Unsuccessful;
+}
+
+int CRaplPower::Update()
+{
+    STK_PROFILE_SCOPE(ProfileModuleRaplPower);
+
+    unsigned long long ullRaw = 0;
+
+    if( 0 == m_nCounters )
+        return Uninitialized;
+
+    unsigned long long ullNow = SensorTimestamp();
+    double dSeconds = (ullNow - m_ullTimestamp) / 1000000.0;
+    m_ullTimestamp = ullNow;
+
+    for(int i = 0; i < m_nCounters; i++)
+    {
+        if( Success == ReadCounterFile(m_pCounters[i].nFile, &ullRaw) )
+            Accumulate(&m_pCounters[i], ullRaw, dSeconds);
+    }
+
+    return Success;
+}
+#endif
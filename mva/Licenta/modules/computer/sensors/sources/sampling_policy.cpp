@@ -0,0 +1,224 @@
+#include "../headers/sampling_policy.h"
+
+#include <math.h>
+
+#include <limits>
+
+#include "../../../../utils/headers/utils.h"
+
+#ifndef STK_WINDOWS
+#include <time.h>
+#endif
+
+// Indexed by SensorUnit, the smallest move that counts next to the
+// relative deadband. Counters (SensorUnitNone) move on every event.
+static const double g_pDeadbands[] = { 0, 1, 0.05, 100, 5, 0, 0, 1, 200, 1048576, 50, 5, 100 };
+
+// Microseconds of user and kernel time of every thread of the process
+static unsigned long long GetProcessCpuTime()
+{
+#ifdef STK_WINDOWS
+    FILETIME Creation, Exit, Kernel, User;
+
+    if( !GetProcessTimes(GetCurrentProcess(), &Creation, &Exit, &Kernel, &User) )
+        return 0;
+
+    // 100 ns units
+    return ((((unsigned long long)Kernel.dwHighDateTime << 32) | Kernel.dwLowDateTime) +
+            (((unsigned long long)User.dwHighDateTime << 32) | User.dwLowDateTime)) / 10;
+#else
+    struct timespec Time;
+    if( 0 != clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &Time) )
+        return 0;
+
+    return (unsigned long long)Time.tv_sec * 1000000ULL + Time.tv_nsec / 1000;
+#endif
+}
+
+CSamplingPolicy::CSamplingPolicy():
+    m_bVisible( true ),
+    m_bOnBattery( false ),
+    m_nStableShift( 0 ),
+    m_nStableTicks( 0 ),
+    m_ullNext( 0 ),
+    m_ullFired( 0 ),
+    m_ullLastCpuTime( 0 ),
+    m_ullLastWallTime( 0 ),
+    m_uWakeups( 0 )
+{
+    memset(m_pActive, 0, sizeof(m_pActive));
+
+    m_Overhead.dCpuPercent = std::numeric_limits<double>::quiet_NaN();
+    m_Overhead.dWakeupsPerMinute = std::numeric_limits<double>::quiet_NaN();
+    m_Overhead.dInterval = SAMPLING_POLICY_QUANTUM;
+
+    m_ullAnchor = SensorTimestamp();
+}
+
+CSamplingPolicy::~CSamplingPolicy()
+{
+}
+
+void CSamplingPolicy::SetActive(SamplingSource Source, bool bActive)
+{
+    m_pActive[Source] = bActive;
+}
+
+bool CSamplingPolicy::IsActive(SamplingSource Source) const
+{
+    return m_pActive[Source];
+}
+
+void CSamplingPolicy::SetVisible(bool bVisible)
+{
+    m_bVisible = bVisible;
+}
+
+bool CSamplingPolicy::IsVisible() const
+{
+    return m_bVisible;
+}
+
+void CSamplingPolicy::SetOnBattery(bool bOnBattery)
+{
+    m_bOnBattery = bOnBattery;
+}
+
+// Nobody sees a page of a minimized window, only the tick keeps running
+bool CSamplingPolicy::IsRunning(SamplingSource Source) const
+{
+    return m_pActive[Source] && (m_bVisible || SamplingSourceSensors == Source);
+}
+
+int CSamplingPolicy::GetShift(SamplingSource Source) const
+{
+    int nShift = m_bOnBattery ? SAMPLING_POLICY_BATTERY_SHIFT : 0;
+
+    switch( Source )
+    {
+    case SamplingSourceSensors:
+        // An open page sets the pace, it shows every tick
+        if( IsRunning(SamplingSourceSensorsPage) )
+            return GetShift(SamplingSourceSensorsPage);
+        return nShift + m_nStableShift + SAMPLING_POLICY_BACKGROUND_SHIFT;
+    case SamplingSourceSensorsPage:
+        return nShift + (m_nStableShift < SAMPLING_POLICY_MAX_WATCHED_SHIFT ? m_nStableShift : SAMPLING_POLICY_MAX_WATCHED_SHIFT);
+    default:
+        return nShift;
+    }
+}
+
+int CSamplingPolicy::GetInterval(SamplingSource Source) const
+{
+    return SAMPLING_POLICY_QUANTUM << GetShift(Source);
+}
+
+void CSamplingPolicy::Observe(const CSensorSamples *pSamples)
+{
+    if( (int)m_qReferences.size() != pSamples->GetCount() )
+        m_qReferences.assign(pSamples->GetCount(), std::numeric_limits<double>::quiet_NaN());
+
+    const SensorDescriptor *pDescriptors = pSamples->GetDescriptors();
+    const double *pValues = pSamples->GetValues();
+    const int *pChanged = pSamples->GetChanged();
+    bool bMoved = false;
+
+    for(int i = 0; i < pSamples->GetChangedCount(); i++)
+    {
+        int nId = pChanged[i];
+        const SensorDescriptor *pDescriptor = &pDescriptors[nId];
+        double dValue = pValues[nId];
+        double dReference = m_qReferences[nId];
+
+        // The tool's own figures move with the interval itself
+        if( SensorKindOverhead == pDescriptor->Kind || dValue != dValue )
+            continue;
+
+        double dDeadband = fabs(dReference) * SAMPLING_POLICY_RELATIVE_DEADBAND;
+        if( dDeadband < g_pDeadbands[pDescriptor->Unit] || SensorUnitNone == pDescriptor->Unit )
+            dDeadband = g_pDeadbands[pDescriptor->Unit];
+
+        if( dReference != dReference || fabs(dValue - dReference) > dDeadband )
+        {
+            m_qReferences[nId] = dValue;
+            bMoved = true;
+        }
+    }
+
+    // A transient brings the quantum back at once, backing off is gradual
+    if( bMoved )
+    {
+        m_nStableShift = 0;
+        m_nStableTicks = 0;
+    }
+    else if( ++m_nStableTicks >= SAMPLING_POLICY_STABLE_TICKS && SAMPLING_POLICY_MAX_STABLE_SHIFT > m_nStableShift )
+    {
+        m_nStableShift++;
+        m_nStableTicks = 0;
+    }
+}
+
+unsigned int CSamplingPolicy::BeginWakeup()
+{
+    unsigned int uDue = 0;
+
+    m_uWakeups++;
+    m_ullFired = m_ullNext;
+
+    for(int i = 0; i < SamplingSourceCount; i++)
+    {
+        if( IsRunning((SamplingSource)i) && 0 == m_ullNext % (1ULL << GetShift((SamplingSource)i)) )
+            uDue |= 1 << i;
+    }
+
+    return uDue;
+}
+
+int CSamplingPolicy::Schedule()
+{
+    int nShift = -1;
+
+    for(int i = 0; i < SamplingSourceCount; i++)
+    {
+        if( IsRunning((SamplingSource)i) && (0 > nShift || GetShift((SamplingSource)i) < nShift) )
+            nShift = GetShift((SamplingSource)i);
+    }
+    if( 0 > nShift )
+        return -1;
+
+    // The next lattice point of the shortest interval, the longer ones are
+    // multiples of it and fall on the same wakeups
+    unsigned long long ullQuantum = SAMPLING_POLICY_QUANTUM * 1000ULL;
+    unsigned long long ullStep = 1ULL << nShift;
+    unsigned long long ullNow = SensorTimestamp();
+
+    m_ullNext = ((ullNow - m_ullAnchor) / ullQuantum / ullStep + 1) * ullStep;
+
+    // A coarse timer may fire up to 5% early, the clock then still reads the
+    // quantum before the point that just ran and it would come up again
+    if( m_ullNext <= m_ullFired )
+        m_ullNext = (m_ullFired / ullStep + 1) * ullStep;
+
+    return (int)((m_ullAnchor + m_ullNext * ullQuantum - ullNow + 999) / 1000);
+}
+
+const SamplingOverhead *CSamplingPolicy::GetOverhead()
+{
+    unsigned long long ullWallTime = SensorTimestamp();
+    unsigned long long ullCpuTime = GetProcessCpuTime();
+
+    if( m_ullLastWallTime && ullWallTime > m_ullLastWallTime )
+    {
+        double dElapsed = (double)(ullWallTime - m_ullLastWallTime);
+
+        m_Overhead.dCpuPercent = (ullCpuTime - m_ullLastCpuTime) * 100.0 / dElapsed;
+        m_Overhead.dWakeupsPerMinute = m_uWakeups * 60000000.0 / dElapsed;
+    }
+    m_Overhead.dInterval = GetInterval(SamplingSourceSensors);
+
+    m_ullLastWallTime = ullWallTime;
+    m_ullLastCpuTime = ullCpuTime;
+    m_uWakeups = 0;
+
+    return &m_Overhead;
+}
@@ -0,0 +1,454 @@
+#include "../headers/sensor_alarms.h"
+
+#include <algorithm>
+
+#include <QDateTime>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStringList>
+
+#include "../../../../utils/headers/utils.h"
+
+// Indexed by SensorGroup and SensorKind
+static const char *g_pszGroups[] = { "board", "cpu", "memory", "storage" };
+static const char *g_pszKinds[] = { "temperature", "voltage", "fan", "load", "memory",
+                                    "numa", "power", "clock", "residency", "throttle", "disk",
+                                    "overhead" };
+
+static bool CompareInstances(const SensorAlarmInstance &Left, const SensorAlarmInstance &Right)
+{
+    return Left.nSensorId < Right.nSensorId;
+}
+
+// Whitespace separated, a token may be quoted to keep its spaces
+static QStringList Tokenize(const QString &qsLine)
+{
+    QStringList qTokens;
+    QString qsToken;
+    bool bQuoted = false, bToken = false;
+
+    for(int i = 0; i < qsLine.length(); i++)
+    {
+        QChar Char = qsLine[i];
+
+        if( '"' == Char )
+        {
+            bQuoted = !bQuoted;
+            bToken = true;
+            continue;
+        }
+
+        if( !bQuoted && Char.isSpace() )
+        {
+            if( bToken )
+                qTokens.append(qsToken);
+            qsToken.clear();
+            bToken = false;
+            continue;
+        }
+
+        qsToken += Char;
+        bToken = true;
+    }
+
+    if( bToken )
+        qTokens.append(qsToken);
+
+    return qTokens;
+}
+
+static bool MatchName(const QString &qsPattern, const QString &qsName)
+{
+    if( "*" == qsPattern )
+        return true;
+
+    if( qsPattern.endsWith('*') )
+        return qsName.startsWith(qsPattern.left(qsPattern.length() - 1), Qt::CaseInsensitive);
+
+    return 0 == qsName.compare(qsPattern, Qt::CaseInsensitive);
+}
+
+CSensorAlarms::CSensorAlarms():
+    m_pSamples( NULL ),
+    m_ullLastEvaluate( 0 ),
+    m_uEpoch( 0 ),
+    m_pServer( NULL ),
+    m_pfnCallback( NULL ),
+    m_pContext( NULL ),
+    m_pfnBurstCallback( NULL ),
+    m_pBurstContext( NULL )
+{
+}
+
+CSensorAlarms::~CSensorAlarms()
+{
+    // the clients are children of the server
+    m_qClients.clear();
+    SAFE_DELETE(m_pServer);
+
+    if( m_LogFile.isOpen() )
+        m_LogFile.close();
+}
+
+int CSensorAlarms::ParseRule(const QString &qsLine, int nLine, QString *pqsGroup, QString *pqsKind, QString *pqsName)
+{
+    SensorAlarmRule Rule;
+    bool bOk = false;
+
+    QStringList qTokens = Tokenize(qsLine);
+    if( 5 > qTokens.count() || 0 == qTokens.count() % 2 )
+        return InvalidParameter;
+
+    *pqsGroup = qTokens[0].toLower();
+    *pqsKind = qTokens[1].toLower();
+    *pqsName = qTokens[2];
+
+    QString qsCondition = qTokens[3].toLower();
+    if( "above" == qsCondition )
+        Rule.Condition = SensorAlarmAbove;
+    else if( "below" == qsCondition )
+        Rule.Condition = SensorAlarmBelow;
+    else if( "rate-above" == qsCondition )
+        Rule.Condition = SensorAlarmRateAbove;
+    else if( "rate-below" == qsCondition )
+        Rule.Condition = SensorAlarmRateBelow;
+    else
+        return InvalidParameter;
+
+    Rule.dThreshold = qTokens[4].toDouble(&bOk);
+    if( !bOk )
+        return InvalidParameter;
+
+    Rule.dHysteresis = 0;
+    Rule.ullDuration = 0;
+    Rule.ullBurst = 0;
+    Rule.nLine = nLine;
+
+    for(int i = 5; i < qTokens.count(); i += 2)
+    {
+        double dValue = qTokens[i + 1].toDouble(&bOk);
+        if( !bOk || 0 > dValue )
+            return InvalidParameter;
+
+        if( 0 == qTokens[i].compare("for", Qt::CaseInsensitive) )
+            Rule.ullDuration = (unsigned long long)(dValue * 1000000);
+        else if( 0 == qTokens[i].compare("hysteresis", Qt::CaseInsensitive) )
+            Rule.dHysteresis = dValue;
+        else if( 0 == qTokens[i].compare("burst", Qt::CaseInsensitive) )
+            Rule.ullBurst = (unsigned long long)(dValue * 1000000);
+        else
+            return InvalidParameter;
+    }
+
+    m_qRules.push_back(Rule);
+
+    return Success;
+}
+
+void CSensorAlarms::BindRule(int nRule, const QString &qsGroup, const QString &qsKind, const QString &qsName,
+                             std::vector<SensorAlarmInstance> &qInstances)
+{
+    const SensorDescriptor *pDescriptors = m_pSamples->GetDescriptors();
+    SensorAlarmInstance Instance;
+
+    memset(&Instance, 0, sizeof(SensorAlarmInstance));
+    Instance.nRule = nRule;
+    Instance.State = SensorAlarmIdle;
+
+    for(int i = 0; i < m_pSamples->GetCount(); i++)
+    {
+        if( "*" != qsGroup && qsGroup != g_pszGroups[pDescriptors[i].Group] )
+            continue;
+        if( "*" != qsKind && qsKind != g_pszKinds[pDescriptors[i].Kind] )
+            continue;
+        if( !MatchName(qsName, SensorShortName(pDescriptors[i].szName)) )
+            continue;
+
+        Instance.nSensorId = i;
+        qInstances.push_back(Instance);
+    }
+}
+
+int CSensorAlarms::Load(const QString &qsRulesFile, const CSensorSamples *pSamples)
+{
+    std::vector<SensorAlarmInstance> qInstances;
+    QString qsGroup, qsKind, qsName;
+    int nLine = 0;
+
+    if( !pSamples )
+        return NullException;
+
+    m_pSamples = pSamples;
+    m_qRules.clear();
+    m_qInstances.clear();
+    m_qArmed.clear();
+
+    int nCount = pSamples->GetCount();
+    m_qSensorFirst.assign(nCount + 1, 0);
+    m_qLastValues.assign(pSamples->GetValues(), pSamples->GetValues() + nCount);
+
+    QFile File(qsRulesFile);
+    if( !File.exists() )
+        return Success;
+    if( !File.open(QIODevice::ReadOnly | QIODevice::Text) )
+        return Unsuccessful;
+
+    while( !File.atEnd() )
+    {
+        QString qsLine = QString::fromUtf8(File.readLine()).trimmed();
+        nLine++;
+
+        if( qsLine.isEmpty() || qsLine.startsWith('#') )
+            continue;
+
+        if( Success != ParseRule(qsLine, nLine, &qsGroup, &qsKind, &qsName) )
+        {
+            qDebug("Invalid alarm rule at line %d", nLine);
+            continue;
+        }
+
+        BindRule((int)m_qRules.size() - 1, qsGroup, qsKind, qsName, qInstances);
+    }
+
+    std::stable_sort(qInstances.begin(), qInstances.end(), CompareInstances);
+    m_qInstances.swap(qInstances);
+
+    for(size_t i = 0; i < m_qInstances.size(); i++)
+        m_qSensorFirst[m_qInstances[i].nSensorId + 1]++;
+    for(int i = 0; i < nCount; i++)
+        m_qSensorFirst[i + 1] += m_qSensorFirst[i];
+
+    m_qArmed.reserve(m_qInstances.size());
+    m_qNextArmed.reserve(m_qInstances.size());
+
+    return Success;
+}
+
+int CSensorAlarms::OpenLog(const QString &qsLogFile)
+{
+    m_LogFile.setFileName(qsLogFile);
+
+    return m_LogFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text) ? Success : Unsuccessful;
+}
+
+int CSensorAlarms::Listen(const QString &qsSocketName)
+{
+    SAFE_DELETE(m_pServer);
+    m_qClients.clear();
+
+    m_pServer = new QLocalServer;
+    CHECK_ALLOCATION_STATUS(m_pServer);
+
+    // a crashed instance leaves its socket file behind on Unix
+    QLocalServer::removeServer(qsSocketName);
+
+    if( !m_pServer->listen(qsSocketName) )
+    {
+        SAFE_DELETE(m_pServer);
+        return Unsuccessful;
+    }
+
+    return Success;
+}
+
+void CSensorAlarms::SetCallback(SensorAlarmCallback pfnCallback, void *pContext)
+{
+    m_pfnCallback = pfnCallback;
+    m_pContext = pContext;
+}
+
+void CSensorAlarms::SetBurstCallback(SensorAlarmBurstCallback pfnCallback, void *pContext)
+{
+    m_pfnBurstCallback = pfnCallback;
+    m_pBurstContext = pContext;
+}
+
+void CSensorAlarms::Emit(const SensorAlarmInstance *pInstance, bool bRaised, double dValue, unsigned long long ullTimestamp)
+{
+    const SensorAlarmRule *pRule = &m_qRules[pInstance->nRule];
+    const SensorDescriptor *pDescriptor = &m_pSamples->GetDescriptors()[pInstance->nSensorId];
+    SensorAlarmEvent Event;
+
+    Event.nRule = pInstance->nRule;
+    Event.nSensorId = pInstance->nSensorId;
+    Event.bRaised = bRaised;
+    Event.dValue = dValue;
+    Event.ullTimestamp = ullTimestamp;
+
+    bool bRate = SensorAlarmRateAbove == pRule->Condition || SensorAlarmRateBelow == pRule->Condition;
+    QString qsValue = bRate ? QString().sprintf("%.3f/s", dValue) : SensorFormatValue(dValue, pDescriptor->Unit);
+    QString qsSensor = SensorShortName(pDescriptor->szName);
+    if( 0 <= pDescriptor->nInstance )
+        qsSensor += QString().sprintf(" (%d)", pDescriptor->nInstance);
+
+    QString qsMessage = QString("%1 %2 line %3: %4 %5 %6 %7 %8, value %9")
+            .arg(QDateTime::currentDateTime().toString(Qt::ISODate))
+            .arg(bRaised ? "RAISED" : "CLEARED")
+            .arg(pRule->nLine)
+            .arg(g_pszGroups[pDescriptor->Group])
+            .arg(g_pszKinds[pDescriptor->Kind])
+            .arg(qsSensor)
+            .arg(SENSOR_ALARM_CONDITION_STRING(pRule->Condition))
+            .arg(pRule->dThreshold)
+            .arg(qsValue);
+
+    if( m_LogFile.isOpen() )
+    {
+        m_LogFile.write(qsMessage.toUtf8() + "\n");
+        m_LogFile.flush();
+    }
+
+    if( m_pfnCallback )
+        m_pfnCallback(&Event, qsMessage, m_pContext);
+
+    if( !m_pServer )
+        return;
+
+    while( m_pServer->hasPendingConnections() )
+        m_qClients.append(m_pServer->nextPendingConnection());
+
+    QByteArray qLine = qsMessage.toUtf8() + "\n";
+    for(int i = m_qClients.count() - 1; i >= 0; i--)
+    {
+        QLocalSocket *pClient = m_qClients[i];
+        if( QLocalSocket::ConnectedState != pClient->state() )
+        {
+            m_qClients.removeAt(i);
+            pClient->deleteLater();
+            continue;
+        }
+
+        pClient->write(qLine);
+        pClient->flush();
+    }
+}
+
+void CSensorAlarms::EvaluateInstance(int nInstance, unsigned long long ullNow, double dSeconds)
+{
+    SensorAlarmInstance *pInstance = &m_qInstances[nInstance];
+    if( m_uEpoch == pInstance->uEpoch )
+        return;
+    pInstance->uEpoch = m_uEpoch;
+
+    const SensorAlarmRule *pRule = &m_qRules[pInstance->nRule];
+    double dValue = m_pSamples->GetValues()[pInstance->nSensorId];
+    bool bHolds = false, bCleared = false;
+
+    if( SensorAlarmRateAbove == pRule->Condition || SensorAlarmRateBelow == pRule->Condition )
+        dValue = 0 < dSeconds ? (dValue - m_qLastValues[pInstance->nSensorId]) / dSeconds : 0;
+
+    // NaN neither raises nor clears
+    switch( pRule->Condition )
+    {
+    case SensorAlarmAbove:
+    case SensorAlarmRateAbove:
+        bHolds = dValue > pRule->dThreshold;
+        bCleared = dValue <= pRule->dThreshold - pRule->dHysteresis;
+        break;
+    default:
+        bHolds = dValue < pRule->dThreshold;
+        bCleared = dValue >= pRule->dThreshold + pRule->dHysteresis;
+        break;
+    }
+
+    switch( pInstance->State )
+    {
+    case SensorAlarmIdle:
+        if( !bHolds )
+            break;
+        pInstance->State = SensorAlarmPending;
+        pInstance->ullSince = ullNow;
+        if( pRule->ullBurst && m_pfnBurstCallback )
+            m_pfnBurstCallback(pInstance->nSensorId, pRule->ullBurst, m_pBurstContext);
+        // fall through, a rule without duration raises on the first sample
+    case SensorAlarmPending:
+        if( !bHolds )
+            pInstance->State = SensorAlarmIdle;
+        else if( ullNow - pInstance->ullSince >= pRule->ullDuration )
+        {
+            pInstance->State = SensorAlarmActive;
+            Emit(pInstance, true, dValue, ullNow);
+        }
+        break;
+    case SensorAlarmActive:
+        if( bCleared )
+        {
+            pInstance->State = SensorAlarmIdle;
+            Emit(pInstance, false, dValue, ullNow);
+        }
+        break;
+    }
+
+    if( SensorAlarmIdle != pInstance->State )
+        m_qNextArmed.push_back(nInstance);
+}
+
+int CSensorAlarms::Evaluate()
+{
+    if( !m_pSamples )
+        return Uninitialized;
+
+    if( m_qInstances.empty() )
+        return Success;
+
+    unsigned long long ullNow = SensorTimestamp();
+    double dSeconds = m_ullLastEvaluate ? (ullNow - m_ullLastEvaluate) / 1000000.0 : 0;
+    m_ullLastEvaluate = ullNow;
+    m_uEpoch++;
+
+    const int *pChanged = m_pSamples->GetChanged();
+    int nChanged = m_pSamples->GetChangedCount();
+    const double *pValues = m_pSamples->GetValues();
+
+    m_qNextArmed.clear();
+
+    for(int i = 0; i < nChanged; i++)
+    {
+        int nId = pChanged[i];
+        for(int j = m_qSensorFirst[nId]; j < m_qSensorFirst[nId + 1]; j++)
+            EvaluateInstance(j, ullNow, dSeconds);
+    }
+
+    // pending ones need the clock to reach their duration, active rate
+    // rules need to see a sensor that stopped moving
+    for(size_t i = 0; i < m_qArmed.size(); i++)
+        EvaluateInstance(m_qArmed[i], ullNow, dSeconds);
+
+    m_qArmed.swap(m_qNextArmed);
+
+    for(int i = 0; i < nChanged; i++)
+        m_qLastValues[pChanged[i]] = pValues[pChanged[i]];
+
+    return Success;
+}
+
+int CSensorAlarms::GetRuleCount() const
+{
+    return (int)m_qRules.size();
+}
+
+int CSensorAlarms::GetBurstRuleCount() const
+{
+    int nRules = 0;
+
+    for(size_t i = 0; i < m_qRules.size(); i++)
+    {
+        if( m_qRules[i].ullBurst )
+            nRules++;
+    }
+
+    return nRules;
+}
+
+int CSensorAlarms::GetActiveCount() const
+{
+    int nActive = 0;
+
+    for(size_t i = 0; i < m_qArmed.size(); i++)
+    {
+        if( SensorAlarmActive == m_qInstances[m_qArmed[i]].State )
+            nActive++;
+    }
+
+    return nActive;
+}
@@ -0,0 +1,365 @@
+#include "../headers/sensor_burst.h"
+
+#include <chrono>
+
+#include <QDateTime>
+#include <QStringList>
+
+#include "../../../../utils/headers/utils.h"
+
+#ifdef STK_WINDOWS
+#include <mmsystem.h>                   // timeBeginPeriod, the default 15.6 ms tick is too coarse
+#else
+#include <pthread.h>
+#endif
+
+// Indexed by SensorKind
+static const char *g_pszKinds[] = { "temperature", "voltage", "fan", "load", "memory",
+                                    "numa", "power", "clock", "residency", "throttle", "disk",
+                                    "overhead" };
+
+CSensorBurst::CSensorBurst():
+    m_pSamples( NULL ),
+    m_nSources( 0 ),
+    m_pRings( NULL ),
+    m_nRings( 0 ),
+    m_nRate( SENSOR_BURST_DEFAULT_RATE ),
+    m_ullTriggered( 0 ),
+    m_ullCaptureEnd( 0 ),
+    m_bSuspended( false ),
+    m_bStop( false )
+{
+    memset(m_pSources, 0, sizeof(m_pSources));
+}
+
+CSensorBurst::~CSensorBurst()
+{
+    Stop();
+
+    delete[] m_pRings;
+    m_pRings = NULL;
+}
+
+int CSensorBurst::ReadConfig(const QString &qsFile, int *pnRate, unsigned int *puSources)
+{
+    QFile File(qsFile);
+    bool bOk = false;
+
+    if( !File.open(QIODevice::ReadOnly | QIODevice::Text) )
+        return Unsuccessful;
+
+    *pnRate = SENSOR_BURST_DEFAULT_RATE;
+    *puSources = 0;
+
+    while( !File.atEnd() )
+    {
+        QString qsLine = QString::fromUtf8(File.readLine()).trimmed();
+        if( qsLine.isEmpty() || qsLine.startsWith('#') )
+            continue;
+
+        QStringList qTokens = qsLine.split(' ', QString::SkipEmptyParts);
+        if( 2 != qTokens.count() )
+            return InvalidParameter;
+
+        if( 0 == qTokens[0].compare("rate", Qt::CaseInsensitive) )
+        {
+            *pnRate = qTokens[1].toInt(&bOk);
+            if( !bOk || SENSOR_BURST_MIN_RATE > *pnRate || SENSOR_BURST_MAX_RATE < *pnRate )
+                return InvalidParameter;
+            continue;
+        }
+
+        if( 0 != qTokens[0].compare("source", Qt::CaseInsensitive) )
+            return InvalidParameter;
+
+        int nSource = 0;
+        while( SensorBurstSourceCount > nSource &&
+               0 != qTokens[1].compare(SENSOR_BURST_SOURCE_STRING((SensorBurstSourceType)nSource), Qt::CaseInsensitive) )
+            nSource++;
+        if( SensorBurstSourceCount == nSource )
+            return InvalidParameter;
+
+        *puSources |= 1 << nSource;
+    }
+
+    return *puSources ? Success : InvalidParameter;
+}
+
+int CSensorBurst::AddSource(int nFirstId, int nCount, SensorBurstRead pfnRead, void *pContext)
+{
+    if( !pfnRead || 0 > nFirstId || 0 >= nCount )
+        return InvalidParameter;
+
+    if( SENSOR_BURST_MAX_SOURCES == m_nSources || m_Sampler.joinable() )
+        return Unsuccessful;
+
+    SensorBurstSource *pSource = &m_pSources[m_nSources++];
+    pSource->nFirstId = nFirstId;
+    pSource->nCount = nCount;
+    pSource->nFirstRing = m_nRings;
+    pSource->pfnRead = pfnRead;
+    pSource->pContext = pContext;
+
+    m_nRings += nCount;
+
+    return Success;
+}
+
+int CSensorBurst::Start(const CSensorSamples *pSamples, int nRate, const QString &qsLogFile)
+{
+    if( !pSamples )
+        return NullException;
+
+    if( 0 == m_nSources || SENSOR_BURST_MIN_RATE > nRate || SENSOR_BURST_MAX_RATE < nRate )
+        return InvalidParameter;
+
+    if( m_Sampler.joinable() )
+        return Success;
+
+    m_pSamples = pSamples;
+    m_nRate = nRate;
+
+    // Everything the thread needs is allocated here, once
+    m_pRings = new CSensorRing<SensorRawSample, SENSOR_BURST_RING_SIZE>[m_nRings];
+    CHECK_ALLOCATION_STATUS(m_pRings);
+
+    int nMaxCount = 0;
+    for(int i = 0; i < m_nSources; i++)
+    {
+        if( m_pSources[i].nCount > nMaxCount )
+            nMaxCount = m_pSources[i].nCount;
+    }
+    m_qValues.resize(nMaxCount);
+    m_qCapture.resize(SENSOR_BURST_RING_SIZE);
+
+    // Without a log the captures still land in the rings
+    m_LogFile.setFileName(qsLogFile);
+    int nStatus = m_LogFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text) ? Success : Unsuccessful;
+    CHECK_OPERATION_STATUS(nStatus);
+
+    m_bStop = false;
+    m_ullTriggered = 0;
+    m_ullCaptureEnd = 0;
+    m_Sampler = std::thread(&CSensorBurst::SamplerThread, this);
+
+    // Best effort, a busy foreground must not stretch the sampling period.
+    // Real time scheduling needs privileges on Linux, it is simply refused.
+#ifdef STK_WINDOWS
+    SetThreadPriority(m_Sampler.native_handle(), THREAD_PRIORITY_HIGHEST);
+#else
+    sched_param Param;
+    Param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    pthread_setschedparam(m_Sampler.native_handle(), SCHED_FIFO, &Param);
+#endif
+
+    return Success;
+}
+
+void CSensorBurst::Stop()
+{
+    if( !m_Sampler.joinable() )
+        return;
+
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_bStop = true;
+    }
+    m_Condition.notify_one();
+    m_Sampler.join();
+
+    m_LogFile.close();
+}
+
+void CSensorBurst::Trigger(unsigned long long ullDuration)
+{
+    if( !m_Sampler.joinable() || 0 == ullDuration )
+        return;
+
+    if( ullDuration > SENSOR_BURST_MAX_DURATION )
+        ullDuration = SENSOR_BURST_MAX_DURATION;
+
+    unsigned long long ullNow = SensorTimestamp();
+
+    // The sampler is already running, it only has to know what to write
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    if( m_bSuspended )
+        return;
+    if( 0 == m_ullCaptureEnd )
+        m_ullTriggered = ullNow;
+
+    // An extended capture still has to fit the rings with its history
+    unsigned long long ullEnd = ullNow + ullDuration;
+    if( ullEnd > m_ullTriggered + SENSOR_BURST_MAX_DURATION )
+        ullEnd = m_ullTriggered + SENSOR_BURST_MAX_DURATION;
+    if( ullEnd > m_ullCaptureEnd )
+        m_ullCaptureEnd = ullEnd;
+}
+
+void CSensorBurst::Suspend(bool bSuspend)
+{
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_bSuspended = bSuspend;
+    }
+    m_Condition.notify_one();
+}
+
+std::mutex &CSensorBurst::GetHardwareMutex()
+{
+    return m_HardwareMutex;
+}
+
+int CSensorBurst::GetRate() const
+{
+    return m_nRate;
+}
+
+int CSensorBurst::FindRing(int nId) const
+{
+    for(int i = 0; i < m_nSources; i++)
+    {
+        const SensorBurstSource *pSource = &m_pSources[i];
+        if( nId >= pSource->nFirstId && nId < pSource->nFirstId + pSource->nCount )
+            return pSource->nFirstRing + nId - pSource->nFirstId;
+    }
+
+    return -1;
+}
+
+int CSensorBurst::ReadRaw(int nId, SensorRawSample *pOut, int nMax) const
+{
+    int nRing = FindRing(nId);
+    if( !m_pRings || 0 > nRing || !pOut )
+        return 0;
+
+    return m_pRings[nRing].Read(pOut, nMax);
+}
+
+void CSensorBurst::Sample()
+{
+    for(int i = 0; i < m_nSources; i++)
+    {
+        const SensorBurstSource *pSource = &m_pSources[i];
+        int nStatus = Unsuccessful;
+
+        {
+            std::lock_guard<std::mutex> Lock(m_HardwareMutex);
+            nStatus = pSource->pfnRead(pSource->pContext, &m_qValues[0]);
+        }
+
+        if( Success != nStatus )
+            continue;
+
+        SensorRawSample Raw;
+        Raw.ullTimestamp = SensorTimestamp();
+        for(int j = 0; j < pSource->nCount; j++)
+        {
+            Raw.dValue = m_qValues[j];
+            m_pRings[pSource->nFirstRing + j].Push(Raw);
+        }
+    }
+}
+
+void CSensorBurst::SamplerThread()
+{
+    unsigned long long ullPeriod = 1000000ULL / m_nRate;
+
+    for( ;; )
+    {
+        {
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+            while( m_bSuspended && !m_bStop )
+                m_Condition.wait(Lock);
+            if( m_bStop )
+                break;
+        }
+
+#ifdef STK_WINDOWS
+        timeBeginPeriod(1);
+#endif
+        unsigned long long ullNext = SensorTimestamp();
+        bool bSampling = true;
+
+        // Continuous, the history before a trigger is what the rings hold
+        while( bSampling )
+        {
+            unsigned long long ullTriggered = 0;
+
+            Sample();
+
+            // Missed periods are dropped, not sampled back to back
+            unsigned long long ullNow = SensorTimestamp();
+            ullNext += ullPeriod;
+            if( ullNext < ullNow )
+                ullNext = ullNow;
+
+            {
+                std::unique_lock<std::mutex> Lock(m_Mutex);
+                bSampling = !m_bStop && !m_bSuspended;
+                if( m_ullCaptureEnd && (!bSampling || ullNext >= m_ullCaptureEnd) )
+                {
+                    ullTriggered = m_ullTriggered;
+                    m_ullCaptureEnd = 0;
+                }
+            }
+
+            if( ullTriggered )
+                WriteCapture(ullTriggered, ullNow);
+
+            if( bSampling )
+            {
+                ullNow = SensorTimestamp();
+                if( ullNext > ullNow )
+                    std::this_thread::sleep_for(std::chrono::microseconds(ullNext - ullNow));
+            }
+        }
+#ifdef STK_WINDOWS
+        timeEndPeriod(1);
+#endif
+    }
+}
+
+void CSensorBurst::WriteCapture(unsigned long long ullTriggered, unsigned long long ullTo)
+{
+    if( !m_LogFile.isOpen() )
+        return;
+
+    unsigned long long ullFrom = ullTriggered > SENSOR_BURST_PRE_TRIGGER ? ullTriggered - SENSOR_BURST_PRE_TRIGGER : 0;
+
+    QString qsText = QString("%1 capture %2 ms at %3 Hz, %4 ms before the trigger\n")
+            .arg(QDateTime::currentDateTime().toString(Qt::ISODate))
+            .arg((int)((ullTo - ullFrom) / 1000))
+            .arg(m_nRate)
+            .arg((int)((ullTriggered - ullFrom) / 1000));
+
+    // Descriptors are registered before Start(), read only from then on
+    const SensorDescriptor *pDescriptors = m_pSamples->GetDescriptors();
+    for(int i = 0; i < m_nSources; i++)
+    {
+        const SensorBurstSource *pSource = &m_pSources[i];
+
+        for(int j = 0; j < pSource->nCount; j++)
+        {
+            const SensorDescriptor *pDescriptor = &pDescriptors[pSource->nFirstId + j];
+            int nCount = m_pRings[pSource->nFirstRing + j].Read(&m_qCapture[0], SENSOR_BURST_RING_SIZE);
+
+            QString qsSensor = SensorShortName(pDescriptor->szName);
+            if( 0 <= pDescriptor->nInstance )
+                qsSensor += QString().sprintf(" (%d)", pDescriptor->nInstance);
+            qsText += QString("  %1 %2:").arg(g_pszKinds[pDescriptor->Kind]).arg(qsSensor);
+
+            // ms from the trigger, negative before it, then the value
+            for(int k = 0; k < nCount; k++)
+            {
+                if( m_qCapture[k].ullTimestamp < ullFrom || m_qCapture[k].ullTimestamp > ullTo )
+                    continue;
+                qsText += QString().sprintf(" %.1f=", ((double)m_qCapture[k].ullTimestamp - (double)ullTriggered) / 1000.0);
+                qsText += SensorFormatValue(m_qCapture[k].dValue, pDescriptor->Unit);
+            }
+            qsText += "\n";
+        }
+    }
+
+    m_LogFile.write(qsText.toUtf8());
+    m_LogFile.flush();
+}
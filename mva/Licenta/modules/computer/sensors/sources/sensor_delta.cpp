@@ -0,0 +1,30 @@
+#include "../headers/sensor_delta.h"
+
+void SensorAppendSchema(std::string *psSchema, int nId, SensorUnit Unit)
+{
+    SensorSchemaItem Item;
+
+    Item.nId = nId;
+    Item.nUnit = Unit;
+
+    psSchema->append((const char*)&Item, sizeof(SensorSchemaItem));
+}
+
+void SensorPackDelta(const CSensorSamples *pSamples, bool bAll, std::string *psDelta)
+{
+    const double *pValues = pSamples->GetValues();
+    const int *pChanged = pSamples->GetChanged();
+    int nCount = bAll ? pSamples->GetCount() : pSamples->GetChangedCount();
+
+    // resize keeps the capacity of the previous ticks
+    psDelta->resize(nCount * sizeof(SensorDeltaItem));
+    if( 0 == nCount )
+        return;
+
+    SensorDeltaItem *pItems = (SensorDeltaItem*)&(*psDelta)[0];
+    for(int i = 0; i < nCount; i++)
+    {
+        pItems[i].nId = bAll ? i : pChanged[i];
+        pItems[i].dValue = pValues[pItems[i].nId];
+    }
+}
@@ -0,0 +1,519 @@
+#include "../headers/sensor_exporter.h"
+
+#ifdef STK_WINDOWS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define SENSOR_EXPORTER_SEND_FLAGS      0
+#define SENSOR_EXPORTER_POLL            WSAPoll
+typedef WSAPOLLFD SensorExporterPollFd;
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define SENSOR_EXPORTER_SEND_FLAGS      MSG_NOSIGNAL
+#define SENSOR_EXPORTER_POLL            poll
+typedef struct pollfd SensorExporterPollFd;
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+
+#include <QFile>
+#include <QStringList>
+
+#include "../../../../utils/headers/utils.h"
+
+// Indexed by SensorGroup, SensorKind and SensorUnit
+static const char *g_pszGroups[] = { "board", "cpu", "memory", "storage" };
+static const char *g_pszKinds[] = { "temperature", "voltage", "fan", "load", "memory",
+                                    "numa", "power", "clock", "residency", "throttle", "disk",
+                                    "overhead" };
+static const char *g_pszUnits[] = { "", "_celsius", "_volts", "_rpm", "_percent",
+                                    "_bytes", "_pages", "_watts", "_megahertz",
+                                    "_bytes_per_second", "_iops", "_milliseconds", "_pages_per_second" };
+
+static void CloseSocket(SensorExporterSocket hSocket)
+{
+#ifdef STK_WINDOWS
+    closesocket(hSocket);
+#else
+    close(hSocket);
+#endif
+}
+
+static int SetNonBlocking(SensorExporterSocket hSocket)
+{
+#ifdef STK_WINDOWS
+    u_long ulNonBlocking = 1;
+    return 0 == ioctlsocket(hSocket, FIONBIO, &ulNonBlocking) ? Success : Unsuccessful;
+#else
+    int nFlags = fcntl(hSocket, F_GETFL, 0);
+    return -1 != nFlags && -1 != fcntl(hSocket, F_SETFL, nFlags | O_NONBLOCK) ? Success : Unsuccessful;
+#endif
+}
+
+// The last socket call failed only for want of data or room, or was interrupted
+static bool WouldBlock()
+{
+#ifdef STK_WINDOWS
+    int nError = WSAGetLastError();
+    return WSAEWOULDBLOCK == nError || WSAEINTR == nError;
+#else
+    return EAGAIN == errno || EWOULDBLOCK == errno || EINTR == errno;
+#endif
+}
+
+QString SensorExporterLabel(const QString &qsValue)
+{
+    QString qsLabel = qsValue;
+
+    qsLabel.replace("\\", "\\\\");
+    qsLabel.replace("\"", "\\\"");
+    qsLabel.replace("\n", "\\n");
+
+    return qsLabel;
+}
+
+CSensorExporter::CSensorExporter():
+    m_pSamples( NULL ),
+    m_hListen( SENSOR_EXPORTER_INVALID_SOCKET ),
+    m_usPort( 0 ),
+    m_bStop( true ),
+    m_bNetwork( false )
+{
+}
+
+CSensorExporter::~CSensorExporter()
+{
+    Stop();
+}
+
+int CSensorExporter::Bind(const CSensorSamples *pSamples)
+{
+    std::map<std::string, int> qFamilies;
+    std::map<std::string, int>::iterator Family;
+
+    if( !pSamples )
+        return NullException;
+
+    m_pSamples = pSamples;
+    m_qSensorPrefixes.clear();
+    m_qSensorFamilies.clear();
+
+    const SensorDescriptor *pDescriptors = pSamples->GetDescriptors();
+    for(int i = 0; i < pSamples->GetCount(); i++)
+    {
+        const SensorDescriptor *pDescriptor = &pDescriptors[i];
+        std::string sMetric = "stk_";
+        const char *pszType = "gauge";
+
+        // the throttling counters and the numastat page counts only grow
+        if( SensorKindThrottle == pDescriptor->Kind )
+        {
+            sMetric += "throttle_events_total";
+            pszType = "counter";
+        }
+        else if( SensorKindNuma == pDescriptor->Kind && SensorUnitPages == pDescriptor->Unit )
+        {
+            sMetric += "numa_pages_total";
+            pszType = "counter";
+        }
+        else
+        {
+            sMetric += g_pszKinds[pDescriptor->Kind];
+            sMetric += g_pszUnits[pDescriptor->Unit];
+        }
+
+        Family = qFamilies.find(sMetric);
+        if( qFamilies.end() == Family )
+        {
+            SensorExporterFamily NewFamily;
+            NewFamily.sHeader = "# TYPE " + sMetric + " " + pszType + "\n";
+            m_qSensorFamilies.push_back(NewFamily);
+            Family = qFamilies.insert(std::make_pair(sMetric, (int)m_qSensorFamilies.size() - 1)).first;
+        }
+        m_qSensorFamilies[Family->second].qItems.push_back(i);
+
+        QString qsLabels = QString("group=\"%1\",sensor=\"%2\"")
+                .arg(g_pszGroups[pDescriptor->Group])
+                .arg(SensorExporterLabel(SensorShortName(pDescriptor->szName)));
+        // NUMA sensors are per node, disks per physical drive and the CPU
+        // time breakdown per logical CPU
+        if( SensorKindNuma == pDescriptor->Kind )
+            qsLabels += QString(",node=\"%1\"").arg(pDescriptor->nInstance);
+        else if( SensorKindDisk == pDescriptor->Kind )
+            qsLabels += QString(",disk=\"%1\"").arg(pDescriptor->nInstance);
+        else if( 0 <= pDescriptor->nInstance )
+            qsLabels += QString(",cpu=\"%1\"").arg(pDescriptor->nInstance);
+
+        m_qSensorPrefixes.push_back(sMetric + "{" + qsLabels.toUtf8().constData() + "} ");
+    }
+
+    return Success;
+}
+
+void CSensorExporter::AppendValue(std::string &sOut, double dValue)
+{
+    char szValue[32];
+
+    if( dValue != dValue )
+        sOut += "NaN";
+    else if( dValue > 1.7976931348623157e308 )
+        sOut += "+Inf";
+    else if( dValue < -1.7976931348623157e308 )
+        sOut += "-Inf";
+    else
+    {
+        sprintf(szValue, "%.10g", dValue);
+        sOut += szValue;
+    }
+}
+
+int CSensorExporter::Render()
+{
+    if( !m_pSamples )
+        return Uninitialized;
+
+    const double *pValues = m_pSamples->GetValues();
+
+    // keeps the capacity, after the first ticks nothing is allocated
+    m_sBack.clear();
+
+    for(size_t i = 0; i < m_qSensorFamilies.size(); i++)
+    {
+        const SensorExporterFamily *pFamily = &m_qSensorFamilies[i];
+
+        m_sBack += pFamily->sHeader;
+        for(size_t j = 0; j < pFamily->qItems.size(); j++)
+        {
+            m_sBack += m_qSensorPrefixes[pFamily->qItems[j]];
+            AppendValue(m_sBack, pValues[pFamily->qItems[j]]);
+            m_sBack += '\n';
+        }
+    }
+
+    for(size_t i = 0; i < m_qGaugeFamilies.size(); i++)
+    {
+        const SensorExporterFamily *pFamily = &m_qGaugeFamilies[i];
+
+        m_sBack += pFamily->sHeader;
+        for(size_t j = 0; j < pFamily->qItems.size(); j++)
+        {
+            const SensorExporterGauge *pGauge = &m_qGauges[pFamily->qItems[j]];
+            m_sBack += pGauge->sPrefix;
+            AppendValue(m_sBack, pGauge->dValue);
+            m_sBack += '\n';
+        }
+    }
+
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+    m_sFront.swap(m_sBack);
+
+    return Success;
+}
+
+void CSensorExporter::SetGauge(const char *pszMetric, const QString &qsLabels, double dValue)
+{
+    SetSeries(pszMetric, "gauge", qsLabels, dValue);
+}
+
+void CSensorExporter::SetCounter(const char *pszMetric, const QString &qsLabels, double dValue)
+{
+    SetSeries(pszMetric, "counter", qsLabels, dValue);
+}
+
+// The type is taken from the first series of a metric
+void CSensorExporter::SetSeries(const char *pszMetric, const char *pszType, const QString &qsLabels, double dValue)
+{
+    std::string sSeries = std::string(pszMetric) + "{" + qsLabels.toUtf8().constData() + "}";
+
+    std::map<std::string, int>::iterator Gauge = m_qGaugeIndex.find(sSeries);
+    if( m_qGaugeIndex.end() != Gauge )
+    {
+        m_qGauges[Gauge->second].dValue = dValue;
+        return;
+    }
+
+    std::map<std::string, int>::iterator Family = m_qGaugeFamilyIndex.find(pszMetric);
+    if( m_qGaugeFamilyIndex.end() == Family )
+    {
+        SensorExporterFamily NewFamily;
+        NewFamily.sHeader = std::string("# TYPE ") + pszMetric + " " + pszType + "\n";
+        m_qGaugeFamilies.push_back(NewFamily);
+        Family = m_qGaugeFamilyIndex.insert(std::make_pair(std::string(pszMetric), (int)m_qGaugeFamilies.size() - 1)).first;
+    }
+
+    SensorExporterGauge NewGauge;
+    NewGauge.sPrefix = sSeries + " ";
+    NewGauge.dValue = dValue;
+    m_qGauges.push_back(NewGauge);
+
+    int nGauge = (int)m_qGauges.size() - 1;
+    m_qGaugeIndex.insert(std::make_pair(sSeries, nGauge));
+    m_qGaugeFamilies[Family->second].qItems.push_back(nGauge);
+}
+
+void CSensorExporter::Respond(SensorExporterClient *pClient)
+{
+    char szHeader[256];
+
+    bool bMetrics = 0 == pClient->sRequest.compare(0, 13, "GET /metrics ") ||
+                    0 == pClient->sRequest.compare(0, 13, "GET /metrics?");
+
+    if( !bMetrics )
+    {
+        pClient->sResponse = "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 10\r\n"
+                             "Connection: close\r\n\r\nNot found\n";
+        return;
+    }
+
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+
+    sprintf(szHeader, "HTTP/1.1 200 OK\r\nContent-Type: " SENSOR_EXPORTER_CONTENT_TYPE "\r\n"
+            "Content-Length: %u\r\nConnection: close\r\n\r\n", (unsigned int)m_sFront.size());
+    pClient->sResponse.assign(szHeader);
+    pClient->sResponse.append(m_sFront);
+}
+
+bool CSensorExporter::Serve(SensorExporterClient *pClient)
+{
+    char szBuffer[SENSOR_EXPORTER_REQUEST_SIZE];
+
+    // only the request line matters, the headers are read and dropped
+    if( pClient->sResponse.empty() )
+    {
+        int nRead = recv(pClient->hSocket, szBuffer,
+                         (int)(SENSOR_EXPORTER_REQUEST_SIZE - 1 - pClient->sRequest.size()), 0);
+        if( 0 == nRead )
+            return false;
+        if( 0 > nRead )
+            return WouldBlock();
+
+        pClient->sRequest.append(szBuffer, nRead);
+        if( pClient->sRequest.size() < SENSOR_EXPORTER_REQUEST_SIZE - 1 &&
+            std::string::npos == pClient->sRequest.find("\r\n\r\n") &&
+            std::string::npos == pClient->sRequest.find("\n\n") )
+            return true;
+
+        // the socket is usually writable already, no need to wait a poll()
+        Respond(pClient);
+    }
+
+    while( pClient->nSent < pClient->sResponse.size() )
+    {
+        int nWritten = send(pClient->hSocket, pClient->sResponse.data() + pClient->nSent,
+                            (int)(pClient->sResponse.size() - pClient->nSent), SENSOR_EXPORTER_SEND_FLAGS);
+        if( 0 > nWritten )
+            return WouldBlock();
+        pClient->nSent += nWritten;
+    }
+
+    return false;
+}
+
+void CSensorExporter::Accept()
+{
+    while( m_qClients.size() < SENSOR_EXPORTER_MAX_CLIENTS )
+    {
+        SensorExporterSocket hClient = accept(m_hListen, NULL, NULL);
+        if( SENSOR_EXPORTER_INVALID_SOCKET == hClient )
+            return;
+
+        if( Success != SetNonBlocking(hClient) )
+        {
+            CloseSocket(hClient);
+            continue;
+        }
+
+        SensorExporterClient Client;
+        Client.hSocket = hClient;
+        Client.nSent = 0;
+        Client.Deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SENSOR_EXPORTER_TIMEOUT);
+        m_qClients.push_back(Client);
+    }
+}
+
+void CSensorExporter::ServerThread()
+{
+    std::vector<SensorExporterPollFd> qPoll;
+
+    // A scrape is a copy of the published buffer and the sends, every
+    // connection advances as far as its socket allows and waits in poll()
+    while( !m_bStop )
+    {
+        // a full table leaves the new connections in the listen backlog
+        bool bListen = m_qClients.size() < SENSOR_EXPORTER_MAX_CLIENTS;
+        int nFirst = bListen ? 1 : 0;
+
+        qPoll.resize(nFirst + m_qClients.size());
+        if( bListen )
+        {
+            qPoll[0].fd = m_hListen;
+            qPoll[0].events = POLLIN;
+            qPoll[0].revents = 0;
+        }
+        for(size_t i = 0; i < m_qClients.size(); i++)
+        {
+            qPoll[nFirst + i].fd = m_qClients[i].hSocket;
+            qPoll[nFirst + i].events = m_qClients[i].sResponse.empty() ? POLLIN : POLLOUT;
+            qPoll[nFirst + i].revents = 0;
+        }
+
+        int nReady = SENSOR_EXPORTER_POLL(qPoll.data(), (unsigned long)qPoll.size(), SENSOR_EXPORTER_POLL_INTERVAL);
+        if( 0 > nReady )
+        {
+            // out of memory and the like, do not spin on it
+            if( !WouldBlock() )
+                std::this_thread::sleep_for(std::chrono::milliseconds(SENSOR_EXPORTER_POLL_INTERVAL));
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point Now = std::chrono::steady_clock::now();
+
+        // backwards, an erase does not move the entries still to visit
+        for(size_t i = m_qClients.size(); i-- > 0; )
+        {
+            SensorExporterClient *pClient = &m_qClients[i];
+            bool bKeep = Now < pClient->Deadline;
+
+            if( bKeep && qPoll[nFirst + i].revents )
+                bKeep = Serve(pClient);
+
+            if( !bKeep )
+            {
+                CloseSocket(pClient->hSocket);
+                m_qClients.erase(m_qClients.begin() + i);
+            }
+        }
+
+        if( bListen && (qPoll[0].revents & POLLIN) )
+            Accept();
+    }
+
+    for(size_t i = 0; i < m_qClients.size(); i++)
+        CloseSocket(m_qClients[i].hSocket);
+    m_qClients.clear();
+}
+
+int CSensorExporter::Start(const QString &qsAddress, unsigned short usPort)
+{
+    struct sockaddr_in Address;
+    socklen_t nAddressSize = sizeof(Address);
+    int nReuse = 1;
+
+    if( m_Server.joinable() )
+        return Success;
+
+#ifdef STK_WINDOWS
+    WSADATA WsaData;
+    if( 0 != WSAStartup(MAKEWORD(2, 2), &WsaData) )
+        return Unsuccessful;
+#endif
+    m_bNetwork = true;
+
+    memset(&Address, 0, sizeof(Address));
+    Address.sin_family = AF_INET;
+    Address.sin_port = htons(usPort);
+    if( 1 != inet_pton(AF_INET, qsAddress.toLatin1().constData(), &Address.sin_addr) )
+    {
+        Stop();
+        return InvalidParameter;
+    }
+
+    m_hListen = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if( SENSOR_EXPORTER_INVALID_SOCKET == m_hListen )
+    {
+        Stop();
+        return InvalidHandle;
+    }
+
+    setsockopt(m_hListen, SOL_SOCKET, SO_REUSEADDR, (const char*)&nReuse, sizeof(nReuse));
+
+    if( 0 != bind(m_hListen, (struct sockaddr*)&Address, sizeof(Address)) || 0 != listen(m_hListen, SOMAXCONN) ||
+        Success != SetNonBlocking(m_hListen) ||
+        0 != getsockname(m_hListen, (struct sockaddr*)&Address, &nAddressSize) )
+    {
+        Stop();
+        return Unsuccessful;
+    }
+    m_usPort = ntohs(Address.sin_port);
+
+    m_bStop = false;
+    m_Server = std::thread(&CSensorExporter::ServerThread, this);
+
+    return Success;
+}
+
+void CSensorExporter::Stop()
+{
+    // the server thread sees the flag within one poll interval
+    m_bStop = true;
+
+    if( m_Server.joinable() )
+        m_Server.join();
+
+    if( SENSOR_EXPORTER_INVALID_SOCKET != m_hListen )
+    {
+        CloseSocket(m_hListen);
+        m_hListen = SENSOR_EXPORTER_INVALID_SOCKET;
+    }
+    m_usPort = 0;
+
+#ifdef STK_WINDOWS
+    if( m_bNetwork )
+        WSACleanup();
+#endif
+    m_bNetwork = false;
+}
+
+unsigned short CSensorExporter::GetPort() const
+{
+    return m_usPort;
+}
+
+int CSensorExporter::ReadConfig(const QString &qsFile, QString *pqsAddress, unsigned short *pusPort, bool *pbProfile)
+{
+    QFile File(qsFile);
+    bool bOk = false;
+
+    if( !File.open(QIODevice::ReadOnly | QIODevice::Text) )
+        return Unsuccessful;
+
+    while( !File.atEnd() )
+    {
+        QString qsLine = QString::fromUtf8(File.readLine()).trimmed();
+        if( qsLine.isEmpty() || qsLine.startsWith('#') )
+            continue;
+
+        QStringList qTokens = qsLine.split(' ', QString::SkipEmptyParts);
+        *pqsAddress = qTokens[0];
+        *pusPort = SENSOR_EXPORTER_DEFAULT_PORT;
+        *pbProfile = false;
+
+        // The port may be left out before profile
+        int nToken = 1;
+        if( nToken < qTokens.count() && 0 != qTokens[nToken].compare("profile", Qt::CaseInsensitive) )
+        {
+            *pusPort = qTokens[nToken++].toUShort(&bOk);
+            if( !bOk )
+                return InvalidParameter;
+        }
+
+        if( nToken < qTokens.count() )
+        {
+            if( 0 != qTokens[nToken++].compare("profile", Qt::CaseInsensitive) || nToken < qTokens.count() )
+                return InvalidParameter;
+            *pbProfile = true;
+        }
+
+        return Success;
+    }
+
+    return InvalidParameter;
+}
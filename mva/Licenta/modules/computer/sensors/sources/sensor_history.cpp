@@ -0,0 +1,143 @@
+#include "../headers/sensor_history.h"
+
+#include "../../../../utils/headers/utils.h"
+
+CSensorHistory::CSensorHistory():
+    m_pSeries( NULL ),
+    m_nSeries( 0 )
+{
+
+}
+
+CSensorHistory::~CSensorHistory()
+{
+    delete[] m_pSeries;
+    m_pSeries = NULL;
+}
+
+int CSensorHistory::Initialize(int nSensors)
+{
+    delete[] m_pSeries;
+    m_pSeries = NULL;
+    m_nSeries = 0;
+
+    if( 0 >= nSensors )
+        return InvalidParameter;
+
+    m_pSeries = new CSensorSeries[nSensors];
+    CHECK_ALLOCATION_STATUS(m_pSeries);
+
+    for( int i = 0; i < nSensors; i++ )
+        memset(m_pSeries[i].pAccumulators, 0, sizeof(m_pSeries[i].pAccumulators));
+
+    m_nSeries = nSensors;
+
+    return Success;
+}
+
+int CSensorHistory::GetSensorCount() const
+{
+    return m_nSeries;
+}
+
+void CSensorHistory::Accumulate(CSensorSeries *pSeries, SensorResolution Resolution, unsigned long long ullTimestamp, double dValue)
+{
+    SensorAccumulator *pAccumulator = &pSeries->pAccumulators[Resolution];
+    unsigned int uBucket = (unsigned int)(ullTimestamp / SENSOR_RESOLUTION_PERIOD(Resolution));
+
+    // Close the previous bucket once a sample lands in a newer one
+    if( pAccumulator->nCount && uBucket != pAccumulator->uBucket )
+    {
+        SensorRollup Rollup;
+        Rollup.uBucket = pAccumulator->uBucket;
+        Rollup.fMin = (float)pAccumulator->dMin;
+        Rollup.fMax = (float)pAccumulator->dMax;
+        Rollup.fMean = (float)(pAccumulator->dSum / pAccumulator->nCount);
+        Rollup.fLast = (float)pAccumulator->dLast;
+
+        switch( Resolution )
+        {
+        case SensorResolutionSecond:
+            pSeries->Seconds.Push(Rollup); break;
+        case SensorResolutionMinute:
+            pSeries->Minutes.Push(Rollup); break;
+        default:
+            pSeries->Hours.Push(Rollup); break;
+        }
+
+        pAccumulator->nCount = 0;
+    }
+
+    // An unreadable sensor still closes the bucket, it just adds nothing
+    if( dValue != dValue )
+        return;
+
+    if( 0 == pAccumulator->nCount )
+    {
+        pAccumulator->uBucket = uBucket;
+        pAccumulator->dMin = dValue;
+        pAccumulator->dMax = dValue;
+        pAccumulator->dSum = 0;
+    }
+
+    if( dValue < pAccumulator->dMin )
+        pAccumulator->dMin = dValue;
+    if( dValue > pAccumulator->dMax )
+        pAccumulator->dMax = dValue;
+    pAccumulator->dSum += dValue;
+    pAccumulator->dLast = dValue;
+    pAccumulator->nCount++;
+}
+
+int CSensorHistory::Record(const CSensorSamples *pSamples)
+{
+    if( !m_pSeries )
+        return Uninitialized;
+
+    const double *pValues = pSamples->GetValues();
+    const unsigned long long *pTimestamps = pSamples->GetTimestamps();
+    int nCount = pSamples->GetCount() < m_nSeries ? pSamples->GetCount() : m_nSeries;
+
+    for( int i = 0; i < nCount; i++ )
+    {
+        // Not sampled yet
+        if( 0 == pTimestamps[i] )
+            continue;
+
+        SensorRawSample Sample;
+        Sample.ullTimestamp = pTimestamps[i];
+        Sample.dValue = pValues[i];
+        m_pSeries[i].Raw.Push(Sample);
+
+        for( int j = 0; j < SensorResolutionCount; j++ )
+            Accumulate(&m_pSeries[i], (SensorResolution)j, pTimestamps[i], pValues[i]);
+    }
+
+    return Success;
+}
+
+int CSensorHistory::ReadRaw(int nId, SensorRawSample *pOut, int nMax) const
+{
+    if( 0 > nId || nId >= m_nSeries || !pOut )
+        return 0;
+
+    return m_pSeries[nId].Raw.Read(pOut, nMax);
+}
+
+int CSensorHistory::ReadRollups(int nId, SensorResolution Resolution, SensorRollup *pOut, int nMax) const
+{
+    if( 0 > nId || nId >= m_nSeries || !pOut )
+        return 0;
+
+    switch( Resolution )
+    {
+    case SensorResolutionSecond:
+        return m_pSeries[nId].Seconds.Read(pOut, nMax);
+    case SensorResolutionMinute:
+        return m_pSeries[nId].Minutes.Read(pOut, nMax);
+    case SensorResolutionHour:
+        return m_pSeries[nId].Hours.Read(pOut, nMax);
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,671 @@
+#include "../headers/sensor_log.h"
+
+#include <QDir>
+#include <QFile>
+
+#include "../../../../utils/headers/utils.h"
+
+#ifndef STK_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#define SENSOR_LOG_HEADER_BITS          (sizeof(SensorLogBlockHeader) * 8)
+#define SENSOR_LOG_CAPACITY_BITS        (SENSOR_LOG_BLOCK_SIZE * 8)
+
+/// File helpers
+
+static SensorLogFile OpenLogFile(const QString &qsPath, bool bWrite)
+{
+#ifdef STK_WINDOWS
+    return CreateFileW((LPCWSTR)qsPath.utf16(), bWrite ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                       FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, bWrite ? OPEN_ALWAYS : OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+    return open(qsPath.toLocal8Bit().constData(), bWrite ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+#endif
+}
+
+static void CloseLogFile(SensorLogFile hFile)
+{
+    if( SENSOR_LOG_INVALID_FILE == hFile )
+        return;
+#ifdef STK_WINDOWS
+    CloseHandle(hFile);
+#else
+    close(hFile);
+#endif
+}
+
+static unsigned long long GetLogFileSize(SensorLogFile hFile)
+{
+#ifdef STK_WINDOWS
+    LARGE_INTEGER Size;
+    if( !GetFileSizeEx(hFile, &Size) )
+        return 0;
+    return Size.QuadPart;
+#else
+    struct stat Stat;
+    if( 0 != fstat(hFile, &Stat) )
+        return 0;
+    return Stat.st_size;
+#endif
+}
+
+static int WriteAt(SensorLogFile hFile, unsigned long long ullOffset, const void *pData, unsigned int uSize)
+{
+#ifdef STK_WINDOWS
+    OVERLAPPED Overlapped;
+    DWORD dwWritten = 0;
+    memset(&Overlapped, 0, sizeof(OVERLAPPED));
+    Overlapped.Offset = (DWORD)ullOffset;
+    Overlapped.OffsetHigh = (DWORD)(ullOffset >> 32);
+    if( !WriteFile(hFile, pData, uSize, &dwWritten, &Overlapped) || dwWritten != uSize )
+        return Unsuccessful;
+#else
+    if( (ssize_t)uSize != pwrite(hFile, pData, uSize, ullOffset) )
+        return Unsuccessful;
+#endif
+    return Success;
+}
+
+static int ReadAt(SensorLogFile hFile, unsigned long long ullOffset, void *pData, unsigned int uSize)
+{
+#ifdef STK_WINDOWS
+    OVERLAPPED Overlapped;
+    DWORD dwRead = 0;
+    memset(&Overlapped, 0, sizeof(OVERLAPPED));
+    Overlapped.Offset = (DWORD)ullOffset;
+    Overlapped.OffsetHigh = (DWORD)(ullOffset >> 32);
+    if( !ReadFile(hFile, pData, uSize, &dwRead, &Overlapped) || dwRead != uSize )
+        return Unsuccessful;
+#else
+    if( (ssize_t)uSize != pread(hFile, pData, uSize, ullOffset) )
+        return Unsuccessful;
+#endif
+    return Success;
+}
+
+// Wall clock, microseconds since the Unix epoch
+static unsigned long long GetWallClock()
+{
+#ifdef STK_WINDOWS
+    FILETIME FileTime;
+    GetSystemTimeAsFileTime(&FileTime);
+    unsigned long long ullTime = ((unsigned long long)FileTime.dwHighDateTime << 32) | FileTime.dwLowDateTime;
+    // 100ns ticks since 1601
+    return ullTime / 10 - 11644473600000000ULL;
+#else
+    struct timespec Time;
+    clock_gettime(CLOCK_REALTIME, &Time);
+    return (unsigned long long)Time.tv_sec * 1000000ULL + Time.tv_nsec / 1000;
+#endif
+}
+
+/// Bit stream, MSB first
+
+static void WriteBits(unsigned char *pbBits, unsigned int *puBitCount, unsigned long long ullValue, int nBits)
+{
+    for( int i = nBits - 1; i >= 0; i-- )
+    {
+        unsigned int uBit = *puBitCount;
+        if( (ullValue >> i) & 1 )
+            pbBits[uBit >> 3] |= (unsigned char)(0x80 >> (uBit & 7));
+        else
+            pbBits[uBit >> 3] &= (unsigned char)~(0x80 >> (uBit & 7));
+        (*puBitCount)++;
+    }
+}
+
+static bool ReadBits(const unsigned char *pbBits, unsigned int uBitLimit, unsigned int *puBit, int nBits, unsigned long long *pullValue)
+{
+    if( *puBit + nBits > uBitLimit )
+        return false;
+
+    unsigned long long ullValue = 0;
+    for( int i = 0; i < nBits; i++ )
+    {
+        unsigned int uBit = (*puBit)++;
+        ullValue = (ullValue << 1) | ((pbBits[uBit >> 3] >> (7 - (uBit & 7))) & 1);
+    }
+    *pullValue = ullValue;
+
+    return true;
+}
+
+static int LeadingZeros(unsigned long long ullValue)
+{
+    int nCount = 0;
+    for( unsigned long long ullMask = 1ULL << 63; ullMask && !(ullValue & ullMask); ullMask >>= 1 )
+        nCount++;
+    return nCount;
+}
+
+static int TrailingZeros(unsigned long long ullValue)
+{
+    int nCount = 0;
+    for( ; nCount < 64 && !(ullValue & 1); ullValue >>= 1 )
+        nCount++;
+    return nCount;
+}
+
+static unsigned long long DoubleToBits(double dValue)
+{
+    unsigned long long ullBits = 0;
+    memcpy(&ullBits, &dValue, sizeof(ullBits));
+    return ullBits;
+}
+
+static double BitsToDouble(unsigned long long ullBits)
+{
+    double dValue = 0;
+    memcpy(&dValue, &ullBits, sizeof(dValue));
+    return dValue;
+}
+
+/// Writer
+
+CSensorLog::CSensorLog():
+    m_hDataFile( SENSOR_LOG_INVALID_FILE ),
+    m_hIndexFile( SENSOR_LOG_INVALID_FILE ),
+    m_uNextBlock( 0 ),
+    m_llClockOffset( 0 ),
+    m_ullLastFlush( 0 ),
+    m_bStop( false )
+{
+
+}
+
+CSensorLog::~CSensorLog()
+{
+    Close();
+}
+
+int CSensorLog::CheckCatalog(const CSensorSamples *pSamples)
+{
+    QDir qDir(m_qsDirectory);
+    QByteArray qCatalog((const char*)pSamples->GetDescriptors(), pSamples->GetCount() * sizeof(SensorDescriptor));
+
+    // Sensor IDs are only stable for an identical descriptor set, start
+    // over (keeping one old generation) when the hardware changed
+    QFile qFile(qDir.filePath(SENSOR_LOG_CATALOG_FILE));
+    if( qFile.open(QIODevice::ReadOnly) )
+    {
+        bool bSame = qFile.readAll() == qCatalog;
+        qFile.close();
+        if( bSame )
+            return Success;
+
+        const char *pszFiles[] = { SENSOR_LOG_DATA_FILE, SENSOR_LOG_INDEX_FILE, SENSOR_LOG_CATALOG_FILE };
+        for( int i = 0; i < 3; i++ )
+        {
+            QFile::remove(qDir.filePath(QString(pszFiles[i]) + ".old"));
+            QFile::rename(qDir.filePath(pszFiles[i]), qDir.filePath(QString(pszFiles[i]) + ".old"));
+        }
+    }
+
+    if( !qFile.open(QIODevice::WriteOnly | QIODevice::Truncate) )
+        return Unsuccessful;
+    qFile.write(qCatalog);
+    qFile.close();
+
+    return Success;
+}
+
+int CSensorLog::Open(const QString &qsDirectory, const CSensorSamples *pSamples)
+{
+    int nStatus = Uninitialized;
+
+    Close();
+
+    if( !pSamples || 0 == pSamples->GetCount() )
+        return InvalidParameter;
+
+    m_qsDirectory = qsDirectory;
+    if( !QDir().mkpath(m_qsDirectory) )
+        return Unsuccessful;
+
+    nStatus = CheckCatalog(pSamples);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    QDir qDir(m_qsDirectory);
+    m_hDataFile = OpenLogFile(qDir.filePath(SENSOR_LOG_DATA_FILE), true);
+    m_hIndexFile = OpenLogFile(qDir.filePath(SENSOR_LOG_INDEX_FILE), true);
+    if( SENSOR_LOG_INVALID_FILE == m_hDataFile || SENSOR_LOG_INVALID_FILE == m_hIndexFile )
+    {
+        Close();
+        return InvalidHandle;
+    }
+
+    m_uNextBlock = (unsigned int)(GetLogFileSize(m_hIndexFile) / sizeof(SensorLogIndexEntry));
+    m_llClockOffset = (long long)GetWallClock() - (long long)SensorTimestamp();
+    m_ullLastFlush = SensorTimestamp();
+
+    // One open block per series, allocated once
+    m_qBlocks.assign((size_t)pSamples->GetCount() * SENSOR_LOG_BLOCK_SIZE, 0);
+    m_qEncoders.resize(pSamples->GetCount());
+    for( int i = 0; i < pSamples->GetCount(); i++ )
+    {
+        m_qEncoders[i].pbBlock = &m_qBlocks[(size_t)i * SENSOR_LOG_BLOCK_SIZE];
+        m_qEncoders[i].uCount = 0;
+        m_qEncoders[i].bDirty = false;
+    }
+
+    m_bStop = false;
+    m_Writer = std::thread(&CSensorLog::WriterThread, this);
+
+    return Success;
+}
+
+int CSensorLog::Close()
+{
+    if( m_Writer.joinable() )
+    {
+        for( size_t i = 0; i < m_qEncoders.size(); i++ )
+        {
+            if( m_qEncoders[i].bDirty )
+                QueueBlock((int)i, &m_qEncoders[i]);
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            m_bStop = true;
+        }
+        m_Condition.notify_one();
+        m_Writer.join();
+    }
+
+    CloseLogFile(m_hDataFile);
+    CloseLogFile(m_hIndexFile);
+    m_hDataFile = SENSOR_LOG_INVALID_FILE;
+    m_hIndexFile = SENSOR_LOG_INVALID_FILE;
+
+    m_qEncoders.clear();
+    m_qBlocks.clear();
+
+    return Success;
+}
+
+void CSensorLog::StartBlock(SensorLogEncoder *pEncoder)
+{
+    pEncoder->uBlock = m_uNextBlock++;
+    pEncoder->uBitCount = SENSOR_LOG_HEADER_BITS;
+    pEncoder->uCount = 0;
+    pEncoder->llLastDelta = 0;
+    pEncoder->nLeading = -1;
+    pEncoder->nTrailing = 0;
+    memset(pEncoder->pbBlock, 0, SENSOR_LOG_BLOCK_SIZE);
+}
+
+void CSensorLog::Encode(SensorLogEncoder *pEncoder, unsigned long long ullTimestamp, double dValue)
+{
+    unsigned char *pbBits = pEncoder->pbBlock;
+    unsigned long long ullValue = DoubleToBits(dValue);
+
+    if( 0 == pEncoder->uCount )
+    {
+        pEncoder->ullFirstTimestamp = ullTimestamp;
+        WriteBits(pbBits, &pEncoder->uBitCount, ullValue, 64);
+    }
+    else
+    {
+        long long llDelta = (long long)(ullTimestamp - pEncoder->ullLastTimestamp);
+        long long llDod = llDelta - pEncoder->llLastDelta;
+
+        // Timestamp: delta-of-delta in variable width buckets
+        if( 0 == llDod )
+            WriteBits(pbBits, &pEncoder->uBitCount, 0, 1);
+        else if( llDod >= -63 && llDod <= 64 )
+        {
+            WriteBits(pbBits, &pEncoder->uBitCount, 0x2, 2);
+            WriteBits(pbBits, &pEncoder->uBitCount, (unsigned long long)(llDod + 63), 7);
+        }
+        else if( llDod >= -255 && llDod <= 256 )
+        {
+            WriteBits(pbBits, &pEncoder->uBitCount, 0x6, 3);
+            WriteBits(pbBits, &pEncoder->uBitCount, (unsigned long long)(llDod + 255), 9);
+        }
+        else if( llDod >= -2047 && llDod <= 2048 )
+        {
+            WriteBits(pbBits, &pEncoder->uBitCount, 0xE, 4);
+            WriteBits(pbBits, &pEncoder->uBitCount, (unsigned long long)(llDod + 2047), 12);
+        }
+        else
+        {
+            WriteBits(pbBits, &pEncoder->uBitCount, 0xF, 4);
+            WriteBits(pbBits, &pEncoder->uBitCount, (unsigned long long)(unsigned int)(int)llDod, 32);
+        }
+        pEncoder->llLastDelta = llDelta;
+
+        // Value: XOR with the previous one, reuse the previous window when it fits
+        unsigned long long ullXor = ullValue ^ pEncoder->ullLastValue;
+        if( 0 == ullXor )
+            WriteBits(pbBits, &pEncoder->uBitCount, 0, 1);
+        else
+        {
+            int nLeading = LeadingZeros(ullXor);
+            int nTrailing = TrailingZeros(ullXor);
+            if( nLeading > 31 )
+                nLeading = 31;
+
+            if( 0 <= pEncoder->nLeading && nLeading >= pEncoder->nLeading && nTrailing >= pEncoder->nTrailing )
+            {
+                WriteBits(pbBits, &pEncoder->uBitCount, 0x2, 2);
+                WriteBits(pbBits, &pEncoder->uBitCount, ullXor >> pEncoder->nTrailing,
+                          64 - pEncoder->nLeading - pEncoder->nTrailing);
+            }
+            else
+            {
+                int nLength = 64 - nLeading - nTrailing;
+                WriteBits(pbBits, &pEncoder->uBitCount, 0x3, 2);
+                WriteBits(pbBits, &pEncoder->uBitCount, nLeading, 5);
+                WriteBits(pbBits, &pEncoder->uBitCount, nLength & 0x3F, 6);
+                WriteBits(pbBits, &pEncoder->uBitCount, ullXor >> nTrailing, nLength);
+                pEncoder->nLeading = nLeading;
+                pEncoder->nTrailing = nTrailing;
+            }
+        }
+    }
+
+    pEncoder->ullLastValue = ullValue;
+    pEncoder->ullLastTimestamp = ullTimestamp;
+    pEncoder->uCount++;
+    pEncoder->bDirty = true;
+}
+
+void CSensorLog::QueueBlock(int nSensorId, SensorLogEncoder *pEncoder)
+{
+    SensorLogBlockHeader *pHeader = (SensorLogBlockHeader*)pEncoder->pbBlock;
+    pHeader->uMagic = SENSOR_LOG_MAGIC;
+    pHeader->usVersion = SENSOR_LOG_VERSION;
+    pHeader->usReserved = 0;
+    pHeader->nSensorId = nSensorId;
+    pHeader->uCount = pEncoder->uCount;
+    pHeader->uBitCount = pEncoder->uBitCount;
+    pHeader->uPadding = 0;
+    pHeader->ullFirstTimestamp = pEncoder->ullFirstTimestamp;
+    pHeader->ullLastTimestamp = pEncoder->ullLastTimestamp;
+
+    SensorLogJob Job;
+    Job.uBlock = pEncoder->uBlock;
+    Job.Entry.nSensorId = nSensorId;
+    Job.Entry.uCount = pEncoder->uCount;
+    Job.Entry.ullFirstTimestamp = pEncoder->ullFirstTimestamp;
+    Job.Entry.ullLastTimestamp = pEncoder->ullLastTimestamp;
+    // Only the used bytes, the rest of the slot is still zero on disk
+    Job.qData.assign(pEncoder->pbBlock, pEncoder->pbBlock + (pEncoder->uBitCount + 7) / 8);
+
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_qJobs.push_back(std::move(Job));
+    }
+    m_Condition.notify_one();
+
+    pEncoder->bDirty = false;
+}
+
+int CSensorLog::Append(const CSensorSamples *pSamples)
+{
+    if( m_qEncoders.empty() )
+        return Uninitialized;
+
+    const double *pValues = pSamples->GetValues();
+    const unsigned long long *pTimestamps = pSamples->GetTimestamps();
+    int nCount = pSamples->GetCount() < (int)m_qEncoders.size() ? pSamples->GetCount() : (int)m_qEncoders.size();
+
+    for( int i = 0; i < nCount; i++ )
+    {
+        SensorLogEncoder *pEncoder = &m_qEncoders[i];
+        if( 0 == pTimestamps[i] )
+            continue;
+
+        unsigned long long ullTimestamp = (unsigned long long)((long long)pTimestamps[i] + m_llClockOffset) / 1000;
+
+        // Skip repeated ticks, seal the block when full or after a gap
+        // too large for the 32 bit delta-of-delta bucket
+        if( pEncoder->uCount )
+        {
+            if( ullTimestamp <= pEncoder->ullLastTimestamp )
+                continue;
+            if( pEncoder->uBitCount + SENSOR_LOG_MAX_SAMPLE_BITS > SENSOR_LOG_CAPACITY_BITS ||
+                ullTimestamp - pEncoder->ullLastTimestamp > 0x7FFFFFFFULL )
+            {
+                QueueBlock(i, pEncoder);
+                pEncoder->uCount = 0;
+            }
+        }
+        if( 0 == pEncoder->uCount )
+            StartBlock(pEncoder);
+
+        Encode(pEncoder, ullTimestamp, pValues[i]);
+    }
+
+    // Periodic snapshot of the open blocks
+    unsigned long long ullNow = SensorTimestamp();
+    if( ullNow - m_ullLastFlush >= SENSOR_LOG_FLUSH_INTERVAL * 1000ULL )
+    {
+        for( int i = 0; i < (int)m_qEncoders.size(); i++ )
+        {
+            if( m_qEncoders[i].bDirty )
+                QueueBlock(i, &m_qEncoders[i]);
+        }
+        m_ullLastFlush = ullNow;
+    }
+
+    return Success;
+}
+
+void CSensorLog::WriterThread()
+{
+    std::deque<SensorLogJob> qBatch;
+
+    for( ;; )
+    {
+        {
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+            while( m_qJobs.empty() && !m_bStop )
+                m_Condition.wait(Lock);
+            if( m_qJobs.empty() && m_bStop )
+                break;
+            qBatch.swap(m_qJobs);
+        }
+
+        // Bits first, header last: a reader never sees a header that
+        // describes bits which are not on disk yet
+        for( size_t i = 0; i < qBatch.size(); i++ )
+        {
+            const SensorLogJob *pJob = &qBatch[i];
+            unsigned long long ullOffset = (unsigned long long)pJob->uBlock * SENSOR_LOG_BLOCK_SIZE;
+
+            if( pJob->qData.size() > sizeof(SensorLogBlockHeader) )
+                WriteAt(m_hDataFile, ullOffset + sizeof(SensorLogBlockHeader), &pJob->qData[sizeof(SensorLogBlockHeader)],
+                        (unsigned int)(pJob->qData.size() - sizeof(SensorLogBlockHeader)));
+            WriteAt(m_hDataFile, ullOffset, &pJob->qData[0], sizeof(SensorLogBlockHeader));
+            WriteAt(m_hIndexFile, (unsigned long long)pJob->uBlock * sizeof(SensorLogIndexEntry),
+                    &pJob->Entry, sizeof(SensorLogIndexEntry));
+        }
+        qBatch.clear();
+    }
+}
+
+/// Reader
+
+int SensorLogDecodeBlock(const unsigned char *pbBlock, unsigned long long ullFrom,
+                         unsigned long long ullTo, QVector<SensorLogSample> &qSamples)
+{
+    const SensorLogBlockHeader *pHeader = (const SensorLogBlockHeader*)pbBlock;
+    if( SENSOR_LOG_MAGIC != pHeader->uMagic || SENSOR_LOG_VERSION != pHeader->usVersion ||
+        pHeader->uBitCount > SENSOR_LOG_CAPACITY_BITS || 0 == pHeader->uCount )
+        return Unsuccessful;
+
+    unsigned int uBit = SENSOR_LOG_HEADER_BITS;
+    unsigned long long ullBits = 0, ullTimestamp = pHeader->ullFirstTimestamp, ullValue = 0;
+    long long llDelta = 0;
+    int nLeading = 0, nTrailing = 0;
+
+    if( !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 64, &ullValue) )
+        return Unsuccessful;
+
+    for( unsigned int i = 0; i < pHeader->uCount; i++ )
+    {
+        if( i )
+        {
+            // Timestamp bucket
+            int nPrefix = 0;
+            while( nPrefix < 4 && ReadBits(pbBlock, pHeader->uBitCount, &uBit, 1, &ullBits) && ullBits )
+                nPrefix++;
+
+            long long llDod = 0;
+            switch( nPrefix )
+            {
+            case 0:
+                break;
+            case 1:
+                if( !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 7, &ullBits) ) return Unsuccessful;
+                llDod = (long long)ullBits - 63; break;
+            case 2:
+                if( !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 9, &ullBits) ) return Unsuccessful;
+                llDod = (long long)ullBits - 255; break;
+            case 3:
+                if( !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 12, &ullBits) ) return Unsuccessful;
+                llDod = (long long)ullBits - 2047; break;
+            default:
+                if( !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 32, &ullBits) ) return Unsuccessful;
+                llDod = (int)(unsigned int)ullBits; break;
+            }
+            llDelta += llDod;
+            ullTimestamp += llDelta;
+
+            // Value
+            if( !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 1, &ullBits) )
+                return Unsuccessful;
+            if( ullBits )
+            {
+                if( !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 1, &ullBits) )
+                    return Unsuccessful;
+                if( ullBits )
+                {
+                    unsigned long long ullLength = 0;
+                    if( !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 5, &ullBits) ||
+                        !ReadBits(pbBlock, pHeader->uBitCount, &uBit, 6, &ullLength) )
+                        return Unsuccessful;
+                    nLeading = (int)ullBits;
+                    if( 0 == ullLength )
+                        ullLength = 64;
+                    nTrailing = 64 - nLeading - (int)ullLength;
+                }
+
+                int nLength = 64 - nLeading - nTrailing;
+                if( 0 > nTrailing || 0 >= nLength || !ReadBits(pbBlock, pHeader->uBitCount, &uBit, nLength, &ullBits) )
+                    return Unsuccessful;
+                ullValue ^= ullBits << nTrailing;
+            }
+        }
+
+        if( ullTimestamp > ullTo )
+            break;
+        if( ullTimestamp >= ullFrom )
+        {
+            SensorLogSample Sample;
+            Sample.ullTimestamp = ullTimestamp;
+            Sample.dValue = BitsToDouble(ullValue);
+            qSamples.append(Sample);
+        }
+    }
+
+    return Success;
+}
+
+int CSensorLog::Query(const QString &qsDirectory, int nSensorId, unsigned long long ullFrom,
+                      unsigned long long ullTo, QVector<SensorLogSample> &qSamples)
+{
+    QDir qDir(qsDirectory);
+    int nStatus = Success;
+
+    SensorLogFile hIndex = OpenLogFile(qDir.filePath(SENSOR_LOG_INDEX_FILE), false);
+    if( SENSOR_LOG_INVALID_FILE == hIndex )
+        return InvalidHandle;
+
+    unsigned int uEntries = (unsigned int)(GetLogFileSize(hIndex) / sizeof(SensorLogIndexEntry));
+    std::vector<SensorLogIndexEntry> qIndex(uEntries);
+    if( uEntries )
+        nStatus = ReadAt(hIndex, 0, &qIndex[0], uEntries * sizeof(SensorLogIndexEntry));
+    CloseLogFile(hIndex);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    SensorLogFile hData = OpenLogFile(qDir.filePath(SENSOR_LOG_DATA_FILE), false);
+    if( SENSOR_LOG_INVALID_FILE == hData )
+        return InvalidHandle;
+    unsigned long long ullDataSize = GetLogFileSize(hData);
+
+#ifdef STK_WINDOWS
+    SYSTEM_INFO SystemInfo;
+    GetSystemInfo(&SystemInfo);
+    unsigned long long ullGranularity = SystemInfo.dwAllocationGranularity;
+    HANDLE hMapping = CreateFileMappingW(hData, NULL, PAGE_READONLY, 0, 0, NULL);
+    if( NULL == hMapping )
+    {
+        CloseLogFile(hData);
+        return InvalidHandle;
+    }
+#else
+    unsigned long long ullGranularity = (unsigned long long)sysconf(_SC_PAGESIZE);
+#endif
+
+    // Blocks are mapped one at a time, only the pages touched by the
+    // decoder are read from disk
+    for( unsigned int i = 0; i < uEntries; i++ )
+    {
+        const SensorLogIndexEntry *pEntry = &qIndex[i];
+        if( pEntry->nSensorId != nSensorId || 0 == pEntry->uCount ||
+            pEntry->ullLastTimestamp < ullFrom || pEntry->ullFirstTimestamp > ullTo )
+            continue;
+
+        unsigned long long ullOffset = (unsigned long long)i * SENSOR_LOG_BLOCK_SIZE;
+        if( ullOffset + sizeof(SensorLogBlockHeader) > ullDataSize )
+            continue;
+
+        unsigned long long ullMapOffset = ullOffset - ullOffset % ullGranularity;
+        unsigned long long ullMapSize = ullOffset - ullMapOffset + SENSOR_LOG_BLOCK_SIZE;
+        if( ullMapOffset + ullMapSize > ullDataSize )
+            ullMapSize = ullDataSize - ullMapOffset;
+
+        // A short tail block is decoded from a zero padded copy
+        std::vector<unsigned char> qTail;
+#ifdef STK_WINDOWS
+        void *pView = MapViewOfFile(hMapping, FILE_MAP_READ, (DWORD)(ullMapOffset >> 32), (DWORD)ullMapOffset, (SIZE_T)ullMapSize);
+        if( NULL == pView )
+            continue;
+#else
+        void *pView = mmap(NULL, ullMapSize, PROT_READ, MAP_SHARED, hData, ullMapOffset);
+        if( MAP_FAILED == pView )
+            continue;
+#endif
+        const unsigned char *pbBlock = (const unsigned char*)pView + (ullOffset - ullMapOffset);
+        if( ullMapSize - (ullOffset - ullMapOffset) < SENSOR_LOG_BLOCK_SIZE )
+        {
+            qTail.assign(SENSOR_LOG_BLOCK_SIZE, 0);
+            memcpy(&qTail[0], pbBlock, (size_t)(ullMapSize - (ullOffset - ullMapOffset)));
+            pbBlock = &qTail[0];
+        }
+
+        if( nSensorId == ((const SensorLogBlockHeader*)pbBlock)->nSensorId )
+            SensorLogDecodeBlock(pbBlock, ullFrom, ullTo, qSamples);
+
+#ifdef STK_WINDOWS
+        UnmapViewOfFile(pView);
+#else
+        munmap(pView, ullMapSize);
+#endif
+    }
+
+#ifdef STK_WINDOWS
+    CloseHandle(hMapping);
+#endif
+    CloseLogFile(hData);
+
+    return Success;
+}
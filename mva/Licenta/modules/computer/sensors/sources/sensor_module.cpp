@@ -3,7 +3,12 @@
 CSensorModule::CSensorModule():
     m_pBoardFactory( NULL ),
     m_pCpuFactory( NULL ),
-    m_pHardwareUsage( NULL )
+    m_pHardwareUsage( NULL ),
+    m_pNumaMemory( NULL ),
+    m_pRaplPower( NULL ),
+    m_pCoreFrequency( NULL ),
+    m_pCpuTimes( NULL ),
+    m_pDiskPerformance( NULL )
 {
     m_pHardwareUsage = new CHardwareUsage;
     CHECK_ALLOCATION(m_pHardwareUsage);
@@ -13,6 +18,34 @@ CSensorModule::CSensorModule():
 
     m_pCpuFactory = new FactoryCpuSensor;
     CHECK_ALLOCATION(m_pCpuFactory);
+
+    m_pNumaMemory = new CNumaMemory;
+    CHECK_ALLOCATION(m_pNumaMemory);
+
+    int nStatus = m_pNumaMemory->Initialize();
+    CHECK_OPERATION_STATUS(nStatus);
+
+    m_pRaplPower = new CRaplPower;
+    CHECK_ALLOCATION(m_pRaplPower);
+
+    nStatus = m_pRaplPower->Initialize();
+    CHECK_OPERATION_STATUS(nStatus);
+
+    m_pCoreFrequency = new CCoreFrequency;
+    CHECK_ALLOCATION(m_pCoreFrequency);
+
+    nStatus = m_pCoreFrequency->Initialize();
+    CHECK_OPERATION_STATUS(nStatus);
+
+    m_pCpuTimes = new CCpuTimes;
+    CHECK_ALLOCATION(m_pCpuTimes);
+
+    nStatus = m_pCpuTimes->Initialize();
+    CHECK_OPERATION_STATUS(nStatus);
+
+    // Initialized by the owner, it knows the physical drives
+    m_pDiskPerformance = new CDiskPerformance;
+    CHECK_ALLOCATION(m_pDiskPerformance);
 }
 
 CSensorModule::~CSensorModule()
@@ -22,6 +55,16 @@ CSensorModule::~CSensorModule()
     SAFE_DELETE(m_pBoardFactory);
 
     SAFE_DELETE(m_pCpuFactory);
+
+    SAFE_DELETE(m_pNumaMemory);
+
+    SAFE_DELETE(m_pRaplPower);
+
+    SAFE_DELETE(m_pCoreFrequency);
+
+    SAFE_DELETE(m_pCpuTimes);
+
+    SAFE_DELETE(m_pDiskPerformance);
 }
 
 ICPUSensor *CSensorModule::GetCpuSensor()
@@ -39,27 +82,42 @@ int CSensorModule::DestroyCpuSensor()
     return m_pCpuFactory->DestroySensor();
 }
 
-ISensor *CSensorModule::GetBoardSensor()
+ISensor *CSensorModule::GetBoardSensor(const QString &qsCacheDirectory, const QString &qsBoardIdentity)
 {
-    return m_pBoardFactory->GetBoardSensor();
+    return m_pBoardFactory->GetBoardSensor(qsCacheDirectory, qsBoardIdentity);
 }
 
-double CSensorModule::GetCpuLoad()
+QString CSensorModule::GetCpuName()
 {
-    return m_pHardwareUsage->GetCpuLoad();
+    return m_pHardwareUsage->GetCpuName();
 }
 
-QString CSensorModule::GetCpuName()
+int CSensorModule::GetMemoryStat(MemoryStatus *pMemoryStatus)
 {
-    return m_pHardwareUsage->GetCpuName();
+    return m_pHardwareUsage->GetMemoryStatus(pMemoryStatus);
+}
+
+CNumaMemory *CSensorModule::GetNumaMemory()
+{
+    return m_pNumaMemory;
+}
+
+CRaplPower *CSensorModule::GetRaplPower()
+{
+    return m_pRaplPower;
+}
+
+CCoreFrequency *CSensorModule::GetCoreFrequency()
+{
+    return m_pCoreFrequency;
 }
 
-double CSensorModule::GetDiskLoad()
+CCpuTimes *CSensorModule::GetCpuTimes()
 {
-    return m_pHardwareUsage->GetDiskLoad();
+    return m_pCpuTimes;
 }
 
-MemoryStatus *CSensorModule::GetMemoryStat()
+CDiskPerformance *CSensorModule::GetDiskPerformance()
 {
-    return m_pHardwareUsage->GetMemoryStatus();
+    return m_pDiskPerformance;
 }
@@ -0,0 +1,153 @@
+#include "../headers/sensor_samples.h"
+
+#include "../../../../utils/headers/utils.h"
+
+#ifndef STK_WINDOWS
+#include <time.h>
+#endif
+
+CSensorSamples::CSensorSamples()
+{
+
+}
+
+CSensorSamples::~CSensorSamples()
+{
+    Clear();
+}
+
+int CSensorSamples::Register(SensorGroup Group, SensorKind Kind, SensorUnit Unit, const char *pszName, int nInstance)
+{
+    SensorDescriptor Descriptor;
+    memset(&Descriptor, 0, sizeof(SensorDescriptor));
+
+    Descriptor.Group = Group;
+    Descriptor.Kind = Kind;
+    Descriptor.Unit = Unit;
+    Descriptor.nInstance = nInstance;
+    if( pszName )
+        strncpy(Descriptor.szName, pszName, SENSOR_NAME_SIZE - 1);
+
+    m_qDescriptors.append(Descriptor);
+    m_qValues.append(0);
+    m_qTimestamps.append(0);
+    m_qChangedFlags.append(0);
+    m_qChanged.reserve(m_qDescriptors.count());
+
+    return m_qDescriptors.count() - 1;
+}
+
+void CSensorSamples::Clear()
+{
+    m_qDescriptors.clear();
+    m_qValues.clear();
+    m_qTimestamps.clear();
+    m_qChangedFlags.clear();
+    m_qChanged.clear();
+}
+
+void CSensorSamples::BeginUpdate()
+{
+    for(int i = 0; i < m_qChanged.count(); i++)
+        m_qChangedFlags[m_qChanged[i]] = 0;
+
+    // resize keeps the reserved capacity, clear() would release it
+    m_qChanged.resize(0);
+}
+
+int CSensorSamples::GetCount() const
+{
+    return m_qDescriptors.count();
+}
+
+const SensorDescriptor *CSensorSamples::GetDescriptors() const
+{
+    return m_qDescriptors.constData();
+}
+
+const double *CSensorSamples::GetValues() const
+{
+    return m_qValues.constData();
+}
+
+const unsigned long long *CSensorSamples::GetTimestamps() const
+{
+    return m_qTimestamps.constData();
+}
+
+int CSensorSamples::GetChangedCount() const
+{
+    return m_qChanged.count();
+}
+
+const int *CSensorSamples::GetChanged() const
+{
+    return m_qChanged.constData();
+}
+
+unsigned long long SensorTimestamp()
+{
+#ifdef STK_WINDOWS
+    static LARGE_INTEGER Frequency = { 0 };
+    LARGE_INTEGER Counter;
+
+    if( 0 == Frequency.QuadPart )
+        QueryPerformanceFrequency(&Frequency);
+    QueryPerformanceCounter(&Counter);
+
+    // Split to avoid overflowing the multiplication
+    return (Counter.QuadPart / Frequency.QuadPart) * 1000000ULL +
+           (Counter.QuadPart % Frequency.QuadPart) * 1000000ULL / Frequency.QuadPart;
+#else
+    struct timespec Time;
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+
+    return (unsigned long long)Time.tv_sec * 1000000ULL + Time.tv_nsec / 1000;
+#endif
+}
+
+QString SensorShortName(const char *pszName)
+{
+    QString qsName = QString(pszName).trimmed();
+    while( qsName.endsWith(':') )
+        qsName.chop(1);
+
+    return qsName.trimmed();
+}
+
+QString SensorFormatValue(double dValue, SensorUnit Unit)
+{
+    // NaN marks a reading the chip reported as out of range
+    if( dValue != dValue )
+        return QString("N/A");
+
+    switch( Unit )
+    {
+    case SensorUnitCelsius:
+        return QString().sprintf("%.1fC", dValue);
+    case SensorUnitVolt:
+        return QString().sprintf("%.3fV", dValue);
+    case SensorUnitRPM:
+        return QString().sprintf("%.1fRPM", dValue);
+    case SensorUnitPercent:
+        return QString().sprintf("%.2f%%", dValue);
+    case SensorUnitBytes:
+        return QString().sprintf("%.0f MB", dValue / 1048576);
+    case SensorUnitPages:
+        return QString().sprintf("%.0f", dValue);
+    case SensorUnitWatt:
+        return QString().sprintf("%.2fW", dValue);
+    case SensorUnitMHz:
+        return QString().sprintf("%.0f MHz", dValue);
+    case SensorUnitBytesPerSecond:
+        return QString().sprintf("%.2f MB/s", dValue / 1048576);
+    case SensorUnitIops:
+        return QString().sprintf("%.1f IOPS", dValue);
+    case SensorUnitMilliseconds:
+        return QString().sprintf("%.2f ms", dValue);
+    case SensorUnitPagesPerSecond:
+        return QString().sprintf("%.0f pages/s", dValue);
+    default:
+        return QString().sprintf("%g", dValue);
+    }
+}
@@ -1,5 +1,7 @@
 #include "../headers/stk_driver_wrapper.h"
 
+#include "../../../../utils/headers/self_profile.h"
+
 
 CRing0Wrapper::CRing0Wrapper(void):
 	m_hDriver(NULL)
@@ -44,6 +46,7 @@ int CRing0Wrapper::ReadMsr(ULONG ulIndex, ULONG *ulEAX, ULONG *ulEDX)
     DWORD dwBytesReturned = 0;
     bool bResult = false;
 
+    STK_PROFILE_SYSCALL();
     bResult = DeviceIoControl(m_hDriver,
                               IOCTL_STK_READ_MSR,
                               (LPVOID)&ulIndex,
@@ -69,6 +72,64 @@ int CRing0Wrapper::ReadMsr(ULONG ulIndex, ULONG *ulEAX, ULONG *ulEDX)
     return Success;
 }
 
+int CRing0Wrapper::ReadMsrAllProcessors(ULONG ulIndex, ULONGLONG *pValues, int nCount)
+{
+    return ReadMsrAllProcessors(&ulIndex, 1, pValues, nCount);
+}
+
+int CRing0Wrapper::ReadMsrAllProcessors(const ULONG *pIndexes, int nIndexes, ULONGLONG *pValues, int nCount)
+{
+    DWORD dwBytesReturned = 0;
+    DWORD dwSize = 0;
+    bool bResult = false;
+
+    if (!pIndexes || !pValues || 0 >= nIndexes || STK_MSR_BROADCAST_MAX < nIndexes || 0 >= nCount)
+        return InvalidParameter;
+
+    dwSize = nCount * nIndexes * sizeof(ULONGLONG);
+    STK_PROFILE_SYSCALL();
+    bResult = DeviceIoControl(m_hDriver,
+                              IOCTL_STK_READ_MSR_ALL,
+                              (LPVOID)pIndexes,
+                              nIndexes * sizeof(ULONG),
+                              (LPVOID)pValues,
+                              dwSize,
+                              &dwBytesReturned,
+                              NULL);
+
+    // Older drivers do not know this IOCTL, callers fall back to ReadMsr()
+    if (false == bResult || dwBytesReturned < dwSize)
+        return Unsuccessful;
+
+    return Success;
+}
+
+int CRing0Wrapper::WriteMsrAllProcessors(ULONG ulIndex, ULONG ulEAX, ULONG ulEDX)
+{
+    STK_MSR_WRITE_ALL_INPUT Input;
+    DWORD dwBytesReturned = 0;
+    bool bResult = false;
+
+    Input.ulRegister = ulIndex;
+    Input.ulEax = ulEAX;
+    Input.ulEdx = ulEDX;
+
+    STK_PROFILE_SYSCALL();
+    bResult = DeviceIoControl(m_hDriver,
+                              IOCTL_STK_WRITE_MSR_ALL,
+                              (LPVOID)&Input,
+                              sizeof(STK_MSR_WRITE_ALL_INPUT),
+                              NULL,
+                              0,
+                              &dwBytesReturned,
+                              NULL);
+
+    if (false == bResult)
+        return Unsuccessful;
+
+    return Success;
+}
+
 int CRing0Wrapper::WriteMsr(ULONG ulIndex, ULONG ulEAX, ULONG ulEDX)
 {
     STK_MSR_INPUT *pInput = new STK_MSR_INPUT;
@@ -78,6 +139,7 @@ int CRing0Wrapper::WriteMsr(ULONG ulIndex, ULONG ulEAX, ULONG ulEDX)
     pInput->uliValue.HighPart = ulEDX;
     pInput->uliValue.LowPart = ulEAX;
 
+    STK_PROFILE_SYSCALL();
     bResult = DeviceIoControl(m_hDriver,
                               IOCTL_STK_WRITE_MSR,
                               (LPVOID)pInput,
@@ -102,6 +164,7 @@ int CRing0Wrapper::ReadIoPortByte(ULONG ulPort, BYTE *bValue)
     bool bResult = false;
     DWORD dwBytesReturned = 0;
 
+    STK_PROFILE_SYSCALL();
     bResult = DeviceIoControl(m_hDriver,
                               IOCTL_STK_READ_IO_PORT_BYTE,
                               (LPVOID)&ulPort,
@@ -134,6 +197,7 @@ int CRing0Wrapper::WriteIoPortByte(ULONG ulPort, BYTE bValue)
     DWORD dwRetParam = 0;
     DWORD dwBytesReceived = 0;
 
+    STK_PROFILE_SYSCALL();
     bResult = DeviceIoControl(m_hDriver,
                               IOCTL_STK_WRITE_IO_PORT_BYTE,
                               (LPVOID)pInput,
@@ -158,6 +222,7 @@ int CRing0Wrapper::ReadIoPortDWORD(ULONG ulPort, DWORD *dwValue)
     bool bResult = false;
     DWORD dwBytesReturned = 0;
 
+    STK_PROFILE_SYSCALL();
     bResult = DeviceIoControl(m_hDriver,
                               IOCTL_STK_READ_IO_PORT_DWORD,
                               (LPVOID)&ulPort,
@@ -190,6 +255,7 @@ int CRing0Wrapper::WriteIoPortDWORD(ULONG ulPort, ULONG dwValue)
     DWORD dwRetParam = 0;
     DWORD dwBytesReceived = 0;
 
+    STK_PROFILE_SYSCALL();
     bResult = DeviceIoControl(m_hDriver,
                               IOCTL_STK_WRITE_IO_PORT_DWORD,
                               (LPVOID)pInput,
@@ -225,6 +291,7 @@ int CRing0Wrapper::ReadPCIConfiguration(ULONG ulPCIAddress, ULONG ulRegAddress,
 
     ULONG ulVal = 0;
 
+    STK_PROFILE_SYSCALL();
     bResult = DeviceIoControl(m_hDriver,
                               IOCTL_STK_READ_PCI_CONFIG,
                               (LPVOID)pInput,
@@ -262,6 +329,7 @@ int CRing0Wrapper::WritePCIConfiguration(ULONG ulPCIAddress, ULONG ulRegAddress,
     pInput->ulPCIOffset = ulRegAddress;
     pInput->ulData = ulData;
 
+    STK_PROFILE_SYSCALL();
     bResult = DeviceIoControl(m_hDriver,
                               IOCTL_STK_WRITE_PCI_CONFIG,
                               (LPVOID)pInput,
@@ -0,0 +1,129 @@
+#include "../headers/superio_cache.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <stddef.h>
+#include <string.h>
+
+#include "../../../../utils/headers/utils.h"
+
+unsigned int CSuperIODetectionCache::Hash(const void *pData, int nSize, unsigned int uHash)
+{
+    const unsigned char *pbData = (const unsigned char*)pData;
+
+    for( int i = 0; i < nSize; i++ )
+    {
+        uHash ^= pbData[i];
+        uHash *= 16777619;
+    }
+
+    return uHash;
+}
+
+unsigned int CSuperIODetectionCache::Checksum(const SuperIOCacheRecord *pRecord)
+{
+    unsigned int uHash = Hash(pRecord, offsetof(SuperIOCacheRecord, uChecksum), 2166136261u);
+
+    return Hash(&pRecord->Detection, sizeof(pRecord->Detection), uHash);
+}
+
+int CSuperIODetectionCache::Load(const QString &qsFile)
+{
+    m_qsFile = qsFile;
+    m_qRecords.clear();
+
+    QFile qFile(m_qsFile);
+    if( !qFile.open(QIODevice::ReadOnly) )
+        return Unsuccessful;
+
+    QByteArray qData = qFile.readAll();
+    qFile.close();
+
+    const SuperIOCacheRecord *pRecords = (const SuperIOCacheRecord*)qData.constData();
+    int nRecords = qData.size() / (int)sizeof(SuperIOCacheRecord);
+
+    // damaged or stale records are dropped and rewritten by the next probe
+    for( int i = 0; i < nRecords; i++ )
+    {
+        SuperIOCacheRecord Record;
+        memcpy(&Record, &pRecords[i], sizeof(Record));
+
+        if( SUPERIO_CACHE_MAGIC == Record.uMagic && SUPERIO_CACHE_VERSION == Record.uVersion &&
+            Checksum(&Record) == Record.uChecksum )
+            m_qRecords.append(Record);
+    }
+
+    return Success;
+}
+
+int CSuperIODetectionCache::Save()
+{
+    if( m_qsFile.isEmpty() )
+        return InvalidParameter;
+
+    QFile qFile(m_qsFile);
+    if( !qFile.open(QIODevice::WriteOnly | QIODevice::Truncate) )
+        return Unsuccessful;
+
+    int nSize = m_qRecords.size() * (int)sizeof(SuperIOCacheRecord);
+    bool bWritten = qFile.write((const char*)m_qRecords.constData(), nSize) == nSize;
+    qFile.close();
+
+    return bWritten ? Success : Unsuccessful;
+}
+
+bool CSuperIODetectionCache::Find(const QString &qsBoardIdentity, SuperIODetection *pDetection)
+{
+    QByteArray qIdentity = qsBoardIdentity.toUtf8();
+    unsigned int uBoard = Hash(qIdentity.constData(), qIdentity.size(), 2166136261u);
+
+    for( int i = 0; i < m_qRecords.size(); i++ )
+    {
+        if( m_qRecords[i].uBoard == uBoard )
+        {
+            *pDetection = m_qRecords[i].Detection;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CSuperIODetectionCache::Store(const QString &qsBoardIdentity, const SuperIODetection *pDetection)
+{
+    QByteArray qIdentity = qsBoardIdentity.toUtf8();
+    SuperIOCacheRecord Record;
+
+    memset(&Record, 0, sizeof(Record));
+    Record.uMagic = SUPERIO_CACHE_MAGIC;
+    Record.uVersion = SUPERIO_CACHE_VERSION;
+    Record.uBoard = Hash(qIdentity.constData(), qIdentity.size(), 2166136261u);
+    Record.Detection = *pDetection;
+    Record.uChecksum = Checksum(&Record);
+
+    for( int i = 0; i < m_qRecords.size(); i++ )
+    {
+        if( m_qRecords[i].uBoard == Record.uBoard )
+        {
+            m_qRecords[i] = Record;
+            return;
+        }
+    }
+
+    m_qRecords.append(Record);
+}
+
+void CSuperIODetectionCache::Remove(const QString &qsBoardIdentity)
+{
+    QByteArray qIdentity = qsBoardIdentity.toUtf8();
+    unsigned int uBoard = Hash(qIdentity.constData(), qIdentity.size(), 2166136261u);
+
+    for( int i = 0; i < m_qRecords.size(); i++ )
+    {
+        if( m_qRecords[i].uBoard == uBoard )
+        {
+            m_qRecords.remove(i);
+            return;
+        }
+    }
+}
@@ -0,0 +1,301 @@
+#include "../headers/superio_descriptors.h"
+
+#define SUPERIO_COUNT(X) ((int)(sizeof(X) / sizeof((X)[0])))
+
+// ITE IT87xx
+
+static const SuperIOVoltageChannel g_pIteVoltages16mV[] =
+{
+    { "VCORE", 0x20, 0.016 },
+    { "DDR",   0x26, 0.016 },
+    { "3VSB",  0x27, 0.032 },
+    { "VBAT",  0x28, 0.032 }
+};
+
+static const SuperIOVoltageChannel g_pIteVoltages12mV[] =
+{
+    { "VCORE", 0x20, 0.012 },
+    { "DDR",   0x26, 0.012 },
+    { "3VSB",  0x27, 0.024 },
+    { "VBAT",  0x28, 0.024 }
+};
+
+static const SuperIOTempChannel g_pIteTemps[] =
+{
+    { 0x29, SuperIOTempByte, 1, 99 },
+    { 0x2A, SuperIOTempByte, 1, 99 },
+    { 0x2B, SuperIOTempByte, 1, 99 }
+};
+
+static const SuperIOFanChannel g_pIteFans16Bit[] =
+{
+    { 0x0D, 0x18, 2 },
+    { 0x0E, 0x19, 2 },
+    { 0x0F, 0x1A, 2 },
+    { 0x80, 0x81, 2 },
+    { 0x82, 0x83, 2 }
+};
+
+// IT8705F and IT8712F only have 8-bit counters, the first two fans with
+// a programmable divisor in register 0x0B
+static const SuperIOFanChannel g_pIteFans8Bit[] =
+{
+    { 0x0D, SUPERIO_NO_REGISTER, 1, 3, { { 0x0B, 0 }, { 0x0B, 1 }, { 0x0B, 2 } } },
+    { 0x0E, SUPERIO_NO_REGISTER, 1, 3, { { 0x0B, 3 }, { 0x0B, 4 }, { 0x0B, 5 } } },
+    { 0x0F, SUPERIO_NO_REGISTER, 2 },
+    { 0x80, SUPERIO_NO_REGISTER, 2 },
+    { 0x82, SUPERIO_NO_REGISTER, 2 }
+};
+
+// Winbond W836xx
+
+#define WINBOND_VBAT_PRESENT { 0x5D, 0x01, 0x01 }
+
+static const SuperIOVoltageChannel g_pWinbondEhfVoltages[] =
+{
+    { "#0", 0x20, 0.008 },
+    { "#1", 0x21, 0.008 },
+    { "#2", 0x22, 0.008 },
+    { "#3", 0x23, 0.008 },
+    { "#4", 0x24, 0.008 },
+    { "#5", 0x25, 0.008 },
+    { "#6", 0x26, 0.008 },
+    { "#7", SUPERIO_REGISTER(5, 0x50), 0.008 },
+    { "#8", SUPERIO_REGISTER(5, 0x51), 0.008, 0, WINBOND_VBAT_PRESENT },
+    { "#9", SUPERIO_REGISTER(5, 0x52), 0.008 }
+};
+
+static const SuperIOVoltageChannel g_pWinbondDhgVoltages[] =
+{
+    { "#0", 0x20, 0.008 },
+    { "#1", 0x21, 0.008 },
+    { "#2", 0x22, 0.008 },
+    { "#3", 0x23, 0.008 },
+    { "#4", 0x24, 0.008 },
+    { "#5", 0x25, 0.008 },
+    { "#6", 0x26, 0.008 },
+    { "#7", SUPERIO_REGISTER(5, 0x50), 0.008 },
+    { "#8", SUPERIO_REGISTER(5, 0x51), 0.008, 0, WINBOND_VBAT_PRESENT }
+};
+
+// VCORE switches to the VRM9 scale when bit 0 of the VRM configuration is set
+static const SuperIOVoltageChannel g_pWinbondHfVoltages[] =
+{
+    { "#0", 0x20, 0.016, 0, { 0, 0, 0 }, { 0x18, 0x01, 0x01 }, 0.00488, 0.69 },
+    { "#1", 0x21, 0.016 },
+    { "#2", 0x22, 0.016 },
+    { "#3", 0x23, 0.016 },
+    { "#4", 0x24, 0.016 },
+    { "#5", SUPERIO_REGISTER(5, 0x50), 0.016 },
+    { "#6", SUPERIO_REGISTER(5, 0x51), 0.016, 0, WINBOND_VBAT_PRESENT }
+};
+
+static const SuperIOTempChannel g_pWinbondTemps[] =
+{
+    { SUPERIO_REGISTER(1, 0x50), SuperIOTempHalfDegree, -55, 125 },
+    { SUPERIO_REGISTER(2, 0x50), SuperIOTempHalfDegree, -55, 125 },
+    { 0x27, SuperIOTempSignedByte, -55, 125 }
+};
+
+// Temperature inputs routed to PECI/SMBus sources are not read over LPC
+static const SuperIOTempChannel g_pWinbondHgTemps[] =
+{
+    { SUPERIO_REGISTER(1, 0x50), SuperIOTempHalfDegree, -55, 125, { 0x49, 0x04, 0x00 } },
+    { SUPERIO_REGISTER(2, 0x50), SuperIOTempHalfDegree, -55, 125, { 0x49, 0x40, 0x00 } },
+    { 0x27, SuperIOTempSignedByte, -55, 125 }
+};
+
+static const SuperIOTempChannel g_pWinbondDhgTemps[] =
+{
+    { SUPERIO_REGISTER(1, 0x50), SuperIOTempHalfDegree, -55, 125, { 0x49, 0x07, 0x00 } },
+    { SUPERIO_REGISTER(2, 0x50), SuperIOTempHalfDegree, -55, 125, { 0x49, 0x70, 0x00 } },
+    { 0x27, SuperIOTempSignedByte, -55, 125 }
+};
+
+static const SuperIOFanChannel g_pWinbondFans[] =
+{
+    { 0x28, SUPERIO_NO_REGISTER, 1, 3, { { 0x47, 4 }, { 0x47, 5 }, { 0x5D, 5 } } },
+    { 0x29, SUPERIO_NO_REGISTER, 1, 3, { { 0x47, 6 }, { 0x47, 7 }, { 0x5D, 6 } } },
+    { 0x2A, SUPERIO_NO_REGISTER, 1, 3, { { 0x4B, 6 }, { 0x4B, 7 }, { 0x5D, 7 } } },
+    { 0x3F, SUPERIO_NO_REGISTER, 1, 3, { { 0x59, 0 }, { 0x59, 1 }, { 0x4C, 7 } } },
+    { SUPERIO_REGISTER(5, 0x53), SUPERIO_NO_REGISTER, 1, 3, { { 0x59, 2 }, { 0x59, 3 }, { 0x59, 7 } } }
+};
+
+// Fintek F718xx
+
+static const SuperIOVoltageChannel g_pFintekVoltages[] =
+{
+    { "#0", 0x20, 0.008 },
+    { "#1", 0x21, 0.008 },
+    { "#2", 0x22, 0.008 },
+    { "#3", 0x23, 0.008 },
+    { "#4", 0x24, 0.008 },
+    { "#5", 0x25, 0.008 },
+    { "#6", 0x26, 0.008 },
+    { "#7", 0x27, 0.008 },
+    { "#8", 0x28, 0.008 }
+};
+
+static const SuperIOVoltageChannel g_pF71808EVoltages[] =
+{
+    { "#0", 0x20, 0.008 },
+    { "#1", 0x21, 0.008 },
+    { "#2", 0x22, 0.008 },
+    { "#3", 0x23, 0.008 },
+    { "#4", 0x24, 0.008 },
+    { "#5", 0x25, 0.008 },
+    { "#6", SUPERIO_NO_REGISTER },
+    { "#7", 0x27, 0.008 },
+    { "#8", 0x28, 0.008 }
+};
+
+static const SuperIOTempChannel g_pFintekTemps[] =
+{
+    { 0x72, SuperIOTempByte, 1, 255 },
+    { 0x74, SuperIOTempByte, 1, 255 },
+    { 0x76, SuperIOTempByte, 1, 255 }
+};
+
+static const SuperIOTempChannel g_pF71858Temps[] =
+{
+    { 0x70, SuperIOTempFintek11Bit, -128, 128 },
+    { 0x72, SuperIOTempFintek11Bit, -128, 128 },
+    { 0x74, SuperIOTempFintek11Bit, -128, 128 }
+};
+
+static const SuperIOFanChannel g_pFintekFans[] =
+{
+    { 0xA1, 0xA0, 1 },
+    { 0xB1, 0xB0, 1 },
+    { 0xC1, 0xC0, 1 },
+    { 0xD1, 0xD0, 1 }
+};
+
+#define ITE_IDENTIFY        { { 0x58, 0xFF, 0x90 }, { 0x00, 0x10, 0x10 } }
+#define WINBOND_IDENTIFY    { { SUPERIO_REGISTER(0x80, 0x4F), 0xFF, 0x5C }, { 0x4F, 0xFF, 0xA3 } }
+#define FINTEK_IDENTIFY     { { 0, 0, 0 }, { 0, 0, 0 } }
+
+#define ITE_CHIP(chip, voltages, fans, min, max) \
+    { chip, #chip, SuperIONoBank, ITE_IDENTIFY, voltages, SUPERIO_COUNT(voltages), \
+      g_pIteTemps, SUPERIO_COUNT(g_pIteTemps), SUPERIO_NO_REGISTER, \
+      fans, SUPERIO_COUNT(fans), 1.35e6, min, max, false }
+
+#define WINBOND_CHIP(chip, voltages, temps) \
+    { chip, #chip, SuperIOWinbondBank, WINBOND_IDENTIFY, voltages, SUPERIO_COUNT(voltages), \
+      temps, SUPERIO_COUNT(temps), SUPERIO_NO_REGISTER, \
+      g_pWinbondFans, SUPERIO_COUNT(g_pWinbondFans), 1.35e6, 0x01, 0xFE, true }
+
+#define FINTEK_CHIP(chip, voltages, nVoltages, temps, mode, nFans) \
+    { chip, #chip, SuperIONoBank, FINTEK_IDENTIFY, voltages, nVoltages, \
+      temps, SUPERIO_COUNT(temps), mode, \
+      g_pFintekFans, nFans, 1.5e6, 0x01, 0x0FFE, false }
+
+static const SuperIOChipDescriptor g_pSuperIOChips[] =
+{
+    ITE_CHIP(IT8705F, g_pIteVoltages16mV, g_pIteFans8Bit, 0x01, 0xFE),
+    ITE_CHIP(IT8712F, g_pIteVoltages16mV, g_pIteFans8Bit, 0x01, 0xFE),
+    ITE_CHIP(IT8716F, g_pIteVoltages16mV, g_pIteFans16Bit, 0x40, 0xFFFE),
+    ITE_CHIP(IT8718F, g_pIteVoltages16mV, g_pIteFans16Bit, 0x40, 0xFFFE),
+    ITE_CHIP(IT8720F, g_pIteVoltages16mV, g_pIteFans16Bit, 0x40, 0xFFFE),
+    ITE_CHIP(IT8721F, g_pIteVoltages12mV, g_pIteFans16Bit, 0x40, 0xFFFE),
+    ITE_CHIP(IT8726F, g_pIteVoltages16mV, g_pIteFans16Bit, 0x40, 0xFFFE),
+    ITE_CHIP(IT8728F, g_pIteVoltages12mV, g_pIteFans16Bit, 0x40, 0xFFFE),
+    ITE_CHIP(IT8771E, g_pIteVoltages12mV, g_pIteFans16Bit, 0x40, 0xFFFE),
+    ITE_CHIP(IT8772E, g_pIteVoltages12mV, g_pIteFans16Bit, 0x40, 0xFFFE),
+
+    WINBOND_CHIP(W83627EHF, g_pWinbondEhfVoltages, g_pWinbondTemps),
+    WINBOND_CHIP(W83627DHG, g_pWinbondDhgVoltages, g_pWinbondDhgTemps),
+    WINBOND_CHIP(W83627DHGP, g_pWinbondDhgVoltages, g_pWinbondDhgTemps),
+    WINBOND_CHIP(W83667HG, g_pWinbondDhgVoltages, g_pWinbondHgTemps),
+    WINBOND_CHIP(W83667HGB, g_pWinbondDhgVoltages, g_pWinbondHgTemps),
+    WINBOND_CHIP(W83627HF, g_pWinbondHfVoltages, g_pWinbondTemps),
+    WINBOND_CHIP(W83627THF, g_pWinbondHfVoltages, g_pWinbondTemps),
+    WINBOND_CHIP(W83687THF, g_pWinbondHfVoltages, g_pWinbondTemps),
+
+    FINTEK_CHIP(F71858, g_pFintekVoltages, 3, g_pF71858Temps, 0x69, 4),
+    FINTEK_CHIP(F71862, g_pFintekVoltages, 9, g_pFintekTemps, SUPERIO_NO_REGISTER, 3),
+    FINTEK_CHIP(F71869, g_pFintekVoltages, 9, g_pFintekTemps, SUPERIO_NO_REGISTER, 3),
+    FINTEK_CHIP(F71869A, g_pFintekVoltages, 9, g_pFintekTemps, SUPERIO_NO_REGISTER, 3),
+    FINTEK_CHIP(F71882, g_pFintekVoltages, 9, g_pFintekTemps, SUPERIO_NO_REGISTER, 4),
+    FINTEK_CHIP(F71889AD, g_pFintekVoltages, 9, g_pFintekTemps, SUPERIO_NO_REGISTER, 3),
+    FINTEK_CHIP(F71889ED, g_pFintekVoltages, 9, g_pFintekTemps, SUPERIO_NO_REGISTER, 3),
+    FINTEK_CHIP(F71889F, g_pFintekVoltages, 9, g_pFintekTemps, SUPERIO_NO_REGISTER, 3),
+    FINTEK_CHIP(F71808E, g_pF71808EVoltages, 9, g_pFintekTemps, SUPERIO_NO_REGISTER, 3)
+};
+
+static const SuperIOChipId g_pSuperIOChipIds[] =
+{
+    { SuperIOIte, 0x8705, 0x00, 0x00, 0x04, 0x05, 0x60, IT8705F },
+    { SuperIOIte, 0x8712, 0x00, 0x00, 0x04, 0x07, 0x62, IT8712F },
+    { SuperIOIte, 0x8716, 0x00, 0x00, 0x04, 0x07, 0x62, IT8716F },
+    { SuperIOIte, 0x8718, 0x00, 0x00, 0x04, 0x07, 0x62, IT8718F },
+    { SuperIOIte, 0x8720, 0x00, 0x00, 0x04, 0x07, 0x62, IT8720F },
+    { SuperIOIte, 0x8721, 0x00, 0x00, 0x04, 0x07, 0x62, IT8721F },
+    { SuperIOIte, 0x8726, 0x00, 0x00, 0x04, 0x07, 0x62, IT8726F },
+    { SuperIOIte, 0x8728, 0x00, 0x00, 0x04, 0x07, 0x62, IT8728F },
+    { SuperIOIte, 0x8771, 0x00, 0x00, 0x04, 0x07, 0x62, IT8771E },
+    { SuperIOIte, 0x8772, 0x00, 0x00, 0x04, 0x07, 0x62, IT8772E },
+
+    { SuperIOWinbond, 0x52, 0xFF, 0x17, 0x0B, 0, 0, W83627HF },
+    { SuperIOWinbond, 0x52, 0xFF, 0x3A, 0x0B, 0, 0, W83627HF },
+    { SuperIOWinbond, 0x52, 0xFF, 0x41, 0x0B, 0, 0, W83627HF },
+    { SuperIOWinbond, 0x82, 0xF0, 0x80, 0x0B, 0, 0, W83627THF },
+    { SuperIOWinbond, 0x85, 0xFF, 0x41, 0x0B, 0, 0, W83687THF },
+    { SuperIOWinbond, 0x88, 0xF0, 0x50, 0x0B, 0, 0, W83627EHF },
+    { SuperIOWinbond, 0x88, 0xF0, 0x60, 0x0B, 0, 0, W83627EHF },
+    { SuperIOWinbond, 0xA0, 0xF0, 0x20, 0x0B, 0, 0, W83627DHG },
+    { SuperIOWinbond, 0xA5, 0xF0, 0x10, 0x0B, 0, 0, W83667HG },
+    { SuperIOWinbond, 0xB0, 0xF0, 0x70, 0x0B, 0, 0, W83627DHGP },
+    { SuperIOWinbond, 0xB3, 0xF0, 0x50, 0x0B, 0, 0, W83667HGB },
+
+    { SuperIOFintek, 0x05, 0xFF, 0x07, 0x02, 0, 0, F71858 },
+    { SuperIOFintek, 0x05, 0xFF, 0x41, 0x04, 0, 0, F71882 },
+    { SuperIOFintek, 0x06, 0xFF, 0x01, 0x04, 0, 0, F71862 },
+    { SuperIOFintek, 0x07, 0xFF, 0x23, 0x04, 0, 0, F71889F },
+    { SuperIOFintek, 0x08, 0xFF, 0x14, 0x04, 0, 0, F71869 },
+    { SuperIOFintek, 0x09, 0xFF, 0x01, 0x04, 0, 0, F71808E },
+    { SuperIOFintek, 0x09, 0xFF, 0x09, 0x04, 0, 0, F71889ED },
+    { SuperIOFintek, 0x10, 0xFF, 0x05, 0x04, 0, 0, F71889AD },
+    { SuperIOFintek, 0x10, 0xFF, 0x07, 0x04, 0, 0, F71869A }
+};
+
+// Probed in this order
+static const SuperIOFamilyDescriptor g_pSuperIOFamilies[] =
+{
+    { SuperIOIte,     0x2E, 0x2F, { 0x87, 0x01, 0x55, 0x55 }, 4, 0x02, 0x02, true,  true,  0,    0,      false },
+    { SuperIOWinbond, 0x2E, 0x2F, { 0x87, 0x87 },             2, 0xAA, 0x00, false, false, 0,    0,      false },
+    { SuperIOFintek,  0x4E, 0x4F, { 0x87, 0x87 },             2, 0xAA, 0x00, false, false, 0x23, 0x1934, true  }
+};
+
+const SuperIOFamilyDescriptor *SuperIOGetFamilies(int *pnCount)
+{
+    if( pnCount )
+        *pnCount = SUPERIO_COUNT(g_pSuperIOFamilies);
+
+    return g_pSuperIOFamilies;
+}
+
+const SuperIOChipId *SuperIOFindChipId(SuperIOFamily eFamily, USHORT usId, BYTE bRevision)
+{
+    for( int i = 0; i < SUPERIO_COUNT(g_pSuperIOChipIds); i++ )
+    {
+        const SuperIOChipId *pId = &g_pSuperIOChipIds[i];
+
+        if( pId->eFamily == eFamily && pId->usId == usId &&
+            (bRevision & pId->bRevisionMask) == pId->bRevision )
+            return pId;
+    }
+
+    return NULL;
+}
+
+const SuperIOChipDescriptor *SuperIOFindChip(Chip eChip)
+{
+    for( int i = 0; i < SUPERIO_COUNT(g_pSuperIOChips); i++ )
+    {
+        if( g_pSuperIOChips[i].eChip == eChip )
+            return &g_pSuperIOChips[i];
+    }
+
+    return NULL;
+}
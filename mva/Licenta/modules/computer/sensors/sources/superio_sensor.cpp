@@ -0,0 +1,531 @@
+#include "../headers/superio_sensor.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../../../utils/headers/self_profile.h"
+
+CSuperIOSensor::CSuperIOSensor(const SuperIOChipDescriptor *pChip, USHORT usAddress):
+    m_pChip( pChip ),
+    m_usAddress( usAddress ),
+    m_pDriver( NULL ),
+    m_nTempMode( 0 ),
+    m_nBank( -1 )
+{
+    m_pDriver = new CRing0Wrapper;
+    CHECK_ALLOCATION(m_pDriver);
+
+    int nStatus = m_pDriver->Initialize();
+    CHECK_OPERATION_STATUS(nStatus);
+}
+
+CSuperIOSensor::~CSuperIOSensor()
+{
+    Destroy();
+}
+
+int CSuperIOSensor::SelectBank(BYTE bBank)
+{
+    int nStatus = Uninitialized;
+
+    if( SuperIOWinbondBank != m_pChip->eBankScheme || m_nBank == bBank )
+        return Success;
+
+    nStatus = m_pDriver->WriteIoPortByte(m_usAddress + SUPERIO_ADDRESS_REGISTER_OFFSET,
+                                         SUPERIO_WINBOND_BANK_SELECT_REGISTER);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    nStatus = m_pDriver->WriteIoPortByte(m_usAddress + SUPERIO_DATA_REGISTER_OFFSET, bBank);
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    m_nBank = bBank;
+
+    return Success;
+}
+
+int CSuperIOSensor::ReadRegister(USHORT usRegister, BYTE *pbValue)
+{
+    int nStatus = Uninitialized;
+
+    nStatus = SelectBank(SUPERIO_REGISTER_BANK(usRegister));
+    if( Success != nStatus )
+        return nStatus;
+
+    nStatus = m_pDriver->WriteIoPortByte(m_usAddress + SUPERIO_ADDRESS_REGISTER_OFFSET,
+                                         SUPERIO_REGISTER_OFFSET(usRegister));
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    return m_pDriver->ReadIoPortByte(m_usAddress + SUPERIO_DATA_REGISTER_OFFSET, pbValue);
+}
+
+int CSuperIOSensor::WriteRegister(USHORT usRegister, BYTE bValue)
+{
+    int nStatus = Uninitialized;
+
+    nStatus = SelectBank(SUPERIO_REGISTER_BANK(usRegister));
+    if( Success != nStatus )
+        return nStatus;
+
+    nStatus = m_pDriver->WriteIoPortByte(m_usAddress + SUPERIO_ADDRESS_REGISTER_OFFSET,
+                                         SUPERIO_REGISTER_OFFSET(usRegister));
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    return m_pDriver->WriteIoPortByte(m_usAddress + SUPERIO_DATA_REGISTER_OFFSET, bValue);
+}
+
+int CSuperIOSensor::CheckCondition(const SuperIOCondition *pCondition, bool *pbHolds)
+{
+    BYTE bValue = 0;
+
+    *pbHolds = true;
+    if( 0 == pCondition->bMask )
+        return Success;
+
+    int nStatus = ReadRegister(pCondition->usRegister, &bValue);
+    if( Success != nStatus )
+        return nStatus;
+
+    *pbHolds = (bValue & pCondition->bMask) == pCondition->bValue;
+
+    return Success;
+}
+
+void CSuperIOSensor::AddChannel(SensorKind Kind, SensorUnit Unit, const char *pszLabel)
+{
+    SensorChannel Channel;
+
+    memset(&Channel, 0, sizeof(Channel));
+    Channel.Kind = Kind;
+    Channel.Unit = Unit;
+    strncpy(Channel.szLabel, pszLabel, SENSOR_NAME_SIZE - 1);
+
+    m_qChannels.push_back(Channel);
+}
+
+void CSuperIOSensor::AddToPlan(USHORT usRegister)
+{
+    m_qPlan.push_back(usRegister);
+}
+
+int CSuperIOSensor::PlanIndex(int nRegister)
+{
+    if( 0 > nRegister )
+        return -1;
+
+    std::vector<USHORT>::iterator it = std::lower_bound(m_qPlan.begin(), m_qPlan.end(),
+                                                        (USHORT)nRegister);
+
+    return (int)(it - m_qPlan.begin());
+}
+
+// Static configuration (identification, routing of the inputs, VRM mode)
+// is read here once; the slots temporarily hold register numbers until the
+// plan is sorted and they can be turned into indexes.
+int CSuperIOSensor::BuildPlan()
+{
+    int nStatus = Uninitialized;
+    bool bHolds = false;
+
+    m_qPlan.clear();
+
+    for( int i = 0; i < SUPERIO_MAX_VOLTAGES; i++ )
+    {
+        SuperIOVoltageSlot *pSlot = &m_pVoltageSlots[i];
+        pSlot->nIndex = -1;
+        pSlot->dScale = 0;
+        pSlot->dOffset = 0;
+
+        if( i >= m_pChip->nVoltages || SUPERIO_NO_REGISTER == m_pChip->pVoltages[i].usRegister )
+            continue;
+
+        const SuperIOVoltageChannel *pChannel = &m_pChip->pVoltages[i];
+
+        nStatus = CheckCondition(&pChannel->Present, &bHolds);
+        if( Success != nStatus )
+            return nStatus;
+        if( !bHolds )
+            continue;
+
+        pSlot->dScale = pChannel->dScale;
+        pSlot->dOffset = pChannel->dOffset;
+
+        if( 0 != pChannel->Alternate.bMask )
+        {
+            nStatus = CheckCondition(&pChannel->Alternate, &bHolds);
+            if( Success != nStatus )
+                return nStatus;
+            if( bHolds )
+            {
+                pSlot->dScale = pChannel->dAltScale;
+                pSlot->dOffset = pChannel->dAltOffset;
+            }
+        }
+
+        pSlot->nIndex = pChannel->usRegister;
+        AddToPlan(pChannel->usRegister);
+    }
+
+    for( int i = 0; i < SUPERIO_MAX_TEMPS; i++ )
+    {
+        SuperIOTempSlot *pSlot = &m_pTempSlots[i];
+        pSlot->nIndex = -1;
+        pSlot->nFraction = -1;
+
+        if( i >= m_pChip->nTemps )
+            continue;
+
+        const SuperIOTempChannel *pChannel = &m_pChip->pTemps[i];
+
+        nStatus = CheckCondition(&pChannel->Present, &bHolds);
+        if( Success != nStatus )
+            return nStatus;
+        if( !bHolds )
+            continue;
+
+        pSlot->nIndex = pChannel->usRegister;
+        AddToPlan(pChannel->usRegister);
+
+        if( SuperIOTempHalfDegree == pChannel->eFormat || SuperIOTempFintek11Bit == pChannel->eFormat )
+        {
+            pSlot->nFraction = pChannel->usRegister + 1;
+            AddToPlan(pChannel->usRegister + 1);
+        }
+    }
+
+    m_nTempMode = 0;
+    if( SUPERIO_NO_REGISTER != m_pChip->usTempMode )
+    {
+        BYTE bMode = 0;
+        nStatus = ReadRegister(m_pChip->usTempMode, &bMode);
+        if( Success != nStatus )
+            return nStatus;
+        m_nTempMode = bMode & 0x03;
+    }
+
+    for( int i = 0; i < SUPERIO_MAX_FANS; i++ )
+    {
+        SuperIOFanSlot *pSlot = &m_pFanSlots[i];
+        pSlot->nLow = -1;
+        pSlot->nHigh = -1;
+        for( int j = 0; j < SUPERIO_MAX_DIVISOR_BITS; j++ )
+            pSlot->pnDivisor[j] = -1;
+
+        if( i >= m_pChip->nFans )
+            continue;
+
+        const SuperIOFanChannel *pChannel = &m_pChip->pFans[i];
+
+        pSlot->nLow = pChannel->usCountLow;
+        AddToPlan(pChannel->usCountLow);
+
+        if( SUPERIO_NO_REGISTER != pChannel->usCountHigh )
+        {
+            pSlot->nHigh = pChannel->usCountHigh;
+            AddToPlan(pChannel->usCountHigh);
+        }
+
+        for( int j = 0; j < pChannel->bDivisorBits; j++ )
+        {
+            pSlot->pnDivisor[j] = pChannel->DivisorBits[j].usRegister;
+            AddToPlan(pChannel->DivisorBits[j].usRegister);
+        }
+    }
+
+    // registers ordered by bank, each read once
+    std::sort(m_qPlan.begin(), m_qPlan.end());
+    m_qPlan.erase(std::unique(m_qPlan.begin(), m_qPlan.end()), m_qPlan.end());
+    m_qValues.assign(m_qPlan.size(), 0);
+
+    for( int i = 0; i < SUPERIO_MAX_VOLTAGES; i++ )
+        m_pVoltageSlots[i].nIndex = PlanIndex(m_pVoltageSlots[i].nIndex);
+
+    for( int i = 0; i < SUPERIO_MAX_TEMPS; i++ )
+    {
+        m_pTempSlots[i].nIndex = PlanIndex(m_pTempSlots[i].nIndex);
+        m_pTempSlots[i].nFraction = PlanIndex(m_pTempSlots[i].nFraction);
+    }
+
+    for( int i = 0; i < SUPERIO_MAX_FANS; i++ )
+    {
+        m_pFanSlots[i].nLow = PlanIndex(m_pFanSlots[i].nLow);
+        m_pFanSlots[i].nHigh = PlanIndex(m_pFanSlots[i].nHigh);
+        for( int j = 0; j < SUPERIO_MAX_DIVISOR_BITS; j++ )
+            m_pFanSlots[i].pnDivisor[j] = PlanIndex(m_pFanSlots[i].pnDivisor[j]);
+    }
+
+    // only sampled inputs are published, grouped by kind
+    char szLabel[SENSOR_NAME_SIZE];
+    m_qChannels.clear();
+
+    for( int i = 0; i < SUPERIO_MAX_TEMPS; i++ )
+    {
+        if( 0 > m_pTempSlots[i].nIndex )
+            continue;
+        sprintf(szLabel, "Temperature #%d", i + 1);
+        AddChannel(SensorKindTemperature, SensorUnitCelsius, szLabel);
+    }
+
+    for( int i = 0; i < SUPERIO_MAX_VOLTAGES; i++ )
+    {
+        if( 0 > m_pVoltageSlots[i].nIndex )
+            continue;
+        AddChannel(SensorKindVoltage, SensorUnitVolt, m_pChip->pVoltages[i].szName);
+    }
+
+    for( int i = 0; i < SUPERIO_MAX_FANS; i++ )
+    {
+        if( 0 > m_pFanSlots[i].nLow )
+            continue;
+        sprintf(szLabel, "Fan #%d", i + 1);
+        AddChannel(SensorKindFan, SensorUnitRPM, szLabel);
+    }
+
+    return Success;
+}
+
+int CSuperIOSensor::Validate()
+{
+    bool bHolds = false;
+
+    if( !m_pChip || !m_pDriver )
+        return NullException;
+
+    if( 0 == m_pChip->Identify[0].bMask )
+        return Unsuccessful;
+
+    m_nBank = -1;
+
+    int nStatus = CheckCondition(&m_pChip->Identify[0], &bHolds);
+    if( Success != nStatus )
+        return nStatus;
+
+    return bHolds ? Success : Unsuccessful;
+}
+
+int CSuperIOSensor::Initialize()
+{
+    int nStatus = Uninitialized;
+    bool bHolds = false;
+
+    if( !m_pChip || !m_pDriver )
+        return NullException;
+
+    m_nBank = -1;
+
+    for( int i = 0; i < 2; i++ )
+    {
+        nStatus = CheckCondition(&m_pChip->Identify[i], &bHolds);
+        if( Success != nStatus )
+            return nStatus;
+
+        if( !bHolds )
+        {
+            DEBUG_STATUS(Unsuccessful);
+            return Unsuccessful;
+        }
+    }
+
+    return BuildPlan();
+}
+
+int CSuperIOSensor::Destroy()
+{
+    int nStatus = Success;
+
+    if( m_pDriver )
+    {
+        nStatus = m_pDriver->Destroy();
+        SAFE_DELETE(m_pDriver);
+    }
+
+    m_qPlan.clear();
+    m_qValues.clear();
+    m_qChannels.clear();
+
+    return nStatus;
+}
+
+bool CSuperIOSensor::DecodeTemp(int nChannel, double *pdValue)
+{
+    const SuperIOTempSlot *pSlot = &m_pTempSlots[nChannel];
+    BYTE bValue = m_qValues[pSlot->nIndex];
+    BYTE bFraction = 0 <= pSlot->nFraction ? m_qValues[pSlot->nFraction] : 0;
+
+    switch( m_pChip->pTemps[nChannel].eFormat )
+    {
+    case SuperIOTempByte:
+        *pdValue = bValue;
+        break;
+    case SuperIOTempSignedByte:
+        *pdValue = (signed char)bValue;
+        break;
+    case SuperIOTempHalfDegree:
+        *pdValue = ((signed char)bValue * 2 + (bFraction >> 7)) / 2.0;
+        break;
+    case SuperIOTempFintek11Bit:
+    {
+        if( 0xBB == bValue || 0xCC == bValue )
+            return false;
+
+        int nBits = 0;
+        if( 2 == m_nTempMode )
+            nBits = (bValue & 0x80) << 8;
+        else if( 3 == m_nTempMode )
+            nBits = (bFraction & 0x01) << 15;
+        nBits |= bValue << 7;
+        nBits |= (bFraction & 0xE0) >> 1;
+
+        *pdValue = (short)(nBits & 0xFFF0) / 128.0;
+    }
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+// Winbond counters are 8-bit, so the divisor is moved whenever the count
+// leaves 96..192. Runs only when a divisor actually changes.
+int CSuperIOSensor::AdjustFanDivisors()
+{
+    int nStatus = Uninitialized;
+
+    for( int i = 0; i < m_pChip->nFans; i++ )
+    {
+        const SuperIOFanChannel *pChannel = &m_pChip->pFans[i];
+        const SuperIOFanSlot *pSlot = &m_pFanSlots[i];
+
+        if( 0 == pChannel->bDivisorBits || 0 > pSlot->nLow )
+            continue;
+
+        int nCount = m_qValues[pSlot->nLow];
+        int nBits = 0;
+        for( int j = 0; j < pChannel->bDivisorBits; j++ )
+            nBits |= ((m_qValues[pSlot->pnDivisor[j]] >> pChannel->DivisorBits[j].bBit) & 1) << j;
+
+        int nNewBits = nBits;
+        if( nCount > 192 && nNewBits < (1 << pChannel->bDivisorBits) - 1 )
+            nNewBits++;
+        if( nCount < 96 && nNewBits > 0 )
+            nNewBits--;
+
+        if( nNewBits == nBits )
+            continue;
+
+        for( int j = 0; j < pChannel->bDivisorBits; j++ )
+        {
+            int nIndex = pSlot->pnDivisor[j];
+            BYTE bMask = (BYTE)(1 << pChannel->DivisorBits[j].bBit);
+            BYTE bOld = m_qValues[nIndex];
+
+            if( (nNewBits >> j) & 1 )
+                m_qValues[nIndex] |= bMask;
+            else
+                m_qValues[nIndex] &= ~bMask;
+
+            if( bOld != m_qValues[nIndex] )
+            {
+                nStatus = WriteRegister(m_qPlan[nIndex], m_qValues[nIndex]);
+                if( Success != nStatus )
+                    return nStatus;
+            }
+        }
+    }
+
+    return Success;
+}
+
+int CSuperIOSensor::GetChannelCount()
+{
+    return (int)m_qChannels.size();
+}
+
+const SensorChannel *CSuperIOSensor::GetChannels()
+{
+    return m_qChannels.empty() ? NULL : &m_qChannels[0];
+}
+
+int CSuperIOSensor::Update(double *pValues)
+{
+    STK_PROFILE_SCOPE(ProfileModuleBoard);
+
+    int nStatus = Uninitialized;
+    int nOut = 0;
+
+    if( !m_pDriver || !pValues )
+        return NullException;
+
+    // another client may have moved the bank since the last tick
+    m_nBank = -1;
+
+    for( size_t i = 0; i < m_qPlan.size(); i++ )
+    {
+        nStatus = ReadRegister(m_qPlan[i], &m_qValues[i]);
+        if( Success != nStatus )
+            return nStatus;
+    }
+
+    // same order as the channel list built by BuildPlan()
+    for( int i = 0; i < SUPERIO_MAX_TEMPS; i++ )
+    {
+        double dValue = 0;
+
+        if( 0 > m_pTempSlots[i].nIndex )
+            continue;
+
+        if( DecodeTemp(i, &dValue) && dValue >= m_pChip->pTemps[i].dMin && dValue <= m_pChip->pTemps[i].dMax )
+            pValues[nOut++] = dValue;
+        else
+            pValues[nOut++] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    for( int i = 0; i < SUPERIO_MAX_VOLTAGES; i++ )
+    {
+        const SuperIOVoltageSlot *pSlot = &m_pVoltageSlots[i];
+
+        if( 0 > pSlot->nIndex )
+            continue;
+
+        double dValue = m_qValues[pSlot->nIndex] * pSlot->dScale + pSlot->dOffset;
+        pValues[nOut++] = 0 < dValue ? dValue : 0;
+    }
+
+    for( int i = 0; i < SUPERIO_MAX_FANS; i++ )
+    {
+        const SuperIOFanSlot *pSlot = &m_pFanSlots[i];
+
+        if( 0 > pSlot->nLow )
+            continue;
+
+        const SuperIOFanChannel *pChannel = &m_pChip->pFans[i];
+
+        int nCount = m_qValues[pSlot->nLow];
+        if( 0 <= pSlot->nHigh )
+            nCount |= m_qValues[pSlot->nHigh] << 8;
+
+        int nBits = 0;
+        for( int j = 0; j < pChannel->bDivisorBits; j++ )
+            nBits |= ((m_qValues[pSlot->pnDivisor[j]] >> pChannel->DivisorBits[j].bBit) & 1) << j;
+
+        int nDivisor = pChannel->bBaseDivisor << nBits;
+
+        // a stopped fan and an empty header both read as 0 rpm
+        if( nCount >= m_pChip->usFanMinCount && nCount <= m_pChip->usFanMaxCount && 0 < nDivisor )
+            pValues[nOut++] = m_pChip->dFanClock / ((double)nCount * nDivisor);
+        else
+            pValues[nOut++] = 0;
+    }
+
+    if( m_pChip->bAdjustFanDivisor )
+        return AdjustFanDivisors();
+
+    return Success;
+}
+
+QString CSuperIOSensor::GetChipName()
+{
+    return m_pChip ? QString(m_pChip->szName) : QString("");
+}
@@ -0,0 +1,146 @@
+#include "../headers/thermal_throttle.h"
+
+#include <string.h>
+
+CThermalThrottle::CThermalThrottle():
+    m_pCores( NULL ),
+    m_nCores( 0 ),
+    m_bBaseline( true ),
+    m_ulLogMask( THERM_STATUS_LOG_MASK ),
+    m_ulCoreKeep( THERM_STATUS_THRESHOLD_LOGS ),
+    m_ulPackageKeep( THERM_STATUS_THRESHOLD_LOGS )
+{
+    memset(&m_Package, 0, sizeof(ThrottleCounter));
+}
+
+CThermalThrottle::~CThermalThrottle()
+{
+    delete[] m_pCores;
+    m_pCores = NULL;
+}
+
+int CThermalThrottle::Initialize(int nCores, unsigned long ulCpuidThermal)
+{
+    delete[] m_pCores;
+    m_pCores = NULL;
+    m_nCores = 0;
+
+    if( 0 >= nCores )
+        return InvalidParameter;
+
+    m_pCores = new ThrottleCounter[nCores];
+    CHECK_ALLOCATION_STATUS(m_pCores);
+    memset(m_pCores, 0, nCores * sizeof(ThrottleCounter));
+    memset(&m_Package, 0, sizeof(ThrottleCounter));
+
+    m_nCores = nCores;
+    m_bBaseline = true;
+
+    // Bit 11 is reserved without power limit notification, bits 13 and 15
+    // of the core register without HWP
+    m_ulLogMask = THERM_STATUS_LOG_MASK;
+    if( ulCpuidThermal & CPUID_06_EAX_PLN )
+        m_ulLogMask |= THERM_STATUS_POWER_LIMIT_LOG;
+
+    m_ulCoreKeep = THERM_STATUS_THRESHOLD_LOGS;
+    if( ulCpuidThermal & CPUID_06_EAX_HWP )
+        m_ulCoreKeep |= THERM_STATUS_LIMIT_LOGS;
+    m_ulPackageKeep = THERM_STATUS_THRESHOLD_LOGS;
+
+    return Success;
+}
+
+void CThermalThrottle::Track(ThrottleCounter *pCounter, unsigned long long ullStatus, unsigned long long ullTimestamp)
+{
+    for( int i = 0; i < ThrottleReasonCount; i++ )
+    {
+        unsigned long long ullMask = THROTTLE_REASON_MASK((ThrottleReason)i);
+        if( 0 == (m_ulLogMask & (ullMask << 1)) )
+            continue;
+
+        bool bActive = 0 != (ullStatus & ullMask);
+        bool bLogged = 0 != (ullStatus & (ullMask << 1));
+
+        // Logs left over from before the first sample have no timestamp
+        if( !m_bBaseline && ((bActive && !pCounter->pActive[i]) || (!bActive && !pCounter->pActive[i] && bLogged)) )
+        {
+            pCounter->pEvents[i]++;
+            pCounter->ullLastEvent = ullTimestamp;
+        }
+
+        pCounter->pActive[i] = bActive;
+    }
+}
+
+int CThermalThrottle::Record(const unsigned long long *pValues, int nStride, unsigned long long ullTimestamp,
+                             unsigned long *pulCoreLogs, unsigned long *pulPackageLogs)
+{
+    unsigned long long ullPackage = 0;
+    unsigned long ulCoreLogs = 0;
+
+    if( !pValues || 0 >= nStride )
+        return InvalidParameter;
+    if( !m_pCores )
+        return Uninitialized;
+
+    for( int i = 0; i < m_nCores; i++ )
+    {
+        unsigned long long ullStatus = pValues[i * nStride];
+        Track(&m_pCores[i], ullStatus, ullTimestamp);
+        ulCoreLogs |= (unsigned long)(ullStatus & m_ulLogMask);
+
+        // Any package on a multi socket host
+        if( 1 < nStride )
+            ullPackage |= pValues[i * nStride + 1];
+    }
+
+    if( 1 < nStride )
+        Track(&m_Package, ullPackage, ullTimestamp);
+
+    m_bBaseline = false;
+
+    if( pulCoreLogs )
+        *pulCoreLogs = ulCoreLogs;
+    if( pulPackageLogs )
+        *pulPackageLogs = (unsigned long)(ullPackage & m_ulLogMask);
+
+    return Success;
+}
+
+unsigned long CThermalThrottle::GetCoreClear(unsigned long ulLogs)
+{
+    return (m_ulLogMask | m_ulCoreKeep) & ~(ulLogs & m_ulLogMask);
+}
+
+unsigned long CThermalThrottle::GetPackageClear(unsigned long ulLogs)
+{
+    return (m_ulLogMask | m_ulPackageKeep) & ~(ulLogs & m_ulLogMask);
+}
+
+int CThermalThrottle::GetCoreCount()
+{
+    return m_nCores;
+}
+
+const ThrottleCounter *CThermalThrottle::GetCores()
+{
+    return m_pCores;
+}
+
+const ThrottleCounter *CThermalThrottle::GetPackage()
+{
+    return &m_Package;
+}
+
+unsigned int CThermalThrottle::GetCoreEvents(int nCore)
+{
+    unsigned int uEvents = 0;
+
+    if( 0 > nCore || nCore >= m_nCores )
+        return 0;
+
+    for( int i = 0; i < ThrottleReasonCount; i++ )
+        uEvents += m_pCores[nCore].pEvents[i];
+
+    return uEvents;
+}
@@ -0,0 +1,802 @@
+#include "memory_benchmark.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <immintrin.h>
+
+#ifdef STK_WINDOWS
+#include <intrin.h>
+#include <malloc.h>
+
+#include "spd.h"
+#include "../../computer/sensors/headers/cpu_topology.h"
+#else
+#include <cpuid.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+#endif
+
+// Wide kernels are compiled for their ISA only and picked at runtime
+#if defined(_MSC_VER)
+    #define STK_TARGET_AVX2
+    #define STK_TARGET_AVX512
+    #if _MSC_VER >= 1911
+        #define STK_HAS_AVX512
+    #endif
+#else
+    #define STK_TARGET_AVX2 __attribute__((target("avx2")))
+    #define STK_TARGET_AVX512 __attribute__((target("avx512f")))
+    #define STK_HAS_AVX512
+#endif
+
+#define BENCHMARK_PHASE_QUIT                        -1
+#define BENCHMARK_KERNEL_READ                       0
+#define BENCHMARK_KERNEL_WRITE                      1
+#define BENCHMARK_KERNEL_COPY                       2
+#define BENCHMARK_KERNEL_COUNT                      3
+
+typedef unsigned long long (*ReadKernel)(const unsigned char *pbBuffer, size_t nSize);
+typedef void (*WriteKernel)(unsigned char *pbBuffer, size_t nSize);
+typedef void (*CopyKernel)(unsigned char *pbDest, const unsigned char *pbSource, size_t nSize);
+
+typedef struct _BENCHMARK_SHARED_
+{
+    std::atomic<int>        nPhase;
+    std::atomic<int>        nDone;
+    ReadKernel              pfnRead;
+    WriteKernel             pfnWrite;
+    CopyKernel              pfnCopy;
+    size_t                  nSize;
+}BenchmarkShared;
+
+typedef struct _BENCHMARK_PROCESSOR_
+{
+    unsigned short          usGroup;        // processor group, 0 on Linux
+    int                     nNumber;        // processor inside its group
+    bool                    bPinned;        // false when the topology is unknown
+}BenchmarkProcessor;
+
+typedef struct _BENCHMARK_WORKER_
+{
+    BenchmarkProcessor      Processor;
+    BenchmarkShared         *pShared;
+    unsigned long long      ullSink;
+    bool                    bAllocated;
+}BenchmarkWorker;
+
+/// Kernels - nSize is always a multiple of 256 bytes and buffers are 64 byte aligned
+
+static unsigned long long ReadScalar(const unsigned char *pbBuffer, size_t nSize)
+{
+    const unsigned long long *pData = (const unsigned long long*)pbBuffer;
+    unsigned long long ull0 = 0, ull1 = 0, ull2 = 0, ull3 = 0;
+
+    for( size_t i = 0; i < nSize / sizeof(unsigned long long); i += 4 )
+    {
+        ull0 += pData[i];
+        ull1 += pData[i + 1];
+        ull2 += pData[i + 2];
+        ull3 += pData[i + 3];
+    }
+
+    return ull0 ^ ull1 ^ ull2 ^ ull3;
+}
+
+static void WriteScalar(unsigned char *pbBuffer, size_t nSize)
+{
+    unsigned long long *pData = (unsigned long long*)pbBuffer;
+
+    for( size_t i = 0; i < nSize / sizeof(unsigned long long); i++ )
+        pData[i] = i;
+}
+
+static void CopyScalar(unsigned char *pbDest, const unsigned char *pbSource, size_t nSize)
+{
+    const unsigned long long *pSource = (const unsigned long long*)pbSource;
+    unsigned long long *pDest = (unsigned long long*)pbDest;
+
+    for( size_t i = 0; i < nSize / sizeof(unsigned long long); i++ )
+        pDest[i] = pSource[i];
+}
+
+static unsigned long long ReduceSSE2(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+    unsigned long long pValues[2];
+
+    _mm_storeu_si128((__m128i*)pValues, _mm_xor_si128(_mm_xor_si128(a, b), _mm_xor_si128(c, d)));
+
+    return pValues[0] ^ pValues[1];
+}
+
+static unsigned long long ReadSSE2(const unsigned char *pbBuffer, size_t nSize)
+{
+    __m128i a = _mm_setzero_si128(), b = _mm_setzero_si128(), c = _mm_setzero_si128(), d = _mm_setzero_si128();
+
+    for( size_t i = 0; i < nSize; i += 64 )
+    {
+        a = _mm_add_epi64(a, _mm_load_si128((const __m128i*)(pbBuffer + i)));
+        b = _mm_add_epi64(b, _mm_load_si128((const __m128i*)(pbBuffer + i + 16)));
+        c = _mm_add_epi64(c, _mm_load_si128((const __m128i*)(pbBuffer + i + 32)));
+        d = _mm_add_epi64(d, _mm_load_si128((const __m128i*)(pbBuffer + i + 48)));
+    }
+
+    return ReduceSSE2(a, b, c, d);
+}
+
+static void WriteSSE2(unsigned char *pbBuffer, size_t nSize)
+{
+    __m128i Value = _mm_set1_epi32(0x5A5A5A5A);
+
+    for( size_t i = 0; i < nSize; i += 64 )
+    {
+        _mm_stream_si128((__m128i*)(pbBuffer + i), Value);
+        _mm_stream_si128((__m128i*)(pbBuffer + i + 16), Value);
+        _mm_stream_si128((__m128i*)(pbBuffer + i + 32), Value);
+        _mm_stream_si128((__m128i*)(pbBuffer + i + 48), Value);
+    }
+    _mm_sfence();
+}
+
+static void CopySSE2(unsigned char *pbDest, const unsigned char *pbSource, size_t nSize)
+{
+    for( size_t i = 0; i < nSize; i += 64 )
+    {
+        __m128i a = _mm_load_si128((const __m128i*)(pbSource + i));
+        __m128i b = _mm_load_si128((const __m128i*)(pbSource + i + 16));
+        __m128i c = _mm_load_si128((const __m128i*)(pbSource + i + 32));
+        __m128i d = _mm_load_si128((const __m128i*)(pbSource + i + 48));
+        _mm_stream_si128((__m128i*)(pbDest + i), a);
+        _mm_stream_si128((__m128i*)(pbDest + i + 16), b);
+        _mm_stream_si128((__m128i*)(pbDest + i + 32), c);
+        _mm_stream_si128((__m128i*)(pbDest + i + 48), d);
+    }
+    _mm_sfence();
+}
+
+STK_TARGET_AVX2 static unsigned long long ReadAVX2(const unsigned char *pbBuffer, size_t nSize)
+{
+    __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256(), c = _mm256_setzero_si256(), d = _mm256_setzero_si256();
+    unsigned long long pValues[4];
+
+    for( size_t i = 0; i < nSize; i += 128 )
+    {
+        a = _mm256_add_epi64(a, _mm256_load_si256((const __m256i*)(pbBuffer + i)));
+        b = _mm256_add_epi64(b, _mm256_load_si256((const __m256i*)(pbBuffer + i + 32)));
+        c = _mm256_add_epi64(c, _mm256_load_si256((const __m256i*)(pbBuffer + i + 64)));
+        d = _mm256_add_epi64(d, _mm256_load_si256((const __m256i*)(pbBuffer + i + 96)));
+    }
+
+    _mm256_storeu_si256((__m256i*)pValues, _mm256_xor_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(c, d)));
+
+    return pValues[0] ^ pValues[1] ^ pValues[2] ^ pValues[3];
+}
+
+STK_TARGET_AVX2 static void WriteAVX2(unsigned char *pbBuffer, size_t nSize)
+{
+    __m256i Value = _mm256_set1_epi32(0x5A5A5A5A);
+
+    for( size_t i = 0; i < nSize; i += 128 )
+    {
+        _mm256_stream_si256((__m256i*)(pbBuffer + i), Value);
+        _mm256_stream_si256((__m256i*)(pbBuffer + i + 32), Value);
+        _mm256_stream_si256((__m256i*)(pbBuffer + i + 64), Value);
+        _mm256_stream_si256((__m256i*)(pbBuffer + i + 96), Value);
+    }
+    _mm_sfence();
+}
+
+STK_TARGET_AVX2 static void CopyAVX2(unsigned char *pbDest, const unsigned char *pbSource, size_t nSize)
+{
+    for( size_t i = 0; i < nSize; i += 128 )
+    {
+        __m256i a = _mm256_load_si256((const __m256i*)(pbSource + i));
+        __m256i b = _mm256_load_si256((const __m256i*)(pbSource + i + 32));
+        __m256i c = _mm256_load_si256((const __m256i*)(pbSource + i + 64));
+        __m256i d = _mm256_load_si256((const __m256i*)(pbSource + i + 96));
+        _mm256_stream_si256((__m256i*)(pbDest + i), a);
+        _mm256_stream_si256((__m256i*)(pbDest + i + 32), b);
+        _mm256_stream_si256((__m256i*)(pbDest + i + 64), c);
+        _mm256_stream_si256((__m256i*)(pbDest + i + 96), d);
+    }
+    _mm_sfence();
+}
+
+#ifdef STK_HAS_AVX512
+STK_TARGET_AVX512 static unsigned long long ReadAVX512(const unsigned char *pbBuffer, size_t nSize)
+{
+    __m512i a = _mm512_setzero_si512(), b = _mm512_setzero_si512(), c = _mm512_setzero_si512(), d = _mm512_setzero_si512();
+    unsigned long long pValues[8];
+
+    for( size_t i = 0; i < nSize; i += 256 )
+    {
+        a = _mm512_add_epi64(a, _mm512_load_si512((const void*)(pbBuffer + i)));
+        b = _mm512_add_epi64(b, _mm512_load_si512((const void*)(pbBuffer + i + 64)));
+        c = _mm512_add_epi64(c, _mm512_load_si512((const void*)(pbBuffer + i + 128)));
+        d = _mm512_add_epi64(d, _mm512_load_si512((const void*)(pbBuffer + i + 192)));
+    }
+
+    _mm512_storeu_si512((void*)pValues, _mm512_xor_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(c, d)));
+
+    return pValues[0] ^ pValues[1] ^ pValues[2] ^ pValues[3] ^ pValues[4] ^ pValues[5] ^ pValues[6] ^ pValues[7];
+}
+
+STK_TARGET_AVX512 static void WriteAVX512(unsigned char *pbBuffer, size_t nSize)
+{
+    __m512i Value = _mm512_set1_epi32(0x5A5A5A5A);
+
+    for( size_t i = 0; i < nSize; i += 256 )
+    {
+        _mm512_stream_si512((__m512i*)(pbBuffer + i), Value);
+        _mm512_stream_si512((__m512i*)(pbBuffer + i + 64), Value);
+        _mm512_stream_si512((__m512i*)(pbBuffer + i + 128), Value);
+        _mm512_stream_si512((__m512i*)(pbBuffer + i + 192), Value);
+    }
+    _mm_sfence();
+}
+
+STK_TARGET_AVX512 static void CopyAVX512(unsigned char *pbDest, const unsigned char *pbSource, size_t nSize)
+{
+    for( size_t i = 0; i < nSize; i += 256 )
+    {
+        __m512i a = _mm512_load_si512((const void*)(pbSource + i));
+        __m512i b = _mm512_load_si512((const void*)(pbSource + i + 64));
+        __m512i c = _mm512_load_si512((const void*)(pbSource + i + 128));
+        __m512i d = _mm512_load_si512((const void*)(pbSource + i + 192));
+        _mm512_stream_si512((__m512i*)(pbDest + i), a);
+        _mm512_stream_si512((__m512i*)(pbDest + i + 64), b);
+        _mm512_stream_si512((__m512i*)(pbDest + i + 128), c);
+        _mm512_stream_si512((__m512i*)(pbDest + i + 192), d);
+    }
+    _mm_sfence();
+}
+#endif
+
+/// Platform helpers
+
+static void *AllocateAligned(size_t nSize)
+{
+#ifdef STK_WINDOWS
+    return _aligned_malloc(nSize, MEMORY_BENCHMARK_CACHE_LINE);
+#else
+    void *pBuffer = 0;
+    if( 0 != posix_memalign(&pBuffer, MEMORY_BENCHMARK_CACHE_LINE, nSize) )
+        return 0;
+    return pBuffer;
+#endif
+}
+
+static void FreeAligned(void *pBuffer)
+{
+#ifdef STK_WINDOWS
+    _aligned_free(pBuffer);
+#else
+    free(pBuffer);
+#endif
+}
+
+// Worker n runs on physical core n of the topology, wrapping around when
+// more workers than cores are asked for. On Linux the n-th processor of
+// the process affinity is used.
+static void GetProcessor(CCpuTopology *pTopology, int nWorker, BenchmarkProcessor *pProcessor)
+{
+    memset(pProcessor, 0, sizeof(BenchmarkProcessor));
+
+#ifdef STK_WINDOWS
+    if( !pTopology || 0 >= pTopology->GetCoreCount() )
+        return;
+
+    const CpuCore *pCore = &pTopology->GetCores()[nWorker % pTopology->GetCoreCount()];
+    pProcessor->usGroup = pCore->wGroup;
+    pProcessor->nNumber = pCore->bNumber;
+    pProcessor->bPinned = true;
+#else
+    UNUSED(pTopology);
+
+    cpu_set_t CpuSet;
+    CPU_ZERO(&CpuSet);
+    if( 0 != sched_getaffinity(0, sizeof(CpuSet), &CpuSet) || 0 == CPU_COUNT(&CpuSet) )
+        return;
+
+    int nSkip = nWorker % CPU_COUNT(&CpuSet);
+    for( int i = 0; i < CPU_SETSIZE; i++ )
+    {
+        if( !CPU_ISSET(i, &CpuSet) )
+            continue;
+        if( 0 == nSkip-- )
+        {
+            pProcessor->nNumber = i;
+            pProcessor->bPinned = true;
+            return;
+        }
+    }
+#endif
+}
+
+static void PinCurrentThread(const BenchmarkProcessor *pProcessor)
+{
+    if( !pProcessor->bPinned )
+        return;
+
+#ifdef STK_WINDOWS
+    // A plain affinity mask only reaches the group of the calling thread
+    GROUP_AFFINITY Affinity;
+    memset(&Affinity, 0, sizeof(GROUP_AFFINITY));
+    Affinity.Group = pProcessor->usGroup;
+    Affinity.Mask = (KAFFINITY)1 << pProcessor->nNumber;
+    SetThreadGroupAffinity(GetCurrentThread(), &Affinity, NULL);
+#else
+    cpu_set_t CpuSet;
+    CPU_ZERO(&CpuSet);
+    CPU_SET(pProcessor->nNumber, &CpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(CpuSet), &CpuSet);
+#endif
+}
+
+// Monotonic time in seconds
+static double GetTimestamp()
+{
+#ifdef STK_WINDOWS
+    LARGE_INTEGER Frequency, Counter;
+    QueryPerformanceFrequency(&Frequency);
+    QueryPerformanceCounter(&Counter);
+    return (double)Counter.QuadPart / (double)Frequency.QuadPart;
+#else
+    struct timespec Time;
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+    return (double)Time.tv_sec + (double)Time.tv_nsec / 1e9;
+#endif
+}
+
+static void CpuId(int pRegisters[4], int nLeaf, int nSubLeaf)
+{
+#ifdef _MSC_VER
+    __cpuidex(pRegisters, nLeaf, nSubLeaf);
+#else
+    __cpuid_count(nLeaf, nSubLeaf, pRegisters[0], pRegisters[1], pRegisters[2], pRegisters[3]);
+#endif
+}
+
+static unsigned long long ReadXCR0()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int uEax = 0, uEdx = 0;
+    __asm__ volatile("xgetbv" : "=a"(uEax), "=d"(uEdx) : "c"(0));
+    return ((unsigned long long)uEdx << 32) | uEax;
+#endif
+}
+
+static void BenchmarkWorkerThread(BenchmarkWorker *pWorker)
+{
+    BenchmarkShared *pShared = pWorker->pShared;
+    int nLastPhase = 0;
+
+    PinCurrentThread(&pWorker->Processor);
+
+    // First touch from the pinned thread
+    unsigned char *pbSource = (unsigned char*)AllocateAligned(pShared->nSize);
+    unsigned char *pbDest = (unsigned char*)AllocateAligned(pShared->nSize);
+    pWorker->bAllocated = (0 != pbSource && 0 != pbDest);
+    if( pWorker->bAllocated )
+    {
+        WriteScalar(pbSource, pShared->nSize);
+        WriteScalar(pbDest, pShared->nSize);
+    }
+    pShared->nDone.fetch_add(1);
+
+    for( ;; )
+    {
+        int nPhase = pShared->nPhase.load();
+        if( BENCHMARK_PHASE_QUIT == nPhase )
+            break;
+        if( nPhase == nLastPhase )
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        nLastPhase = nPhase;
+
+        if( pWorker->bAllocated )
+        {
+            switch( (nPhase - 1) % BENCHMARK_KERNEL_COUNT )
+            {
+            case BENCHMARK_KERNEL_READ:
+                pWorker->ullSink += pShared->pfnRead(pbSource, pShared->nSize); break;
+            case BENCHMARK_KERNEL_WRITE:
+                pShared->pfnWrite(pbDest, pShared->nSize); break;
+            case BENCHMARK_KERNEL_COPY:
+                pShared->pfnCopy(pbDest, pbSource, pShared->nSize); break;
+            }
+        }
+
+        pShared->nDone.fetch_add(1);
+    }
+
+    FreeAligned(pbSource);
+    FreeAligned(pbDest);
+}
+
+static void WaitForWorkers(BenchmarkShared *pShared, int nCount)
+{
+    while( pShared->nDone.load() < nCount )
+        std::this_thread::yield();
+}
+
+// Links the first nSize bytes of pbBuffer into one random cycle of cache
+// lines and returns the ns per dependent load around it
+static double ChasePointers(unsigned char *pbBuffer, unsigned int *pOrder, size_t nSize)
+{
+    size_t nLines = nSize / MEMORY_BENCHMARK_CACHE_LINE;
+
+    // Sattolo shuffle gives a single cycle through every line, so the
+    // prefetchers cannot guess the next address
+    unsigned long long ullState = 0x9E3779B97F4A7C15ULL;
+    for( size_t i = 0; i < nLines; i++ )
+        pOrder[i] = (unsigned int)i;
+    for( size_t i = nLines - 1; i > 0; i-- )
+    {
+        ullState ^= ullState << 13;
+        ullState ^= ullState >> 7;
+        ullState ^= ullState << 17;
+        size_t j = (size_t)(ullState % i);
+        unsigned int uTemp = pOrder[i];
+        pOrder[i] = pOrder[j];
+        pOrder[j] = uTemp;
+    }
+    for( size_t i = 0; i < nLines; i++ )
+        *(void**)(pbBuffer + i * MEMORY_BENCHMARK_CACHE_LINE) = pbBuffer + (size_t)pOrder[i] * MEMORY_BENCHMARK_CACHE_LINE;
+
+    void **ppNext = (void**)pbBuffer;
+
+    // Warm up caches and TLB on one full lap
+    for( size_t i = 0; i < nLines; i++ )
+        ppNext = (void**)*ppNext;
+
+    double dStart = GetTimestamp();
+    for( int i = 0; i < MEMORY_BENCHMARK_LATENCY_HOPS; i += 8 )
+    {
+        ppNext = (void**)*ppNext; ppNext = (void**)*ppNext;
+        ppNext = (void**)*ppNext; ppNext = (void**)*ppNext;
+        ppNext = (void**)*ppNext; ppNext = (void**)*ppNext;
+        ppNext = (void**)*ppNext; ppNext = (void**)*ppNext;
+    }
+    double dElapsed = GetTimestamp() - dStart;
+
+    // Keep the chain alive for the optimizer
+    if( 0 == ppNext )
+        dElapsed = 0;
+
+    return dElapsed * 1e9 / MEMORY_BENCHMARK_LATENCY_HOPS;
+}
+
+// One buffer sized for the largest working set, every point reuses its head
+static void LatencyThread(BenchmarkProcessor Processor, MemoryLatencyPoint *pPoints, int *pnPoints)
+{
+    size_t nMaxSize = ((size_t)MEMORY_BENCHMARK_LATENCY_MIN_KB * 1024) << (MEMORY_BENCHMARK_LATENCY_POINTS - 1);
+    *pnPoints = 0;
+
+    PinCurrentThread(&Processor);
+
+    unsigned char *pbBuffer = (unsigned char*)AllocateAligned(nMaxSize);
+    unsigned int *pOrder = (unsigned int*)malloc(nMaxSize / MEMORY_BENCHMARK_CACHE_LINE * sizeof(unsigned int));
+    if( pbBuffer && pOrder )
+    {
+        for( int i = 0; i < MEMORY_BENCHMARK_LATENCY_POINTS; i++ )
+        {
+            pPoints[i].nSize = ((size_t)MEMORY_BENCHMARK_LATENCY_MIN_KB * 1024) << i;
+            pPoints[i].dLatency = ChasePointers(pbBuffer, pOrder, pPoints[i].nSize);
+        }
+        *pnPoints = MEMORY_BENCHMARK_LATENCY_POINTS;
+    }
+
+    FreeAligned(pbBuffer);
+    free(pOrder);
+}
+
+CMemoryBenchmark::CMemoryBenchmark(CSPDInformation *pSPD) :
+    m_pSPD(pSPD), m_pTopology(NULL), m_pResultsModel(NULL), m_SimdLevel(MemorySimdScalar),
+    m_nThreads(0), m_nChannels(0), m_nBufferSize((size_t)MEMORY_BENCHMARK_DEFAULT_BUFFER_MB * 1024 * 1024)
+{
+    m_pResultsModel = new QStandardItemModel;
+    CHECK_ALLOCATION(m_pResultsModel);
+
+    memset(&m_Result, 0, sizeof(MemoryBenchmarkResult));
+
+    m_SimdLevel = DetectSimdLevel();
+    m_nThreads = (int)std::thread::hardware_concurrency();
+
+#ifdef STK_WINDOWS
+    // SMT siblings share the load ports of their core, one worker per core
+    m_pTopology = new CCpuTopology;
+    if( m_pTopology && Success == m_pTopology->Initialize() )
+        m_nThreads = m_pTopology->GetCoreCount();
+    else
+        SAFE_DELETE(m_pTopology);
+#endif
+
+    if( 0 >= m_nThreads )
+        m_nThreads = 1;
+}
+
+CMemoryBenchmark::~CMemoryBenchmark()
+{
+    SAFE_DELETE(m_pResultsModel);
+#ifdef STK_WINDOWS
+    SAFE_DELETE(m_pTopology);
+#endif
+    m_pSPD = 0;
+}
+
+void CMemoryBenchmark::SetThreadCount(int nThreads)
+{
+    if( 0 < nThreads )
+        m_nThreads = nThreads;
+}
+
+void CMemoryBenchmark::SetChannelCount(int nChannels)
+{
+    m_nChannels = nChannels;
+}
+
+void CMemoryBenchmark::SetBufferSize(size_t nBufferMB)
+{
+    if( 0 < nBufferMB )
+        m_nBufferSize = nBufferMB * 1024 * 1024;
+}
+
+const MemoryBenchmarkResult *CMemoryBenchmark::GetResult()
+{
+    return &m_Result;
+}
+
+QStandardItemModel *CMemoryBenchmark::GetResultsModel()
+{
+    return m_pResultsModel;
+}
+
+MemorySimdLevel CMemoryBenchmark::DetectSimdLevel()
+{
+    int pRegisters[4] = { 0 };
+
+    CpuId(pRegisters, 0, 0);
+    int nMaxLeaf = pRegisters[0];
+
+    CpuId(pRegisters, 1, 0);
+    if( !(pRegisters[3] & (1 << 26)) )
+        return MemorySimdScalar;
+
+    // OSXSAVE - BIT 27, AVX - BIT 28
+    if( !(pRegisters[2] & (1 << 27)) || !(pRegisters[2] & (1 << 28)) || 7 > nMaxLeaf )
+        return MemorySimdSSE2;
+
+    // The OS must save YMM (XCR0 bits 1, 2) and ZMM state (bits 5~7)
+    unsigned long long ullXCR0 = ReadXCR0();
+    if( 0x6 != (ullXCR0 & 0x6) )
+        return MemorySimdSSE2;
+
+    CpuId(pRegisters, 7, 0);
+#ifdef STK_HAS_AVX512
+    if( (pRegisters[1] & (1 << 16)) && 0xE6 == (ullXCR0 & 0xE6) )
+        return MemorySimdAVX512;
+#endif
+    if( pRegisters[1] & (1 << 5) )
+        return MemorySimdAVX2;
+
+    return MemorySimdSSE2;
+}
+
+int CMemoryBenchmark::Run()
+{
+    int nStatus = Uninitialized;
+
+    memset(&m_Result, 0, sizeof(MemoryBenchmarkResult));
+    m_Result.SimdLevel = m_SimdLevel;
+    m_Result.nThreads = m_nThreads;
+
+    nStatus = RunBandwidth();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    nStatus = RunLatency();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+
+    return Success;
+}
+
+void CMemoryBenchmark::Publish()
+{
+    int nStatus = ComputeRatedBandwidth();
+    CHECK_OPERATION_STATUS(nStatus);
+
+    PopulateModel();
+}
+
+int CMemoryBenchmark::RunBandwidth()
+{
+    BenchmarkShared Shared;
+    std::vector<BenchmarkWorker> qWorkers(m_nThreads);
+    std::vector<std::thread> qThreads;
+
+    // Split the buffer between workers, rounded to the widest kernel step
+    Shared.nSize = (m_nBufferSize / m_nThreads) & ~(size_t)255;
+    if( Shared.nSize < 1024 * 1024 )
+        Shared.nSize = 1024 * 1024;
+    Shared.nPhase.store(0);
+    Shared.nDone.store(0);
+
+    switch( m_SimdLevel )
+    {
+#ifdef STK_HAS_AVX512
+    case MemorySimdAVX512:
+        Shared.pfnRead = ReadAVX512; Shared.pfnWrite = WriteAVX512; Shared.pfnCopy = CopyAVX512; break;
+#endif
+    case MemorySimdAVX2:
+        Shared.pfnRead = ReadAVX2; Shared.pfnWrite = WriteAVX2; Shared.pfnCopy = CopyAVX2; break;
+    case MemorySimdSSE2:
+        Shared.pfnRead = ReadSSE2; Shared.pfnWrite = WriteSSE2; Shared.pfnCopy = CopySSE2; break;
+    default:
+        Shared.pfnRead = ReadScalar; Shared.pfnWrite = WriteScalar; Shared.pfnCopy = CopyScalar; break;
+    }
+
+    for( int i = 0; i < m_nThreads; i++ )
+    {
+        GetProcessor(m_pTopology, i, &qWorkers[i].Processor);
+        qWorkers[i].pShared = &Shared;
+        qWorkers[i].ullSink = 0;
+        qWorkers[i].bAllocated = false;
+        qThreads.push_back(std::thread(BenchmarkWorkerThread, &qWorkers[i]));
+    }
+
+    WaitForWorkers(&Shared, m_nThreads);
+
+    bool bAllocated = true;
+    for( int i = 0; i < m_nThreads; i++ )
+        bAllocated = bAllocated && qWorkers[i].bAllocated;
+
+    // Best of N passes per kernel
+    double pdBest[BENCHMARK_KERNEL_COUNT] = { 0 };
+    int nPhase = 0;
+    for( int nPass = 0; bAllocated && nPass < MEMORY_BENCHMARK_PASSES; nPass++ )
+    {
+        for( int nKernel = 0; nKernel < BENCHMARK_KERNEL_COUNT; nKernel++ )
+        {
+            Shared.nDone.store(0);
+            double dStart = GetTimestamp();
+            Shared.nPhase.store(++nPhase);
+            WaitForWorkers(&Shared, m_nThreads);
+            double dElapsed = GetTimestamp() - dStart;
+
+            if( 0 == pdBest[nKernel] || dElapsed < pdBest[nKernel] )
+                pdBest[nKernel] = dElapsed;
+        }
+    }
+
+    Shared.nPhase.store(BENCHMARK_PHASE_QUIT);
+    for( size_t i = 0; i < qThreads.size(); i++ )
+        qThreads[i].join();
+
+    if( !bAllocated )
+        return NotAllocated;
+
+    double dMegabytes = (double)Shared.nSize * m_nThreads / (1024.0 * 1024.0);
+    m_Result.dReadBandwidth = pdBest[BENCHMARK_KERNEL_READ] > 0 ? dMegabytes / pdBest[BENCHMARK_KERNEL_READ] : 0;
+    m_Result.dWriteBandwidth = pdBest[BENCHMARK_KERNEL_WRITE] > 0 ? dMegabytes / pdBest[BENCHMARK_KERNEL_WRITE] : 0;
+    m_Result.dCopyBandwidth = pdBest[BENCHMARK_KERNEL_COPY] > 0 ? 2 * dMegabytes / pdBest[BENCHMARK_KERNEL_COPY] : 0;
+
+    return Success;
+}
+
+int CMemoryBenchmark::RunLatency()
+{
+    BenchmarkProcessor Processor;
+    int nPoints = 0;
+
+    GetProcessor(m_pTopology, 0, &Processor);
+
+    // Own thread so the caller's affinity is left alone
+    std::thread LatencyWorker(LatencyThread, Processor, m_Result.LatencyPoints, &nPoints);
+    LatencyWorker.join();
+
+    m_Result.nLatencyPoints = nPoints;
+    if( 0 == nPoints )
+        return NotAllocated;
+
+    m_Result.dLatency = m_Result.LatencyPoints[nPoints - 1].dLatency;
+
+    return Success;
+}
+
+int CMemoryBenchmark::ComputeRatedBandwidth()
+{
+#ifndef STK_WINDOWS
+    // SPD is read through the Windows driver only
+    return Unsuccessful;
+#else
+    if( !m_pSPD )
+        return Unsuccessful;
+
+    const QMap<int, SpdInformation*> &qDimms = m_pSPD->GetDimmsInformation();
+    QMap<int, SpdInformation*>::const_iterator it;
+    int nRatedSpeed = 0;
+
+    // The controller runs every DIMM at the speed of the slowest one
+    for(it = qDimms.begin(); it != qDimms.end(); it++)
+    {
+        int nSpeed = 0;
+        const SpdModuleTimings *pTimings = &it.value()->Timings;
+        if( 0 == pTimings->nProfiles )
+            continue;
+
+        for( int i = 0; i < pTimings->Profiles[0].nClockEntries; i++ )
+        {
+            if( pTimings->Profiles[0].ClockEntries[i].nFrequency * 2 > nSpeed )
+                nSpeed = pTimings->Profiles[0].ClockEntries[i].nFrequency * 2;
+        }
+
+        if( nSpeed && (0 == nRatedSpeed || nSpeed < nRatedSpeed) )
+            nRatedSpeed = nSpeed;
+    }
+
+    if( 0 == nRatedSpeed )
+        return Unsuccessful;
+
+    // Channel layout is not in SPD, assume dual channel when populated
+    int nChannels = m_nChannels;
+    if( 0 >= nChannels )
+        nChannels = qDimms.count() >= 2 ? 2 : 1;
+
+    // 64 bit data bus per channel -> 8 bytes per transfer
+    m_Result.nRatedSpeed = nRatedSpeed;
+    m_Result.nChannels = nChannels;
+    m_Result.dRatedBandwidth = (double)nRatedSpeed * 8 * nChannels * 1000000.0 / (1024.0 * 1024.0);
+    m_Result.dEfficiency = m_Result.dReadBandwidth / m_Result.dRatedBandwidth;
+
+    return Success;
+#endif
+}
+
+void CMemoryBenchmark::PopulateModel()
+{
+    QList<QStandardItem*> qList;
+
+    m_pResultsModel->clear();
+    m_pResultsModel->setHorizontalHeaderLabels(QStringList() << "Field" << "Value");
+
+    qList << new QStandardItem("Instruction set: ") << new QStandardItem(MEMORY_SIMD_LEVEL_STRING(m_Result.SimdLevel));
+    m_pResultsModel->appendRow(qList); qList.clear();
+    qList << new QStandardItem("Threads: ") << new QStandardItem(QString::number(m_Result.nThreads));
+    m_pResultsModel->appendRow(qList); qList.clear();
+    qList << new QStandardItem("Read: ") << new QStandardItem(QString().sprintf("%.0f MB/s", m_Result.dReadBandwidth));
+    m_pResultsModel->appendRow(qList); qList.clear();
+    qList << new QStandardItem("Write: ") << new QStandardItem(QString().sprintf("%.0f MB/s", m_Result.dWriteBandwidth));
+    m_pResultsModel->appendRow(qList); qList.clear();
+    qList << new QStandardItem("Copy: ") << new QStandardItem(QString().sprintf("%.0f MB/s", m_Result.dCopyBandwidth));
+    m_pResultsModel->appendRow(qList); qList.clear();
+    qList << new QStandardItem("Latency: ") << new QStandardItem(QString().sprintf("%.1f ns", m_Result.dLatency));
+    m_pResultsModel->appendRow(qList); qList.clear();
+
+    for( int i = 0; i < m_Result.nLatencyPoints; i++ )
+    {
+        size_t nKB = m_Result.LatencyPoints[i].nSize / 1024;
+        QString qzSize = nKB < 1024 ? QString().sprintf("%u KB", (unsigned int)nKB) :
+                                      QString().sprintf("%u MB", (unsigned int)(nKB / 1024));
+
+        qList << new QStandardItem("Latency at " + qzSize + ": ")
+              << new QStandardItem(QString().sprintf("%.1f ns", m_Result.LatencyPoints[i].dLatency));
+        m_pResultsModel->appendRow(qList); qList.clear();
+    }
+
+    if( m_Result.nRatedSpeed )
+    {
+        qList << new QStandardItem("SPD rated: ")
+              << new QStandardItem(QString().sprintf("%d MT/s x %d channel(s) = %.0f MB/s",
+                                                     m_Result.nRatedSpeed, m_Result.nChannels, m_Result.dRatedBandwidth));
+        m_pResultsModel->appendRow(qList); qList.clear();
+        qList << new QStandardItem("Read efficiency: ") << new QStandardItem(QString().sprintf("%.1f %%", m_Result.dEfficiency * 100.0));
+        m_pResultsModel->appendRow(qList); qList.clear();
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef _MEMORY_BENCHMARK_H
+#define _MEMORY_BENCHMARK_H
+
+#include <QStandardItemModel>
+
+#include "../../../utils/headers/utils.h"
+
+#define MEMORY_BENCHMARK_DEFAULT_BUFFER_MB          256     // split between workers, well above any LLC
+#define MEMORY_BENCHMARK_PASSES                     5
+#define MEMORY_BENCHMARK_CACHE_LINE                 64
+
+// Latency working sets double from L1 sized to well past the LLC
+#define MEMORY_BENCHMARK_LATENCY_MIN_KB             16
+#define MEMORY_BENCHMARK_LATENCY_POINTS             15      // 16 KB ~ 256 MB
+#define MEMORY_BENCHMARK_LATENCY_HOPS               (4 * 1024 * 1024)
+
+class CSPDInformation;
+class CCpuTopology;
+
+typedef enum _MEMORY_SIMD_LEVEL_
+{
+    MemorySimdScalar = 0,
+    MemorySimdSSE2,
+    MemorySimdAVX2,
+    MemorySimdAVX512
+}MemorySimdLevel;
+
+#define MEMORY_SIMD_LEVEL_STRING(X) \
+    X == MemorySimdSSE2 ? "SSE2" : \
+    X == MemorySimdAVX2 ? "AVX2" : \
+    X == MemorySimdAVX512 ? "AVX-512" : \
+    "Scalar"
+
+typedef struct _MEMORY_LATENCY_POINT_
+{
+    size_t nSize;                   // bytes
+    double dLatency;                // ns per dependent load
+}MemoryLatencyPoint;
+
+typedef struct _MEMORY_BENCHMARK_RESULT_
+{
+    double dReadBandwidth;          // MB/s
+    double dWriteBandwidth;         // MB/s
+    double dCopyBandwidth;          // MB/s, bytes read + written
+    double dLatency;                // ns per dependent load, largest working set
+    MemoryLatencyPoint LatencyPoints[MEMORY_BENCHMARK_LATENCY_POINTS];
+    int nLatencyPoints;
+    double dRatedBandwidth;         // MB/s, from SPD speed * bus width * channels
+    double dEfficiency;             // read bandwidth / rated bandwidth
+    int nThreads;
+    int nChannels;
+    int nRatedSpeed;                // MT/s
+    MemorySimdLevel SimdLevel;
+}MemoryBenchmarkResult;
+
+// Bandwidth (read/write/copy) and pointer chasing latency benchmark. By
+// default one worker runs on each physical core, pinned inside its
+// processor group, and touches its own buffer first so pages end up on the
+// worker's node.
+class CMemoryBenchmark
+{
+private:
+    CSPDInformation         *m_pSPD;
+    CCpuTopology            *m_pTopology;
+    QStandardItemModel      *m_pResultsModel;
+
+    MemorySimdLevel         m_SimdLevel;
+    int                     m_nThreads;
+    int                     m_nChannels;
+    size_t                  m_nBufferSize;
+
+    MemoryBenchmarkResult   m_Result;
+
+public:
+    CMemoryBenchmark(CSPDInformation *pSPD = 0);
+    ~CMemoryBenchmark();
+
+    void SetThreadCount(int nThreads);
+    void SetChannelCount(int nChannels);
+    void SetBufferSize(size_t nBufferMB);
+
+    // Only measures, the SPD manager and the model are not touched so it may
+    // run on a worker thread
+    int Run();
+    // Rates the last run against the SPD speed and fills the model, on the
+    // thread that owns both
+    void Publish();
+    const MemoryBenchmarkResult *GetResult();
+    QStandardItemModel *GetResultsModel();
+
+private:
+    MemorySimdLevel DetectSimdLevel();
+    int RunBandwidth();
+    int RunLatency();
+    int ComputeRatedBandwidth();
+    void PopulateModel();
+};
+
+#endif
@@ -1,6 +1,66 @@
 #include "memory_data.h"
 
-CRAMInformation::CRAMInformation()
+#ifndef STK_WINDOWS
+#include <string.h>
+
+#include <QDir>
+#include <QFile>
+
+#define MEMORY_DMI_TABLE                "/sys/firmware/dmi/tables/DMI"
+#define MEMORY_DMI_ENTRIES              "/sys/firmware/dmi/entries"
+#define MEMORY_SYSFS_BLOCKS             "/sys/devices/system/memory"
+#define MEMORY_DMI_TYPE17               17
+#define MEMORY_DMI_END_OF_TABLE         127
+#define MEMORY_DMI_TYPE17_MIN_LENGTH    0x15            // SMBIOS 2.1 layout
+
+// SMBIOS type 17 field names, indexed by the raw value
+static const char *g_pszFormFactors[] = { "", "Other", "Unknown", "SIMM", "SIP", "Chip", "DIP", "ZIP", "PC",
+                                          "DIMM", "TSOP", "ROC", "RIMM", "SO-DIMM", "S-RIMM", "FB-DIMM", "Die" };
+static const char *g_pszMemoryTypes[] = { "", "Other", "Unknown", "DRAM", "EDRAM", "VRAM", "SRAM", "RAM", "ROM",
+                                          "FLASH", "EEPROM", "FEPROM", "EPROM", "CDRAM", "3DRAM", "SDRAM", "SGRAM",
+                                          "RDRAM", "DDR", "DDR2", "DDR2 FB-DIMM", "N/A", "N/A", "N/A", "DDR3",
+                                          "FBD2", "DDR4", "LPDDR", "LPDDR2", "LPDDR3", "LPDDR4",
+                                          "Logical non-volatile", "HBM", "HBM2", "DDR5", "LPDDR5" };
+// By bit, the lowest set bit wins like in the DMI module
+static const char *g_pszTypeDetails[] = { "Reserved", "Other", "Unknown", "Fast-paged", "Static column",
+                                          "Pseudo-static", "RAMBUS", "Synchronous", "CMOS", "EDO",
+                                          "Window DRAM", "Cache DRAM", "Non-volatile", "Registered (Buffered)",
+                                          "Unbuffered (Unregistered)", "LRDIMM" };
+
+#define DMI_WORD(P, O)      ((unsigned int)(P)[O] | ((unsigned int)(P)[(O) + 1] << 8))
+#define DMI_DWORD(P, O)     (DMI_WORD(P, O) | (DMI_WORD(P, (O) + 2) << 16))
+
+// 1 based string of a structure, empty for 0 or a missing one
+static QString DMIString(const unsigned char *pData, int nSize, int nIndex)
+{
+    int nOffset = pData[1];
+
+    for( int i = 1; 0 < nIndex && nOffset < nSize && 0 != pData[nOffset]; i++ )
+    {
+        const char *pszString = (const char*)(pData + nOffset);
+        int nLength = (int)strnlen(pszString, nSize - nOffset);
+        if( i == nIndex )
+            return QString::fromLatin1(pszString, nLength).trimmed();
+        nOffset += nLength + 1;
+    }
+
+    return QString();
+}
+#endif
+
+static QString FormatCapacity(unsigned long long ullBytes)
+{
+    if( ullBytes >= 1024ULL * 1024 * 1024 && 0 == ullBytes % (1024ULL * 1024 * 1024) )
+        return QString().sprintf("%llu GB", ullBytes / (1024ULL * 1024 * 1024));
+
+    return QString().sprintf("%llu MB", ullBytes / (1024ULL * 1024));
+}
+
+CRAMInformation::CRAMInformation(CSMBiosEntryPoint *pSMBios, CSPDInformation *pSPD) :
+    m_pSMBios(pSMBios), m_pSPD(pSPD), m_Source(MemorySourceNone)
+#ifndef STK_WINDOWS
+    , m_ullOnlineMemory(0)
+#endif
 {
 
 }
@@ -8,18 +68,41 @@ CRAMInformation::CRAMInformation()
 CRAMInformation::~CRAMInformation()
 {
     ClearRamDataList();
+    m_pSMBios = 0;
+    m_pSPD = 0;
 }
 
-QStandardItemModel *CRAMInformation::GetRAMInformations()
+const QList<RamData*> &CRAMInformation::GetModules()
 {
-    int nStatus = ClearRamDataList();
-    CHECK_OPERATION_STATUS(nStatus);
-    if( Success != nStatus )
-        return 0;
+    if( MemorySourceNone == m_Source )
+    {
+        int nStatus = InitializeInformation();
+        CHECK_OPERATION_STATUS(nStatus);
+    }
 
-    nStatus = InitializeInformation();
-    CHECK_OPERATION_STATUS(nStatus);
-    if( Success != nStatus )
+    return m_qRamData;
+}
+
+MemoryDataSource CRAMInformation::GetSource()
+{
+    GetModules();
+
+    return m_Source;
+}
+
+#ifndef STK_WINDOWS
+unsigned long long CRAMInformation::GetOnlineMemory()
+{
+    GetModules();
+
+    return m_ullOnlineMemory;
+}
+#endif
+
+QStandardItemModel *CRAMInformation::GetRAMInformations()
+{
+    const QList<RamData*> &qModules = GetModules();
+    if( MemorySourceNone == m_Source )
         return 0;
 
     QStandardItemModel  *pModel = new QStandardItemModel;
@@ -27,39 +110,48 @@ QStandardItemModel *CRAMInformation::GetRAMInformations()
 
     pModel->setHorizontalHeaderLabels(QStringList() << "Field" << "Value");
 
-    for(int i = 0; i < m_qRamData.count(); i++)
+    for(int i = 0; i < qModules.count(); i++)
     {
-        pRamData = m_qRamData.at(i);
+        pRamData = qModules.at(i);
+
+        pModel->setItem(i * 13 + 0, 0, new QStandardItem("Bank label:"));
+        pModel->setItem(i * 13 + 0, 1, new QStandardItem(pRamData->qzBankLabel == "" ? "N/A" : pRamData->qzBankLabel));
+
+        pModel->setItem(i * 13 + 1, 0, new QStandardItem("Capacity:"));
+        pModel->setItem(i * 13 + 1, 1, new QStandardItem(pRamData->qzCapacity == "" ? "N/A" : pRamData->qzCapacity));
 
-        pModel->setItem(i * 11 + 0, 0, new QStandardItem("Bank label:"));
-        pModel->setItem(i * 11 + 0, 1, new QStandardItem(pRamData->qzBankLabel == "" ? "N/A" : pRamData->qzBankLabel));
+        pModel->setItem(i * 13 + 2, 0, new QStandardItem("Data width:"));
+        pModel->setItem(i * 13 + 2, 1, new QStandardItem(pRamData->qzDataWidth == "" ? "N/A" : pRamData->qzDataWidth));
 
-        pModel->setItem(i * 11 + 1, 0, new QStandardItem("Capacity:"));
-        pModel->setItem(i * 11 + 1, 1, new QStandardItem(pRamData->qzCapacity == "" ? "N/A" : pRamData->qzCapacity));
+        pModel->setItem(i * 13 + 3, 0, new QStandardItem("Description:"));
+        pModel->setItem(i * 13 + 3, 1, new QStandardItem(pRamData->qzDescription == "" ? "N/A" : pRamData->qzDescription));
 
-        pModel->setItem(i * 11 + 2, 0, new QStandardItem("Data width:"));
-        pModel->setItem(i * 11 + 2, 1, new QStandardItem(pRamData->qzDataWidth == "" ? "N/A" : pRamData->qzDataWidth));
+        pModel->setItem(i * 13 + 4, 0, new QStandardItem("Form factor:"));
+        pModel->setItem(i * 13 + 4, 1, new QStandardItem(pRamData->qzFormFactor == "" ? "N/A" : pRamData->qzFormFactor));
 
-        pModel->setItem(i * 11 + 3, 0, new QStandardItem("Description:"));
-        pModel->setItem(i * 11 + 3, 1, new QStandardItem(pRamData->qzDescription == "" ? "N/A" : pRamData->qzDescription));
+        pModel->setItem(i * 13 + 5, 0, new QStandardItem("Manufacturer:"));
+        pModel->setItem(i * 13 + 5, 1, new QStandardItem(pRamData->qzManufacturer == "" ? "N/A" : pRamData->qzManufacturer));
 
-        pModel->setItem(i * 11 + 4, 0, new QStandardItem("Form factor:"));
-        pModel->setItem(i * 11 + 4, 1, new QStandardItem(pRamData->qzFormFactor == "" ? "N/A" : pRamData->qzFormFactor));
+        pModel->setItem(i * 13 + 6, 0, new QStandardItem("Memory type:"));
+        pModel->setItem(i * 13 + 6, 1, new QStandardItem(pRamData->qzMemoryType == "" ? "N/A" : pRamData->qzMemoryType));
 
-        pModel->setItem(i * 11 + 5, 0, new QStandardItem("Manufacturer:"));
-        pModel->setItem(i * 11 + 5, 1, new QStandardItem(pRamData->qzManufacturer == "" ? "N/A" : pRamData->qzManufacturer));
+        pModel->setItem(i * 13 + 7, 0, new QStandardItem("Model:"));
+        pModel->setItem(i * 13 + 7, 1, new QStandardItem(pRamData->qzModel == "" ? "N/A" : pRamData->qzModel));
 
-        pModel->setItem(i * 11 + 6, 0, new QStandardItem("Memory type:"));
-        pModel->setItem(i * 11 + 6, 1, new QStandardItem(pRamData->qzMemoryType == "" ? "N/A" : pRamData->qzMemoryType));
+        pModel->setItem(i * 13 + 8, 0, new QStandardItem("Name:"));
+        pModel->setItem(i * 13 + 8, 1, new QStandardItem(pRamData->qzName == "" ? "N/A" : pRamData->qzName));
 
-        pModel->setItem(i * 11 + 7, 0, new QStandardItem("Model:"));
-        pModel->setItem(i * 11 + 7, 1, new QStandardItem(pRamData->qzModel == "" ? "N/A" : pRamData->qzModel));
+        pModel->setItem(i * 13 + 9, 0, new QStandardItem("Speed:"));
+        pModel->setItem(i * 13 + 9, 1, new QStandardItem(pRamData->qzSpeed == "" ? "N/A" : pRamData->qzSpeed));
 
-        pModel->setItem(i * 11 + 8, 0, new QStandardItem("Name:"));
-        pModel->setItem(i * 11 + 8, 1, new QStandardItem(pRamData->qzName == "" ? "N/A" : pRamData->qzName));
+        pModel->setItem(i * 13 + 10, 0, new QStandardItem("Part number:"));
+        pModel->setItem(i * 13 + 10, 1, new QStandardItem(pRamData->qzPartNumber == "" ? "N/A" : pRamData->qzPartNumber));
 
-        pModel->setItem(i * 11 + 9, 0, new QStandardItem("Speed:"));
-        pModel->setItem(i * 11 + 9, 1, new QStandardItem(pRamData->qzSpeed == "" ? "N/A" : pRamData->qzSpeed));
+        pModel->setItem(i * 13 + 11, 0, new QStandardItem("Serial number:"));
+        pModel->setItem(i * 13 + 11, 1, new QStandardItem(pRamData->qzSerialNumber == "" ? "N/A" : pRamData->qzSerialNumber));
+
+        pModel->setItem(i * 13 + 12, 0, new QStandardItem("Source:"));
+        pModel->setItem(i * 13 + 12, 1, new QStandardItem(MEMORY_DATA_SOURCE_STRING(m_Source)));
     }
 
     return pModel;
@@ -80,6 +172,142 @@ int CRAMInformation::InitializeInformation()
     int nStatus = ClearRamDataList();
     CHECK_OPERATION_STATUS(nStatus);
 
+    m_Source = MemorySourceNone;
+
+#ifdef STK_WINDOWS
+    if( m_pSMBios )
+    {
+        nStatus = InitializeFromSMBios(m_pSMBios->GetMemoryDevices());
+        if( Success == nStatus && !m_qRamData.isEmpty() )
+        {
+            m_Source = MemorySourceSMBios;
+            return Success;
+        }
+    }
+
+    nStatus = InitializeFromSPD();
+    if( Success == nStatus && !m_qRamData.isEmpty() )
+    {
+        m_Source = MemorySourceSPD;
+        return Success;
+    }
+
+    nStatus = InitializeFromWMI();
+    CHECK_OPERATION_STATUS_EX(nStatus);
+    m_Source = MemorySourceWMI;
+#else
+    nStatus = ReadOnlineMemory();
+    CHECK_OPERATION_STATUS(nStatus);
+
+    nStatus = InitializeFromSysfs();
+    if( Success == nStatus && !m_qRamData.isEmpty() )
+    {
+        m_Source = MemorySourceSMBios;
+        return Success;
+    }
+
+    // No per module data, report the online memory as a whole
+    if( 0 == m_ullOnlineMemory )
+        return Unsuccessful;
+
+    RamData *pRamData = new RamData;
+    CHECK_ALLOCATION_STATUS(pRamData);
+
+    pRamData->ullCapacity = m_ullOnlineMemory;
+    pRamData->qzCapacity = FormatCapacity(m_ullOnlineMemory);
+    pRamData->qzName = "System memory";
+    pRamData->nSpeed = 0;
+    m_qRamData.append(pRamData);
+
+    m_Source = MemorySourceSysfs;
+#endif
+
+    return Success;
+}
+
+#ifdef STK_WINDOWS
+int CRAMInformation::InitializeFromSMBios(QList<PT17MemoryDeviceInformation> qDevices)
+{
+    RamData *pRamData = 0;
+
+    foreach(PT17MemoryDeviceInformation pDevice, qDevices)
+    {
+        // Empty slots are reported with a zero size
+        if( 0 == pDevice->SizeInBytes )
+            continue;
+
+        pRamData = new RamData;
+        CHECK_ALLOCATION_STATUS(pRamData);
+
+        pRamData->qzBankLabel = pDevice->BankLocator;
+        pRamData->qzName = pDevice->DeviceLocator;
+        pRamData->ullCapacity = pDevice->SizeInBytes;
+        pRamData->qzCapacity = FormatCapacity(pDevice->SizeInBytes);
+        pRamData->qzDataWidth = pDevice->DataWidth;
+        pRamData->qzDescription = pDevice->TypeDetails;
+        pRamData->qzFormFactor = pDevice->FormFactor;
+        pRamData->qzManufacturer = pDevice->Manufacturer.trimmed();
+        pRamData->qzMemoryType = pDevice->Type;
+        pRamData->qzPartNumber = pDevice->PartNumber.trimmed();
+        pRamData->qzSerialNumber = pDevice->SerialNumber.trimmed();
+        pRamData->nSpeed = pDevice->SpeedMTs;
+        pRamData->qzSpeed = pDevice->CurrentClockSpeed;
+
+        m_qRamData.append(pRamData);
+    }
+
+    return Success;
+}
+
+int CRAMInformation::InitializeFromSPD()
+{
+    if( !m_pSPD )
+        return Unsuccessful;
+
+    RamData *pRamData = 0;
+    const QMap<int, SpdInformation*> &qDimms = m_pSPD->GetDimmsInformation();
+    QMap<int, SpdInformation*>::const_iterator it;
+
+    for(it = qDimms.begin(); it != qDimms.end(); it++)
+    {
+        const SpdInformation *pSpd = it.value();
+
+        pRamData = new RamData;
+        CHECK_ALLOCATION_STATUS(pRamData);
+
+        pRamData->qzBankLabel = QString(DIMM_TO_STRING(it.key()));
+        pRamData->qzName = pSpd->qsName;
+        pRamData->ullCapacity = (unsigned long long)pSpd->dwSizeMB * 1024 * 1024;
+        pRamData->qzCapacity = FormatCapacity(pRamData->ullCapacity);
+        pRamData->qzDataWidth = pSpd->qsModuleBusWidth;
+        pRamData->qzFormFactor = pSpd->qsModuleType;
+        pRamData->qzManufacturer = pSpd->qsManufacturer;
+        pRamData->qzMemoryType = pSpd->qsDeviceType;
+        pRamData->qzPartNumber = pSpd->qsPartNumber.trimmed();
+        pRamData->qzSerialNumber = pSpd->qsSerial;
+
+        // Fastest JEDEC operating point, clock -> transfer rate
+        pRamData->nSpeed = 0;
+        if( pSpd->Timings.nProfiles )
+        {
+            const SpdProfile *pJedec = &pSpd->Timings.Profiles[0];
+            for(int i = 0; i < pJedec->nClockEntries; i++)
+            {
+                if( pJedec->ClockEntries[i].nFrequency * 2 > pRamData->nSpeed )
+                    pRamData->nSpeed = pJedec->ClockEntries[i].nFrequency * 2;
+            }
+        }
+        if( pRamData->nSpeed )
+            pRamData->qzSpeed.sprintf("%d MHz", pRamData->nSpeed);
+
+        m_qRamData.append(pRamData);
+    }
+
+    return Success;
+}
+
+int CRAMInformation::InitializeFromWMI()
+{
     IWbemLocator            *pLocator = 0;
     IWbemServices           *pService = 0;
     IEnumWbemClassObject    *pEnumerator = 0;
@@ -132,6 +360,8 @@ int CRAMInformation::InitializeInformation()
 
         pRamData = new RamData;
         CHECK_ALLOCATION_STATUS(pRamData);
+        pRamData->ullCapacity = 0;
+        pRamData->nSpeed = 0;
 
         VariantInit(&vtProp);
         hRes = pClassObject->Get(L"BankLabel", 0, &vtProp, 0, 0);
@@ -142,8 +372,10 @@ int CRAMInformation::InitializeInformation()
         hRes = pClassObject->Get(L"Capacity", 0, &vtProp, 0, 0);
         if( VT_BSTR == vtProp.vt ) // when query for UINT64 -> return STRING (MSDN REF).
         {
-            UINT64 uiVal = _atoi64(_com_util::ConvertBSTRToString(vtProp.bstrVal));
-            pRamData->qzCapacity.sprintf("%d GB", (uiVal / (1024*1024*1024)));
+            char *pszCapacity = _com_util::ConvertBSTRToString(vtProp.bstrVal);
+            pRamData->ullCapacity = _atoi64(pszCapacity);
+            pRamData->qzCapacity = FormatCapacity(pRamData->ullCapacity);
+            delete[] pszCapacity;
         }
 
         VariantClear(&vtProp);
@@ -231,7 +463,7 @@ int CRAMInformation::InitializeInformation()
             pRamData->qzName = _com_util::ConvertBSTRToString(vtProp.bstrVal);
 
         VariantClear(&vtProp);
-        hRes = pClassObject->Get(L"FormFactor", 0, &vtProp, 0, 0);
+        hRes = pClassObject->Get(L"MemoryType", 0, &vtProp, 0, 0);
         if( VT_I4 == vtProp.vt)
         {
             switch(vtProp.intVal)
@@ -288,15 +520,177 @@ int CRAMInformation::InitializeInformation()
         VariantClear(&vtProp);
         hRes = pClassObject->Get(L"Speed", 0, &vtProp, 0, 0);
         if( VT_I4 == vtProp.vt)
+        {
+            pRamData->nSpeed = vtProp.intVal;
             pRamData->qzSpeed.sprintf("%d MHz", vtProp.intVal);
+        }
+
+        VariantClear(&vtProp);
+        hRes = pClassObject->Get(L"PartNumber", 0, &vtProp, 0, 0);
+        if( VT_BSTR == vtProp.vt)
+            pRamData->qzPartNumber = QString::fromWCharArray(vtProp.bstrVal).trimmed();
+
+        VariantClear(&vtProp);
+        hRes = pClassObject->Get(L"SerialNumber", 0, &vtProp, 0, 0);
+        if( VT_BSTR == vtProp.vt)
+            pRamData->qzSerialNumber = QString::fromWCharArray(vtProp.bstrVal).trimmed();
+
+        VariantClear(&vtProp);
+        pClassObject->Release();
 
         m_qRamData.append(pRamData);
     }
 
+    pEnumerator->Release();
     pService->Release();
     pLocator->Release();
 
     return Success;
 }
+#else
+int CRAMInformation::InitializeFromSysfs()
+{
+    QFile qTable(MEMORY_DMI_TABLE);
 
+    if( qTable.open(QIODevice::ReadOnly) )
+        return ParseDMITable(qTable.readAll());
+
+    // Older kernels only export the structures one by one
+    QDir qDir(MEMORY_DMI_ENTRIES);
+    foreach(QString qsEntry, qDir.entryList(QStringList() << "17-*", QDir::Dirs))
+    {
+        QFile qRaw(qDir.absoluteFilePath(qsEntry + "/raw"));
+        if( !qRaw.open(QIODevice::ReadOnly) )
+            continue;
 
+        QByteArray qData = qRaw.readAll();
+        int nStatus = AddMemoryDevice((const unsigned char*)qData.constData(), qData.size());
+        CHECK_OPERATION_STATUS(nStatus);
+    }
+
+    return Success;
+}
+
+int CRAMInformation::ParseDMITable(const QByteArray &qTable)
+{
+    const unsigned char *pData = (const unsigned char*)qTable.constData();
+    int nSize = qTable.size();
+    int nIndex = 0;
+
+    // Header: type, length, handle
+    while( nIndex + 4 <= nSize )
+    {
+        const unsigned char *pStructure = pData + nIndex;
+        if( 4 > pStructure[1] || MEMORY_DMI_END_OF_TABLE == pStructure[0] )
+            break;
+
+        // Formatted area followed by a double NUL terminated string set
+        int nEnd = nIndex + pStructure[1];
+        while( nEnd + 1 < nSize && (0 != pData[nEnd] || 0 != pData[nEnd + 1]) )
+            nEnd++;
+        nEnd += 2;
+        if( nEnd > nSize )
+            break;
+
+        if( MEMORY_DMI_TYPE17 == pStructure[0] )
+        {
+            int nStatus = AddMemoryDevice(pStructure, nEnd - nIndex);
+            CHECK_OPERATION_STATUS(nStatus);
+        }
+
+        nIndex = nEnd;
+    }
+
+    return Success;
+}
+
+int CRAMInformation::AddMemoryDevice(const unsigned char *pData, int nSize)
+{
+    if( MEMORY_DMI_TYPE17 != pData[0] || MEMORY_DMI_TYPE17_MIN_LENGTH > pData[1] || nSize < pData[1] )
+        return InvalidParameter;
+
+    // Size - 0xFFFF unknown, 0x7FFF means the real size is in the extended
+    // size (SMBIOS 2.7+, MB), bit 15 selects KB over MB
+    unsigned int uSize = DMI_WORD(pData, 0x0C);
+    unsigned long long ullCapacity = 0;
+    if( 0x7FFF == uSize && 0x20 <= pData[1] )
+        ullCapacity = (unsigned long long)(DMI_DWORD(pData, 0x1C) & 0x7FFFFFFF) * 1024 * 1024;
+    else if( 0xFFFF != uSize )
+        ullCapacity = (unsigned long long)(uSize & 0x7FFF) * ((uSize & 0x8000) ? 1024 : 1024 * 1024);
+
+    // Empty slots are reported with a zero size
+    if( 0 == ullCapacity )
+        return Success;
+
+    RamData *pRamData = new RamData;
+    CHECK_ALLOCATION_STATUS(pRamData);
+
+    pRamData->ullCapacity = ullCapacity;
+    pRamData->qzCapacity = FormatCapacity(ullCapacity);
+    pRamData->qzName = DMIString(pData, nSize, pData[0x10]);
+    pRamData->qzBankLabel = DMIString(pData, nSize, pData[0x11]);
+
+    unsigned int uDataWidth = DMI_WORD(pData, 0x0A);
+    if( 0xFFFF != uDataWidth )
+        pRamData->qzDataWidth.sprintf("%u bits", uDataWidth);
+
+    if( pData[0x0E] < sizeof(g_pszFormFactors) / sizeof(g_pszFormFactors[0]) )
+        pRamData->qzFormFactor = g_pszFormFactors[pData[0x0E]];
+    if( pData[0x12] < sizeof(g_pszMemoryTypes) / sizeof(g_pszMemoryTypes[0]) )
+        pRamData->qzMemoryType = g_pszMemoryTypes[pData[0x12]];
+
+    unsigned int uTypeDetail = DMI_WORD(pData, 0x13);
+    for( int i = 0; i < 16; i++ )
+    {
+        if( uTypeDetail & (1 << i) )
+        {
+            pRamData->qzDescription = g_pszTypeDetails[i];
+            break;
+        }
+    }
+
+    // Speed and the strings after it are SMBIOS 2.3+
+    pRamData->nSpeed = 0;
+    if( 0x1B <= pData[1] )
+    {
+        unsigned int uSpeed = DMI_WORD(pData, 0x15);
+        if( 0xFFFF != uSpeed )
+            pRamData->nSpeed = (int)uSpeed;
+
+        pRamData->qzManufacturer = DMIString(pData, nSize, pData[0x17]);
+        pRamData->qzSerialNumber = DMIString(pData, nSize, pData[0x18]);
+        pRamData->qzPartNumber = DMIString(pData, nSize, pData[0x1A]);
+    }
+    if( pRamData->nSpeed )
+        pRamData->qzSpeed.sprintf("%d MHz", pRamData->nSpeed);
+
+    m_qRamData.append(pRamData);
+
+    return Success;
+}
+
+int CRAMInformation::ReadOnlineMemory()
+{
+    QFile qBlockSize(MEMORY_SYSFS_BLOCKS "/block_size_bytes");
+    if( !qBlockSize.open(QIODevice::ReadOnly) )
+        return Unsuccessful;
+
+    bool bOk = false;
+    unsigned long long ullBlockSize = qBlockSize.readAll().trimmed().toULongLong(&bOk, 16);
+    if( !bOk )
+        return Unsuccessful;
+
+    unsigned long long ullBlocks = 0;
+    QDir qDir(MEMORY_SYSFS_BLOCKS);
+    foreach(QString qsBlock, qDir.entryList(QStringList() << "memory*", QDir::Dirs))
+    {
+        QFile qOnline(qDir.absoluteFilePath(qsBlock + "/online"));
+        if( qOnline.open(QIODevice::ReadOnly) && qOnline.read(1).startsWith('1') )
+            ullBlocks++;
+    }
+
+    m_ullOnlineMemory = ullBlocks * ullBlockSize;
+
+    return Success;
+}
+#endif
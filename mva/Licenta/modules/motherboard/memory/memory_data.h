@@ -1,14 +1,42 @@
 #ifndef _MEMORY_DATA_H
 #define _MEMORY_DATA_H
 
+#ifdef STK_WINDOWS
 #include <Windows.h>
 #include <comdef.h>
 #include <WbemIdl.h>
+#endif
 
 #include <QStandardItemModel>
 
 #include "../../../utils/headers/utils.h"
 
+#ifdef STK_WINDOWS
+#include "../../computer/dmi/headers/smbios_entry_point.h"
+#include "spd.h"
+#else
+// Both need the Ring0 driver, on Linux the type 17 records are read from
+// sysfs by this class
+class CSMBiosEntryPoint;
+class CSPDInformation;
+#endif
+
+typedef enum _MEMORY_DATA_SOURCE_
+{
+    MemorySourceNone = 0,
+    MemorySourceSMBios,
+    MemorySourceSPD,
+    MemorySourceWMI,
+    MemorySourceSysfs
+}MemoryDataSource;
+
+#define MEMORY_DATA_SOURCE_STRING(X) \
+    X == MemorySourceSMBios ? "SMBIOS" : \
+    X == MemorySourceSPD ? "SPD" : \
+    X == MemorySourceWMI ? "WMI" : \
+    X == MemorySourceSysfs ? "sysfs" : \
+    "N/A"
+
 typedef struct _RAM_DATA_
 {
     QString qzBankLabel;
@@ -21,21 +49,51 @@ typedef struct _RAM_DATA_
     QString qzModel;
     QString qzName;
     QString qzSpeed;
+    QString qzPartNumber;
+    QString qzSerialNumber;
+    unsigned long long ullCapacity;     // bytes
+    int nSpeed;                         // MT/s
 }RamData;
 
+// Memory inventory. Sources are tried in order: SMBIOS type 17 (already
+// parsed by the DMI module), SPD, then WMI. On Linux the type 17 records
+// come from the raw table in /sys/firmware/dmi, which needs root; without
+// it only the online memory from /sys/devices/system/memory is reported.
 class CRAMInformation
 {
 private:
-    QList<RamData*> m_qRamData;
+    QList<RamData*>         m_qRamData;
+    CSMBiosEntryPoint       *m_pSMBios;
+    CSPDInformation         *m_pSPD;
+    MemoryDataSource        m_Source;
+#ifndef STK_WINDOWS
+    unsigned long long      m_ullOnlineMemory;
+#endif
 
     int ClearRamDataList();
     int InitializeInformation();
+#ifdef STK_WINDOWS
+    int InitializeFromSMBios(QList<PT17MemoryDeviceInformation> qDevices);
+    int InitializeFromSPD();
+    int InitializeFromWMI();
+#else
+    int InitializeFromSysfs();
+    int ParseDMITable(const QByteArray &qTable);
+    int AddMemoryDevice(const unsigned char *pData, int nSize);
+    int ReadOnlineMemory();
+#endif
 
 public:
-    CRAMInformation();
+    CRAMInformation(CSMBiosEntryPoint *pSMBios = 0, CSPDInformation *pSPD = 0);
     ~CRAMInformation();
 
     QStandardItemModel *GetRAMInformations();
+    const QList<RamData*> &GetModules();
+    MemoryDataSource GetSource();
+#ifndef STK_WINDOWS
+    // bytes, sum of the online blocks
+    unsigned long long GetOnlineMemory();
+#endif
 };
 
 #endif
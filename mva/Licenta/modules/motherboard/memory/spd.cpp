@@ -118,6 +118,11 @@ QStandardItemModel *CSPDInformation::GetDimmsInformationModel()
     return m_pDimmInformationModel;
 }
 
+const QMap<int, SpdInformation*> &CSPDInformation::GetDimmsInformation() const
+{
+    return m_qDimmsInformation;
+}
+
 void CSPDInformation::OnRefreshData(int nDimm)
 {
     SpdInformation *pData = m_qDimmsInformation[nDimm];
@@ -161,11 +166,34 @@ void CSPDInformation::OnRefreshData(int nDimm)
     m_pDimmInformationModel->appendRow(qList); qList.clear();
     qList << new QStandardItem("Memory timings:");
     m_pDimmInformationModel->appendRow(qList); qList.clear();
-    for( int i = 0; i < pData->qTimings.count(); i++ )
+    for( int i = 0; i < pData->Timings.nProfiles; i++ )
     {
-        QString qsTiming = pData->qTimings.at(i);
-        qList << new QStandardItem(qsTiming.split(":").first()) << new QStandardItem(qsTiming.split(":").last());
+        const SpdProfile *pProfile = &pData->Timings.Profiles[i];
+        const SpdTimings *pTimings = &pProfile->Timings;
+
+        QString qsProfile = QString(SPD_PROFILE_TYPE_STRING(pProfile->nType));
+        if( SPD_PROFILE_XMP == pProfile->nType )
+            qsProfile += QString().sprintf(" profile %d", pProfile->nIndex);
+        if( pTimings->nVoltage )
+            qsProfile += QString().sprintf(" (%.2fV)", pTimings->nVoltage / 1000.0);
+
+        qList << new QStandardItem(qsProfile + ": ")
+              << new QStandardItem(QString().sprintf("tCK %.3f, tAA %.3f, tRCD %.3f, tRP %.3f, tRAS %.3f, tRC %.3f, tRFC %.3f ns",
+                                                     pTimings->nTCK / 1000.0, pTimings->nTAA / 1000.0, pTimings->nTRCD / 1000.0,
+                                                     pTimings->nTRP / 1000.0, pTimings->nTRAS / 1000.0, pTimings->nTRC / 1000.0,
+                                                     pTimings->nTRFC / 1000.0));
         m_pDimmInformationModel->appendRow(qList); qList.clear();
+
+        for( int j = 0; j < pProfile->nClockEntries; j++ )
+        {
+            const SpdClockEntry *pEntry = &pProfile->ClockEntries[j];
+
+            qList << new QStandardItem(QString().sprintf("@ %dMHz", pEntry->nFrequency))
+                  << new QStandardItem(QString().sprintf("%d-%d-%d-%d-%d (CL-RCD-RP-RAS-RC), RFC %d",
+                                                         pEntry->nCL, pEntry->nRCD, pEntry->nRP, pEntry->nRAS,
+                                                         pEntry->nRC, pEntry->nRFC));
+            m_pDimmInformationModel->appendRow(qList); qList.clear();
+        }
     }
 }
 
@@ -291,6 +319,7 @@ int CSPDInformation::InterpretDDR3SPDArray(BYTE *pbArray, int nDimm)
     dwRanks = RANKS_DDR3(bCurrentVal);
 
     DWORD dwSize = dwSDRAMCap / 8 * dwBusWidth / dwSDRAMWidth * dwRanks;
+    pData->dwSizeMB = dwSize;
     pData->qsSize.sprintf("%d MB", dwSize);
     pData->qsModuleBusWidth.sprintf("%d - bit", dwBusWidth);
 
@@ -403,65 +432,8 @@ int CSPDInformation::InterpretDDR3SPDArray(BYTE *pbArray, int nDimm)
     pData->qsName = QString(DIMM_TO_STRING(nDimm)) + QString(": ") + pData->qsManufacturer + " " + pData->qsPartNumber;
 
 
-    // DDR3 Timings data
-    // FTB - BYTE 9
-    bCurrentVal = pbArray[9];
-    double dFTB = (double)((bCurrentVal >> 4) & 0xF) / (double)(bCurrentVal & 0xF);
-    dFTB /= 1000;
-
-    // MTB - BYTE 10, 11
-    bCurrentVal = pbArray[10];
-    bAdditional = pbArray[11];
-    double dMTB = (double)(bCurrentVal) / (double)(bAdditional);
-
-    // TAA - BYTE 16, offset - BYTE 35
-    bCurrentVal = pbArray[16];
-    signed char cAAOffset = pbArray[35];
-    double dTAA = (double)(bCurrentVal) * dMTB;
-    dTAA += (double)(cAAOffset) * dFTB;
-
-    // TCK - BYTE 12, offset - BYTE 34
-    bCurrentVal = pbArray[12];
-    signed char cCKOffset = pbArray[34];
-    double dTCK = (double)(bCurrentVal) * dMTB;
-    dTCK += (double)(cCKOffset) * dFTB;
-
-    // TRCD - BYTE 18, offset - BYTE 36
-    bCurrentVal = pbArray[18];
-    signed char cTRCDOffset = pbArray[36];
-    double dTRCD = (double)(bCurrentVal) * dMTB;
-    dTRCD += (double)(cTRCDOffset) * dFTB;
-
-    // TRP - BYTE 20, offset - BYTE 37
-    bCurrentVal = pbArray[20];
-    signed char cTRPOffset = pbArray[36];
-    double dTRP = (double)(bCurrentVal) * dMTB;
-    dTRP += (double)(cTRPOffset) * dFTB;
-
-    // TRAS - BYTE 21 [3~0], 22
-    int nTRAS = pbArray[21] & 0xF;
-    nTRAS <<= 8;
-    nTRAS |= pbArray[22];
-    double dTRAS = (double)nTRAS * dMTB;
-
-    QStringList qsCLs = pData->qsCASLatencies.split(", ");
-    qsCLs[0] = qsCLs[0].at(qsCLs[0].count() - 1);
-    QString qsTimings = "";
-    for( int i = 0; i < qsCLs.count(); i++ )
-    {
-        int nCL = qsCLs[i].toInt();
-
-        double dCurrentTCK = dTAA / nCL;
-        if( dCurrentTCK < dTCK )
-            dCurrentTCK = dTCK;
-        double dCurrentFreq = floor(1000.0/dCurrentTCK);
-        int nRCD = ceil(dTRCD / dCurrentTCK);
-        int nRP = ceil(dTRP / dCurrentTCK);
-        int nRAS = ceil(dTRAS / dCurrentTCK);
-
-        qsTimings = QString().sprintf("@ %dMHz: %d-%d-%d-%d (CL-RCD-RP-RAS)", (int)dCurrentFreq, nCL, nRCD, nRP, nRAS);
-        pData->qTimings.append(qsTimings);
-    }
+    // DDR3 Timings data - JEDEC and XMP profiles
+    SpdDecodeDDR3Timings(pbArray, &pData->Timings);
 
     m_qDimmsInformation.insert(nDimm, pData);
 
@@ -520,7 +492,8 @@ int CSPDInformation::InterpretDDR2SPDArray(BYTE *pbArray, int nDimm)
     BYTE bBanks = pbArray[17];
 
     DWORD dwSize = bPrimaryDataWidth * (1ULL << bRows) * (1ULL << bColumns) * bBanks * bRanks;
-    pData->qsSize.sprintf("%d MB", (dwSize / (1024 * 1024)));
+    pData->dwSizeMB = dwSize / (1024 * 1024);
+    pData->qsSize.sprintf("%d MB", pData->dwSizeMB);
 
     // ECC - BYTE 11
     pData->qsECCMethod = "None";
@@ -605,59 +578,8 @@ int CSPDInformation::InterpretDDR2SPDArray(BYTE *pbArray, int nDimm)
     pData->qsName = QString(DIMM_TO_STRING(nDimm)) + QString(": ") + pData->qsManufacturer + " " + (pData->qsPartNumber != "N/A" ?
                 pData->qsPartNumber : "");
 
-    BYTE bCASSupported = pbArray[18] & 0xFC;
-    int i = 0;
-    for( i = 7; i >= 0; i-- )
-    {
-        if( bCASSupported & (1 << i) )
-            break;
-    }
-    BYTE bMaxCL = i;
-
-    double bRP = ((pbArray[27] & 0xFC) >> 2) + ((pbArray[27] & 0x3) * 0.25);
-    double bRCD = ((pbArray[29] & 0xFC) >> 2) + ((pbArray[29] & 0x3) * 0.25);
-    double bRAS = pbArray[30];
-
-    DWORD dwFreq = MODULE_DDR2_FREQ_INT(pbArray[9]);
-    double dClockNS = 0;
-    MODULE_DDR2_GET_FREQ_CLOCK_NS(dwFreq, dClockNS);
-
-    int nRP = ceil(bRP / dClockNS);
-    int nRCD = ceil(bRCD / dClockNS);
-    int nRAS  = ceil(bRAS / dClockNS);
-
-    QString qsTiming;
-    qsTiming = QString().sprintf("@ %dMHz: %d-%d-%d-%d (CL-RCD-RP-RAS)", dwFreq, bMaxCL, nRCD, nRP, nRAS);
-    pData->qTimings.append(qsTiming);
-
-    if( bCASSupported & (1 << (bMaxCL - 1)) )
-    {
-        bCurrentVal = pbArray[23];
-        dwFreq = MODULE_DDR2_FREQ_INT(pbArray[23]);
-        MODULE_DDR2_GET_FREQ_CLOCK_NS(dwFreq, dClockNS);
-
-        nRP = ceil(bRP / dClockNS);
-        nRCD = ceil(bRCD / dClockNS);
-        nRAS  = ceil(bRAS / dClockNS);
-
-
-        qsTiming = QString().sprintf("@ %dMHz: %d-%d-%d-%d (CL-RCD-RP-RAS)", dwFreq, bMaxCL - 1, nRCD, nRP, nRAS);
-        pData->qTimings.append(qsTiming);
-    }
-
-    if( bCASSupported & (1 << (bMaxCL - 2)) )
-    {
-        dwFreq = MODULE_DDR2_FREQ_INT(pbArray[25]);
-        MODULE_DDR2_GET_FREQ_CLOCK_NS(dwFreq, dClockNS);
-
-        nRP = ceil(bRP / dClockNS);
-        nRCD = ceil(bRCD / dClockNS);
-        nRAS  = ceil(bRAS / dClockNS);
-
-
-        qsTiming = QString().sprintf("@ %dMHz: %d-%d-%d-%d (CL-RCD-RP-RAS)", dwFreq, bMaxCL - 2, nRCD, nRP, nRAS);
-        pData->qTimings.append(qsTiming);
-    }
+    // DDR2 Timings data
+    SpdDecodeDDR2Timings(pbArray, &pData->Timings);
 
     m_qDimmsInformation.insert(nDimm, pData);
 
@@ -49,6 +49,8 @@ public:
 
     void OnRefreshData(int nDimm);
 
+    const QMap<int, SpdInformation*> &GetDimmsInformation() const;
+
 private:
     BYTE ReadSPDByte(DWORD dwBase, BYTE bOffset, BYTE bDevID);
     BOOL IsWaitReady(DWORD dwBase);
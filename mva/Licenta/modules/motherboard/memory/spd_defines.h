@@ -1,6 +1,8 @@
 #ifndef _SPD_DEFINES_H
 #define _SPD_DEFINES_H
 
+#include "spd_timings.h"
+
 #define IO_CONFIG_SPACE_CONTROL_ADDRESS             0x0cf8 //config  space  control  address
 #define IO_CONFIG_SPACE_DATA_ADDRESS                0x0cfc //config  space  data  address
 #define BASEADDRESS                                 0x80000000 //PCI-SMBus  init  address
@@ -197,7 +199,8 @@ typedef struct _SPD_INFORMATION_
     QString qsDeviceType;
     QString qsSDRAMDeviceType;
     QString qsECCMethod;
-    QStringList qTimings;
+    DWORD dwSizeMB;
+    SpdModuleTimings Timings;
     QStringList qFeatures;
 }SpdInformation;
 
@@ -0,0 +1,278 @@
+#include "spd_timings.h"
+
+#include <string.h>
+
+// DDR3 JEDEC and common XMP speed bins, cycle time in ps (DDR3-3200 down to DDR3-800)
+static const int g_pDDR3CycleTimes[] =
+{
+    625, 645, 667, 682, 714, 750, 833, 909, 938, 1000, 1071, 1111, 1250, 1500, 1875, 2500
+};
+
+static int MtbToPs(int nValue, int nDividend, int nDivisor)
+{
+    if( 0 == nDivisor )
+        return 0;
+
+    return (int)((long long)nValue * nDividend * 1000 / nDivisor);
+}
+
+static int FtbToPs(signed char cValue, int nDividend, int nDivisor)
+{
+    if( 0 == nDivisor )
+        return 0;
+
+    return (int)cValue * nDividend / nDivisor;
+}
+
+// JEDEC rounding algorithm, 2.5% guard band
+static int PsToClocks(int nValue, int nTCK)
+{
+    if( 0 >= nValue || 0 >= nTCK )
+        return 0;
+
+    return (int)(((long long)nValue * 1000 / nTCK + 974) / 1000);
+}
+
+static int SnapDDR3CycleTime(int nMinTCK)
+{
+    int nTolerance = nMinTCK / 100;
+
+    for( int i = 0; i < (int)(sizeof(g_pDDR3CycleTimes) / sizeof(g_pDDR3CycleTimes[0])); i++ )
+    {
+        if( g_pDDR3CycleTimes[i] >= nMinTCK - nTolerance )
+            return g_pDDR3CycleTimes[i];
+    }
+
+    return 0;
+}
+
+// DDR2 cycle time - upper nibble ns, lower nibble tenths or .25/.33/.66/.75
+static int DDR2CycleToPs(unsigned char bValue)
+{
+    static const int pFraction[16] = { 0, 100, 200, 300, 400, 500, 600, 700, 800, 900, 250, 333, 667, 750, 0, 0 };
+
+    return ((bValue >> 4) & 0xF) * 1000 + pFraction[bValue & 0xF];
+}
+
+// DDR2 tRP/tRRD/tRCD/tWR/tWTR/tRTP - bits 7~2 ns, bits 1~0 quarter ns
+static int DDR2QuarterToPs(unsigned char bValue)
+{
+    return (bValue >> 2) * 1000 + (bValue & 0x3) * 250;
+}
+
+// DDR2 tRC/tRFC extension fractions - BYTE 40
+static int DDR2ExtensionToPs(unsigned char bValue)
+{
+    static const int pFraction[8] = { 0, 250, 333, 500, 667, 750, 0, 0 };
+
+    return pFraction[bValue & 0x7];
+}
+
+void SpdComputeClockEntry(const SpdTimings *pTimings, int nCL, int nTCK, SpdClockEntry *pEntry)
+{
+    pEntry->nTCK = nTCK;
+    pEntry->nFrequency = (1000000 + nTCK / 2) / nTCK;
+    pEntry->nCL = nCL;
+    pEntry->nRCD = PsToClocks(pTimings->nTRCD, nTCK);
+    pEntry->nRP = PsToClocks(pTimings->nTRP, nTCK);
+    pEntry->nRAS = PsToClocks(pTimings->nTRAS, nTCK);
+    pEntry->nRC = PsToClocks(pTimings->nTRC, nTCK);
+    pEntry->nRFC = PsToClocks(pTimings->nTRFC, nTCK);
+    pEntry->nWR = PsToClocks(pTimings->nTWR, nTCK);
+    pEntry->nRRD = PsToClocks(pTimings->nTRRD, nTCK);
+    pEntry->nWTR = PsToClocks(pTimings->nTWTR, nTCK);
+    pEntry->nRTP = PsToClocks(pTimings->nTRTP, nTCK);
+    pEntry->nFAW = PsToClocks(pTimings->nTFAW, nTCK);
+}
+
+int SpdBuildClockTable(SpdProfile *pProfile)
+{
+    const SpdTimings *pTimings = &pProfile->Timings;
+    int nLastTCK = 0;
+
+    pProfile->nClockEntries = 0;
+    if( 0 >= pTimings->nTCK || 0 >= pTimings->nTAA )
+        return 0;
+
+    // CL ascending -> tCK descending, so a CL that ends up on an already
+    // listed cycle time gives nothing better than the previous entry
+    for( int i = 0; i < 32 && pProfile->nClockEntries < SPD_MAX_CLOCK_ENTRIES; i++ )
+    {
+        if( !(pTimings->uCASMask & (1u << i)) )
+            continue;
+
+        int nCL = pTimings->nCASBase + i;
+        int nMinTCK = (pTimings->nTAA + nCL - 1) / nCL;
+        if( nMinTCK < pTimings->nTCK )
+            nMinTCK = pTimings->nTCK;
+
+        int nTCK = SnapDDR3CycleTime(nMinTCK);
+        if( 0 == nTCK || nTCK == nLastTCK )
+            continue;
+
+        SpdComputeClockEntry(pTimings, nCL, nTCK, &pProfile->ClockEntries[pProfile->nClockEntries]);
+        pProfile->nClockEntries++;
+        nLastTCK = nTCK;
+    }
+
+    return pProfile->nClockEntries;
+}
+
+static void DecodeDDR3XMPProfile(const unsigned char *pbArray, int nProfile, SpdProfile *pProfile)
+{
+    const unsigned char *pbProfile = pbArray + XMP_DDR3_PROFILE_OFFSET + nProfile * XMP_DDR3_PROFILE_SIZE;
+    int nDividend = pbArray[XMP_DDR3_MTB_OFFSET + nProfile * 2];
+    int nDivisor = pbArray[XMP_DDR3_MTB_OFFSET + nProfile * 2 + 1];
+    SpdTimings *pTimings = &pProfile->Timings;
+
+    pProfile->nType = SPD_PROFILE_XMP;
+    pProfile->nIndex = nProfile + 1;
+
+    // Voltage - bits 6~5 V, bits 4~0 multiple of 50mV
+    pTimings->nVoltage = ((pbProfile[0] >> 5) & 0x3) * 1000 + (pbProfile[0] & 0x1F) * 50;
+
+    pTimings->nTCK = MtbToPs(pbProfile[1], nDividend, nDivisor);
+    pTimings->nTAA = MtbToPs(pbProfile[2], nDividend, nDivisor);
+    pTimings->uCASMask = pbProfile[3] | (pbProfile[4] << 8);
+    pTimings->nCASBase = 4;
+    pTimings->nTCWL = MtbToPs(pbProfile[5], nDividend, nDivisor);
+    pTimings->nTRP = MtbToPs(pbProfile[6], nDividend, nDivisor);
+    pTimings->nTRCD = MtbToPs(pbProfile[7], nDividend, nDivisor);
+    pTimings->nTWR = MtbToPs(pbProfile[8], nDividend, nDivisor);
+    pTimings->nTRAS = MtbToPs(((pbProfile[9] & 0xF) << 8) | pbProfile[10], nDividend, nDivisor);
+    pTimings->nTRC = MtbToPs(((pbProfile[9] & 0xF0) << 4) | pbProfile[11], nDividend, nDivisor);
+    pTimings->nTRFC = MtbToPs(pbProfile[14] | (pbProfile[15] << 8), nDividend, nDivisor);
+    pTimings->nTRTP = MtbToPs(pbProfile[16], nDividend, nDivisor);
+    pTimings->nTRRD = MtbToPs(pbProfile[17], nDividend, nDivisor);
+    pTimings->nTFAW = MtbToPs(((pbProfile[18] & 0xF) << 8) | pbProfile[19], nDividend, nDivisor);
+    pTimings->nTWTR = MtbToPs(pbProfile[20], nDividend, nDivisor);
+
+    SpdBuildClockTable(pProfile);
+}
+
+int SpdDecodeDDR3Timings(const unsigned char *pbArray, SpdModuleTimings *pTimings)
+{
+    memset(pTimings, 0, sizeof(SpdModuleTimings));
+
+    // MTB - BYTE 10, 11 (ns), FTB - BYTE 9 (ps)
+    int nDividend = pbArray[10];
+    int nDivisor = pbArray[11];
+    int nFineDividend = (pbArray[9] >> 4) & 0xF;
+    int nFineDivisor = pbArray[9] & 0xF;
+
+    if( 0 == nDivisor )
+        return 0;
+
+    SpdProfile *pProfile = &pTimings->Profiles[pTimings->nProfiles++];
+    SpdTimings *pJedec = &pProfile->Timings;
+    pProfile->nType = SPD_PROFILE_JEDEC;
+
+    // Voltage - BYTE 6, bit 0 set means NOT 1.5V operable
+    if( !(pbArray[6] & 0x1) )
+        pJedec->nVoltage = 1500;
+    else if( pbArray[6] & 0x2 )
+        pJedec->nVoltage = 1350;
+    else if( pbArray[6] & 0x4 )
+        pJedec->nVoltage = 1250;
+
+    // TCK - BYTE 12, offset - BYTE 34
+    pJedec->nTCK = MtbToPs(pbArray[12], nDividend, nDivisor) + FtbToPs(pbArray[34], nFineDividend, nFineDivisor);
+    // CAS latencies - BYTE 14, 15
+    pJedec->uCASMask = pbArray[14] | (pbArray[15] << 8);
+    pJedec->nCASBase = 4;
+    // TAA - BYTE 16, offset - BYTE 35
+    pJedec->nTAA = MtbToPs(pbArray[16], nDividend, nDivisor) + FtbToPs(pbArray[35], nFineDividend, nFineDivisor);
+    // TWR - BYTE 17
+    pJedec->nTWR = MtbToPs(pbArray[17], nDividend, nDivisor);
+    // TRCD - BYTE 18, offset - BYTE 36
+    pJedec->nTRCD = MtbToPs(pbArray[18], nDividend, nDivisor) + FtbToPs(pbArray[36], nFineDividend, nFineDivisor);
+    // TRRD - BYTE 19
+    pJedec->nTRRD = MtbToPs(pbArray[19], nDividend, nDivisor);
+    // TRP - BYTE 20, offset - BYTE 37
+    pJedec->nTRP = MtbToPs(pbArray[20], nDividend, nDivisor) + FtbToPs(pbArray[37], nFineDividend, nFineDivisor);
+    // TRAS - BYTE 21 [3~0], 22
+    pJedec->nTRAS = MtbToPs(((pbArray[21] & 0xF) << 8) | pbArray[22], nDividend, nDivisor);
+    // TRC - BYTE 21 [7~4], 23, offset - BYTE 38
+    pJedec->nTRC = MtbToPs(((pbArray[21] & 0xF0) << 4) | pbArray[23], nDividend, nDivisor) +
+            FtbToPs(pbArray[38], nFineDividend, nFineDivisor);
+    // TRFC - BYTE 24, 25
+    pJedec->nTRFC = MtbToPs(pbArray[24] | (pbArray[25] << 8), nDividend, nDivisor);
+    // TWTR - BYTE 26
+    pJedec->nTWTR = MtbToPs(pbArray[26], nDividend, nDivisor);
+    // TRTP - BYTE 27
+    pJedec->nTRTP = MtbToPs(pbArray[27], nDividend, nDivisor);
+    // TFAW - BYTE 28 [3~0], 29
+    pJedec->nTFAW = MtbToPs(((pbArray[28] & 0xF) << 8) | pbArray[29], nDividend, nDivisor);
+
+    SpdBuildClockTable(pProfile);
+
+    // XMP - BYTE 176, 177 magic, 178 enabled profiles
+    if( XMP_DDR3_MAGIC_0 == pbArray[XMP_DDR3_HEADER_OFFSET] && XMP_DDR3_MAGIC_1 == pbArray[XMP_DDR3_HEADER_OFFSET + 1] )
+    {
+        pTimings->nXMPRevision = pbArray[XMP_DDR3_REVISION_OFFSET];
+
+        for( int i = 0; i < 2; i++ )
+        {
+            if( !(pbArray[XMP_DDR3_PROFILE_ENABLE_OFFSET] & (1 << i)) )
+                continue;
+
+            DecodeDDR3XMPProfile(pbArray, i, &pTimings->Profiles[pTimings->nProfiles++]);
+        }
+    }
+
+    return pTimings->nProfiles;
+}
+
+int SpdDecodeDDR2Timings(const unsigned char *pbArray, SpdModuleTimings *pTimings)
+{
+    memset(pTimings, 0, sizeof(SpdModuleTimings));
+
+    SpdProfile *pProfile = &pTimings->Profiles[pTimings->nProfiles++];
+    SpdTimings *pJedec = &pProfile->Timings;
+    pProfile->nType = SPD_PROFILE_JEDEC;
+
+    // Voltage - BYTE 8
+    if( 0x5 == pbArray[8] )
+        pJedec->nVoltage = 1800;
+
+    // CAS latencies - BYTE 18, bit N -> CL N
+    pJedec->uCASMask = pbArray[18] & 0xFC;
+    pJedec->nCASBase = 0;
+
+    int nMaxCL = 0;
+    for( nMaxCL = 7; nMaxCL > 0; nMaxCL-- )
+    {
+        if( pJedec->uCASMask & (1u << nMaxCL) )
+            break;
+    }
+
+    // TCK @ CL X - BYTE 9, X-1 - BYTE 23, X-2 - BYTE 25
+    pJedec->nTCK = DDR2CycleToPs(pbArray[9]);
+    pJedec->nTAA = nMaxCL * pJedec->nTCK;
+    pJedec->nTRP = DDR2QuarterToPs(pbArray[27]);
+    pJedec->nTRRD = DDR2QuarterToPs(pbArray[28]);
+    pJedec->nTRCD = DDR2QuarterToPs(pbArray[29]);
+    pJedec->nTRAS = pbArray[30] * 1000;
+    pJedec->nTWR = DDR2QuarterToPs(pbArray[36]);
+    pJedec->nTWTR = DDR2QuarterToPs(pbArray[37]);
+    pJedec->nTRTP = DDR2QuarterToPs(pbArray[38]);
+    // TRC - BYTE 41, extension BYTE 40 [6~4]
+    pJedec->nTRC = pbArray[41] * 1000 + DDR2ExtensionToPs(pbArray[40] >> 4);
+    // TRFC - BYTE 42, extension BYTE 40 [3~0]
+    pJedec->nTRFC = (pbArray[42] + ((pbArray[40] & 0x1) ? 256 : 0)) * 1000 + DDR2ExtensionToPs(pbArray[40] >> 1);
+
+    const int pCycleOffsets[3] = { 9, 23, 25 };
+    for( int i = 0; i < 3 && nMaxCL - i > 0; i++ )
+    {
+        int nCL = nMaxCL - i;
+        int nTCK = DDR2CycleToPs(pbArray[pCycleOffsets[i]]);
+
+        if( !(pJedec->uCASMask & (1u << nCL)) || 0 == nTCK )
+            continue;
+
+        SpdComputeClockEntry(pJedec, nCL, nTCK, &pProfile->ClockEntries[pProfile->nClockEntries]);
+        pProfile->nClockEntries++;
+    }
+
+    return pTimings->nProfiles;
+}
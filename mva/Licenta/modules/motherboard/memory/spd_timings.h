@@ -0,0 +1,95 @@
+#ifndef _SPD_TIMINGS_H
+#define _SPD_TIMINGS_H
+
+// Typed SPD timing decoding. Kept free of Qt/WinAPI so the same code can be
+// used by the GUI module and by offline tools working on SPD dumps.
+
+#define SPD_MAX_PROFILES                            3 // JEDEC + 2 XMP profiles
+#define SPD_MAX_CLOCK_ENTRIES                       16
+
+#define SPD_PROFILE_JEDEC                           0
+#define SPD_PROFILE_XMP                             1
+
+// Intel XMP 1.x header for DDR3 - BYTE 176~184
+#define XMP_DDR3_HEADER_OFFSET                      176
+#define XMP_DDR3_MAGIC_0                            0x0C
+#define XMP_DDR3_MAGIC_1                            0x4A
+#define XMP_DDR3_PROFILE_ENABLE_OFFSET              178
+#define XMP_DDR3_REVISION_OFFSET                    179
+#define XMP_DDR3_MTB_OFFSET                         180
+#define XMP_DDR3_PROFILE_OFFSET                     185
+#define XMP_DDR3_PROFILE_SIZE                       35
+
+#define SPD_PROFILE_TYPE_STRING(X) \
+    X == SPD_PROFILE_JEDEC ? "JEDEC" : \
+    X == SPD_PROFILE_XMP ? "XMP" : \
+    "Unknown"
+
+// All time values are in picoseconds
+typedef struct _SPD_TIMINGS_
+{
+    int nTCK;
+    int nTAA;
+    int nTRCD;
+    int nTRP;
+    int nTRAS;
+    int nTRC;
+    int nTRFC;
+    int nTWR;
+    int nTRRD;
+    int nTWTR;
+    int nTRTP;
+    int nTFAW;
+    int nTCWL;
+    unsigned int uCASMask;      // bit N set -> CL (nCASBase + N) supported
+    int nCASBase;
+    int nVoltage;               // mV
+}SpdTimings;
+
+// Timings converted to clock counts for one operating point
+typedef struct _SPD_CLOCK_ENTRY_
+{
+    int nTCK;                   // ps
+    int nFrequency;             // MHz
+    int nCL;
+    int nRCD;
+    int nRP;
+    int nRAS;
+    int nRC;
+    int nRFC;
+    int nWR;
+    int nRRD;
+    int nWTR;
+    int nRTP;
+    int nFAW;
+}SpdClockEntry;
+
+typedef struct _SPD_PROFILE_
+{
+    int nType;
+    int nIndex;                 // XMP profile number, 0 for JEDEC
+    SpdTimings Timings;
+    int nClockEntries;
+    SpdClockEntry ClockEntries[SPD_MAX_CLOCK_ENTRIES];
+}SpdProfile;
+
+typedef struct _SPD_MODULE_TIMINGS_
+{
+    int nProfiles;
+    int nXMPRevision;           // 0 when no XMP header is present
+    SpdProfile Profiles[SPD_MAX_PROFILES];
+}SpdModuleTimings;
+
+// Decode JEDEC (and XMP when present) timings from a 256 byte SPD image and
+// build the clock table of every profile. Returns the number of profiles.
+int SpdDecodeDDR3Timings(const unsigned char *pbArray, SpdModuleTimings *pTimings);
+int SpdDecodeDDR2Timings(const unsigned char *pbArray, SpdModuleTimings *pTimings);
+
+// Convert every timing of pTimings to clock counts at nCL / nTCK
+void SpdComputeClockEntry(const SpdTimings *pTimings, int nCL, int nTCK, SpdClockEntry *pEntry);
+
+// Fill the clock table for each supported CL of a DDR3 profile in one pass.
+// Returns the number of entries.
+int SpdBuildClockTable(SpdProfile *pProfile);
+
+#endif
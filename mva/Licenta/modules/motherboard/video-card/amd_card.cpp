@@ -63,6 +63,11 @@ QStandardItemModel *CAmdCard::GetGPUDetailsModel()
     return m_pGpuDataModel;
 }
 
+const QList<GpuReading> &CAmdCard::GetReadings()
+{
+    return m_qReadings;
+}
+
 void CAmdCard::OnRefreshData(int)
 {
     double *dAux = 0;
@@ -71,8 +76,10 @@ void CAmdCard::OnRefreshData(int)
     double dAux2 = 0;
 
     m_pGpuDataModel->clear();
+    m_qReadings.clear();
 
     QStandardItem *pIndex = 0;
+    GpuReading Reading;
 
     dAux = GetTemperatures();
     if( dAux )
@@ -85,8 +92,13 @@ void CAmdCard::OnRefreshData(int)
             if( dAux[i] == 0 )
                 continue;
 
+            Reading.Kind = GpuReadingTemperature;
+            Reading.qsField = QString().sprintf("Temp #%d", ++nCount);
+            Reading.dValue = dAux[i];
+            m_qReadings.append(Reading);
+
             qRow.clear();
-            qRow << new QStandardItem(QString().sprintf("Temp #%d", ++nCount));
+            qRow << new QStandardItem(Reading.qsField);
             qRow << new QStandardItem(QString().sprintf("%.2f",dAux[i]));
 
             pIndex->appendRow(qRow);
@@ -104,14 +116,36 @@ void CAmdCard::OnRefreshData(int)
             if( dAux[i] == 0 )
                 continue;
 
+            Reading.Kind = GpuReadingFanRPM;
+            Reading.qsField = QString().sprintf("Fan #%d", ++nCount);
+            Reading.dValue = dAux[i];
+            m_qReadings.append(Reading);
+
             qRow.clear();
-            qRow << new QStandardItem(QString().sprintf("Fan #%d", ++nCount));
+            qRow << new QStandardItem(Reading.qsField);
             qRow << new QStandardItem(QString().sprintf("%.2f",dAux[i]));
 
             pIndex->appendRow(qRow);
         }
     }
 
+    // Controllers without a tachometer only report the duty cycle
+    dAux = GetFanSpeedsPercentage();
+    if( dAux )
+    {
+        nCount = 0;
+        for(int i = 0; i < 10; i++)
+        {
+            if( dAux[i] == 0 )
+                continue;
+
+            Reading.Kind = GpuReadingFanPercent;
+            Reading.qsField = QString().sprintf("Fan #%d", ++nCount);
+            Reading.dValue = dAux[i];
+            m_qReadings.append(Reading);
+        }
+    }
+
     dAux2 = GetEngineClock();
     qRow.clear();
     qRow << new QStandardItem("Engine Clock: ");
@@ -8,6 +8,8 @@
 
 #include <QStandardItemModel>
 
+#include "video_structures.h"
+
 class CAmdCard
 {
 private:
@@ -29,6 +31,7 @@ private:
 
     QStandardItemModel                      *m_pGpuModel;
     QStandardItemModel                      *m_pGpuDataModel;
+    QList<GpuReading>                       m_qReadings;
 
     bool Initialize();
     QString GetAdapterName();
@@ -45,6 +48,7 @@ public:
 
     QStandardItemModel *GetPhysicalGPUModel();
     QStandardItemModel *GetGPUDetailsModel();
+    const QList<GpuReading> &GetReadings();
 
     void OnRefreshData(int);
 };
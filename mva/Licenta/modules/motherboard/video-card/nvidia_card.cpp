@@ -97,6 +97,11 @@ QStandardItemModel *CNvidiaManager::GetGPUDetailsModel()
     return m_pGpuDataModel;
 }
 
+const QList<GpuReading> &CNvidiaManager::GetReadings()
+{
+    return m_qReadings;
+}
+
 void CNvidiaManager::OnRefreshData(int nIndex)
 {
     m_pData = new NVidiaReport;
@@ -248,11 +253,19 @@ int CNvidiaManager::OnRefreshDynamicData()
     for(int i = 0; i < NVAPI_MAX_THERMAL_SENSORS_PER_GPU;i++)
         pNvThermalSettings[i].version = NV_GPU_THERMAL_SETTINGS_VER_2;
 
+    m_qReadings.clear();
+
     NvAPI_Status nStatus = NvAPI_GPU_GetThermalSettings(m_pGpuHandles[m_nCurrentIndex], NVAPI_THERMAL_TARGET_ALL, pNvThermalSettings);
     if( NVAPI_OK != nStatus )
         return Unsuccessful;
 
-    m_pGpuDataModel->item(1)->child(0, 0)->setText(GetThermalTargetName(pNvThermalSettings[0].sensor[0].target));
+    GpuReading Reading;
+    Reading.Kind = GpuReadingTemperature;
+    Reading.qsField = GetThermalTargetName(pNvThermalSettings[0].sensor[0].target);
+    Reading.dValue = pNvThermalSettings[0].sensor[0].currentTemp;
+    m_qReadings.append(Reading);
+
+    m_pGpuDataModel->item(1)->child(0, 0)->setText(Reading.qsField);
     m_pGpuDataModel->item(1)->child(0, 1)->setText(QString().sprintf("%d.0C", pNvThermalSettings[0].sensor[0].currentTemp));
 
     free(pNvThermalSettings);
@@ -262,6 +275,11 @@ int CNvidiaManager::OnRefreshDynamicData()
     if( NVAPI_OK != nStatus )
         return Unsuccessful;
 
+    Reading.Kind = GpuReadingFanRPM;
+    Reading.qsField = "Speed";
+    Reading.dValue = nValue;
+    m_qReadings.append(Reading);
+
     m_pGpuDataModel->item(2)->child(0, 1)->setText(QString().sprintf("%d RPM", nValue));
 
     NV_GPU_DYNAMIC_PSTATES_INFO_EX nvDynamicPStatesEx = {0};
@@ -271,10 +289,17 @@ int CNvidiaManager::OnRefreshDynamicData()
     if( NVAPI_OK != nStatus )
         return 0;
 
-    m_pGpuDataModel->item(3)->child(0, 1)->setText(QString().sprintf("%d%", nvDynamicPStatesEx.utilization[0].percentage));
-    m_pGpuDataModel->item(3)->child(1, 1)->setText(QString().sprintf("%d%", nvDynamicPStatesEx.utilization[1].percentage));
-    m_pGpuDataModel->item(3)->child(2, 1)->setText(QString().sprintf("%d%", nvDynamicPStatesEx.utilization[2].percentage));
-    m_pGpuDataModel->item(3)->child(3, 1)->setText(QString().sprintf("%d%", nvDynamicPStatesEx.utilization[3].percentage));
+    // GPU, frame buffer, video engine and bus, the rows of the Usage section
+    static const char *pszUsages[] = { "GPU usage", "FBU usage", "VID usage", "BUS usage" };
+    for(int i = 0; i < 4; i++)
+    {
+        Reading.Kind = GpuReadingUsage;
+        Reading.qsField = pszUsages[i];
+        Reading.dValue = nvDynamicPStatesEx.utilization[i].percentage;
+        m_qReadings.append(Reading);
+
+        m_pGpuDataModel->item(3)->child(i, 1)->setText(QString().sprintf("%d%", nvDynamicPStatesEx.utilization[i].percentage));
+    }
 
     return Success;
 }
@@ -18,6 +18,7 @@ private:
     int                 m_nCurrentIndex;
 
     NVidiaReport        *m_pData;
+    QList<GpuReading>   m_qReadings;
 
     NvU32               m_nGPUCount;
     NvPhysicalGpuHandle m_pGpuHandles[NVAPI_MAX_PHYSICAL_GPUS];
@@ -34,6 +35,7 @@ public:
 
     QStandardItemModel *GetPhysicalGPUModel();
     QStandardItemModel *GetGPUDetailsModel();
+    const QList<GpuReading> &GetReadings();
 
     void OnRefreshData(int);
 };
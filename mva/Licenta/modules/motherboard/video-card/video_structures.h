@@ -38,4 +38,20 @@ typedef struct _NVIDIA_REPORT_
     QString qsChipsetName;
 }NVidiaReport;
 
+typedef enum _GPU_READING_KIND_
+{
+    GpuReadingTemperature = 0,      // C
+    GpuReadingFanRPM,
+    GpuReadingFanPercent,
+    GpuReadingUsage                 // %
+}GpuReadingKind;
+
+// The dynamic values of the last refresh, as read from the driver
+typedef struct _GPU_READING_
+{
+    GpuReadingKind Kind;
+    QString qsField;
+    double dValue;
+}GpuReading;
+
 #endif // VIDEO_STRUCTURES_H
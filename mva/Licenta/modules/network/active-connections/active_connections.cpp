@@ -1,5 +1,7 @@
 #include "active_connections.h"
 
+#include "../../../utils/headers/self_profile.h"
+
 
 CActiveConnections::CActiveConnections() : m_pDataModel(NULL)
 {
@@ -19,6 +21,8 @@ CActiveConnections::~CActiveConnections()
 
 int CActiveConnections::GetAllTCPConnections()
 {
+    STK_PROFILE_SCOPE(ProfileModuleTcpConnections);
+
     PMIB_TCPTABLE_OWNER_MODULE pTcpTable = 0;
     DWORD dwSize = 0;
     DWORD dwRetVal = 0;
@@ -35,6 +39,7 @@ int CActiveConnections::GetAllTCPConnections()
 
     dwSize = sizeof(MIB_TCPTABLE_OWNER_MODULE);
 
+    STK_PROFILE_SYSCALL();
     if( (dwRetVal = GetExtendedTcpTable(pTcpTable, &dwSize, TRUE, AF_INET,
                                         TCP_TABLE_OWNER_MODULE_ALL, 0)) == ERROR_INSUFFICIENT_BUFFER )
     {
@@ -46,6 +51,7 @@ int CActiveConnections::GetAllTCPConnections()
         }
     }
 
+    STK_PROFILE_SYSCALL();
     if( (dwRetVal = GetExtendedTcpTable(pTcpTable, &dwSize, TRUE, AF_INET, TCP_TABLE_OWNER_MODULE_ALL, 0)) == NO_ERROR )
     {
         for(int i = 0; i < (int) pTcpTable->dwNumEntries; i++)
@@ -151,6 +157,8 @@ int CActiveConnections::GetAllTCPConnections()
 
 int CActiveConnections::GetAllUDPConnections()
 {
+    STK_PROFILE_SCOPE(ProfileModuleUdpConnections);
+
     PMIB_UDPTABLE_OWNER_MODULE pUdpTable = 0;
     DWORD dwSize = 0;
     DWORD dwRetVal = 0;
@@ -167,6 +175,7 @@ int CActiveConnections::GetAllUDPConnections()
 
     dwSize = sizeof(MIB_UDPTABLE_OWNER_MODULE);
 
+    STK_PROFILE_SYSCALL();
     if( (dwRetVal = GetExtendedUdpTable(pUdpTable, &dwSize, TRUE, AF_INET,
                                         UDP_TABLE_OWNER_MODULE, 0)) == ERROR_INSUFFICIENT_BUFFER )
     {
@@ -178,6 +187,7 @@ int CActiveConnections::GetAllUDPConnections()
         }
     }
 
+    STK_PROFILE_SYSCALL();
     if( (dwRetVal = GetExtendedUdpTable(pUdpTable, &dwSize, TRUE, AF_INET, UDP_TABLE_OWNER_MODULE, 0)) == NO_ERROR )
     {
         for(int i = 0; i < (int) pUdpTable->dwNumEntries; i++)
@@ -238,6 +248,7 @@ int CActiveConnections::GetAllUDPConnections()
 
 QString CActiveConnections::GetProcessNameFromPID(int nPID)
 {
+    STK_PROFILE_SYSCALL();
     HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS,0);
     if(hSnapshot)
     {
@@ -1,5 +1,7 @@
 #include "../headers/processes.h"
 
+#include "../../../../utils/headers/self_profile.h"
+
 Processes::Processes() : m_pModuleModel(NULL), m_pProcessModel(NULL)
 {
     m_pProcessModel = new QStandardItemModel();
@@ -17,6 +19,8 @@ Processes::~Processes()
 
 int Processes::GetProcessList()
 {
+    STK_PROFILE_SCOPE(ProfileModuleProcesses);
+
     int nStatus = Uninitialized;
 
     // clear current list
@@ -50,6 +54,7 @@ int Processes::GetProcessList()
     Process *pProcess = 0;
     BOOL bIsTrue = 0;
 
+    STK_PROFILE_SYSCALL();
     hProcessSnap = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     CHECK_ALLOCATION_STATUS(hProcessSnap);
 
@@ -63,6 +68,7 @@ int Processes::GetProcessList()
 
     do
     {
+        STK_PROFILE_SYSCALL();
         hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION , FALSE, peProcessEntry.th32ProcessID );
         if( 0 == hProcess )
         {
@@ -74,6 +80,7 @@ int Processes::GetProcessList()
         CHECK_ALLOCATION_STATUS(pProcess);
 
         dwProcessFileNameSize = MAX_PATH;
+        STK_PROFILE_SYSCALL();
         if( 0 != QueryFullProcessImageName(hProcess, 0, wszProcessFileName, &dwProcessFileNameSize))
             pProcess->qszProcessFileName = QString::fromWCharArray(wszProcessFileName);
         else
@@ -85,6 +92,7 @@ int Processes::GetProcessList()
 
         pProcess->qnNumberOfThreads = (qint32) peProcessEntry.cntThreads;
 
+        STK_PROFILE_SYSCALL();
         if( 0 == IsWOW64Process(hProcess, &bIsTrue))
         {
             nStatus = Unsuccessful;
@@ -94,6 +102,7 @@ int Processes::GetProcessList()
 
         pProcess->qnMemoryUsed = 0;
 
+        STK_PROFILE_SYSCALL();
         if( 0 != GetProcessMemInfo(hProcess, &pmProcessMemoryCounters, sizeof(pmProcessMemoryCounters)))
         {
             SIZE_T workingSetSize = pmProcessMemoryCounters.WorkingSetSize / (1024 * 1024);
@@ -103,6 +112,7 @@ int Processes::GetProcessList()
         }
 
         pProcess->qszProcessCommandLine = "";
+        STK_PROFILE_SYSCALL();
         CloseHandle(hProcess);
 
         m_qlProcesses.append(pProcess);
@@ -45,14 +45,15 @@ private:
     int CollectSmartAttributes(const wchar_t* tszDriveName);
     void PopulateModel(DriveInfo *pDriveInfo);
     int Initialize(QString qsDrive);
-    SmartDetails *GetSMARTDetailsFromDB(short sAttribIndex);
-    QList<SmartData*> GetSmartData();
 
 public:
     CSmartInfo();
     ~CSmartInfo();
     QStandardItemModel* GetAvailableHDD();
     QStandardItemModel* GetSMARTPropertiesForHDD();
+    // Attributes of the drive last refreshed, empty when the read failed
+    QList<SmartData*> GetSmartData();
+    SmartDetails *GetSMARTDetailsFromDB(short sAttribIndex);
 
     void OnRefreshData(QString qsDrive);
 };
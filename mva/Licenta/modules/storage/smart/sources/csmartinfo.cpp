@@ -369,6 +369,9 @@ int CSmartInfo::CollectSmartAttributes(const wchar_t *tszDriveName)
 
 QList<SmartData*> CSmartInfo::GetSmartData()
 {
+    if( NULL == m_data )
+        return QList<SmartData*>();
+
     return m_data->SmartEntries;
 }
 
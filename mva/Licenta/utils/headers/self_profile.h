@@ -0,0 +1,126 @@
+#ifndef SELF_PROFILE_H
+#define SELF_PROFILE_H
+
+#include <atomic>
+
+// Instrumentation of what the tool itself costs, per module. Compiled in
+// with DEFINES += STK_SELF_PROFILE, without it every STK_PROFILE_ macro
+// expands to nothing. Compiled in, it stays off until
+// CSelfProfile::Enable(): a scope then costs one relaxed atomic load, a
+// counted call or an allocation one thread local increment.
+
+typedef enum _PROFILE_MODULE_
+{
+    ProfileModuleSensorTick = 0,        // a whole UpdateSensorSamples(), the sensor modules included
+    ProfileModuleBoard,                 // Super I/O or hwmon board chip
+    ProfileModuleCpuTemperature,        // CIntelCpuSensor, the AMD and hwmon CPU sensors
+    ProfileModuleCpuTimes,
+    ProfileModuleRaplPower,
+    ProfileModuleCoreFrequency,
+    ProfileModuleMemory,
+    ProfileModuleNumaMemory,
+    ProfileModuleDiskPerformance,
+    ProfileModuleSensorsPage,           // packing the tree or the delta for the page
+    ProfileModuleGpu,
+    ProfileModuleProcesses,
+    ProfileModuleTcpConnections,
+    ProfileModuleUdpConnections,
+    ProfileModuleCount
+}ProfileModule;
+
+#define PROFILE_MODULE_STRING(X) \
+    X == ProfileModuleSensorTick ? "tick" : \
+    X == ProfileModuleBoard ? "board" : \
+    X == ProfileModuleCpuTemperature ? "cpu_temperature" : \
+    X == ProfileModuleCpuTimes ? "cpu_times" : \
+    X == ProfileModuleRaplPower ? "rapl" : \
+    X == ProfileModuleCoreFrequency ? "core_frequency" : \
+    X == ProfileModuleMemory ? "memory" : \
+    X == ProfileModuleNumaMemory ? "numa" : \
+    X == ProfileModuleDiskPerformance ? "disk" : \
+    X == ProfileModuleSensorsPage ? "sensors_page" : \
+    X == ProfileModuleGpu ? "gpu" : \
+    X == ProfileModuleProcesses ? "processes" : \
+    X == ProfileModuleTcpConnections ? "tcp_connections" : \
+    X == ProfileModuleUdpConnections ? "udp_connections" : \
+    ""
+
+typedef struct _PROFILE_COUNTERS_
+{
+    unsigned long long ullCalls;
+    unsigned long long ullWallTime;     // us
+    unsigned long long ullCpuTime;      // us of the calling thread, scheduler tick granularity on Windows
+    unsigned long long ullSyscalls;     // driver IOCTLs, file reads and the other counted kernel calls
+    unsigned long long ullAllocations;  // operator new, malloc() of the modules is not seen
+}ProfileCounters;
+
+#ifdef STK_WINDOWS
+#define STK_THREAD_LOCAL __declspec(thread)
+#else
+#define STK_THREAD_LOCAL __thread
+#endif
+
+extern std::atomic<bool> g_bSelfProfileEnabled;
+extern STK_THREAD_LOCAL unsigned long long g_ullSelfProfileSyscalls;
+extern STK_THREAD_LOCAL unsigned long long g_ullSelfProfileAllocations;
+
+// Counters are inclusive, a nested scope is also seen by the enclosing
+// one. Scopes on other threads (the burst sampler reads the board and CPU
+// sensors) add to the same module.
+class CSelfProfileScope
+{
+private:
+    ProfileModule               m_Module;
+    bool                        m_bActive;
+    unsigned long long          m_ullWallTime;
+    unsigned long long          m_ullCpuTime;
+    unsigned long long          m_ullSyscalls;
+    unsigned long long          m_ullAllocations;
+
+    void Begin();
+    void End();
+
+public:
+    CSelfProfileScope(ProfileModule Module):
+        m_Module( Module ),
+        m_bActive( g_bSelfProfileEnabled.load(std::memory_order_relaxed) )
+    {
+        if( m_bActive )
+            Begin();
+    }
+
+    ~CSelfProfileScope()
+    {
+        if( m_bActive )
+            End();
+    }
+};
+
+// Counters of the tick in progress, of the last closed tick and since the
+// profile was enabled, one set per ProfileModule
+class CSelfProfile
+{
+public:
+    static void Enable(bool bEnable);
+    static bool IsEnabled();
+
+    static void Record(ProfileModule Module, const ProfileCounters *pCounters);
+    // The tick in progress becomes the last tick and is added to the totals
+    static void EndTick();
+
+    // ProfileModuleCount entries each, returns the number of closed ticks
+    static unsigned long long GetLastTick(ProfileCounters *pCounters);
+    static unsigned long long GetTotals(ProfileCounters *pCounters);
+};
+
+#ifdef STK_SELF_PROFILE
+#define STK_PROFILE_SCOPE(Module)       CSelfProfileScope SelfProfileScope(Module)
+#define STK_PROFILE_SYSCALL()           (g_ullSelfProfileSyscalls++)
+#define STK_PROFILE_END_TICK()          CSelfProfile::EndTick()
+#else
+#define STK_PROFILE_SCOPE(Module)
+#define STK_PROFILE_SYSCALL()
+#define STK_PROFILE_END_TICK()
+#endif
+
+#endif // SELF_PROFILE_H
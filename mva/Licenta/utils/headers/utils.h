@@ -1,9 +1,11 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#ifdef STK_WINDOWS
 //WinAPI includes
 #include <Windows.h>
 #include <WinBase.h>
+#endif
 #include <wchar.h>
 
 //Qt includes
@@ -11,8 +13,10 @@
 #include <QDebug>
 #include <QIcon>
 #include <QPixmap>
+#ifdef STK_WINDOWS
 #include <QtWinExtras>
 #include <QtWin>
+#endif
 #include <QDir>
 
 //Defines
@@ -20,13 +24,11 @@
 
 #define SAFE_DELETE(X) if(X) { delete (X); X = 0; }
 
-#ifdef STK_WINDOWS
-    #define DEBUG_STATUS(expr) qDebug("\nEXCEPTION ON: \"%s\"(%d)\nFUNCTION: \"%s\"\nStatus: %d\n",__FILE__, __LINE__, __FUNCTION__, expr)
-    #define CHECK_ALLOCATION(X) if(!X) { qDebug("Allocation failed in: %s at line %d: ", __FILE__, __LINE__); return; }
-    #define CHECK_ALLOCATION_STATUS(X) if(!X) { qDebug("Allocation failed in: %s at line %d: ", __FILE__, __LINE__); return 5; }
-    #define CHECK_OPERATION_STATUS(X) if(0 != X) { qDebug("Operation unsuccessful in: %s at line %d with status %d", __FILE__, __LINE__, X); }
-    #define CHECK_OPERATION_STATUS_EX(X) if(0 != X) { qDebug("Operation unsuccessful in: %s at line %d with status %d", __FILE__, __LINE__, X); return X; }
-#endif
+#define DEBUG_STATUS(expr) qDebug("\nEXCEPTION ON: \"%s\"(%d)\nFUNCTION: \"%s\"\nStatus: %d\n",__FILE__, __LINE__, __FUNCTION__, expr)
+#define CHECK_ALLOCATION(X) if(!X) { qDebug("Allocation failed in: %s at line %d: ", __FILE__, __LINE__); return; }
+#define CHECK_ALLOCATION_STATUS(X) if(!X) { qDebug("Allocation failed in: %s at line %d: ", __FILE__, __LINE__); return 5; }
+#define CHECK_OPERATION_STATUS(X) if(0 != X) { qDebug("Operation unsuccessful in: %s at line %d with status %d", __FILE__, __LINE__, X); }
+#define CHECK_OPERATION_STATUS_EX(X) if(0 != X) { qDebug("Operation unsuccessful in: %s at line %d with status %d", __FILE__, __LINE__, X); return X; }
 
 #define AMD_CHIPSET_VENDOR_STRING QString("AuthenticAMD")
 #define INTEL_CHIPSET_VENDOR_STRING QString("GenuineIntel")
@@ -47,12 +49,15 @@ typedef enum _SysToolError
 }SysToolError;
 
 QString WcharArrayToQString(wchar_t* pwszParam);
+int SafeDelete(void *pParam);
+QString GetChipsetType();
+
+#ifdef STK_WINDOWS
 QString ByteToQString(LPBYTE pbParam, DWORD dwSize);
 char* WCharArrayToCharArray(wchar_t* pwszParam);
 wchar_t* CharArrayToWcharArray(char* pszParam);
-int SafeDelete(void *pParam);
 bool WIN32_FROM_HRESULT(HRESULT hr, OUT DWORD *pdwWin32);
 QIcon GetIconFromHICON(QString qzFileName);
-QString GetChipsetType();
+#endif
 
 #endif // UTILS_H
@@ -0,0 +1,172 @@
+#include "../headers/self_profile.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <mutex>
+#include <new>
+
+#ifdef STK_WINDOWS
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+std::atomic<bool> g_bSelfProfileEnabled(false);
+STK_THREAD_LOCAL unsigned long long g_ullSelfProfileSyscalls = 0;
+STK_THREAD_LOCAL unsigned long long g_ullSelfProfileAllocations = 0;
+
+static std::mutex g_ProfileMutex;
+static ProfileCounters g_pCurrent[ProfileModuleCount];
+static ProfileCounters g_pLastTick[ProfileModuleCount];
+static ProfileCounters g_pTotals[ProfileModuleCount];
+static unsigned long long g_ullTicks = 0;
+
+#ifdef STK_SELF_PROFILE
+// Counts every allocation of the executable. Both operators go to the CRT
+// heap like the default ones, memory may be freed by a Qt DLL.
+void *operator new(size_t uSize)
+{
+    g_ullSelfProfileAllocations++;
+
+    void *pMemory = malloc(uSize ? uSize : 1);
+    if( !pMemory )
+        throw std::bad_alloc();
+
+    return pMemory;
+}
+
+void operator delete(void *pMemory) throw()
+{
+    free(pMemory);
+}
+#endif
+
+static unsigned long long GetWallTime()
+{
+#ifdef STK_WINDOWS
+    static LARGE_INTEGER Frequency = { 0 };
+    LARGE_INTEGER Counter;
+
+    if( 0 == Frequency.QuadPart )
+        QueryPerformanceFrequency(&Frequency);
+    QueryPerformanceCounter(&Counter);
+
+    return (Counter.QuadPart / Frequency.QuadPart) * 1000000ULL +
+           (Counter.QuadPart % Frequency.QuadPart) * 1000000ULL / Frequency.QuadPart;
+#else
+    struct timespec Time;
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+
+    return (unsigned long long)Time.tv_sec * 1000000ULL + Time.tv_nsec / 1000;
+#endif
+}
+
+static unsigned long long GetThreadCpuTime()
+{
+#ifdef STK_WINDOWS
+    FILETIME Creation, Exit, Kernel, User;
+
+    if( !GetThreadTimes(GetCurrentThread(), &Creation, &Exit, &Kernel, &User) )
+        return 0;
+
+    // 100 ns units
+    return ((((unsigned long long)Kernel.dwHighDateTime << 32) | Kernel.dwLowDateTime) +
+            (((unsigned long long)User.dwHighDateTime << 32) | User.dwLowDateTime)) / 10;
+#else
+    struct timespec Time;
+    if( 0 != clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Time) )
+        return 0;
+
+    return (unsigned long long)Time.tv_sec * 1000000ULL + Time.tv_nsec / 1000;
+#endif
+}
+
+static void AddCounters(ProfileCounters *pTo, const ProfileCounters *pFrom)
+{
+    pTo->ullCalls += pFrom->ullCalls;
+    pTo->ullWallTime += pFrom->ullWallTime;
+    pTo->ullCpuTime += pFrom->ullCpuTime;
+    pTo->ullSyscalls += pFrom->ullSyscalls;
+    pTo->ullAllocations += pFrom->ullAllocations;
+}
+
+void CSelfProfileScope::Begin()
+{
+    m_ullSyscalls = g_ullSelfProfileSyscalls;
+    m_ullAllocations = g_ullSelfProfileAllocations;
+    m_ullCpuTime = GetThreadCpuTime();
+    m_ullWallTime = GetWallTime();
+}
+
+void CSelfProfileScope::End()
+{
+    ProfileCounters Counters;
+
+    Counters.ullWallTime = GetWallTime() - m_ullWallTime;
+    Counters.ullCpuTime = GetThreadCpuTime() - m_ullCpuTime;
+    Counters.ullSyscalls = g_ullSelfProfileSyscalls - m_ullSyscalls;
+    Counters.ullAllocations = g_ullSelfProfileAllocations - m_ullAllocations;
+    Counters.ullCalls = 1;
+
+    CSelfProfile::Record(m_Module, &Counters);
+}
+
+void CSelfProfile::Enable(bool bEnable)
+{
+    std::lock_guard<std::mutex> Lock(g_ProfileMutex);
+
+    // Totals start over with every enabling
+    if( bEnable && !g_bSelfProfileEnabled.load() )
+    {
+        memset(g_pCurrent, 0, sizeof(g_pCurrent));
+        memset(g_pLastTick, 0, sizeof(g_pLastTick));
+        memset(g_pTotals, 0, sizeof(g_pTotals));
+        g_ullTicks = 0;
+    }
+
+    g_bSelfProfileEnabled.store(bEnable);
+}
+
+bool CSelfProfile::IsEnabled()
+{
+    return g_bSelfProfileEnabled.load(std::memory_order_relaxed);
+}
+
+void CSelfProfile::Record(ProfileModule Module, const ProfileCounters *pCounters)
+{
+    std::lock_guard<std::mutex> Lock(g_ProfileMutex);
+
+    AddCounters(&g_pCurrent[Module], pCounters);
+}
+
+void CSelfProfile::EndTick()
+{
+    if( !IsEnabled() )
+        return;
+
+    std::lock_guard<std::mutex> Lock(g_ProfileMutex);
+
+    for(int i = 0; i < ProfileModuleCount; i++)
+        AddCounters(&g_pTotals[i], &g_pCurrent[i]);
+
+    memcpy(g_pLastTick, g_pCurrent, sizeof(g_pLastTick));
+    memset(g_pCurrent, 0, sizeof(g_pCurrent));
+    g_ullTicks++;
+}
+
+unsigned long long CSelfProfile::GetLastTick(ProfileCounters *pCounters)
+{
+    std::lock_guard<std::mutex> Lock(g_ProfileMutex);
+
+    memcpy(pCounters, g_pLastTick, sizeof(g_pLastTick));
+    return g_ullTicks;
+}
+
+unsigned long long CSelfProfile::GetTotals(ProfileCounters *pCounters)
+{
+    std::lock_guard<std::mutex> Lock(g_ProfileMutex);
+
+    memcpy(pCounters, g_pTotals, sizeof(g_pTotals));
+    return g_ullTicks;
+}
@@ -1,5 +1,9 @@
 #include "../headers/utils.h"
 
+#ifndef STK_WINDOWS
+#include <cpuid.h>
+#endif
+
 ///
 /// \brief Convert wchar_t array parameter into QString
 /// \param pwszParam - wchar_t array
@@ -15,6 +19,7 @@ QString WcharArrayToQString(wchar_t* pwszParam)
     return returnValue;
 }
 
+#ifdef STK_WINDOWS
 ///
 /// \brief Convert wchar_t array to chat array
 /// \param pwszParam - wchat_t array
@@ -67,6 +72,8 @@ wchar_t* CharArrayToWcharArray(char* pszParam)
     return returnValue;
 }
 
+#endif
+
 ///
 /// \brief Safe delete any piece of memory
 /// \param pParam - void*
@@ -83,6 +90,7 @@ int SafeDelete(void *pParam)
     return Success;
 }
 
+#ifdef STK_WINDOWS
 ///
 /// \brief Convert byte array to QString
 /// \param pbParam - byte array
@@ -154,6 +162,7 @@ QIcon GetIconFromHICON(QString qzFileName)
         return qRetIcon;
 }
 
+#endif
 
 QString GetChipsetType()
 {
@@ -161,7 +170,11 @@ QString GetChipsetType()
     std::string RegisterString;
 
     // getting manufacturer
+#ifdef STK_WINDOWS
     __cpuid(CPUInfo, 0);
+#else
+    __cpuid(0, CPUInfo[0], CPUInfo[1], CPUInfo[2], CPUInfo[3]);
+#endif
     RegisterString += std::string((char*)&CPUInfo[1], 4);
     RegisterString += std::string((char*)&CPUInfo[3], 4);
     RegisterString += std::string((char*)&CPUInfo[2], 4);
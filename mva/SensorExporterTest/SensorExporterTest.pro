@@ -0,0 +1,35 @@
+QT       += core network testlib
+QT       -= gui
+win32:QT += winextras
+
+CONFIG   += console c++11 testcase
+CONFIG   -= app_bundle
+
+include(../Licenta/others/project-configuration/project-defines.pri)
+
+TARGET = SensorExporterTest
+TEMPLATE = app
+
+win32 {
+DEFINES += NOMINMAX
+DEFINES += STK_WINDOWS
+LIBS += -lws2_32
+}
+
+unix:!macx {
+DEFINES += STK_LINUX
+LIBS += -lpthread
+}
+
+Release:DESTDIR = $$PWD/../build
+Release:OBJECTS_DIR = $$PWD/../build/.obj/sensor-exporter-test
+
+Debug:DESTDIR = $$PWD/../build
+Debug:OBJECTS_DIR = $$PWD/../build/.obj/sensor-exporter-test
+
+SOURCES += tst_sensor_exporter.cpp \
+        ../Licenta/modules/computer/sensors/sources/sensor_samples.cpp \
+        ../Licenta/modules/computer/sensors/sources/sensor_exporter.cpp
+
+HEADERS += ../Licenta/modules/computer/sensors/headers/sensor_samples.h \
+        ../Licenta/modules/computer/sensors/headers/sensor_exporter.h
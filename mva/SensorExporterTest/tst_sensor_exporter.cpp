@@ -0,0 +1,138 @@
+#include <QElapsedTimer>
+#include <QTcpSocket>
+#include <QtTest>
+
+#include "../Licenta/modules/computer/sensors/headers/sensor_exporter.h"
+#include "../Licenta/utils/headers/utils.h"
+
+#define TEST_WAIT       5000        // ms, longer than SENSOR_EXPORTER_TIMEOUT
+
+// Scrapes the exporter over loopback the way a Prometheus server does
+class CSensorExporterTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    CSensorSamples      m_Samples;
+    CSensorExporter     m_Exporter;
+
+    QByteArray Request(const QByteArray &qRequest);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void Exposition();
+    void UnknownPath();
+    void SlowClient();
+};
+
+QByteArray CSensorExporterTest::Request(const QByteArray &qRequest)
+{
+    QTcpSocket Socket;
+    QByteArray qResponse;
+
+    Socket.connectToHost("127.0.0.1", m_Exporter.GetPort());
+    if( !Socket.waitForConnected(TEST_WAIT) )
+        return qResponse;
+
+    Socket.write(qRequest);
+    Socket.waitForBytesWritten(TEST_WAIT);
+
+    // Connection: close, the response ends with the connection
+    while( Socket.state() == QAbstractSocket::ConnectedState && Socket.waitForReadyRead(TEST_WAIT) )
+        qResponse += Socket.readAll();
+    qResponse += Socket.readAll();
+
+    return qResponse;
+}
+
+void CSensorExporterTest::initTestCase()
+{
+    int nTemperature = m_Samples.Register(SensorGroupCpu, SensorKindTemperature, SensorUnitCelsius, "Core #0: ");
+    int nThrottle = m_Samples.Register(SensorGroupCpu, SensorKindThrottle, SensorUnitNone, "Thermal: ", 1);
+    int nNumaFree = m_Samples.Register(SensorGroupMemory, SensorKindNuma, SensorUnitBytes, "Free: ", 0);
+    int nNumaHit = m_Samples.Register(SensorGroupMemory, SensorKindNuma, SensorUnitPages, "Hit: ", 0);
+
+    m_Samples.BeginUpdate();
+    m_Samples.Set(nTemperature, 45, SensorTimestamp());
+    m_Samples.Set(nThrottle, 3, SensorTimestamp());
+    m_Samples.Set(nNumaFree, 4096, SensorTimestamp());
+    m_Samples.Set(nNumaHit, 1500, SensorTimestamp());
+
+    QCOMPARE(m_Exporter.Bind(&m_Samples), (int)Success);
+    m_Exporter.SetGauge("stk_gpu_temperature_celsius", "gpu=\"0\"", 60.5);
+    m_Exporter.SetCounter("stk_profile_calls_total", "module=\"tick\"", 12);
+    QCOMPARE(m_Exporter.Render(), (int)Success);
+
+    QCOMPARE(m_Exporter.Start("127.0.0.1", 0), (int)Success);
+    QVERIFY(0 != m_Exporter.GetPort());
+}
+
+void CSensorExporterTest::cleanupTestCase()
+{
+    m_Exporter.Stop();
+}
+
+void CSensorExporterTest::Exposition()
+{
+    QByteArray qResponse = Request("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+
+    int nBody = qResponse.indexOf("\r\n\r\n");
+    QVERIFY(0 < nBody);
+    QVERIFY(qResponse.startsWith("HTTP/1.1 200 OK\r\n"));
+    QVERIFY(qResponse.contains("Content-Type: " SENSOR_EXPORTER_CONTENT_TYPE "\r\n"));
+
+    QByteArray qBody = qResponse.mid(nBody + 4);
+    QVERIFY(qResponse.contains(QByteArray("Content-Length: ") + QByteArray::number(qBody.size()) + "\r\n"));
+    QCOMPARE(qBody, QByteArray("# TYPE stk_temperature_celsius gauge\n"
+                               "stk_temperature_celsius{group=\"cpu\",sensor=\"Core #0\"} 45\n"
+                               "# TYPE stk_throttle_events_total counter\n"
+                               "stk_throttle_events_total{group=\"cpu\",sensor=\"Thermal\",cpu=\"1\"} 3\n"
+                               "# TYPE stk_numa_bytes gauge\n"
+                               "stk_numa_bytes{group=\"memory\",sensor=\"Free\",node=\"0\"} 4096\n"
+                               "# TYPE stk_numa_pages_total counter\n"
+                               "stk_numa_pages_total{group=\"memory\",sensor=\"Hit\",node=\"0\"} 1500\n"
+                               "# TYPE stk_gpu_temperature_celsius gauge\n"
+                               "stk_gpu_temperature_celsius{gpu=\"0\"} 60.5\n"
+                               "# TYPE stk_profile_calls_total counter\n"
+                               "stk_profile_calls_total{module=\"tick\"} 12\n"));
+}
+
+void CSensorExporterTest::UnknownPath()
+{
+    QByteArray qResponse = Request("GET / HTTP/1.1\r\n\r\n");
+
+    QVERIFY(qResponse.startsWith("HTTP/1.1 404 Not Found\r\n"));
+}
+
+void CSensorExporterTest::SlowClient()
+{
+    QList<QTcpSocket*> qIdle;
+    QElapsedTimer Timer;
+
+    // Connected clients that never send their request must not hold up
+    // the scrapes behind them
+    for(int i = 0; i < 8; i++)
+    {
+        QTcpSocket *pSocket = new QTcpSocket;
+        pSocket->connectToHost("127.0.0.1", m_Exporter.GetPort());
+        QVERIFY(pSocket->waitForConnected(TEST_WAIT));
+        pSocket->write("GET /metr");
+        pSocket->waitForBytesWritten(TEST_WAIT);
+        qIdle.append(pSocket);
+    }
+
+    Timer.start();
+    QByteArray qResponse = Request("GET /metrics HTTP/1.1\r\n\r\n");
+    qint64 nElapsed = Timer.elapsed();
+
+    qDeleteAll(qIdle);
+
+    QVERIFY(qResponse.startsWith("HTTP/1.1 200 OK\r\n"));
+    QVERIFY(nElapsed < SENSOR_EXPORTER_TIMEOUT / 2);
+}
+
+QTEST_GUILESS_MAIN(CSensorExporterTest)
+
+#include "tst_sensor_exporter.moc"
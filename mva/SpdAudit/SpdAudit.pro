@@ -0,0 +1,33 @@
+QT       -= core gui
+
+CONFIG   += console c++11
+CONFIG   -= app_bundle qt
+
+include(../Licenta/others/project-configuration/project-defines.pri)
+
+TARGET = SpdAudit
+TEMPLATE = app
+
+win32 {
+DEFINES += NOMINMAX
+DEFINES += STK_WINDOWS
+}
+
+unix:!macx {
+DEFINES += STK_LINUX
+QMAKE_CXXFLAGS_RELEASE += -O2
+LIBS += -lpthread
+}
+
+Release:DESTDIR = $$PWD/../build
+Release:OBJECTS_DIR = $$PWD/../build/.obj/spd-audit
+
+Debug:DESTDIR = $$PWD/../build
+Debug:OBJECTS_DIR = $$PWD/../build/.obj/spd-audit
+
+SOURCES += main.cpp \
+        spd_audit.cpp \
+        ../Licenta/modules/motherboard/memory/spd_timings.cpp
+
+HEADERS += spd_audit.h \
+        ../Licenta/modules/motherboard/memory/spd_timings.h
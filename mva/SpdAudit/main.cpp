@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef STK_WINDOWS
+#include <Windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "spd_audit.h"
+
+#define SPD_AUDIT_CHUNK_SIZE                        64
+#define SPD_AUDIT_OUTPUT_BUFFER_SIZE                (256 * 1024)
+#define SPD_AUDIT_MAX_READ_SIZE                     512
+
+// All paths live in one arena, records and workers only keep offsets
+typedef struct _SPD_AUDIT_FILES_
+{
+    std::vector<char> qPaths;
+    std::vector<size_t> qOffsets;
+}SpdAuditFiles;
+
+static void AddFile(SpdAuditFiles *pFiles, const char *pszDirectory, const char *pszName)
+{
+    size_t nDirectory = strlen(pszDirectory);
+    size_t nName = strlen(pszName);
+
+    pFiles->qOffsets.push_back(pFiles->qPaths.size());
+    pFiles->qPaths.insert(pFiles->qPaths.end(), pszDirectory, pszDirectory + nDirectory);
+    pFiles->qPaths.push_back('/');
+    pFiles->qPaths.insert(pFiles->qPaths.end(), pszName, pszName + nName + 1);
+}
+
+#ifdef STK_WINDOWS
+static void CollectFiles(const char *pszDirectory, SpdAuditFiles *pFiles)
+{
+    WIN32_FIND_DATAA FindData;
+    char szPattern[MAX_PATH];
+
+    _snprintf_s(szPattern, sizeof(szPattern), _TRUNCATE, "%s\\*", pszDirectory);
+    HANDLE hFind = FindFirstFileA(szPattern, &FindData);
+    if( INVALID_HANDLE_VALUE == hFind )
+        return;
+
+    do
+    {
+        if( 0 == strcmp(FindData.cFileName, ".") || 0 == strcmp(FindData.cFileName, "..") )
+            continue;
+
+        if( FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY )
+        {
+            char szChild[MAX_PATH];
+            _snprintf_s(szChild, sizeof(szChild), _TRUNCATE, "%s\\%s", pszDirectory, FindData.cFileName);
+            CollectFiles(szChild, pFiles);
+        }
+        else
+            AddFile(pFiles, pszDirectory, FindData.cFileName);
+    }while( FindNextFileA(hFind, &FindData) );
+
+    FindClose(hFind);
+}
+
+static int ReadImage(const char *pszPath, unsigned char *pbBuffer, int nSize)
+{
+    HANDLE hFile = CreateFileA(pszPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if( INVALID_HANDLE_VALUE == hFile )
+        return -1;
+
+    DWORD dwRead = 0;
+    BOOL bRet = ReadFile(hFile, pbBuffer, nSize, &dwRead, NULL);
+    CloseHandle(hFile);
+
+    return bRet ? (int)dwRead : -1;
+}
+#else
+static void CollectFiles(const char *pszDirectory, SpdAuditFiles *pFiles)
+{
+    DIR *pDir = opendir(pszDirectory);
+    if( !pDir )
+        return;
+
+    struct dirent *pEntry = 0;
+    while( 0 != (pEntry = readdir(pDir)) )
+    {
+        if( 0 == strcmp(pEntry->d_name, ".") || 0 == strcmp(pEntry->d_name, "..") )
+            continue;
+
+        char szChild[4096];
+        snprintf(szChild, sizeof(szChild), "%s/%s", pszDirectory, pEntry->d_name);
+
+        bool bDirectory = DT_DIR == pEntry->d_type;
+        if( DT_UNKNOWN == pEntry->d_type )
+        {
+            struct stat Stat;
+            bDirectory = 0 == stat(szChild, &Stat) && S_ISDIR(Stat.st_mode);
+        }
+
+        if( bDirectory )
+            CollectFiles(szChild, pFiles);
+        else if( DT_REG == pEntry->d_type || DT_UNKNOWN == pEntry->d_type )
+            AddFile(pFiles, pszDirectory, pEntry->d_name);
+    }
+
+    closedir(pDir);
+}
+
+static int ReadImage(const char *pszPath, unsigned char *pbBuffer, int nSize)
+{
+    int nFile = open(pszPath, O_RDONLY);
+    if( 0 > nFile )
+        return -1;
+
+    ssize_t nRead = read(nFile, pbBuffer, nSize);
+    close(nFile);
+
+    return (int)nRead;
+}
+#endif
+
+static void AuditWorker(const SpdAuditFiles *pFiles, SpdAuditRecord *pRecords, std::atomic<size_t> *pNext)
+{
+    unsigned char pbImage[SPD_AUDIT_MAX_READ_SIZE];
+    size_t nCount = pFiles->qOffsets.size();
+
+    for( ;; )
+    {
+        size_t nStart = pNext->fetch_add(SPD_AUDIT_CHUNK_SIZE);
+        if( nStart >= nCount )
+            break;
+
+        size_t nEnd = nStart + SPD_AUDIT_CHUNK_SIZE < nCount ? nStart + SPD_AUDIT_CHUNK_SIZE : nCount;
+        for( size_t i = nStart; i < nEnd; i++ )
+        {
+            int nRead = ReadImage(&pFiles->qPaths[pFiles->qOffsets[i]], pbImage, sizeof(pbImage));
+            SpdAuditImage(pbImage, nRead, &pRecords[i]);
+        }
+    }
+}
+
+static void FlushOutput(FILE *pOutput, char *pszBuffer, size_t *pnUsed)
+{
+    fwrite(pszBuffer, 1, *pnUsed, pOutput);
+    *pnUsed = 0;
+}
+
+static void WriteCSV(FILE *pOutput, const SpdAuditFiles *pFiles, const std::vector<SpdAuditRecord> &qRecords)
+{
+    std::vector<char> qBuffer(SPD_AUDIT_OUTPUT_BUFFER_SIZE);
+    char *pszBuffer = qBuffer.data();
+    size_t nUsed = 0;
+
+    nUsed += snprintf(pszBuffer, qBuffer.size(), "file,flags,type,size_mb,jedec_bank,jedec_id,serial,year,week,part_number,"
+                      "crc_stored,crc_computed,jedec_mhz,cl,rcd,rp,ras,xmp_profiles,xmp_mhz,xmp_mv\n");
+
+    for( size_t i = 0; i < qRecords.size(); i++ )
+    {
+        // A row never exceeds a path with every character doubled, a part
+        // number and ~200 bytes of numbers
+        const char *pszPath = &pFiles->qPaths[pFiles->qOffsets[i]];
+        if( qBuffer.size() - nUsed < 2 * strlen(pszPath) + 512 )
+            FlushOutput(pOutput, pszBuffer, &nUsed);
+
+        const SpdAuditRecord *pRecord = &qRecords[i];
+        nUsed += SpdCSVField(pszBuffer + nUsed, qBuffer.size() - nUsed, pszPath);
+        nUsed += snprintf(pszBuffer + nUsed, qBuffer.size() - nUsed, ",0x%04X,%d,%d,%d,%d,%08X,%d,%d,",
+                          pRecord->uFlags, pRecord->nDeviceType, pRecord->nSizeMB, pRecord->bManufacturerBank + 1,
+                          pRecord->bManufacturerID, pRecord->uSerial, pRecord->nYear, pRecord->nWeek);
+        nUsed += SpdCSVField(pszBuffer + nUsed, qBuffer.size() - nUsed, pRecord->szPartNumber);
+        nUsed += snprintf(pszBuffer + nUsed, qBuffer.size() - nUsed, ",%04X,%04X,%d,%d,%d,%d,%d,%d,%d,%d\n",
+                          pRecord->usStoredCRC, pRecord->usComputedCRC, pRecord->nJedecFrequency,
+                          pRecord->nJedecCL, pRecord->nJedecRCD, pRecord->nJedecRP, pRecord->nJedecRAS,
+                          pRecord->nXMPProfiles, pRecord->nXMPFrequency, pRecord->nXMPVoltage);
+    }
+
+    FlushOutput(pOutput, pszBuffer, &nUsed);
+}
+
+static void PrintUsage(const char *pszName)
+{
+    fprintf(stderr, "Usage: %s <spd dump directory> [output.csv] [-j threads]\n", pszName);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pszDirectory = 0;
+    const char *pszOutput = 0;
+    unsigned int uThreads = std::thread::hardware_concurrency();
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( 0 == strcmp(argv[i], "-j") && i + 1 < argc )
+            uThreads = (unsigned int)atoi(argv[++i]);
+        else if( !pszDirectory )
+            pszDirectory = argv[i];
+        else if( !pszOutput )
+            pszOutput = argv[i];
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if( !pszDirectory )
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if( 0 == uThreads )
+        uThreads = 1;
+
+    SpdAuditFiles Files;
+    CollectFiles(pszDirectory, &Files);
+
+    std::vector<SpdAuditRecord> qRecords(Files.qOffsets.size());
+    std::atomic<size_t> nNext(0);
+    std::vector<std::thread> qWorkers;
+
+    for( unsigned int i = 0; i < uThreads; i++ )
+        qWorkers.push_back(std::thread(AuditWorker, &Files, qRecords.data(), &nNext));
+    for( size_t i = 0; i < qWorkers.size(); i++ )
+        qWorkers[i].join();
+
+    std::vector<unsigned int> qOrder;
+    SpdAuditCrossCheck(qRecords, qOrder);
+
+    FILE *pOutput = pszOutput ? fopen(pszOutput, "wb") : stdout;
+    if( !pOutput )
+    {
+        fprintf(stderr, "Cannot open %s\n", pszOutput);
+        return 1;
+    }
+
+    WriteCSV(pOutput, &Files, qRecords);
+
+    if( pOutput != stdout )
+        fclose(pOutput);
+
+    size_t nFlagged = 0;
+    for( size_t i = 0; i < qRecords.size(); i++ )
+    {
+        if( qRecords[i].uFlags )
+            nFlagged++;
+    }
+    fprintf(stderr, "%u images audited, %u flagged\n", (unsigned int)qRecords.size(), (unsigned int)nFlagged);
+
+    return 0;
+}
@@ -0,0 +1,322 @@
+#include "spd_audit.h"
+
+#include <string.h>
+#include <algorithm>
+
+static bool HasOddParity(unsigned char bValue)
+{
+    int nBits = 0;
+    for( int i = 0; i < 8; i++ )
+        nBits += (bValue >> i) & 0x1;
+
+    return 1 == (nBits & 0x1);
+}
+
+static bool IsValidBCD(unsigned char bValue)
+{
+    return ((bValue >> 4) & 0xF) <= 9 && (bValue & 0xF) <= 9;
+}
+
+static int BCDToInt(unsigned char bValue)
+{
+    return ((bValue >> 4) & 0xF) * 10 + (bValue & 0xF);
+}
+
+unsigned short SpdCRC16(const unsigned char *pbArray, int nCount)
+{
+    unsigned int uCRC = 0;
+
+    for( int i = 0; i < nCount; i++ )
+    {
+        uCRC ^= (unsigned int)pbArray[i] << 8;
+        for( int j = 0; j < 8; j++ )
+        {
+            if( uCRC & 0x8000 )
+                uCRC = (uCRC << 1) ^ 0x1021;
+            else
+                uCRC <<= 1;
+        }
+    }
+
+    return (unsigned short)(uCRC & 0xFFFF);
+}
+
+static void PutChar(char *pszOutput, size_t nSize, size_t *pnLength, char cChar)
+{
+    if( *pnLength + 1 < nSize )
+        pszOutput[*pnLength] = cChar;
+    (*pnLength)++;
+}
+
+int SpdCSVField(char *pszOutput, size_t nSize, const char *pszField)
+{
+    size_t nLength = 0;
+
+    PutChar(pszOutput, nSize, &nLength, '"');
+    for( const char *pszChar = pszField; *pszChar; pszChar++ )
+    {
+        if( '"' == *pszChar )
+            PutChar(pszOutput, nSize, &nLength, '"');
+        PutChar(pszOutput, nSize, &nLength, *pszChar);
+    }
+    PutChar(pszOutput, nSize, &nLength, '"');
+
+    if( 0 < nSize )
+        pszOutput[nLength < nSize ? nLength : nSize - 1] = 0;
+
+    return (int)nLength;
+}
+
+static void CopyPartNumber(const unsigned char *pbArray, int nOffset, SpdAuditRecord *pRecord)
+{
+    int nLength = 0;
+
+    for( int i = 0; i < SPD_AUDIT_PART_NUMBER_SIZE; i++ )
+    {
+        unsigned char bChar = pbArray[nOffset + i];
+
+        // Unused characters are space or 0x00/0xFF padded
+        if( 0x00 == bChar || 0xFF == bChar )
+            bChar = ' ';
+        if( bChar < 0x20 || bChar > 0x7E )
+        {
+            pRecord->uFlags |= SPD_AUDIT_BAD_PART_NUMBER;
+            bChar = '?';
+        }
+
+        pRecord->szPartNumber[i] = bChar;
+        if( ' ' != bChar )
+            nLength = i + 1;
+    }
+    pRecord->szPartNumber[nLength] = 0;
+
+    if( 0 == nLength )
+        pRecord->uFlags |= SPD_AUDIT_BAD_PART_NUMBER;
+}
+
+static void AuditTimings(const unsigned char *pbArray, SpdAuditRecord *pRecord)
+{
+    SpdModuleTimings Timings;
+
+    if( SPD_AUDIT_TYPE_DDR3 == pRecord->nDeviceType )
+        SpdDecodeDDR3Timings(pbArray, &Timings);
+    else
+        SpdDecodeDDR2Timings(pbArray, &Timings);
+
+    if( 0 == Timings.nProfiles || 0 == Timings.Profiles[0].nClockEntries )
+    {
+        pRecord->uFlags |= SPD_AUDIT_BAD_TIMINGS;
+        return;
+    }
+
+    const SpdProfile *pJedec = &Timings.Profiles[0];
+    const SpdClockEntry *pFastest = &pJedec->ClockEntries[0];
+    for( int i = 1; i < pJedec->nClockEntries; i++ )
+    {
+        if( pJedec->ClockEntries[i].nFrequency > pFastest->nFrequency )
+            pFastest = &pJedec->ClockEntries[i];
+    }
+
+    pRecord->nJedecFrequency = pFastest->nFrequency;
+    pRecord->nJedecCL = pFastest->nCL;
+    pRecord->nJedecRCD = pFastest->nRCD;
+    pRecord->nJedecRP = pFastest->nRP;
+    pRecord->nJedecRAS = pFastest->nRAS;
+
+    // A module whose tRAS does not cover tRCD + CL cannot work at its own rating
+    if( pFastest->nRAS < pFastest->nRCD + pFastest->nCL - 1 )
+        pRecord->uFlags |= SPD_AUDIT_BAD_TIMINGS;
+
+    pRecord->nXMPProfiles = Timings.nProfiles - 1;
+    if( 0 < pRecord->nXMPProfiles )
+    {
+        const SpdProfile *pXMP = &Timings.Profiles[1];
+        for( int i = 0; i < pXMP->nClockEntries; i++ )
+        {
+            if( pXMP->ClockEntries[i].nFrequency > pRecord->nXMPFrequency )
+                pRecord->nXMPFrequency = pXMP->ClockEntries[i].nFrequency;
+        }
+        pRecord->nXMPVoltage = pXMP->Timings.nVoltage;
+    }
+}
+
+static void AuditDDR3Image(const unsigned char *pbArray, SpdAuditRecord *pRecord)
+{
+    // CRC - BYTE 126, 127, coverage BYTE 0 bit 7 (0~116 or 0~125)
+    int nCoverage = (pbArray[0] & 0x80) ? 117 : 126;
+    pRecord->usStoredCRC = (unsigned short)(pbArray[126] | (pbArray[127] << 8));
+    pRecord->usComputedCRC = SpdCRC16(pbArray, nCoverage);
+    if( pRecord->usStoredCRC != pRecord->usComputedCRC )
+        pRecord->uFlags |= SPD_AUDIT_CRC_MISMATCH;
+
+    // Size - BYTE 4, 7, 8
+    static const int pCapacity[8] = { 256, 512, 1024, 2048, 4096, 8192, 16384, 32768 };
+    int nCapacityCode = pbArray[4] & 0xF;
+    int nBusWidth = 8 << (pbArray[8] & 0x7);
+    int nDeviceWidth = 4 << (pbArray[7] & 0x7);
+    int nRanks = ((pbArray[7] >> 3) & 0x7) + 1;
+    if( nCapacityCode > 7 || (pbArray[8] & 0x7) > 3 || (pbArray[7] & 0x7) > 3 )
+        pRecord->uFlags |= SPD_AUDIT_BAD_SIZE;
+    else
+        pRecord->nSizeMB = pCapacity[nCapacityCode] / 8 * nBusWidth / nDeviceWidth * nRanks;
+
+    // Module manufacturer - BYTE 117, 118
+    if( !HasOddParity(pbArray[117]) || !HasOddParity(pbArray[118]) )
+        pRecord->uFlags |= SPD_AUDIT_BAD_JEDEC_PARITY;
+    pRecord->bManufacturerBank = pbArray[117] & 0x7F;
+    pRecord->bManufacturerID = pbArray[118] & 0x7F;
+
+    // Manufacturing date - BYTE 120, 121 (BCD)
+    if( !IsValidBCD(pbArray[120]) || !IsValidBCD(pbArray[121]) )
+        pRecord->uFlags |= SPD_AUDIT_BAD_DATE;
+    pRecord->nYear = 2000 + BCDToInt(pbArray[120]);
+    pRecord->nWeek = BCDToInt(pbArray[121]);
+    if( 1 > pRecord->nWeek || 53 < pRecord->nWeek )
+        pRecord->uFlags |= SPD_AUDIT_BAD_DATE;
+
+    // Serial number - BYTE 122~125
+    pRecord->uSerial = ((unsigned int)pbArray[122] << 24) | (pbArray[123] << 16) | (pbArray[124] << 8) | pbArray[125];
+
+    // Part number - BYTE 128~145
+    CopyPartNumber(pbArray, 128, pRecord);
+}
+
+static void AuditDDR2Image(const unsigned char *pbArray, SpdAuditRecord *pRecord)
+{
+    // Checksum - BYTE 63, sum of BYTE 0~62
+    unsigned char bSum = 0;
+    for( int i = 0; i < 63; i++ )
+        bSum += pbArray[i];
+    pRecord->usStoredCRC = pbArray[63];
+    pRecord->usComputedCRC = bSum;
+    if( pRecord->usStoredCRC != pRecord->usComputedCRC )
+        pRecord->uFlags |= SPD_AUDIT_CRC_MISMATCH;
+
+    // Size - BYTE 31 rank density, BYTE 5 ranks. A rank is 64 data bits
+    // wide whatever the device width, BYTE 3, 4, 17 addressing must agree.
+    static const int pDensity[8] = { 1024, 2048, 4096, 8192, 16384, 128, 256, 512 };
+    int nRankMB = 0;
+    for( int i = 0; i < 8; i++ )
+    {
+        if( (pbArray[31] >> i) & 0x1 )
+            nRankMB = nRankMB ? -1 : pDensity[i];
+    }
+    unsigned long long ullRank = (1ULL << (pbArray[3] & 0x1F)) * (1ULL << (pbArray[4] & 0x0F)) * pbArray[17] * 8;
+    if( 0 >= nRankMB || ullRank / (1024 * 1024) != (unsigned long long)nRankMB )
+        pRecord->uFlags |= SPD_AUDIT_BAD_SIZE;
+    else
+        pRecord->nSizeMB = nRankMB * ((pbArray[5] & 0x07) + 1);
+
+    // Module manufacturer - BYTE 64~71, 0x7F continuation codes
+    int nBank = 0;
+    for( nBank = 0; nBank < 7; nBank++ )
+    {
+        if( 0x7F != pbArray[64 + nBank] )
+            break;
+    }
+    if( !HasOddParity(pbArray[64 + nBank]) )
+        pRecord->uFlags |= SPD_AUDIT_BAD_JEDEC_PARITY;
+    pRecord->bManufacturerBank = (unsigned char)nBank;
+    pRecord->bManufacturerID = pbArray[64 + nBank] & 0x7F;
+
+    // Manufacturing date - BYTE 93, 94
+    if( !IsValidBCD(pbArray[93]) || !IsValidBCD(pbArray[94]) )
+        pRecord->uFlags |= SPD_AUDIT_BAD_DATE;
+    pRecord->nYear = 2000 + BCDToInt(pbArray[93]);
+    pRecord->nWeek = BCDToInt(pbArray[94]);
+    if( 1 > pRecord->nWeek || 53 < pRecord->nWeek )
+        pRecord->uFlags |= SPD_AUDIT_BAD_DATE;
+
+    // Serial number - BYTE 95~98
+    pRecord->uSerial = ((unsigned int)pbArray[95] << 24) | (pbArray[96] << 16) | (pbArray[97] << 8) | pbArray[98];
+
+    // Part number - BYTE 73~90
+    CopyPartNumber(pbArray, 73, pRecord);
+}
+
+void SpdAuditImage(const unsigned char *pbArray, int nSize, SpdAuditRecord *pRecord)
+{
+    memset(pRecord, 0, sizeof(SpdAuditRecord));
+
+    // DDR2 images are 128 bytes when the EEPROM upper half was not dumped
+    if( SPD_AUDIT_DDR2_IMAGE_SIZE > nSize )
+    {
+        pRecord->uFlags |= SPD_AUDIT_READ_ERROR;
+        return;
+    }
+
+    pRecord->nDeviceType = pbArray[2];
+    if( SPD_AUDIT_TYPE_DDR3 == pRecord->nDeviceType && SPD_AUDIT_DDR3_IMAGE_SIZE > nSize )
+    {
+        pRecord->uFlags |= SPD_AUDIT_READ_ERROR;
+        return;
+    }
+
+    if( SPD_AUDIT_TYPE_DDR3 == pRecord->nDeviceType )
+        AuditDDR3Image(pbArray, pRecord);
+    else if( SPD_AUDIT_TYPE_DDR2 == pRecord->nDeviceType )
+        AuditDDR2Image(pbArray, pRecord);
+    else
+    {
+        pRecord->uFlags |= SPD_AUDIT_UNKNOWN_TYPE;
+        return;
+    }
+
+    if( 0 == pRecord->uSerial || 0xFFFFFFFF == pRecord->uSerial )
+        pRecord->uFlags |= SPD_AUDIT_BLANK_SERIAL;
+
+    AuditTimings(pbArray, pRecord);
+}
+
+void SpdAuditCrossCheck(std::vector<SpdAuditRecord> &qRecords, std::vector<unsigned int> &qOrder)
+{
+    qOrder.resize(qRecords.size());
+    for( size_t i = 0; i < qOrder.size(); i++ )
+        qOrder[i] = (unsigned int)i;
+
+    const unsigned int uSkipFlags = SPD_AUDIT_READ_ERROR | SPD_AUDIT_UNKNOWN_TYPE | SPD_AUDIT_BLANK_SERIAL;
+    const SpdAuditRecord *pRecords = qRecords.data();
+
+    std::sort(qOrder.begin(), qOrder.end(), [pRecords](unsigned int uLeft, unsigned int uRight)
+    {
+        const SpdAuditRecord &Left = pRecords[uLeft];
+        const SpdAuditRecord &Right = pRecords[uRight];
+
+        if( Left.bManufacturerBank != Right.bManufacturerBank )
+            return Left.bManufacturerBank < Right.bManufacturerBank;
+        if( Left.bManufacturerID != Right.bManufacturerID )
+            return Left.bManufacturerID < Right.bManufacturerID;
+        return Left.uSerial < Right.uSerial;
+    });
+
+    size_t nStart = 0;
+    while( nStart < qOrder.size() )
+    {
+        const SpdAuditRecord &First = qRecords[qOrder[nStart]];
+        size_t nEnd = nStart + 1;
+
+        while( nEnd < qOrder.size() )
+        {
+            const SpdAuditRecord &Current = qRecords[qOrder[nEnd]];
+            if( Current.bManufacturerBank != First.bManufacturerBank || Current.bManufacturerID != First.bManufacturerID ||
+                    Current.uSerial != First.uSerial )
+                break;
+            nEnd++;
+        }
+
+        if( nEnd - nStart > 1 && !(First.uFlags & uSkipFlags) )
+        {
+            bool bConflict = false;
+            for( size_t i = nStart + 1; i < nEnd; i++ )
+            {
+                if( 0 != strcmp(qRecords[qOrder[i]].szPartNumber, First.szPartNumber) )
+                    bConflict = true;
+            }
+
+            for( size_t i = nStart; i < nEnd; i++ )
+                qRecords[qOrder[i]].uFlags |= bConflict ? SPD_AUDIT_SERIAL_CONFLICT : SPD_AUDIT_DUPLICATE_SERIAL;
+        }
+
+        nStart = nEnd;
+    }
+}
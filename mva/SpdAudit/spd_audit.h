@@ -0,0 +1,66 @@
+#ifndef _SPD_AUDIT_H
+#define _SPD_AUDIT_H
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "../Licenta/modules/motherboard/memory/spd_timings.h"
+
+#define SPD_AUDIT_DDR2_IMAGE_SIZE                   128
+#define SPD_AUDIT_DDR3_IMAGE_SIZE                   256
+#define SPD_AUDIT_PART_NUMBER_SIZE                  18
+
+#define SPD_AUDIT_TYPE_DDR2                         8
+#define SPD_AUDIT_TYPE_DDR3                         11
+
+// Audit flags
+#define SPD_AUDIT_READ_ERROR                        0x0001
+#define SPD_AUDIT_UNKNOWN_TYPE                      0x0002
+#define SPD_AUDIT_CRC_MISMATCH                      0x0004
+#define SPD_AUDIT_BAD_JEDEC_PARITY                  0x0008
+#define SPD_AUDIT_BAD_DATE                          0x0010
+#define SPD_AUDIT_BLANK_SERIAL                      0x0020
+#define SPD_AUDIT_BAD_PART_NUMBER                   0x0040
+#define SPD_AUDIT_BAD_TIMINGS                       0x0080
+#define SPD_AUDIT_BAD_SIZE                          0x0100
+#define SPD_AUDIT_DUPLICATE_SERIAL                  0x0200 // same vendor/serial, same part number
+#define SPD_AUDIT_SERIAL_CONFLICT                   0x0400 // same vendor/serial, different part number
+
+typedef struct _SPD_AUDIT_RECORD_
+{
+    unsigned int uFlags;
+    int nDeviceType;
+    int nSizeMB;
+    unsigned char bManufacturerBank;        // JEP106 continuation count, parity stripped
+    unsigned char bManufacturerID;          // JEP106 ID, parity stripped
+    unsigned short usStoredCRC;
+    unsigned short usComputedCRC;
+    unsigned int uSerial;
+    int nYear;
+    int nWeek;
+    char szPartNumber[SPD_AUDIT_PART_NUMBER_SIZE + 1];
+    int nJedecFrequency;                    // fastest JEDEC operating point
+    int nJedecCL;
+    int nJedecRCD;
+    int nJedecRP;
+    int nJedecRAS;
+    int nXMPProfiles;
+    int nXMPFrequency;                      // fastest XMP profile 1 operating point
+    int nXMPVoltage;                        // mV
+}SpdAuditRecord;
+
+// Decode and validate a single image. Does not allocate.
+void SpdAuditImage(const unsigned char *pbArray, int nSize, SpdAuditRecord *pRecord);
+
+// Flag records sharing a vendor/serial pair. qOrder is reused as scratch
+// space for the sort.
+void SpdAuditCrossCheck(std::vector<SpdAuditRecord> &qRecords, std::vector<unsigned int> &qOrder);
+
+unsigned short SpdCRC16(const unsigned char *pbArray, int nCount);
+
+// Write pszField as a quoted CSV field, embedded quotes doubled. Returns
+// the length the field needs, like snprintf, output truncated past nSize.
+int SpdCSVField(char *pszOutput, size_t nSize, const char *pszField);
+
+#endif
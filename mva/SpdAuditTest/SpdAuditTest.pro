@@ -0,0 +1,32 @@
+QT       += core testlib
+QT       -= gui
+
+CONFIG   += console c++11 testcase
+CONFIG   -= app_bundle
+
+include(../Licenta/others/project-configuration/project-defines.pri)
+
+TARGET = SpdAuditTest
+TEMPLATE = app
+
+win32 {
+DEFINES += NOMINMAX
+DEFINES += STK_WINDOWS
+}
+
+unix:!macx {
+DEFINES += STK_LINUX
+}
+
+Release:DESTDIR = $$PWD/../build
+Release:OBJECTS_DIR = $$PWD/../build/.obj/spd-audit-test
+
+Debug:DESTDIR = $$PWD/../build
+Debug:OBJECTS_DIR = $$PWD/../build/.obj/spd-audit-test
+
+SOURCES += tst_spd_audit.cpp \
+        ../SpdAudit/spd_audit.cpp \
+        ../Licenta/modules/motherboard/memory/spd_timings.cpp
+
+HEADERS += ../SpdAudit/spd_audit.h \
+        ../Licenta/modules/motherboard/memory/spd_timings.h
@@ -0,0 +1,298 @@
+#include <QtTest>
+
+#include <string.h>
+
+#include "../SpdAudit/spd_audit.h"
+
+// Decodes hand built images of known modules
+class CSpdAuditTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static void CopyString(unsigned char *pbArray, int nOffset, const char *pszString, int nSize);
+    static void SetDDR2Checksum(unsigned char *pbArray);
+    static void BuildDDR2Image(unsigned char *pbArray);
+    static void BuildDDR3Image(unsigned char *pbArray);
+
+private slots:
+    void DDR2Image();
+    void DDR2DeviceWidth();
+    void DDR2DensityMismatch();
+    void DDR3Image();
+    void TruncatedImage();
+    void ChecksumMismatch();
+    void CSVField();
+    void CrossCheck();
+};
+
+void CSpdAuditTest::CopyString(unsigned char *pbArray, int nOffset, const char *pszString, int nSize)
+{
+    memset(pbArray + nOffset, ' ', nSize);
+    memcpy(pbArray + nOffset, pszString, strlen(pszString));
+}
+
+void CSpdAuditTest::SetDDR2Checksum(unsigned char *pbArray)
+{
+    unsigned char bSum = 0;
+    for( int i = 0; i < 63; i++ )
+        bSum += pbArray[i];
+    pbArray[63] = bSum;
+}
+
+// 2 GB, 2 ranks of x8 512 Mb devices, DDR2-800 5-5-5-18
+void CSpdAuditTest::BuildDDR2Image(unsigned char *pbArray)
+{
+    memset(pbArray, 0, SPD_AUDIT_DDR2_IMAGE_SIZE);
+
+    pbArray[0] = 0x80;
+    pbArray[1] = 0x08;
+    pbArray[2] = SPD_AUDIT_TYPE_DDR2;
+    pbArray[3] = 14;                // row address bits
+    pbArray[4] = 10;                // column address bits
+    pbArray[5] = 0x61;              // 2 ranks
+    pbArray[6] = 64;
+    pbArray[8] = 0x05;              // SSTL 1.8V
+    pbArray[9] = 0x25;              // 2.5 ns @ CL5
+    pbArray[13] = 8;                // x8
+    pbArray[17] = 8;                // banks
+    pbArray[18] = 0x38;             // CL 3, 4, 5
+    pbArray[23] = 0x30;             // 3.0 ns @ CL4
+    pbArray[25] = 0x3D;             // 3.75 ns @ CL3
+    pbArray[27] = 0x32;             // tRP 12.5 ns
+    pbArray[28] = 0x1E;             // tRRD 7.5 ns
+    pbArray[29] = 0x32;             // tRCD 12.5 ns
+    pbArray[30] = 45;               // tRAS
+    pbArray[31] = 0x01;             // 1 GB per rank
+    pbArray[41] = 58;
+    pbArray[42] = 128;
+
+    SetDDR2Checksum(pbArray);
+
+    pbArray[64] = 0x7F;             // Kingston, bank 2
+    pbArray[65] = 0x98;
+    CopyString(pbArray, 73, "KVR800D2N5/2G", SPD_AUDIT_PART_NUMBER_SIZE);
+    pbArray[93] = 0x08;
+    pbArray[94] = 0x23;
+    pbArray[95] = 0x12;
+    pbArray[96] = 0x34;
+    pbArray[97] = 0x56;
+    pbArray[98] = 0x78;
+}
+
+// 2 GB, 1 rank of x8 2 Gb devices, DDR3-1333 9-9-9-24
+void CSpdAuditTest::BuildDDR3Image(unsigned char *pbArray)
+{
+    memset(pbArray, 0, SPD_AUDIT_DDR3_IMAGE_SIZE);
+
+    pbArray[0] = 0x92;              // CRC covers BYTE 0~116
+    pbArray[1] = 0x10;
+    pbArray[2] = SPD_AUDIT_TYPE_DDR3;
+    pbArray[3] = 0x02;
+    pbArray[4] = 0x03;              // 2 Gb, 8 banks
+    pbArray[5] = 0x11;
+    pbArray[7] = 0x01;              // 1 rank, x8
+    pbArray[8] = 0x03;              // 64 bit
+    pbArray[9] = 0x11;              // FTB 1 ps
+    pbArray[10] = 1;                // MTB 0.125 ns
+    pbArray[11] = 8;
+    pbArray[12] = 12;               // tCK 1.5 ns
+    pbArray[14] = 0x7E;             // CL 5~10
+    pbArray[16] = 108;              // tAA 13.5 ns
+    pbArray[17] = 120;
+    pbArray[18] = 108;
+    pbArray[19] = 48;
+    pbArray[20] = 108;
+    pbArray[21] = 0x11;
+    pbArray[22] = 0x20;             // tRAS 36 ns
+    pbArray[23] = 0x8C;             // tRC 49.5 ns
+    pbArray[24] = 0x70;
+    pbArray[25] = 0x03;
+    pbArray[26] = 60;
+    pbArray[27] = 60;
+    pbArray[28] = 0x01;
+    pbArray[29] = 0x2C;
+
+    pbArray[117] = 0x80;            // Samsung, bank 1
+    pbArray[118] = 0xCE;
+    pbArray[120] = 0x12;
+    pbArray[121] = 0x10;
+    pbArray[122] = 0x87;
+    pbArray[123] = 0x65;
+    pbArray[124] = 0x43;
+    pbArray[125] = 0x21;
+
+    unsigned short usCRC = SpdCRC16(pbArray, 117);
+    pbArray[126] = (unsigned char)(usCRC & 0xFF);
+    pbArray[127] = (unsigned char)(usCRC >> 8);
+
+    CopyString(pbArray, 128, "M378B5673FH0-CH9", SPD_AUDIT_PART_NUMBER_SIZE);
+}
+
+void CSpdAuditTest::DDR2Image()
+{
+    unsigned char pbImage[SPD_AUDIT_DDR2_IMAGE_SIZE];
+    SpdAuditRecord Record;
+
+    // Only the lower half of a DDR2 EEPROM is defined, dumps often stop there
+    BuildDDR2Image(pbImage);
+    SpdAuditImage(pbImage, sizeof(pbImage), &Record);
+
+    QCOMPARE(Record.uFlags, 0u);
+    QCOMPARE(Record.nDeviceType, SPD_AUDIT_TYPE_DDR2);
+    QCOMPARE(Record.nSizeMB, 2048);
+    QCOMPARE((int)Record.bManufacturerBank, 1);
+    QCOMPARE((int)Record.bManufacturerID, 0x18);
+    QCOMPARE(Record.uSerial, 0x12345678u);
+    QCOMPARE(Record.nYear, 2008);
+    QCOMPARE(Record.nWeek, 23);
+    QCOMPARE(QString(Record.szPartNumber), QString("KVR800D2N5/2G"));
+    QCOMPARE(Record.nJedecFrequency, 400);
+    QCOMPARE(Record.nJedecCL, 5);
+    QCOMPARE(Record.nJedecRCD, 5);
+    QCOMPARE(Record.nJedecRP, 5);
+    QCOMPARE(Record.nJedecRAS, 18);
+}
+
+void CSpdAuditTest::DDR2DeviceWidth()
+{
+    unsigned char pbImage[SPD_AUDIT_DDR2_IMAGE_SIZE];
+    SpdAuditRecord Record;
+
+    // 1 rank of x4 512 Mb devices is still 1 GB, the device width does not
+    // scale the module size
+    BuildDDR2Image(pbImage);
+    pbImage[4] = 11;
+    pbImage[5] = 0x60;
+    pbImage[13] = 4;
+    pbImage[17] = 4;
+    SetDDR2Checksum(pbImage);
+    SpdAuditImage(pbImage, sizeof(pbImage), &Record);
+
+    QCOMPARE(Record.uFlags, 0u);
+    QCOMPARE(Record.nSizeMB, 1024);
+}
+
+void CSpdAuditTest::DDR2DensityMismatch()
+{
+    unsigned char pbImage[SPD_AUDIT_DDR2_IMAGE_SIZE];
+    SpdAuditRecord Record;
+
+    // 2 GB ranks do not fit the addressing
+    BuildDDR2Image(pbImage);
+    pbImage[31] = 0x02;
+    SetDDR2Checksum(pbImage);
+    SpdAuditImage(pbImage, sizeof(pbImage), &Record);
+
+    QCOMPARE(Record.uFlags, (unsigned int)SPD_AUDIT_BAD_SIZE);
+    QCOMPARE(Record.nSizeMB, 0);
+
+    // Exactly one density bit is valid
+    pbImage[31] = 0x81;
+    SetDDR2Checksum(pbImage);
+    SpdAuditImage(pbImage, sizeof(pbImage), &Record);
+
+    QCOMPARE(Record.uFlags, (unsigned int)SPD_AUDIT_BAD_SIZE);
+}
+
+void CSpdAuditTest::DDR3Image()
+{
+    unsigned char pbImage[SPD_AUDIT_DDR3_IMAGE_SIZE];
+    SpdAuditRecord Record;
+
+    BuildDDR3Image(pbImage);
+    SpdAuditImage(pbImage, sizeof(pbImage), &Record);
+
+    QCOMPARE(Record.uFlags, 0u);
+    QCOMPARE(Record.nDeviceType, SPD_AUDIT_TYPE_DDR3);
+    QCOMPARE(Record.nSizeMB, 2048);
+    QCOMPARE((int)Record.bManufacturerBank, 0);
+    QCOMPARE((int)Record.bManufacturerID, 0x4E);
+    QCOMPARE(Record.uSerial, 0x87654321u);
+    QCOMPARE(Record.nYear, 2012);
+    QCOMPARE(Record.nWeek, 10);
+    QCOMPARE(QString(Record.szPartNumber), QString("M378B5673FH0-CH9"));
+    QCOMPARE(Record.nJedecFrequency, 667);
+    QCOMPARE(Record.nJedecCL, 9);
+    QCOMPARE(Record.nXMPProfiles, 0);
+}
+
+void CSpdAuditTest::TruncatedImage()
+{
+    unsigned char pbImage[SPD_AUDIT_DDR3_IMAGE_SIZE];
+    SpdAuditRecord Record;
+
+    // The DDR3 part number and XMP header live past BYTE 127
+    BuildDDR3Image(pbImage);
+    SpdAuditImage(pbImage, SPD_AUDIT_DDR2_IMAGE_SIZE, &Record);
+    QCOMPARE(Record.uFlags, (unsigned int)SPD_AUDIT_READ_ERROR);
+
+    BuildDDR2Image(pbImage);
+    SpdAuditImage(pbImage, SPD_AUDIT_DDR2_IMAGE_SIZE - 1, &Record);
+    QCOMPARE(Record.uFlags, (unsigned int)SPD_AUDIT_READ_ERROR);
+
+    SpdAuditImage(pbImage, -1, &Record);
+    QCOMPARE(Record.uFlags, (unsigned int)SPD_AUDIT_READ_ERROR);
+}
+
+void CSpdAuditTest::ChecksumMismatch()
+{
+    unsigned char pbImage[SPD_AUDIT_DDR3_IMAGE_SIZE];
+    SpdAuditRecord Record;
+
+    BuildDDR2Image(pbImage);
+    pbImage[63]++;
+    SpdAuditImage(pbImage, SPD_AUDIT_DDR2_IMAGE_SIZE, &Record);
+    QCOMPARE(Record.uFlags, (unsigned int)SPD_AUDIT_CRC_MISMATCH);
+
+    BuildDDR3Image(pbImage);
+    pbImage[126]++;
+    SpdAuditImage(pbImage, sizeof(pbImage), &Record);
+    QCOMPARE(Record.uFlags, (unsigned int)SPD_AUDIT_CRC_MISMATCH);
+}
+
+void CSpdAuditTest::CSVField()
+{
+    char szField[32];
+
+    QCOMPARE(SpdCSVField(szField, sizeof(szField), "dumps/a.bin"), 13);
+    QCOMPARE(QString(szField), QString("\"dumps/a.bin\""));
+
+    QCOMPARE(SpdCSVField(szField, sizeof(szField), "KHX\"1600\",C9"), 16);
+    QCOMPARE(QString(szField), QString("\"KHX\"\"1600\"\",C9\""));
+
+    QCOMPARE(SpdCSVField(szField, sizeof(szField), ""), 2);
+    QCOMPARE(QString(szField), QString("\"\""));
+
+    // Truncated like snprintf, the needed length is still returned
+    QCOMPARE(SpdCSVField(szField, 5, "a\"bcd"), 8);
+    QCOMPARE(QString(szField), QString("\"a\"\""));
+}
+
+void CSpdAuditTest::CrossCheck()
+{
+    unsigned char pbImage[SPD_AUDIT_DDR2_IMAGE_SIZE];
+    std::vector<SpdAuditRecord> qRecords(4);
+    std::vector<unsigned int> qOrder;
+
+    BuildDDR2Image(pbImage);
+    SpdAuditImage(pbImage, sizeof(pbImage), &qRecords[0]);
+    SpdAuditImage(pbImage, sizeof(pbImage), &qRecords[1]);
+
+    // Another serial, then the same vendor and serial with another part number
+    pbImage[95] = 0x11;
+    SpdAuditImage(pbImage, sizeof(pbImage), &qRecords[2]);
+    CopyString(pbImage, 73, "KVR667D2N5/2G", SPD_AUDIT_PART_NUMBER_SIZE);
+    SpdAuditImage(pbImage, sizeof(pbImage), &qRecords[3]);
+
+    SpdAuditCrossCheck(qRecords, qOrder);
+
+    QCOMPARE(qRecords[0].uFlags, (unsigned int)SPD_AUDIT_DUPLICATE_SERIAL);
+    QCOMPARE(qRecords[1].uFlags, (unsigned int)SPD_AUDIT_DUPLICATE_SERIAL);
+    QCOMPARE(qRecords[2].uFlags, (unsigned int)SPD_AUDIT_SERIAL_CONFLICT);
+    QCOMPARE(qRecords[3].uFlags, (unsigned int)SPD_AUDIT_SERIAL_CONFLICT);
+}
+
+QTEST_APPLESS_MAIN(CSpdAuditTest)
+
+#include "tst_spd_audit.moc"